@@ -27,7 +27,8 @@ mkdir -p "${DIST_DIR}"
 echo "[1/5] Building Docker image (this downloads SCIP ~100MB)..."
 echo "      This step takes 5-10 minutes on first run."
 echo ""
-docker build -t scip-wasm-builder "${SCRIPT_DIR}"
+# SCIPJS_DYNLINK=1 ./build.sh also builds scip-api-dynlink.* for native wasm plugins
+docker build --build-arg SCIPJS_DYNLINK="${SCIPJS_DYNLINK:-0}" -t scip-wasm-builder "${SCRIPT_DIR}"
 
 echo ""
 echo "[2/5] Running WASM compilation..."
@@ -55,6 +56,13 @@ cp "${SCRIPT_DIR}/src/scip-wrapper.js" "${DIST_DIR}/"
 cp "${SCRIPT_DIR}/src/scip-worker.js" "${DIST_DIR}/"
 cp "${SCRIPT_DIR}/src/scip-worker-client.js" "${DIST_DIR}/"
 cp "${SCRIPT_DIR}/src/scip-api-wrapper.js" "${DIST_DIR}/"
+cp "${SCRIPT_DIR}/src/scip-model-builder.js" "${DIST_DIR}/"
+cp "${SCRIPT_DIR}/src/scip-pool.js" "${DIST_DIR}/"
+cp "${SCRIPT_DIR}/src/scip-pool-worker.js" "${DIST_DIR}/"
+cp "${SCRIPT_DIR}/src/scip-lns.js" "${DIST_DIR}/"
+cp "${SCRIPT_DIR}/src/scip-rolling-horizon.js" "${DIST_DIR}/"
+cp "${SCRIPT_DIR}/src/scip-server.js" "${DIST_DIR}/"
+cp "${SCRIPT_DIR}/src/scip-loadgen.js" "${DIST_DIR}/"
 cp "${SCRIPT_DIR}/src/index.mjs" "${DIST_DIR}/"
 cp "${SCRIPT_DIR}/src/types.d.ts" "${DIST_DIR}/"
 cp "${SCRIPT_DIR}/src/pre.js" "${DIST_DIR}/"
@@ -67,6 +75,14 @@ else
     echo "      Check api-build.log for details"
 fi
 
+if [ -f "${DIST_DIR}/scip-api-mimalloc.wasm" ]; then
+    echo "      scip-api-mimalloc.wasm found (init({ allocator: 'mimalloc' }) available)"
+fi
+
+if [ -f "${DIST_DIR}/scip-api-dynlink.wasm" ]; then
+    echo "      scip-api-dynlink.wasm found (init({ dynamicLinking: true }) and loadPlugin() available)"
+fi
+
 # Create a simple post-process wrapper that adds pre.js content
 if [ -f "${DIST_DIR}/scip.js" ]; then
     echo ""
@@ -0,0 +1,404 @@
+/**
+ * SCIP.js test suite (npm test)
+ *
+ * Runs against the built dist/ (./build.sh first): model blob loading and
+ * rejection of malformed blobs, checkpoint save/resume, cut export/import,
+ * presolve-only with postsolve, and LNS and rolling-horizon results checked
+ * against a direct solve of the same model.
+ */
+import { SCIPApi, Status, decodeCheckpoint, decodeCutPack, postsolveSolution } from '../dist/scip-api-wrapper.js';
+import { ModelBuilder, VarType, readModel } from '../dist/scip-model-builder.js';
+import { randomKnapsack } from '../dist/scip-loadgen.js';
+import { solveRollingHorizon } from '../dist/scip-rolling-horizon.js';
+import { SolverPool } from '../dist/scip-pool.js';
+import { LNSEngine } from '../dist/scip-lns.js';
+import { fileURLToPath } from 'url';
+import { dirname, resolve } from 'path';
+
+const __filename = fileURLToPath(import.meta.url);
+const __dirname = dirname(__filename);
+const WASM_PATH = resolve(__dirname, '..', 'dist', 'scip-api.wasm');
+
+const EPS = 1e-6;
+
+function mulberry32(seed) {
+  return function () {
+    seed |= 0;
+    seed = (seed + 0x6d2b79f5) | 0;
+    let t = Math.imul(seed ^ (seed >>> 15), 1 | seed);
+    t = (t + Math.imul(t ^ (t >>> 7), 61 | t)) ^ t;
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+async function createSolver() {
+  const solver = new SCIPApi();
+  await solver.init({ wasmPath: WASM_PATH });
+  solver.setParamInt('display/verblevel', 0);
+  return solver;
+}
+
+function check(condition, message) {
+  if (!condition) {
+    throw new Error(message);
+  }
+}
+
+function near(a, b, tol = EPS) {
+  return Math.abs(a - b) <= tol * Math.max(1, Math.abs(a), Math.abs(b));
+}
+
+// Objective and the first violated bound or row of `values` in a blob (null if feasible)
+function evaluate(blob, values) {
+  const m = readModel(blob);
+  let objective = 0;
+  for (let j = 0; j < m.nvars; j += 1) {
+    const v = values[j];
+    if (v < m.lb[j] - EPS || v > m.ub[j] + EPS) {
+      return { objective: NaN, violation: `bound of x${j}` };
+    }
+    if (m.vartype[j] !== VarType.CONTINUOUS && Math.abs(v - Math.round(v)) > EPS) {
+      return { objective: NaN, violation: `integrality of x${j}` };
+    }
+    objective += m.obj[j] * v;
+  }
+  for (let i = 0; i < m.nrows; i += 1) {
+    let activity = 0;
+    for (let k = m.rowStart[i]; k < m.rowStart[i + 1]; k += 1) {
+      activity += m.vals[k] * values[m.colIdx[k]];
+    }
+    const tol = EPS * Math.max(1, Math.abs(activity));
+    if (activity < m.lhs[i] - tol || activity > m.rhs[i] + tol) {
+      return { objective: NaN, violation: `row ${i}` };
+    }
+  }
+  return { objective, violation: null };
+}
+
+// Small lot-sizing model (see scripts/bench-rolling-horizon.mjs) with week labels
+function lotSizing(rand, { items, weeks }) {
+  const model = new ModelBuilder({ name: 'lotsizing' });
+  const periods = [];
+  const label = (first, count, week) => {
+    for (let k = 0; k < count; k += 1) {
+      periods[first + k] = week;
+    }
+  };
+  const capacity = items * 25;
+  let stockBefore = null;
+  for (let t = 0; t < weeks; t += 1) {
+    const make = model.addVars(items, { ub: capacity });
+    const setup = model.addVars(items, { ub: 1, vartype: VarType.BINARY });
+    const stock = model.addVars(items, { ub: 1e20 });
+    label(make, items, t);
+    label(setup, items, t);
+    label(stock, items, t);
+    const cap = model.addRow({ rhs: capacity });
+    model.addCoefs(cap, Array.from({ length: items }, (_, i) => make + i), new Array(items).fill(1));
+    for (let i = 0; i < items; i += 1) {
+      model.setObjective(setup + i, 50 + Math.floor(rand() * 150));
+      model.setObjective(stock + i, 1 + Math.floor(rand() * 4));
+      const demand = Math.floor(rand() * 40);
+      const balance = model.addRow({ lhs: demand, rhs: demand });
+      const cols = [make + i, stock + i];
+      const vals = [1, -1];
+      if (stockBefore !== null) {
+        cols.push(stockBefore + i);
+        vals.push(1);
+      }
+      model.addCoefs(balance, cols, vals);
+      const link = model.addRow({ rhs: 0 });
+      model.addCoefs(link, [make + i, setup + i], [1, -capacity]);
+    }
+    stockBefore = stock;
+  }
+  return { model, periods };
+}
+
+async function testBlobRoundTrip() {
+  console.log('=== Model blob round trip ===');
+  const model = new ModelBuilder({ name: 'roundtrip', maximize: true });
+  const x = model.addVar({ name: 'x', ub: 4, obj: 5, vartype: VarType.INTEGER });
+  const y = model.addVar({ name: 'y', ub: 10, obj: 2 });
+  const row = model.addRow({ name: 'cap', rhs: 9 });
+  model.addCoefs(row, [x, y], [2, 1]);
+  const blob = model.compile();
+
+  const view = readModel(blob);
+  check(view.nvars === 2 && view.nrows === 1 && view.nnz === 2, 'readModel sizes');
+  check(view.varNames.join() === 'x,y' && view.rowNames.join() === 'cap', 'readModel names');
+
+  const solver = await createSolver();
+  try {
+    const result = await solver.solveModel(blob);
+    console.log('  status:', result.status, 'objective:', result.objective);
+    // x = 4 uses 8 of 9, y = 1: 20 + 2
+    check(result.status === Status.OPTIMAL && near(result.objective, 22), 'round-trip objective');
+    check(near(result.values[0], 4) && near(result.values[1], 1), 'round-trip values');
+  } finally {
+    solver.destroy();
+  }
+  return true;
+}
+
+async function testMalformedBlobs() {
+  console.log('\n=== Malformed model blobs are rejected ===');
+  const base = new Uint8Array(randomKnapsack(mulberry32(5), { vars: 12, rows: 3 }));
+  const mutate = (fn) => {
+    const copy = base.slice();
+    fn(copy, readModel(copy), new Int32Array(copy.buffer, 0, 16));
+    return copy;
+  };
+  const cases = {
+    'bad magic': mutate((_, __, header) => { header[0] = 0; }),
+    truncated: base.slice(0, base.length - 5),
+    'header only': base.slice(0, 64),
+    'negative count': mutate((_, __, header) => { header[5] = -1; }),
+    // Section sizes that wrap a 32-bit size_t back into the buffer
+    'wrapping nvars': mutate((_, __, header) => { header[3] = 0x20000000; }),
+    'rowstart not from 0': mutate((_, view) => { view.rowStart[0] = 1; }),
+    'rowstart decreasing': mutate((_, view) => { view.rowStart[1] = view.nnz + 100; }),
+    'column out of range': mutate((_, view) => { view.colIdx[0] = view.nvars; }),
+    'bad vartype': mutate((_, view) => { view.vartype[0] = 7; }),
+  };
+
+  const solver = await createSolver();
+  try {
+    for (const [name, blob] of Object.entries(cases)) {
+      check(solver.loadModel(blob) === false, `loadModel accepted a blob with ${name}`);
+      check(solver.modelComponents(blob) === null, `modelComponents accepted a blob with ${name}`);
+      console.log(`  rejected: ${name}`);
+    }
+    // A rejected load leaves no half-built problem behind
+    const result = await solver.solveModel(base);
+    check(result.status === Status.OPTIMAL, 'solve after rejected loads');
+    check(evaluate(base, result.values).violation === null, 'solution after rejected loads is feasible');
+  } finally {
+    solver.destroy();
+  }
+  return true;
+}
+
+async function testCheckpointResume() {
+  console.log('\n=== Checkpoint save and resume ===');
+  const blob = randomKnapsack(mulberry32(3), { vars: 120, rows: 10 });
+  const stopEarly = { params: { 'limits/nodes': 3 } };
+
+  const direct = await createSolver();
+  const full = await direct.solveModel(blob);
+  direct.destroy();
+  check(full.status === Status.OPTIMAL, 'direct solve of the checkpoint model');
+
+  const first = await createSolver();
+  const part = await first.solveModel(blob, { settings: stopEarly, checkpoint: true });
+  first.destroy();
+  check(part.checkpoint, `no checkpoint after the node limit (status ${part.status})`);
+  const info = decodeCheckpoint(part.checkpoint);
+  console.log(`  checkpoint: ${part.checkpoint.byteLength} bytes, ${info.openNodes} open nodes, region ${info.regionHash}`);
+
+  const second = await createSolver();
+  try {
+    const resumed = await second.solveModel(blob, { resumeFrom: part.checkpoint });
+    console.log('  resumed:', resumed.status, resumed.objective, 'direct:', full.objective);
+    check(resumed.status === Status.OPTIMAL && near(resumed.objective, full.objective), 'resumed objective');
+
+    // Same variable count, different model: objective or rows changed
+    const otherObjective = new Uint8Array(blob).slice();
+    readModel(otherObjective).obj[0] += 1;
+    const otherRows = new Uint8Array(blob).slice();
+    readModel(otherRows).rhs[0] -= 1;
+    for (const other of [otherObjective, otherRows]) {
+      const rejected = await second.solveModel(other, { resumeFrom: part.checkpoint });
+      check(rejected.status === Status.ERROR, 'checkpoint accepted on a different model');
+    }
+
+    // A damaged node table is rejected before anything is applied: nodestart
+    // follows the header, stats, node bounds, bound values, solutions and pseudocosts
+    const damaged = part.checkpoint.slice();
+    const nodestart = 128 + 8 * (info.openNodes + info.boundChanges + info.solutions * info.nvars + 4 * info.nvars);
+    new DataView(damaged.buffer).setInt32(nodestart, 1, true);
+    check(second.loadModel(blob) && second.loadCheckpoint(damaged) === false, 'damaged checkpoint accepted');
+  } finally {
+    second.destroy();
+  }
+  return true;
+}
+
+async function testCutReuse() {
+  console.log('\n=== Cut export and import ===');
+  const blob = randomKnapsack(mulberry32(11), { vars: 80, rows: 8 });
+  const primalOnly = { params: { 'misc/allowstrongdualreds': false, 'misc/allowweakdualreds': false } };
+
+  const solver = await createSolver();
+  try {
+    const source = await solver.solveModel(blob, { settings: primalOnly, exportCuts: true });
+    check(source.status === Status.OPTIMAL && source.cuts, 'export after solve');
+    const pack = decodeCutPack(source.cuts);
+    console.log(`  pack: ${pack.cuts} cuts, ${pack.conflicts} conflicts, region ${pack.regionHash}`);
+    check(pack.nvars === readModel(blob).nvars, 'pack variable count');
+
+    const warm = await solver.solveModel(blob, { settings: primalOnly, reuseCuts: source.cuts });
+    console.log('  with cuts:', warm.status, warm.objective, `(${warm.cutsImported} rows imported)`);
+    check(warm.cutsImported === pack.nrows, 'every row of the pack imported on the same model');
+    check(warm.status === Status.OPTIMAL && near(warm.objective, source.objective), 'objective with imported cuts');
+
+    const otherRows = new Uint8Array(blob).slice();
+    readModel(otherRows).rhs[0] -= 1;
+    const rejected = await solver.solveModel(otherRows, { reuseCuts: source.cuts });
+    check(rejected.cutsImported === -1, 'cut pack accepted on a different feasible region');
+  } finally {
+    solver.destroy();
+  }
+  return true;
+}
+
+async function testPresolveOnly() {
+  console.log('\n=== Presolve only and postsolve ===');
+  // Knapsack with a fixed variable and an aggregation x1 = x2 for presolve to remove
+  const model = new ModelBuilder({ name: 'presolve', maximize: true });
+  const rand = mulberry32(7);
+  model.addVars(30, { ub: 1, vartype: VarType.BINARY });
+  for (let j = 0; j < 30; j += 1) {
+    model.setObjective(j, 1 + Math.floor(rand() * 20));
+  }
+  model.setBounds(0, 1, 1);
+  for (let i = 0; i < 3; i += 1) {
+    const row = model.addRow({ rhs: 60 });
+    model.addCoefs(row, Array.from({ length: 30 }, (_, j) => j), Array.from({ length: 30 }, () => 1 + Math.floor(rand() * 15)));
+  }
+  const link = model.addRow({ lhs: 0, rhs: 0 });
+  model.addCoefs(link, [1, 2], [1, -1]);
+  const blob = model.compile();
+
+  const solver = await createSolver();
+  try {
+    const direct = await solver.solveModel(blob);
+    check(direct.status === Status.OPTIMAL, 'direct solve of the presolve model');
+
+    const presolved = solver.presolveOnly(blob);
+    console.log('  presolve:', presolved.status, presolved.statistics);
+    let mapped;
+    if (presolved.status === Status.OPTIMAL) {
+      mapped = { values: presolved.values, objective: presolved.objective };
+    } else {
+      check(presolved.status === Status.UNKNOWN && presolved.model, 'reduced model');
+      check(presolved.statistics.vars < 30, 'presolve removed no variables');
+      const reduced = await solver.solveModel(presolved.model);
+      check(reduced.status === Status.OPTIMAL, 'solve of the reduced model');
+      mapped = postsolveSolution(presolved.postsolve, reduced.values, reduced.objective);
+    }
+    console.log('  postsolved objective:', mapped.objective, 'direct:', direct.objective);
+    check(near(mapped.objective, direct.objective), 'postsolved objective');
+    const { objective, violation } = evaluate(blob, mapped.values);
+    check(violation === null, `postsolved solution violates ${violation}`);
+    check(near(objective, direct.objective), 'objective of the postsolved values');
+
+    // Presolve alone settles a model whose variables are all fixed
+    const fixed = new ModelBuilder({ name: 'fixed' });
+    fixed.addVar({ lb: 2, ub: 2, obj: 3 });
+    fixed.addVar({ lb: 1, ub: 1, obj: -1 });
+    const row = fixed.addRow({ lhs: 0, rhs: 10 });
+    fixed.addCoefs(row, [0, 1], [1, 1]);
+    const solved = solver.presolveOnly(fixed.compile());
+    check(solved.status === Status.OPTIMAL && near(solved.objective, 5), 'model solved by presolve');
+    check(near(solved.values[0], 2) && near(solved.values[1], 1), 'values of a model solved by presolve');
+  } finally {
+    solver.destroy();
+  }
+  return true;
+}
+
+async function testLNS() {
+  console.log('\n=== LNS against a direct solve ===');
+  const blob = randomKnapsack(mulberry32(21), { vars: 60, rows: 6 });
+
+  const solver = await createSolver();
+  const direct = await solver.solveModel(blob);
+  solver.destroy();
+  check(direct.status === Status.OPTIMAL, 'direct solve of the LNS model');
+
+  const pool = new SolverPool({ size: 2, initOptions: { wasmPath: WASM_PATH } });
+  try {
+    const lns = await new LNSEngine(pool, blob, { timeLimit: 10, maxIterations: 20, seed: 1 }).run();
+    console.log(`  lns: ${lns.objective} after ${lns.iterations} iterations, direct: ${direct.objective}`);
+    const { objective, violation } = evaluate(blob, lns.values);
+    check(violation === null, `LNS solution violates ${violation}`);
+    check(near(objective, lns.objective), 'LNS objective matches its values');
+    // Maximizing: a heuristic cannot beat the proven optimum
+    check(lns.objective <= direct.objective + EPS * Math.max(1, Math.abs(direct.objective)), 'LNS beat the optimum');
+  } finally {
+    await pool.close();
+  }
+  return true;
+}
+
+async function testRollingHorizon() {
+  console.log('\n=== Rolling horizon against a direct solve ===');
+  const { model, periods } = lotSizing(mulberry32(11), { items: 3, weeks: 8 });
+  const blob = model.compile();
+
+  const direct = await createSolver();
+  const full = await direct.solveModel(blob, { timeLimit: 60 });
+  direct.destroy();
+  check(full.status === Status.OPTIMAL, 'direct solve of the lot-sizing model');
+
+  const solver = await createSolver();
+  try {
+    const rolling = await solveRollingHorizon(solver, blob, { varPeriods: periods, window: 4, step: 2, timeLimit: 60 });
+    console.log(`  rolling: ${rolling.status} ${rolling.objective} over ${rolling.windows.length} windows, direct: ${full.objective}`);
+    check(rolling.violatedRows.length === 0, `stitched solution violates rows ${rolling.violatedRows}`);
+    const { objective, violation } = evaluate(blob, rolling.values);
+    check(violation === null, `stitched solution violates ${violation}`);
+    check(near(objective, rolling.objective), 'rolling objective matches its values');
+    // Minimizing: committed windows can only lose against the monolithic optimum
+    check(rolling.objective >= full.objective - EPS * Math.max(1, Math.abs(full.objective)), 'rolling horizon beat the optimum');
+  } finally {
+    solver.destroy();
+  }
+  return true;
+}
+
+async function main() {
+  console.log('SCIP.js Test Suite\n');
+
+  const probe = await createSolver();
+  const current = ['_scip_problem_load_blob', '_scip_checkpoint_save', '_scip_cuts_export', '_scip_presolve_only']
+    .every((name) => typeof probe._module[name] === 'function');
+  probe.destroy();
+  if (!current) {
+    console.error('dist/scip-api.wasm predates the tested exports; rebuild with ./build.sh first');
+    process.exit(1);
+  }
+
+  const tests = [
+    testBlobRoundTrip,
+    testMalformedBlobs,
+    testCheckpointResume,
+    testCutReuse,
+    testPresolveOnly,
+    testLNS,
+    testRollingHorizon,
+  ];
+
+  let passed = 0;
+  for (const test of tests) {
+    try {
+      if (await test()) {
+        passed++;
+      }
+    } catch (error) {
+      console.error(`${test.name} failed: ${error.message}`);
+      console.error(error.stack);
+    }
+  }
+
+  console.log(`\n=== Results: ${passed}/${tests.length} tests passed ===`);
+  if (passed !== tests.length) {
+    process.exit(1);
+  }
+}
+
+main().catch((error) => {
+  console.error('Fatal error:', error);
+  process.exit(1);
+});
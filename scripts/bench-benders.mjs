@@ -0,0 +1,146 @@
+#!/usr/bin/env node
+/**
+ * Benders decomposition vs extensive form
+ *
+ * Two-stage stochastic capacitated facility location: open facilities in the
+ * master (binary), serve each scenario's demand from open facilities in the
+ * subproblems (continuous, unmet demand penalised). Solves the deterministic
+ * equivalent with solveModel() and the decomposition with solveBenders(),
+ * then both decompositions at once on a SolverPool (--workers > 0).
+ *
+ * Usage:
+ *   node scripts/bench-benders.mjs [--facilities 12] [--customers 40] [--scenarios 20] [--seed 5] [--workers 0]
+ */
+
+import { SCIPApi } from '../dist/scip-api-wrapper.js';
+import { ModelBuilder, VarType } from '../dist/scip-model-builder.js';
+import { SolverPool } from '../dist/scip-pool.js';
+import { fileURLToPath } from 'url';
+import { dirname, resolve } from 'path';
+
+const __dirname = dirname(fileURLToPath(import.meta.url));
+const distDir = resolve(__dirname, '..', 'dist');
+
+function parseArgs(argv) {
+  const args = { facilities: 12, customers: 40, scenarios: 20, seed: 5, workers: 0 };
+  for (let i = 0; i < argv.length; i += 1) {
+    const key = argv[i].replace(/^--/, '');
+    if (key in args) {
+      args[key] = Number(argv[i + 1]);
+      i += 1;
+    }
+  }
+  return args;
+}
+
+function mulberry32(seed) {
+  return function () {
+    seed |= 0;
+    seed = (seed + 0x6d2b79f5) | 0;
+    let t = Math.imul(seed ^ (seed >>> 15), 1 | seed);
+    t = (t + Math.imul(t ^ (t >>> 7), 61 | t)) ^ t;
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+function instance(rand, { facilities, customers, scenarios }) {
+  const fixed = Array.from({ length: facilities }, () => 200 + Math.floor(rand() * 300));
+  const capacity = Array.from({ length: facilities }, () => 80 + Math.floor(rand() * 120));
+  const cost = Array.from({ length: facilities }, () => Array.from({ length: customers }, () => 1 + Math.floor(rand() * 20)));
+  const demand = Array.from({ length: scenarios }, () => Array.from({ length: customers }, () => 5 + Math.floor(rand() * 25)));
+  return { facilities, customers, scenarios, fixed, capacity, cost, demand, penalty: 100 };
+}
+
+// Scenario s's recourse block over `open` (the facility variables of `model`)
+function addScenario(model, data, s, open, weight) {
+  const { facilities, customers, capacity, cost, demand, penalty } = data;
+  const x = [];
+  for (let i = 0; i < facilities; i += 1) {
+    x.push(model.addVars(customers, { ub: 1e20 }));
+    for (let j = 0; j < customers; j += 1) {
+      model.setObjective(x[i] + j, weight * cost[i][j]);
+    }
+  }
+  const unmet = model.addVars(customers, { obj: weight * penalty });
+  for (let i = 0; i < facilities; i += 1) {
+    const row = model.addRow({ name: `cap_${s}_${i}`, rhs: 0 });
+    const cols = Array.from({ length: customers }, (_, j) => x[i] + j);
+    model.addCoefs(row, [...cols, open[i]], [...cols.map(() => 1), -capacity[i]]);
+  }
+  for (let j = 0; j < customers; j += 1) {
+    const row = model.addRow({ name: `dem_${s}_${j}`, lhs: demand[s][j] });
+    model.addCoefs(row, [...Array.from({ length: facilities }, (_, i) => x[i] + j), unmet + j], new Array(facilities + 1).fill(1));
+  }
+}
+
+function extensiveForm(data) {
+  const model = new ModelBuilder({ name: 'extensive' });
+  const open = data.fixed.map((f, i) => model.addVar({ name: `open_${i}`, ub: 1, obj: f, vartype: VarType.BINARY }));
+  for (let s = 0; s < data.scenarios; s += 1) {
+    addScenario(model, data, s, open, 1 / data.scenarios);
+  }
+  return model.compile();
+}
+
+function decomposition(data) {
+  const master = new ModelBuilder({ name: 'master' });
+  data.fixed.forEach((f, i) => master.addVar({ name: `open_${i}`, ub: 1, obj: f, vartype: VarType.BINARY }));
+  const subproblems = [];
+  for (let s = 0; s < data.scenarios; s += 1) {
+    const sub = new ModelBuilder({ name: `scenario_${s}` });
+    // Copies of the master variables, linked by name
+    const open = data.fixed.map((_, i) => sub.addVar({ name: `open_${i}`, ub: 1 }));
+    addScenario(sub, data, s, open, 1 / data.scenarios);
+    subproblems.push(sub.compile());
+  }
+  return { master: master.compile(), subproblems };
+}
+
+async function main() {
+  const args = parseArgs(process.argv.slice(2));
+  const data = instance(mulberry32(args.seed), args);
+  const wasmPath = resolve(distDir, 'scip-api.wasm');
+
+  const solver = new SCIPApi();
+  await solver.init({ wasmPath });
+  if (!solver._module._scip_benders_begin) {
+    console.error('dist/scip-api.wasm predates scip_benders_begin; rebuild with ./build.sh first');
+    process.exit(1);
+  }
+  solver.setParamInt('display/verblevel', 0);
+
+  let t = performance.now();
+  const extensive = await solver.solveModel(extensiveForm(data));
+  const extensiveMs = performance.now() - t;
+
+  const { master, subproblems } = decomposition(data);
+  t = performance.now();
+  const benders = await solver.solveBenders(master, subproblems);
+  const bendersMs = performance.now() - t;
+  solver.destroy();
+
+  const rows = [
+    { method: 'extensive form', status: extensive.status, objective: extensive.objective, ms: Math.round(extensiveMs), nodes: extensive.statistics.nodes },
+    { method: 'benders', status: benders.status, objective: benders.objective, ms: Math.round(bendersMs), nodes: benders.statistics.nodes },
+  ];
+
+  if (args.workers > 0) {
+    // Independent decompositions (e.g. one per seed) spread over the workers
+    const pool = new SolverPool({ size: args.workers, initOptions: { wasmPath } });
+    const batches = Array.from({ length: args.workers }, (_, k) => decomposition(instance(mulberry32(args.seed + k), args)));
+    t = performance.now();
+    const results = await Promise.all(batches.map((d) => pool.solveBenders(d.master, d.subproblems, { budgetMs: 600000 })));
+    rows.push({ method: `${args.workers} x benders on pool`, status: results.map((r) => r.status).join(','), objective: NaN, ms: Math.round(performance.now() - t), nodes: NaN });
+    await pool.close();
+  }
+
+  console.table(rows);
+  console.log(`${args.scenarios} scenarios; benders: ${benders.benders.calls} subproblem rounds, ${benders.benders.cuts} cuts; `
+    + `objective difference ${Math.abs(benders.objective - extensive.objective).toExponential(2)}; `
+    + `speedup ${(extensiveMs / bendersMs).toFixed(2)}x`);
+}
+
+main().catch((error) => {
+  console.error(error);
+  process.exit(1);
+});
@@ -0,0 +1,146 @@
+#!/usr/bin/env node
+/**
+ * Microbenchmark of the C -> JS callback crossing
+ *
+ * Compares the old EM_ASM path (property lookup of Module.onX on every call)
+ * with a direct call through the wasm function table, the way the bridge now
+ * invokes onIncumbent/onNode/onPricerRedcost/onPricerFarkas. Then solves a
+ * random multi-knapsack with and without onNode/onIncumbent set and reports
+ * the overhead per delivered callback inside a real solve (--solve 0 skips it).
+ *
+ * Usage:
+ *   node scripts/bench-callbacks.mjs [--iterations 200000] [--repeats 5] [--solve 1] [--vars 60] [--rows 6] [--seed 3]
+ */
+
+import { SCIPApi } from '../dist/scip-api-wrapper.js';
+import { randomKnapsack } from '../dist/scip-loadgen.js';
+import { fileURLToPath } from 'url';
+import { dirname, resolve } from 'path';
+
+const __dirname = dirname(fileURLToPath(import.meta.url));
+const distDir = resolve(__dirname, '..', 'dist');
+
+function parseArgs(argv) {
+  const args = { iterations: 200000, repeats: 5, solve: 1, vars: 60, rows: 6, seed: 3 };
+  for (let i = 0; i < argv.length; i += 1) {
+    const key = argv[i].replace(/^--/, '');
+    if (key in args) {
+      args[key] = Number(argv[i + 1]);
+      i += 1;
+    }
+  }
+  return args;
+}
+
+function mulberry32(seed) {
+  return function () {
+    seed |= 0;
+    seed = (seed + 0x6d2b79f5) | 0;
+    let t = Math.imul(seed ^ (seed >>> 15), 1 | seed);
+    t = (t + Math.imul(t ^ (t >>> 7), 61 | t)) ^ t;
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+function median(values) {
+  const sorted = [...values].sort((a, b) => a - b);
+  return sorted[Math.floor(sorted.length / 2)];
+}
+
+async function main() {
+  const args = parseArgs(process.argv.slice(2));
+  const solver = new SCIPApi();
+  await solver.init({ wasmPath: resolve(distDir, 'scip-api.wasm') });
+  const module = solver._module;
+
+  if (!module._scip_bench_callback || !module.addFunction) {
+    console.error('dist/scip-api.wasm predates scip_bench_callback; rebuild with ./build.sh first');
+    process.exit(1);
+  }
+
+  // Same trivial body on both paths so only the crossing differs
+  let sink = 0;
+  module.onBenchCallback = (i) => { sink += i; };
+  const fnptr = module.addFunction((i) => { sink += i; }, 'vi');
+
+  // Warm up both paths so the JIT has settled before measuring
+  module._scip_bench_callback(0, 10000);
+  module._scip_bench_callback(fnptr, 10000);
+
+  const emAsm = [];
+  const table = [];
+  for (let r = 0; r < args.repeats; r += 1) {
+    emAsm.push(module._scip_bench_callback(0, args.iterations));
+    table.push(module._scip_bench_callback(fnptr, args.iterations));
+  }
+
+  module.removeFunction(fnptr);
+  solver.destroy();
+
+  const rows = [
+    { path: 'EM_ASM Module.onX lookup', ...summarize(emAsm, args.iterations) },
+    { path: 'function table pointer', ...summarize(table, args.iterations) },
+  ];
+  console.log(`iterations: ${args.iterations}, repeats: ${args.repeats} (median), checksum ${sink}`);
+  console.table(rows);
+  console.log(`speedup: ${(median(emAsm) / median(table)).toFixed(2)}x`);
+
+  if (args.solve) {
+    await benchSolve(args);
+  }
+}
+
+// Same model and settings with and without JS callbacks; the search does not
+// depend on them, so the time difference is the cost of delivering them
+async function benchSolve(args) {
+  const model = randomKnapsack(mulberry32(args.seed), { vars: args.vars, rows: args.rows });
+  const run = async (withCallbacks) => {
+    const solver = new SCIPApi();
+    await solver.init({ wasmPath: resolve(distDir, 'scip-api.wasm') });
+    solver.setParamInt('display/verblevel', 0);
+    let callbacks = 0;
+    if (withCallbacks) {
+      solver.onNode(() => { callbacks += 1; });
+      solver.onIncumbent(() => { callbacks += 1; });
+    }
+    const t = performance.now();
+    const result = await solver.solveModel(model);
+    const ms = performance.now() - t;
+    solver.destroy();
+    return { ms, nodes: result.statistics.nodes, callbacks };
+  };
+
+  const without = [];
+  const withCb = [];
+  let nodes = 0;
+  let callbacks = 0;
+  for (let r = 0; r < args.repeats; r += 1) {
+    without.push((await run(false)).ms);
+    const sample = await run(true);
+    withCb.push(sample.ms);
+    nodes = sample.nodes;
+    callbacks = sample.callbacks;
+  }
+
+  const delta = median(withCb) - median(without);
+  console.log(`\nin-solve: ${args.vars} vars, ${args.rows} rows, ${nodes} nodes, ${callbacks} callbacks per solve`);
+  console.table([
+    { run: 'no callbacks', ms: +median(without).toFixed(1) },
+    { run: 'onNode + onIncumbent', ms: +median(withCb).toFixed(1) },
+  ]);
+  console.log(`overhead: ${(delta).toFixed(1)} ms per solve, `
+    + `${callbacks > 0 ? ((delta * 1e3) / callbacks).toFixed(2) : 'n/a'} us per callback`);
+}
+
+function summarize(samples, iterations) {
+  const ms = median(samples);
+  return {
+    totalMs: +ms.toFixed(2),
+    nsPerCall: +((ms * 1e6) / iterations).toFixed(1),
+  };
+}
+
+main().catch((error) => {
+  console.error(error);
+  process.exit(1);
+});
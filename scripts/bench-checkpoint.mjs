@@ -0,0 +1,96 @@
+#!/usr/bin/env node
+/**
+ * Checkpoint / resume progress loss
+ *
+ * Solves a random multi-knapsack to optimality once without interruption,
+ * then again with an interruption after --cut seconds: checkpoint, destroy the
+ * instance, resume in a fresh SCIPApi. Reports how much of the interrupted
+ * run's work had to be redone (target: under 20%).
+ *
+ * Usage:
+ *   node scripts/bench-checkpoint.mjs [--vars 60] [--rows 6] [--cut 2] [--seed 3]
+ */
+
+import { SCIPApi, decodeCheckpoint } from '../dist/scip-api-wrapper.js';
+import { randomKnapsack } from '../dist/scip-loadgen.js';
+import { fileURLToPath } from 'url';
+import { dirname, resolve } from 'path';
+
+const __dirname = dirname(fileURLToPath(import.meta.url));
+const distDir = resolve(__dirname, '..', 'dist');
+
+function parseArgs(argv) {
+  const args = { vars: 60, rows: 6, cut: 2, seed: 3 };
+  for (let i = 0; i < argv.length; i += 1) {
+    const key = argv[i].replace(/^--/, '');
+    if (key in args) {
+      args[key] = Number(argv[i + 1]);
+      i += 1;
+    }
+  }
+  return args;
+}
+
+function mulberry32(seed) {
+  return function () {
+    seed |= 0;
+    seed = (seed + 0x6d2b79f5) | 0;
+    let t = Math.imul(seed ^ (seed >>> 15), 1 | seed);
+    t = (t + Math.imul(t ^ (t >>> 7), 61 | t)) ^ t;
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+async function freshSolver() {
+  const solver = new SCIPApi();
+  await solver.init({ wasmPath: resolve(distDir, 'scip-api.wasm') });
+  if (!solver._module._scip_checkpoint_save) {
+    console.error('dist/scip-api.wasm predates scip_checkpoint_save; rebuild with ./build.sh first');
+    process.exit(1);
+  }
+  solver.setParamInt('display/verblevel', 0);
+  return solver;
+}
+
+async function main() {
+  const args = parseArgs(process.argv.slice(2));
+  const model = randomKnapsack(mulberry32(args.seed), { vars: args.vars, rows: args.rows });
+
+  const baseline = await freshSolver();
+  const full = await baseline.solveModel(model);
+  baseline.destroy();
+
+  const first = await freshSolver();
+  const part1 = await first.solveModel(model, { timeLimit: args.cut, checkpoint: true });
+  first.destroy();
+
+  if (!part1.checkpoint) {
+    console.log(`solved before the ${args.cut}s cut (${part1.statistics.solvingTime.toFixed(2)}s); use a harder model`);
+    return;
+  }
+
+  const info = decodeCheckpoint(part1.checkpoint);
+  const second = await freshSolver();
+  const part2 = await second.solveModel(model, { resumeFrom: part1.checkpoint });
+  second.destroy();
+
+  const interrupted = part1.statistics.solvingTime;
+  const total = interrupted + part2.statistics.solvingTime;
+  // Work redone = resumed total beyond the uninterrupted run, relative to the work done before the cut
+  const lost = Math.max(0, total - full.statistics.solvingTime) / interrupted;
+
+  console.table([
+    { run: 'uninterrupted', seconds: +full.statistics.solvingTime.toFixed(2), nodes: full.statistics.nodes, objective: full.objective },
+    { run: `until ${args.cut}s cut`, seconds: +interrupted.toFixed(2), nodes: part1.statistics.nodes, objective: part1.objective },
+    { run: 'resumed', seconds: +part2.statistics.solvingTime.toFixed(2), nodes: part2.statistics.nodes, objective: part2.objective },
+  ]);
+  console.log(`checkpoint: ${part1.checkpoint.byteLength} bytes, ${info.openNodes} open nodes, `
+    + `${info.solutions} solutions, ${info.droppedBoundChanges} dropped bound changes; `
+    + `${part2.resumedNodes} nodes re-created`);
+  console.log(`progress lost: ${(lost * 100).toFixed(1)}% of the interrupted run`);
+}
+
+main().catch((error) => {
+  console.error(error);
+  process.exit(1);
+});
@@ -0,0 +1,209 @@
+#!/usr/bin/env node
+/**
+ * Column generation with and without dual stabilization
+ *
+ * Root LP of a random cutting-stock instance (Gilmore-Gomory master, bounded
+ * knapsack pricing by dynamic programming in JS), solved once per
+ * stabilization mode, then with the knapsack as a native pricing template
+ * (solved by a secondary SCIP inside the bridge, no JS in the loop), and once
+ * more with column aging. Reports pricing rounds, mispricings, time to the
+ * same root bound and the LP size from the pricing trace.
+ *
+ * Usage:
+ *   node scripts/bench-colgen.mjs [--items 60] [--width 10000] [--seed 7]
+ */
+
+import { SCIPApi } from '../dist/scip-api-wrapper.js';
+import { ModelBuilder, VarType } from '../dist/scip-model-builder.js';
+import { fileURLToPath } from 'url';
+import { dirname, resolve } from 'path';
+
+const __dirname = dirname(fileURLToPath(import.meta.url));
+const distDir = resolve(__dirname, '..', 'dist');
+
+function parseArgs(argv) {
+  const args = { items: 60, width: 10000, seed: 7 };
+  for (let i = 0; i < argv.length; i += 1) {
+    const key = argv[i].replace(/^--/, '');
+    if (key in args) {
+      args[key] = Number(argv[i + 1]);
+      i += 1;
+    }
+  }
+  return args;
+}
+
+function mulberry32(seed) {
+  return function () {
+    seed |= 0;
+    seed = (seed + 0x6d2b79f5) | 0;
+    let t = Math.imul(seed ^ (seed >>> 15), 1 | seed);
+    t = (t + Math.imul(t ^ (t >>> 7), 61 | t)) ^ t;
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+function instance(rand, { items, width }) {
+  const sizes = Array.from({ length: items }, () => Math.floor(width * (0.05 + rand() * 0.45)));
+  const demand = Array.from({ length: items }, () => 1 + Math.floor(rand() * 100));
+  return { width, sizes, demand };
+}
+
+// Pattern knapsack as a pricing template: a[i] copies of item i, column cost 1
+function knapsackTemplate({ width, sizes }) {
+  const model = new ModelBuilder({ name: 'pattern' });
+  const a = sizes.map((s) => model.addVar({ ub: Math.floor(width / s), vartype: VarType.INTEGER }));
+  const row = model.addRow({ rhs: width });
+  model.addCoefs(row, a, sizes);
+  return model;
+}
+
+async function solveRoot(data, stabilization, { native = false, aging = null } = {}) {
+  const solver = new SCIPApi();
+  await solver.init({ wasmPath: resolve(distDir, 'scip-api.wasm') });
+  solver.setParamInt('display/verblevel', 0);
+  solver.setParamLongint('limits/nodes', 1);
+
+  const { width, sizes, demand } = data;
+  const n = sizes.length;
+  solver.beginProblem({ name: 'cutting_stock' });
+  const conss = demand.map((d, i) => solver.addLinearCons({ name: `demand_${i}`, lhs: d, modifiable: true }));
+  for (let i = 0; i < n; i += 1) {
+    const v = solver.addVar({ name: `single_${i}`, obj: 1 });
+    solver.addCoefLinear(conss[i], v, Math.floor(width / sizes[i]));
+  }
+  solver.includePricer({ name: 'cutting_stock_pricer' });
+  solver.activatePricer();
+  solver.setDualStabilization(stabilization);
+  solver.enablePricingTrace();
+  if (aging) {
+    solver.setColumnAging(aging);
+  }
+  if (native) {
+    const template = solver.addPricingTemplate(knapsackTemplate(data), {
+      column: { consIds: conss, vars: conss.map((_, i) => i), coefs: conss.map(() => 1) },
+      constCost: 1,
+    });
+    return finish(solver, `${stabilization.mode} + native template`, () => solver.getPricingTemplateStats(template).columns);
+  }
+
+  let transformed = null;
+  let columns = 0;
+  const bounds = sizes.map((s) => Math.floor(width / s));
+  solver.onPricerRedcost(() => {
+    transformed ||= conss.map((c) => solver.getTransformedConsId(c));
+    const duals = transformed.map((c) => solver.getConsDualLinear(c));
+    const pattern = bestPattern(duals, sizes, bounds, width);
+    if (pattern.value > 1 + 1e-6) {
+      const v = solver.addPricedVar({ name: `p${columns}`, obj: 1 });
+      const rows = [];
+      const vals = [];
+      pattern.counts.forEach((a, i) => {
+        if (a > 0) {
+          rows.push(transformed[i]);
+          vals.push(a);
+        }
+      });
+      solver.addVarToConssBatch(v, rows, vals);
+      columns += 1;
+    }
+    solver.setPricerResult(solver.getResultCodeSuccess());
+  });
+
+  return finish(solver, aging ? `${stabilization.mode} + aging` : stabilization.mode, () => columns);
+}
+
+async function finish(solver, label, countColumns) {
+  const t = performance.now();
+  const result = await solver.solveCurrentModel();
+  const ms = performance.now() - t;
+  const stats = solver.getDualStabilizationStats();
+  const { rounds: trace } = solver.exportPricingTraceJSON();
+  const row = {
+    pricing: label,
+    rounds: solver.getPricerRedcostCalls(),
+    calls: solver.getPricerRound(),
+    mispricings: stats.mispricings,
+    columns: countColumns(),
+    peakLpCols: trace.reduce((peak, rec) => Math.max(peak, rec.lpCols), 0),
+    lastLpCols: trace.length > 0 ? trace[trace.length - 1].lpCols : 0,
+    pooled: trace.length > 0 ? trace[trace.length - 1].pooled : 0,
+    rootBound: +result.statistics.dualBound.toFixed(4),
+    ms: Math.round(ms),
+  };
+  solver.destroy();
+  return row;
+}
+
+// Bounded knapsack max sum(duals[i] * a[i]) s.t. sum(sizes[i] * a[i]) <= width, a[i] <= bounds[i];
+// binary splitting of the bounds keeps the DP 0-1, one choice table per piece
+function bestPattern(duals, sizes, bounds, width) {
+  const n = sizes.length;
+  const best = new Float64Array(width + 1);
+  const choice = [];
+  for (let i = 0; i < n; i += 1) {
+    const profit = duals[i];
+    const pieces = [];
+    if (profit > 1e-9) {
+      for (let k = 1, left = bounds[i]; left > 0; k *= 2) {
+        const copies = Math.min(k, left);
+        left -= copies;
+        pieces.push(copies);
+      }
+    }
+    for (const copies of pieces) {
+      const w = sizes[i] * copies;
+      const p = profit * copies;
+      const took = new Uint8Array(width + 1);
+      for (let c = width; c >= w; c -= 1) {
+        if (best[c - w] + p > best[c] + 1e-12) {
+          best[c] = best[c - w] + p;
+          took[c] = 1;
+        }
+      }
+      choice.push({ item: i, copies, w, took });
+    }
+  }
+  const counts = new Int32Array(n);
+  let c = width;
+  for (let k = choice.length - 1; k >= 0; k -= 1) {
+    if (choice[k].took[c]) {
+      counts[choice[k].item] += choice[k].copies;
+      c -= choice[k].w;
+    }
+  }
+  return { value: best[width], counts };
+}
+
+async function main() {
+  const args = parseArgs(process.argv.slice(2));
+  const data = instance(mulberry32(args.seed), args);
+
+  const probe = new SCIPApi();
+  await probe.init({ wasmPath: resolve(distDir, 'scip-api.wasm') });
+  if (!probe._module._scip_pricing_trace_enable) {
+    console.error('dist/scip-api.wasm predates scip_pricing_trace_enable; rebuild with ./build.sh first');
+    process.exit(1);
+  }
+  probe.destroy();
+
+  const rows = [];
+  for (const stabilization of [
+    { mode: 'none' },
+    { mode: 'smoothing', alpha: 0.5, adaptive: true },
+    { mode: 'boxstep', width: 0.05, adaptive: true },
+  ]) {
+    rows.push(await solveRoot(data, stabilization));
+  }
+  rows.push(await solveRoot(data, { mode: 'smoothing', alpha: 0.5, adaptive: true }, { native: true }));
+  rows.push(await solveRoot(data, { mode: 'smoothing', alpha: 0.5, adaptive: true }, { aging: { ageLimit: 5 } }));
+  console.table(rows);
+  console.log(`rounds saved by smoothing: ${(100 * (1 - rows[1].rounds / rows[0].rounds)).toFixed(1)}%; `
+    + `native template vs JS pricer: ${(rows[1].ms / rows[3].ms).toFixed(2)}x; `
+    + `peak LP columns with aging: ${rows[4].peakLpCols} vs ${rows[1].peakLpCols}`);
+}
+
+main().catch((error) => {
+  console.error(error);
+  process.exit(1);
+});
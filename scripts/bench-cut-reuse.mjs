@@ -0,0 +1,139 @@
+#!/usr/bin/env node
+/**
+ * Cut and conflict reuse across related solves
+ *
+ * Solves a random multi-knapsack once and exports its cuts and conflicts,
+ * then solves objective-perturbed scenarios of it cold and with the pack
+ * imported (dual reductions off throughout, so the cuts stay valid for any
+ * objective), and finally re-solves the unchanged model with the pack of a
+ * default-settings solve, conflicts included. Reports root-node time, total
+ * time and nodes per solve, and checks the objectives agree.
+ *
+ * Usage:
+ *   node scripts/bench-cut-reuse.mjs [--vars 80] [--rows 8] [--scenarios 5] [--seed 11]
+ */
+
+import { SCIPApi, decodeCutPack } from '../dist/scip-api-wrapper.js';
+import { readModel } from '../dist/scip-model-builder.js';
+import { randomKnapsack } from '../dist/scip-loadgen.js';
+import { fileURLToPath } from 'url';
+import { dirname, resolve } from 'path';
+
+const __dirname = dirname(fileURLToPath(import.meta.url));
+const distDir = resolve(__dirname, '..', 'dist');
+
+const PRIMAL_ONLY = { params: { 'misc/allowstrongdualreds': false, 'misc/allowweakdualreds': false } };
+
+function parseArgs(argv) {
+  const args = { vars: 80, rows: 8, scenarios: 5, seed: 11 };
+  for (let i = 0; i < argv.length; i += 1) {
+    const key = argv[i].replace(/^--/, '');
+    if (key in args) {
+      args[key] = Number(argv[i + 1]);
+      i += 1;
+    }
+  }
+  return args;
+}
+
+function mulberry32(seed) {
+  return function () {
+    seed |= 0;
+    seed = (seed + 0x6d2b79f5) | 0;
+    let t = Math.imul(seed ^ (seed >>> 15), 1 | seed);
+    t = (t + Math.imul(t ^ (t >>> 7), 61 | t)) ^ t;
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+// Same rows and bounds, objective scaled by up to +-20% per variable
+function perturbObjective(blob, rand) {
+  const copy = new Uint8Array(blob).slice();
+  const { obj } = readModel(copy);
+  for (let j = 0; j < obj.length; j += 1) {
+    obj[j] = Math.round(obj[j] * (0.8 + 0.4 * rand()));
+  }
+  return copy;
+}
+
+async function run(model, options) {
+  const solver = new SCIPApi();
+  await solver.init({ wasmPath: resolve(distDir, 'scip-api.wasm') });
+  if (!solver._module._scip_cuts_export) {
+    console.error('dist/scip-api.wasm predates scip_cuts_export; rebuild with ./build.sh first');
+    process.exit(1);
+  }
+  solver.setParamInt('display/verblevel', 0);
+  solver.enableProfiling();
+  const result = await solver.solveModel(model, options);
+  const root = solver.exportChromeTrace().traceEvents.find((event) => event.name === 'root node');
+  solver.destroy();
+  return {
+    objective: result.objective,
+    rootMs: root ? root.dur / 1000 : NaN,
+    ms: result.statistics.solvingTime * 1000,
+    nodes: result.statistics.nodes,
+    cutsImported: result.cutsImported,
+    cuts: result.cuts,
+  };
+}
+
+async function main() {
+  const args = parseArgs(process.argv.slice(2));
+  const rand = mulberry32(args.seed);
+  const base = randomKnapsack(rand, { vars: args.vars, rows: args.rows });
+
+  const source = await run(base, { settings: PRIMAL_ONLY, exportCuts: true });
+  if (!source.cuts) {
+    console.log('no cuts to export; use a larger model');
+    return;
+  }
+  const pack = decodeCutPack(source.cuts);
+  console.log(`pack: ${pack.cuts} cuts, ${pack.conflicts} conflicts, ${pack.dropped} dropped, region ${pack.regionHash}`);
+
+  const rows = [];
+  for (let s = 0; s < args.scenarios; s += 1) {
+    const scenario = perturbObjective(base, rand);
+    const cold = await run(scenario, { settings: PRIMAL_ONLY });
+    const warm = await run(scenario, { settings: PRIMAL_ONLY, reuseCuts: source.cuts });
+    if (Math.abs(cold.objective - warm.objective) > 1e-6 * Math.max(1, Math.abs(cold.objective))) {
+      throw new Error(`scenario ${s}: objective ${warm.objective} with reused cuts, ${cold.objective} cold`);
+    }
+    rows.push({
+      solve: `scenario ${s}`,
+      imported: warm.cutsImported,
+      coldRootMs: +cold.rootMs.toFixed(1),
+      warmRootMs: +warm.rootMs.toFixed(1),
+      coldMs: Math.round(cold.ms),
+      warmMs: Math.round(warm.ms),
+      coldNodes: cold.nodes,
+      warmNodes: warm.nodes,
+    });
+  }
+
+  // Same objective: conflicts and dual-reduction cuts apply too
+  const first = await run(base, { exportCuts: true });
+  const again = await run(base, { reuseCuts: first.cuts });
+  if (Math.abs(first.objective - again.objective) > 1e-6 * Math.max(1, Math.abs(first.objective))) {
+    throw new Error(`re-solve: objective ${again.objective} with reused cuts, ${first.objective} cold`);
+  }
+  rows.push({
+    solve: 're-solve',
+    imported: again.cutsImported,
+    coldRootMs: +first.rootMs.toFixed(1),
+    warmRootMs: +again.rootMs.toFixed(1),
+    coldMs: Math.round(first.ms),
+    warmMs: Math.round(again.ms),
+    coldNodes: first.nodes,
+    warmNodes: again.nodes,
+  });
+
+  console.table(rows);
+  const sum = (key) => rows.reduce((total, row) => total + row[key], 0);
+  console.log(`root-node time with reused cuts: ${(100 * (1 - sum('warmRootMs') / sum('coldRootMs'))).toFixed(1)}% lower`);
+}
+
+main().catch((error) => {
+  console.error(error);
+  process.exit(1);
+});
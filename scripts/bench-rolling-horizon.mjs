@@ -0,0 +1,140 @@
+#!/usr/bin/env node
+/**
+ * Rolling horizon vs monolithic solve
+ *
+ * Multi-item capacitated lot sizing over --weeks periods (setup binaries,
+ * production, inventory): solves the full model with solveModel() and the
+ * same model with solveRollingHorizon(), each in a fresh SCIPApi, and reports
+ * objective, time and the WASM heap each needed (heap memory only grows, so
+ * its final size is the peak).
+ *
+ * Usage:
+ *   node scripts/bench-rolling-horizon.mjs [--items 20] [--weeks 52] [--window 8] [--step 4] [--time 120] [--seed 11]
+ */
+
+import { SCIPApi } from '../dist/scip-api-wrapper.js';
+import { ModelBuilder, VarType } from '../dist/scip-model-builder.js';
+import { solveRollingHorizon } from '../dist/scip-rolling-horizon.js';
+import { fileURLToPath } from 'url';
+import { dirname, resolve } from 'path';
+
+const __dirname = dirname(fileURLToPath(import.meta.url));
+const distDir = resolve(__dirname, '..', 'dist');
+
+function parseArgs(argv) {
+  const args = { items: 20, weeks: 52, window: 8, step: 4, time: 120, seed: 11 };
+  for (let i = 0; i < argv.length; i += 1) {
+    const key = argv[i].replace(/^--/, '');
+    if (key in args) {
+      args[key] = Number(argv[i + 1]);
+      i += 1;
+    }
+  }
+  return args;
+}
+
+function mulberry32(seed) {
+  return function () {
+    seed |= 0;
+    seed = (seed + 0x6d2b79f5) | 0;
+    let t = Math.imul(seed ^ (seed >>> 15), 1 | seed);
+    t = (t + Math.imul(t ^ (t >>> 7), 61 | t)) ^ t;
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+// Lot sizing with one shared capacity row per week; returns the model and week labels
+function lotSizing(rand, { items, weeks }) {
+  const model = new ModelBuilder({ name: 'lotsizing' });
+  const periods = [];
+  const label = (first, count, week) => {
+    for (let k = 0; k < count; k += 1) {
+      periods[first + k] = week;
+    }
+  };
+  const setupCost = Array.from({ length: items }, () => 50 + Math.floor(rand() * 150));
+  const holdCost = Array.from({ length: items }, () => 1 + Math.floor(rand() * 4));
+  const capacity = items * 25;
+  let stockBefore = null;
+  for (let t = 0; t < weeks; t += 1) {
+    const make = model.addVars(items, { ub: capacity });
+    const setup = model.addVars(items, { ub: 1, vartype: VarType.BINARY });
+    const stock = model.addVars(items, { ub: 1e20 });
+    label(make, items, t);
+    label(setup, items, t);
+    label(stock, items, t);
+    const cap = model.addRow({ rhs: capacity });
+    model.addCoefs(cap, Array.from({ length: items }, (_, i) => make + i), new Array(items).fill(1));
+    for (let i = 0; i < items; i += 1) {
+      model.setObjective(setup + i, setupCost[i]);
+      model.setObjective(stock + i, holdCost[i]);
+      const demand = Math.floor(rand() * 40);
+      // stock[t-1] + make[t] - stock[t] = demand[t]
+      const balance = model.addRow({ lhs: demand, rhs: demand });
+      const cols = [make + i, stock + i];
+      const vals = [1, -1];
+      if (stockBefore !== null) {
+        cols.push(stockBefore + i);
+        vals.push(1);
+      }
+      model.addCoefs(balance, cols, vals);
+      // make <= capacity * setup
+      const link = model.addRow({ rhs: 0 });
+      model.addCoefs(link, [make + i, setup + i], [1, -capacity]);
+    }
+    stockBefore = stock;
+  }
+  return { model, periods };
+}
+
+async function freshSolver() {
+  const solver = new SCIPApi();
+  await solver.init({ wasmPath: resolve(distDir, 'scip-api.wasm') });
+  solver.setParamInt('display/verblevel', 0);
+  return solver;
+}
+
+async function main() {
+  const args = parseArgs(process.argv.slice(2));
+  const { model, periods } = lotSizing(mulberry32(args.seed), args);
+  const rows = [];
+
+  let solver = await freshSolver();
+  let t = performance.now();
+  const full = await solver.solveModel(model, { timeLimit: args.time });
+  rows.push({
+    method: 'monolithic',
+    status: full.status,
+    objective: full.objective,
+    ms: Math.round(performance.now() - t),
+    heapMiB: +(solver._module.HEAP8.byteLength / 2 ** 20).toFixed(1),
+  });
+  solver.destroy();
+
+  solver = await freshSolver();
+  t = performance.now();
+  const rolling = await solveRollingHorizon(solver, model, {
+    varPeriods: periods,
+    window: args.window,
+    step: args.step,
+    timeLimit: args.time,
+  });
+  rows.push({
+    method: `rolling ${args.window}/${args.step}`,
+    status: rolling.status,
+    objective: rolling.objective,
+    ms: Math.round(performance.now() - t),
+    heapMiB: +(solver._module.HEAP8.byteLength / 2 ** 20).toFixed(1),
+  });
+  solver.destroy();
+
+  console.table(rows);
+  console.log(`${model.numVars} vars, ${model.numRows} rows; ${rolling.windows.length} windows of at most `
+    + `${Math.max(...rolling.windows.map((w) => w.vars))} vars; `
+    + `objective gap to monolithic ${((rolling.objective - full.objective) / Math.abs(full.objective) * 100).toFixed(2)}%`);
+}
+
+main().catch((error) => {
+  console.error(error);
+  process.exit(1);
+});
@@ -0,0 +1,143 @@
+#!/usr/bin/env node
+/**
+ * Soak test for long-lived SCIPApi instances
+ *
+ * Reuses one instance for thousands of sequential, varied models (the way
+ * pooled workers do) and reports throughput and the wasm heap over time, so
+ * the default dlmalloc build can be compared with the mimalloc variant.
+ *
+ * Usage:
+ *   node scripts/soak-reuse.mjs [--models 5000] [--allocator dlmalloc|mimalloc] [--every 500]
+ */
+
+import { SCIPApi } from '../dist/scip-api-wrapper.js';
+import { fileURLToPath } from 'url';
+import { dirname, resolve } from 'path';
+
+const __dirname = dirname(fileURLToPath(import.meta.url));
+const distDir = resolve(__dirname, '..', 'dist');
+
+function parseArgs(argv) {
+  const args = { models: 5000, allocator: 'dlmalloc', every: 500, seed: 1 };
+  for (let i = 0; i < argv.length; i += 1) {
+    const key = argv[i].replace(/^--/, '');
+    if (key in args) {
+      args[key] = key === 'allocator' ? argv[i + 1] : Number(argv[i + 1]);
+      i += 1;
+    }
+  }
+  return args;
+}
+
+// Small deterministic PRNG so runs are comparable across allocators
+function mulberry32(seed) {
+  return function () {
+    seed |= 0;
+    seed = (seed + 0x6d2b79f5) | 0;
+    let t = Math.imul(seed ^ (seed >>> 15), 1 | seed);
+    t = (t + Math.imul(t ^ (t >>> 7), 61 | t)) ^ t;
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+/**
+ * Random multi-knapsack with varying size so allocation sizes differ per model
+ */
+function buildModel(rand) {
+  const nvars = 5 + Math.floor(rand() * 60);
+  const nrows = 1 + Math.floor(rand() * 12);
+  const terms = [];
+  for (let j = 0; j < nvars; j += 1) {
+    terms.push(`${1 + Math.floor(rand() * 20)} x${j}`);
+  }
+  const lines = ['Maximize', ` obj: ${terms.join(' + ')}`, 'Subject To'];
+  for (let i = 0; i < nrows; i += 1) {
+    const row = [];
+    let total = 0;
+    for (let j = 0; j < nvars; j += 1) {
+      if (rand() < 0.5) {
+        const w = 1 + Math.floor(rand() * 15);
+        total += w;
+        row.push(`${w} x${j}`);
+      }
+    }
+    if (row.length === 0) {
+      row.push('1 x0');
+      total = 1;
+    }
+    lines.push(` c${i}: ${row.join(' + ')} <= ${Math.max(1, Math.floor(total / 2))}`);
+  }
+  lines.push('Binary');
+  for (let j = 0; j < nvars; j += 1) {
+    lines.push(` x${j}`);
+  }
+  lines.push('End');
+  return lines.join('\n');
+}
+
+function heapBytes(solver) {
+  if (typeof solver.sampleMemory === 'function' && solver._module._scip_memory_sample_now) {
+    return solver.sampleMemory().heapSize;
+  }
+  return solver._module.HEAPU8.length;
+}
+
+// Allocator footprint: the sbrk break, comparable across dlmalloc and mimalloc
+function breakBytes(solver) {
+  if (typeof solver.sampleMemory === 'function' && solver._module._scip_memory_sample_now) {
+    const { heapBreak } = solver.sampleMemory();
+    return heapBreak === undefined ? NaN : heapBreak;
+  }
+  return NaN;
+}
+
+async function main() {
+  const args = parseArgs(process.argv.slice(2));
+  const rand = mulberry32(args.seed);
+  const artifact = args.allocator === 'mimalloc' ? 'scip-api-mimalloc.wasm' : 'scip-api.wasm';
+
+  // Silence SCIP's console output; the soak is about the allocator
+  const log = console.log;
+  const solver = new SCIPApi();
+  await solver.init({ wasmPath: resolve(distDir, artifact), allocator: args.allocator });
+  solver.setParamInt('display/verblevel', 0);
+  solver._module.print = () => {};
+
+  const rows = [];
+  let failures = 0;
+  const start = performance.now();
+  let windowStart = start;
+
+  console.log = () => {};
+  try {
+    for (let m = 1; m <= args.models; m += 1) {
+      const result = await solver.solve(buildModel(rand), { format: 'lp', timeLimit: 10 });
+      if (result.status !== 'optimal') {
+        failures += 1;
+      }
+      if (m % args.every === 0) {
+        const t = performance.now();
+        rows.push({
+          models: m,
+          heapMB: +(heapBytes(solver) / 1048576).toFixed(1),
+          breakMB: +(breakBytes(solver) / 1048576).toFixed(1),
+          modelsPerSec: +((args.every * 1000) / (t - windowStart)).toFixed(1),
+        });
+        windowStart = t;
+      }
+    }
+  } finally {
+    console.log = log;
+  }
+
+  const elapsed = (performance.now() - start) / 1000;
+  console.log(`allocator: ${args.allocator}, models: ${args.models}, failures: ${failures}`);
+  console.table(rows);
+  console.log(`overall: ${(args.models / elapsed).toFixed(1)} models/s, final heap ${(heapBytes(solver) / 1048576).toFixed(1)} MB, heap break ${(breakBytes(solver) / 1048576).toFixed(1)} MB`);
+  solver.destroy();
+}
+
+main().catch((error) => {
+  console.error(error);
+  process.exit(1);
+});
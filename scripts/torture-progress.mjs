@@ -0,0 +1,108 @@
+#!/usr/bin/env node
+/**
+ * Progress seqlock torture test
+ *
+ * A writer thread publishes --updates snapshots with writeProgress() as fast
+ * as it can, each with every field set to its update number, while --readers
+ * threads (the main thread included) read the block with readProgress().
+ * A snapshot whose fields disagree is torn. Needs no wasm build: the seqlock
+ * is pure JS on both sides. Exits 1 on any torn or out-of-order snapshot.
+ *
+ * Usage:
+ *   node scripts/torture-progress.mjs [--updates 3000000] [--readers 2]
+ */
+
+import { Worker, isMainThread, parentPort, workerData } from 'worker_threads';
+import { fileURLToPath } from 'url';
+import { createProgressBuffer, readProgress, writeProgress, PROGRESS_FIELDS } from '../src/scip-api-wrapper.js';
+
+const __filename = fileURLToPath(import.meta.url);
+
+function parseArgs(argv) {
+  const args = { updates: 3000000, readers: 2 };
+  for (let i = 0; i < argv.length; i += 1) {
+    const key = argv[i].replace(/^--/, '');
+    if (key in args) {
+      args[key] = Number(argv[i + 1]);
+      i += 1;
+    }
+  }
+  return args;
+}
+
+// 'stage' is mapped to a name by readProgress; every other field carries the update number
+const CHECKED = PROGRESS_FIELDS.filter((name) => name !== 'stage');
+
+function write(buffer, updates, done) {
+  const fields = new Float64Array(PROGRESS_FIELDS.length);
+  for (let k = 1; k <= updates; k += 1) {
+    fields.fill(k);
+    writeProgress(buffer, fields);
+  }
+  Atomics.store(done, 0, 1);
+}
+
+// Read until the writer is done; counts reads, torn snapshots and ones older than the last seen
+function read(buffer, done) {
+  let reads = 0;
+  let torn = 0;
+  let backwards = 0;
+  let last = 0;
+  while (Atomics.load(done, 0) === 0) {
+    const snapshot = readProgress(buffer);
+    if (snapshot === null) {
+      continue;
+    }
+    reads += 1;
+    const value = snapshot[CHECKED[0]];
+    if (CHECKED.some((name) => snapshot[name] !== value)) {
+      torn += 1;
+    }
+    if (value < last) {
+      backwards += 1;
+    }
+    last = value;
+  }
+  return { reads, torn, backwards, last };
+}
+
+if (!isMainThread) {
+  const { role, buffer, done, updates } = workerData;
+  if (role === 'writer') {
+    write(buffer, updates, done);
+    parentPort.postMessage(null);
+  } else {
+    parentPort.postMessage(read(buffer, done));
+  }
+} else {
+  const args = parseArgs(process.argv.slice(2));
+  const buffer = createProgressBuffer();
+  const done = new Int32Array(new SharedArrayBuffer(4));
+  const spawn = (role) => new Promise((resolve, reject) => {
+    const worker = new Worker(__filename, { workerData: { role, buffer, done, updates: args.updates } });
+    worker.once('message', resolve);
+    worker.once('error', reject);
+  });
+
+  const start = performance.now();
+  const threads = [spawn('writer')];
+  for (let r = 1; r < args.readers; r += 1) {
+    threads.push(spawn('reader'));
+  }
+  // The main thread reads too, so readers run even with --readers 1
+  const results = [read(buffer, done), ...(await Promise.all(threads)).slice(1)];
+  const seconds = (performance.now() - start) / 1000;
+
+  const total = results.reduce((sum, r) => ({
+    reads: sum.reads + r.reads,
+    torn: sum.torn + r.torn,
+    backwards: sum.backwards + r.backwards,
+  }), { reads: 0, torn: 0, backwards: 0 });
+  const final = readProgress(buffer);
+  console.table(results.map((r, i) => ({ reader: i, ...r })));
+  console.log(`${args.updates} updates in ${seconds.toFixed(2)}s; ${total.reads} reads, `
+    + `${total.torn} torn, ${total.backwards} out of order; final update ${final ? final.updates : 'none'}`);
+  if (total.torn > 0 || total.backwards > 0 || !final || final.updates !== args.updates) {
+    process.exit(1);
+  }
+}
@@ -55,9 +55,34 @@ export {
 export { 
   SCIPApi,
   solveWithCallbacks,
+  decodeTreeTrace,
+  treeTraceToVbc,
+  decodePricingTrace,
+  TreeNodeStatus,
+  createProgressBuffer,
+  readProgress,
+  writeProgress,
+  createMailbox,
+  postToMailbox,
+  MailboxFlag,
+  decodeCheckpoint,
+  decodeCutPack,
+  decodePostsolveMap,
+  postsolveSolution,
+  CutRowFlag,
+  FEATURE_NAMES,
+  featuresToObject,
+  Emphasis,
+  ParamSetting,
   Status as ApiStatus
 } from './scip-api-wrapper.js';
 
+// Columnar model builder (pure JS, compiles to one blob for SCIPApi.solveModel)
+export { ModelBuilder, VarType, shareModel, readModel, extractSubmodel } from './scip-model-builder.js';
+
+// Rolling-horizon decomposition of time-indexed models over a SCIPApi
+export { solveRollingHorizon } from './scip-rolling-horizon.js';
+
 // Default export (main thread API)
 import SCIP from './scip-wrapper.js';
 export default SCIP;
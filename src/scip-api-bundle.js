@@ -81,29 +81,29 @@
         throw new Error("Failed to create SCIP instance");
       }
 
-      // Setup callbacks
-      this._module.onIncumbent = (objValue) => {
-        if (this._incumbentCallback) {
-          this._incumbentCallback(objValue);
-        }
-      };
-
-      this._module.onNode = (dualBound, primalBound, nodes) => {
-        if (this._nodeCallback) {
-          this._nodeCallback({ dualBound, primalBound, nodes });
-        }
-      };
-
-      this._module.onPricerRedcost = () => {
-        if (this._pricerRedcostCallback) {
-          this._pricerRedcostCallback();
-        }
-      };
-
-      this._module.onPricerFarkas = () => {
-        if (this._pricerFarkasCallback) {
-          this._pricerFarkasCallback();
-        }
+      // Setup callbacks: trampolines live in the wasm function table and C calls
+      // them through typed pointers; a 0 pointer disables the callback in C
+      this._callbackPtrs = {
+        incumbent: this._module.addFunction((objValue) => {
+          if (this._incumbentCallback) {
+            this._incumbentCallback(objValue);
+          }
+        }, "vd"),
+        node: this._module.addFunction((dualBound, primalBound, nodes) => {
+          if (this._nodeCallback) {
+            this._nodeCallback({ dualBound, primalBound, nodes });
+          }
+        }, "vddd"),
+        pricerRedcost: this._module.addFunction(() => {
+          if (this._pricerRedcostCallback) {
+            this._pricerRedcostCallback();
+          }
+        }, "vi"),
+        pricerFarkas: this._module.addFunction(() => {
+          if (this._pricerFarkasCallback) {
+            this._pricerFarkasCallback();
+          }
+        }, "vi"),
       };
 
       // Create virtual filesystem directories
@@ -116,28 +116,28 @@
     onIncumbent(callback) {
       this._incumbentCallback = callback;
       if (this._module) {
-        this._module._scip_enable_incumbent_callback(callback ? 1 : 0);
+        this._module._scip_set_incumbent_callback(callback ? this._callbackPtrs.incumbent : 0);
       }
     }
 
     onNode(callback) {
       this._nodeCallback = callback;
       if (this._module) {
-        this._module._scip_enable_node_callback(callback ? 1 : 0);
+        this._module._scip_set_node_callback(callback ? this._callbackPtrs.node : 0);
       }
     }
 
     onPricerRedcost(callback) {
       this._pricerRedcostCallback = callback;
       if (this._module) {
-        this._module._scip_pricer_enable_redcost_callback(callback ? 1 : 0);
+        this._module._scip_pricer_set_redcost_callback(callback ? this._callbackPtrs.pricerRedcost : 0);
       }
     }
 
     onPricerFarkas(callback) {
       this._pricerFarkasCallback = callback;
       if (this._module) {
-        this._module._scip_pricer_enable_farkas_callback(callback ? 1 : 0);
+        this._module._scip_pricer_set_farkas_callback(callback ? this._callbackPtrs.pricerFarkas : 0);
       }
     }
 
@@ -399,6 +399,41 @@
       return this._module._scip_pricer_get_round();
     }
 
+    setDualStabilization({ mode = "smoothing", alpha = 0.5, width = 1, adaptive = true } = {}) {
+      const modes = { none: 0, smoothing: 1, boxstep: 2 };
+      if (!(mode in modes)) {
+        throw new Error(`Unknown stabilization mode: ${mode}`);
+      }
+      const param = mode === "boxstep" ? width : alpha;
+      return this._module._scip_pricer_set_stabilization(modes[mode], param, adaptive ? 1 : 0) === 1;
+    }
+
+    getDualStabilizationStats() {
+      const ptr = this._module._malloc(4 * 8);
+      try {
+        this._module._scip_pricer_get_stabilization_stats(ptr);
+        const [rounds, mispricings, fallbacks, value] = this._module.HEAPF64.slice(ptr >> 3, (ptr >> 3) + 4);
+        return { rounds, mispricings, fallbacks, value };
+      } finally {
+        this._module._free(ptr);
+      }
+    }
+
+    setColumnAging({ ageLimit = 10, cleanupRoot = false, cleanupNodes = false } = {}) {
+      return this._module._scip_pricer_set_column_aging(ageLimit, cleanupRoot ? 1 : 0, cleanupNodes ? 1 : 0) === 1;
+    }
+
+    getColumnStats() {
+      const ptr = this._module._malloc(4 * 8);
+      try {
+        this._module._scip_pricer_get_column_stats(ptr);
+        const [inLP, pooled, meanAge, maxAge] = this._module.HEAPF64.slice(ptr >> 3, (ptr >> 3) + 4);
+        return { inLP, pooled, meanAge, maxAge };
+      } finally {
+        this._module._free(ptr);
+      }
+    }
+
     setParamInt(name, value) {
       return this._withCString(name, (namePtr) => this._module._scip_set_param_int(namePtr, value) === 1);
     }
@@ -507,10 +542,11 @@
       }
 
       // Enable callbacks if registered
-      this._module._scip_enable_incumbent_callback(this._incumbentCallback ? 1 : 0);
-      this._module._scip_enable_node_callback(this._nodeCallback ? 1 : 0);
-      this._module._scip_pricer_enable_redcost_callback(this._pricerRedcostCallback ? 1 : 0);
-      this._module._scip_pricer_enable_farkas_callback(this._pricerFarkasCallback ? 1 : 0);
+      const ptrs = this._callbackPtrs;
+      this._module._scip_set_incumbent_callback(this._incumbentCallback ? ptrs.incumbent : 0);
+      this._module._scip_set_node_callback(this._nodeCallback ? ptrs.node : 0);
+      this._module._scip_pricer_set_redcost_callback(this._pricerRedcostCallback ? ptrs.pricerRedcost : 0);
+      this._module._scip_pricer_set_farkas_callback(this._pricerFarkasCallback ? ptrs.pricerFarkas : 0);
 
       // Solve
       const statusCode = this._module._scip_solve();
@@ -570,6 +606,10 @@
     destroy() {
       if (this._module) {
         this._module._scip_free();
+        for (const ptr of Object.values(this._callbackPtrs || {})) {
+          this._module.removeFunction(ptr);
+        }
+        this._callbackPtrs = null;
         this._module = null;
         this._isInitialized = false;
       }
@@ -104,6 +104,531 @@ export const Status = {
   ERROR: "error",
 };
 
+/**
+ * Tree trace record layout (see TREETRACERECORD in scip_api.c)
+ */
+const TREE_TRACE_RECORD_SIZE = 48;
+
+export const TreeNodeStatus = {
+  FOCUSED: 0,
+  BRANCHED: 1,
+  INFEASIBLE: 2,
+  PRUNED: 3,
+  SOLUTION: 4,
+};
+
+const TREE_NODE_STATUS_NAMES = ["focused", "branched", "infeasible", "pruned", "solution"];
+const TREE_BRANCH_DIRECTION_NAMES = [null, "down", "up"];
+
+// VBC colors as used by SCIP's own visualization output
+const VBC_COLORS = [3, 2, 15, 4, 14];
+
+/**
+ * Decode a binary tree trace into plain records
+ * @param {ArrayBuffer} buffer - Trace from SCIPApi.getTreeTrace()
+ * @param {string[]} [varNames] - Optional names indexed by branchVar
+ */
+export function decodeTreeTrace(buffer, varNames = null) {
+  const view = new DataView(buffer);
+  const count = Math.floor(buffer.byteLength / TREE_TRACE_RECORD_SIZE);
+  const records = new Array(count);
+  for (let i = 0; i < count; i += 1) {
+    const base = i * TREE_TRACE_RECORD_SIZE;
+    const branchVar = view.getInt32(base + 36, true);
+    const status = view.getUint8(base + 44);
+    const direction = view.getUint8(base + 45);
+    records[i] = {
+      time: view.getFloat64(base, true),
+      lowerBound: view.getFloat64(base + 8, true),
+      branchBound: view.getFloat64(base + 16, true),
+      node: view.getUint32(base + 24, true),
+      parent: view.getUint32(base + 28, true),
+      depth: view.getInt32(base + 32, true),
+      branchVar,
+      branchVarName: varNames && branchVar >= 0 ? varNames[branchVar] || null : null,
+      lpIterations: view.getUint32(base + 40, true),
+      status: TREE_NODE_STATUS_NAMES[status] || "unknown",
+      direction: TREE_BRANCH_DIRECTION_NAMES[direction] || null,
+    };
+  }
+  return records;
+}
+
+function formatVbcTime(seconds) {
+  const centis = Math.floor(seconds * 100);
+  const pad = (v) => String(v).padStart(2, "0");
+  const h = Math.floor(centis / 360000);
+  const m = Math.floor(centis / 6000) % 60;
+  const s = Math.floor(centis / 100) % 60;
+  return `${pad(h)}:${pad(m)}:${pad(s)}.${pad(centis % 100)}`;
+}
+
+/**
+ * Convert a binary tree trace to the VBC format read by VBCTool/vbc viewers
+ */
+export function treeTraceToVbc(buffer, varNames = null) {
+  const lines = [
+    "#TYPE: COMPLETE TREE",
+    "#TIME: SET",
+    "#BOUNDS: NONE",
+    "#INFORMATION: STANDARD",
+    "#NODE_NUMBER: NONE",
+  ];
+  // A node is created by its first record; later records (focused, then
+  // branched/pruned/...) repaint it
+  const created = new Set();
+  for (const rec of decodeTreeTrace(buffer, varNames)) {
+    const time = formatVbcTime(rec.time);
+    const color = VBC_COLORS[TREE_NODE_STATUS_NAMES.indexOf(rec.status)] || 3;
+    if (created.has(rec.node)) {
+      lines.push(`${time} P ${rec.node} ${color}`);
+    } else {
+      created.add(rec.node);
+      lines.push(`${time} N ${rec.parent} ${rec.node} ${color}`);
+    }
+    let info = `\\inode: ${rec.node}\\idepth: ${rec.depth}\\ibound: ${rec.lowerBound}\\ilp iterations: ${rec.lpIterations}\\istatus: ${rec.status}`;
+    if (rec.direction) {
+      info += `\\ibranch: ${rec.branchVarName || rec.branchVar} ${rec.direction === "down" ? "<=" : ">="} ${rec.branchBound}`;
+    }
+    lines.push(`${time} I ${rec.node} ${info}`);
+  }
+  return lines.join("\n") + "\n";
+}
+
+const PRICING_TRACE_RECORD_SIZE = 48;
+const PRICING_TRACE_MODE_NAMES = [null, "redcost", "farkas"];
+
+/**
+ * Decode a binary pricing trace into plain records
+ * @param {ArrayBuffer} buffer - Trace from SCIPApi.getPricingTrace()
+ */
+export function decodePricingTrace(buffer) {
+  const view = new DataView(buffer);
+  const count = Math.floor(buffer.byteLength / PRICING_TRACE_RECORD_SIZE);
+  const records = new Array(count);
+  for (let i = 0; i < count; i += 1) {
+    const base = i * PRICING_TRACE_RECORD_SIZE;
+    records[i] = {
+      time: view.getFloat64(base, true),
+      lpObjective: view.getFloat64(base + 8, true),
+      node: view.getUint32(base + 16, true),
+      round: view.getInt32(base + 20, true),
+      mode: PRICING_TRACE_MODE_NAMES[view.getInt32(base + 24, true)] || "unknown",
+      lpCols: view.getInt32(base + 28, true),
+      lpRows: view.getInt32(base + 32, true),
+      added: view.getInt32(base + 36, true),
+      pooled: view.getInt32(base + 40, true),
+      mispricings: view.getInt32(base + 44, true),
+    };
+  }
+  return records;
+}
+
+/**
+ * Profiling span names, indexed by PROFILE_SPAN_* in scip_api.c
+ */
+const PROFILE_SPAN_NAMES = [
+  "read",
+  "solve",
+  "transform",
+  "presolve",
+  "root LP",
+  "root node",
+  "branch-and-bound",
+  "pricing round (redcost)",
+  "pricing round (farkas)",
+  "JS callback",
+];
+const PROFILE_CALLBACK_NAMES = ["onIncumbent", "onNode", "onPricerRedcost", "onPricerFarkas"];
+const PROFILE_PLUGIN_KINDS = ["heuristic", "separator", "propagator", "presolver", "branchrule"];
+const PROFILE_SPAN_SIZE = 24;
+
+function now() {
+  return typeof performance !== "undefined" ? performance.now() : Date.now();
+}
+
+/**
+ * Memory sample layout (MEMORY_SAMPLE_FIELDS doubles per sample in scip_api.c)
+ */
+export const MEMORY_SAMPLE_FIELDS = [
+  "time",
+  "phase",
+  "nodes",
+  "scipMemUsed",
+  "scipMemTotal",
+  "heapSize",
+  "mallocInUse",
+  "mallocFree",
+  "scipMemExtern",
+  "heapBreak",
+];
+export const MemoryPhase = ["read", "transformed", "presolved", "root", "nodes", "solved", "cleared", "manual"];
+
+/**
+ * Live progress block (PROGRESS_FIELDS doubles in scip_api.c), published into a
+ * SharedArrayBuffer seqlock: Int32 sequence number at byte 0 (odd while a
+ * write is in progress), fields as float64 from byte 8
+ */
+export const PROGRESS_FIELDS = [
+  "elapsedMs",
+  "stage",
+  "primalBound",
+  "dualBound",
+  "gap",
+  "nodes",
+  "openNodes",
+  "lpIterations",
+  "solutions",
+  "scipMemUsed",
+  "heapSize",
+  "updates",
+];
+export const SolverStage = [
+  "init", "problem", "transforming", "transformed", "initpresolve", "presolving", "exitpresolve",
+  "presolved", "initsolve", "solving", "solved", "exitsolve", "freetrans", "free",
+];
+const PROGRESS_HEADER_BYTES = 8;
+const SCIP_INVALID = 1e99;
+
+/**
+ * Allocate a progress block for SCIPApi.attachProgress()
+ * @returns {SharedArrayBuffer}
+ */
+export function createProgressBuffer() {
+  return new SharedArrayBuffer(PROGRESS_HEADER_BYTES + 8 * PROGRESS_FIELDS.length);
+}
+
+/**
+ * Seqlock write of one snapshot (PROGRESS_FIELDS values) into a progress
+ * block; the sequence number is odd while the fields are being copied
+ * @param {SharedArrayBuffer} buffer
+ * @param {ArrayLike<number>} fields
+ */
+export function writeProgress(buffer, fields) {
+  const seq = new Int32Array(buffer, 0, 1);
+  Atomics.add(seq, 0, 1);
+  new Float64Array(buffer, PROGRESS_HEADER_BYTES, PROGRESS_FIELDS.length).set(fields);
+  Atomics.add(seq, 0, 1);
+  Atomics.notify(seq, 0);
+}
+
+/**
+ * Consistent snapshot of a progress block, from any thread and without
+ * messaging. Returns null if no snapshot has been published yet, or if the
+ * writer kept the block busy for `maxRetries` attempts.
+ * @param {SharedArrayBuffer} buffer
+ */
+export function readProgress(buffer, { maxRetries = 64 } = {}) {
+  const seq = new Int32Array(buffer, 0, 1);
+  const fields = new Float64Array(buffer, PROGRESS_HEADER_BYTES, PROGRESS_FIELDS.length);
+  for (let attempt = 0; attempt < maxRetries; attempt += 1) {
+    const before = Atomics.load(seq, 0);
+    if (before === 0) {
+      return null;
+    }
+    if (before & 1) {
+      continue;
+    }
+    const copy = fields.slice();
+    if (Atomics.load(seq, 0) !== before) {
+      continue;
+    }
+    const snapshot = { version: before >>> 1 };
+    for (let j = 0; j < PROGRESS_FIELDS.length; j += 1) {
+      snapshot[PROGRESS_FIELDS[j]] = copy[j] >= SCIP_INVALID ? null : copy[j];
+    }
+    snapshot.stage = SolverStage[snapshot.stage] || "unknown";
+    return snapshot;
+  }
+  return null;
+}
+
+/**
+ * Mailbox for live cutoffs (SharedArrayBuffer): Int32 sequence (odd while a
+ * post is written), value capacity, flags, value count; objective limit as
+ * float64 at byte 16, solution values in variable handle order from byte 24.
+ * Polled by the solver at every focused node; a post replaces an unread one.
+ */
+export const MailboxFlag = {
+  OBJLIMIT: 1,
+  SOLUTION: 2,
+};
+const MAILBOX_HEADER_BYTES = 24;
+
+/**
+ * Allocate a mailbox for SCIPApi.attachMailbox()
+ * @param {number} capacity - Variables a posted solution may carry (0: cutoffs only)
+ * @returns {SharedArrayBuffer}
+ */
+export function createMailbox(capacity = 0) {
+  const buffer = new SharedArrayBuffer(MAILBOX_HEADER_BYTES + 8 * capacity);
+  new Int32Array(buffer, 0, 4)[1] = capacity;
+  return buffer;
+}
+
+/**
+ * Post an objective limit and/or a full solution to a running solve, from any thread
+ * @param {SharedArrayBuffer} buffer - From createMailbox()
+ * @param {Object} message
+ * @param {number} message.objlimit - Objective limit (original space); applied if tighter
+ * @param {ArrayLike<number>} message.values - Solution in variable handle order, tried with SCIPtrySol
+ */
+export function postToMailbox(buffer, { objlimit, values } = {}) {
+  const header = new Int32Array(buffer, 0, 4);
+  const capacity = header[1];
+  if (values && values.length > capacity) {
+    throw new Error(`Mailbox holds ${capacity} values, got ${values.length}`);
+  }
+
+  Atomics.add(header, 0, 1);
+  header[2] = (objlimit !== undefined ? MailboxFlag.OBJLIMIT : 0) | (values ? MailboxFlag.SOLUTION : 0);
+  header[3] = values ? values.length : 0;
+  new Float64Array(buffer, 16, 1)[0] = objlimit ?? 0;
+  if (values) {
+    new Float64Array(buffer, MAILBOX_HEADER_BYTES, values.length).set(values);
+  }
+  Atomics.add(header, 0, 1);
+}
+
+/**
+ * Checkpoint layout (see scip_checkpoint_save in scip_api.c)
+ */
+const CHECKPOINT_MAGIC = 0x504b4353; // "SCKP"
+const CHECKPOINT_HEADER_INTS = 16;
+
+/**
+ * Summary of a checkpoint from SCIPApi.saveCheckpoint(), e.g. to account for
+ * the progress carried over into a resumed solve
+ * @param {Uint8Array|ArrayBuffer} checkpoint
+ */
+export function decodeCheckpoint(checkpoint) {
+  const bytes = checkpoint instanceof Uint8Array ? checkpoint : new Uint8Array(checkpoint);
+  const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+  if (bytes.byteLength < CHECKPOINT_HEADER_INTS * 4 + 64 || view.getInt32(0, true) !== CHECKPOINT_MAGIC) {
+    throw new Error("Not a SCIP.js checkpoint");
+  }
+  const int = (i) => view.getInt32(i * 4, true);
+  const hash = (i) => view.getUint32((i + 1) * 4, true).toString(16).padStart(8, "0")
+    + view.getUint32(i * 4, true).toString(16).padStart(8, "0");
+  const stat = (i) => view.getFloat64(CHECKPOINT_HEADER_INTS * 4 + i * 8, true);
+  return {
+    version: int(1),
+    nvars: int(2),
+    openNodes: int(3),
+    boundChanges: int(4),
+    solutions: int(5),
+    droppedBoundChanges: int(7),
+    regionHash: hash(8),
+    objectiveHash: hash(10),
+    dualBound: stat(0),
+    primalBound: stat(1),
+    solvingTime: stat(2),
+    nodes: stat(3),
+    lpIterations: stat(4),
+  };
+}
+
+/**
+ * Cut pack layout (see scip_cuts_export in scip_api.c)
+ */
+const CUTPACK_MAGIC = 0x54554353; // "SCUT"
+const CUTPACK_HEADER_INTS = 16;
+
+export const CutRowFlag = {
+  CONFLICT: 1,
+  OBJECTIVE: 2,
+};
+
+/**
+ * Rows of a cut pack from SCIPApi.exportCuts() in CSR form over variable
+ * indices (handle - 1), with the model hashes it is valid for. Rows flagged
+ * CutRowFlag.OBJECTIVE also need the same objective.
+ * @param {Uint8Array|ArrayBuffer} pack
+ */
+export function decodeCutPack(pack) {
+  const bytes = pack instanceof Uint8Array ? pack : new Uint8Array(pack);
+  const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+  if (bytes.byteLength < CUTPACK_HEADER_INTS * 4 || view.getInt32(0, true) !== CUTPACK_MAGIC) {
+    throw new Error("Not a SCIP.js cut pack");
+  }
+  const int = (i) => view.getInt32(i * 4, true);
+  const hash = (i) => view.getUint32((i + 1) * 4, true).toString(16).padStart(8, "0")
+    + view.getUint32(i * 4, true).toString(16).padStart(8, "0");
+  const [nvars, nrows, nnz, nsols] = [int(2), int(3), int(4), int(5)];
+  // Copy out so the arrays are aligned whatever the pack's offset
+  let off = CUTPACK_HEADER_INTS * 4;
+  const take = (Type, count) => {
+    const array = new Type(bytes.slice(off, off + count * Type.BYTES_PER_ELEMENT).buffer);
+    off += count * Type.BYTES_PER_ELEMENT;
+    return array;
+  };
+  const lhs = take(Float64Array, nrows);
+  const rhs = take(Float64Array, nrows);
+  const vals = take(Float64Array, nnz);
+  const solutions = take(Float64Array, nsols * nvars);
+  const rowStart = take(Int32Array, nrows + 1);
+  const colIdx = take(Int32Array, nnz);
+  const flags = take(Uint8Array, nrows);
+  let conflicts = 0;
+  for (let i = 0; i < nrows; i += 1) {
+    conflicts += flags[i] & CutRowFlag.CONFLICT;
+  }
+  return {
+    version: int(1),
+    nvars,
+    nrows,
+    nnz,
+    cuts: nrows - conflicts,
+    conflicts,
+    dropped: int(6),
+    regionHash: hash(8),
+    objectiveHash: hash(10),
+    lhs,
+    rhs,
+    rowStart,
+    colIdx,
+    vals,
+    flags,
+    incumbent: nsols > 0 ? solutions.subarray(0, nvars) : null,
+  };
+}
+
+/**
+ * Postsolve map layout (see scip_presolve_only in scip_api.c)
+ */
+const POSTSOLVE_MAGIC = 0x4d504353; // "SCPM"
+const POSTSOLVE_HEADER_INTS = 16;
+
+/**
+ * Postsolve map from SCIPApi.presolveOnly(): variable handle i - 1 of the
+ * original model is constant[i] + sum scalar[k] * y[index[k]] over
+ * k in [start[i], start[i + 1]), y being the reduced model's variables
+ * @param {Uint8Array|ArrayBuffer} map
+ */
+export function decodePostsolveMap(map) {
+  const bytes = map instanceof Uint8Array ? map : new Uint8Array(map);
+  const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+  if (bytes.byteLength < POSTSOLVE_HEADER_INTS * 4 + 16 || view.getInt32(0, true) !== POSTSOLVE_MAGIC) {
+    throw new Error("Not a SCIP.js postsolve map");
+  }
+  const int = (i) => view.getInt32(i * 4, true);
+  const [nvars, nnz] = [int(2), int(3)];
+  let off = POSTSOLVE_HEADER_INTS * 4 + 16;
+  const take = (Type, count) => {
+    const array = new Type(bytes.slice(off, off + count * Type.BYTES_PER_ELEMENT).buffer);
+    off += count * Type.BYTES_PER_ELEMENT;
+    return array;
+  };
+  const constant = take(Float64Array, nvars);
+  const scalar = take(Float64Array, nnz);
+  const start = take(Int32Array, nvars + 1);
+  const index = take(Int32Array, nnz);
+  return {
+    version: int(1),
+    nvars,
+    nnz,
+    fixed: int(4),
+    aggregated: int(5),
+    multiAggregated: int(6),
+    objScale: view.getFloat64(POSTSOLVE_HEADER_INTS * 4, true),
+    objOffset: view.getFloat64(POSTSOLVE_HEADER_INTS * 4 + 8, true),
+    constant,
+    scalar,
+    start,
+    index,
+  };
+}
+
+/**
+ * Map a solution of the reduced model back to the original variables
+ * @param {Object|Uint8Array|ArrayBuffer} map - Postsolve map or its decodePostsolveMap() form
+ * @param {ArrayLike<number>} values - Reduced model values, in its variable order
+ * @param {number} [objective] - Reduced model objective, mapped into result.objective
+ * @returns {{values: Float64Array, objective: number}} values in original handle order
+ */
+export function postsolveSolution(map, values, objective = NaN) {
+  const m = map.constant ? map : decodePostsolveMap(map);
+  const out = new Float64Array(m.nvars);
+  for (let i = 0; i < m.nvars; i += 1) {
+    let value = m.constant[i];
+    for (let k = m.start[i]; k < m.start[i + 1]; k += 1) {
+      value += m.scalar[k] * values[m.index[k]];
+    }
+    out[i] = value;
+  }
+  return { values: out, objective: m.objScale * objective + m.objOffset };
+}
+
+/**
+ * SCIP emphasis settings (SCIP_PARAMEMPHASIS), for settings profiles
+ */
+export const Emphasis = {
+  DEFAULT: 0,
+  CPSOLVER: 1,
+  EASYCIP: 2,
+  FEASIBILITY: 3,
+  HARDLP: 4,
+  OPTIMALITY: 5,
+  COUNTER: 6,
+  PHASEFEAS: 7,
+  PHASEIMPROVE: 8,
+  PHASEPROOF: 9,
+  NUMERICS: 10,
+  BENCHMARK: 11,
+};
+
+/**
+ * Meta settings for the heuristics, presolving and separating groups (SCIP_PARAMSETTING)
+ */
+export const ParamSetting = {
+  DEFAULT: 0,
+  AGGRESSIVE: 1,
+  FAST: 2,
+  OFF: 3,
+};
+
+const META_GROUPS = ["heuristics", "presolving", "separating"];
+const SETTINGS_FILE = "/problems/params.set";
+
+function settingCode(table, value, what) {
+  const code = typeof value === "number" ? value : table[String(value).toUpperCase()];
+  if (code === undefined) {
+    throw new Error(`Unknown ${what} setting: ${value}`);
+  }
+  return code;
+}
+
+/**
+ * Instance feature vector layout (see scip_extract_features in scip_api.c).
+ * The lin* entries count linear rows by the constraint type SCIP would
+ * upgrade them to; components ignore variables in no constraint.
+ */
+export const FEATURE_NAMES = [
+  "nvars", "nbinary", "ninteger", "nimplint", "ncontinuous",
+  "nconss", "nlinear", "nother", "nnz", "density",
+  "rowLengthAvg", "rowLengthMax", "columnLengthMax",
+  "coefAbsMin", "coefAbsMax", "coefLog10Range",
+  "objNnz", "objAbsMin", "objAbsMax", "rhsAbsMax",
+  "equalityFraction", "freeVars", "unboundedIntVars",
+  "linEmpty", "linFree", "linSingleton", "linAggregation", "linPrecedence",
+  "linVarbound", "linSetPartition", "linSetPacking", "linSetCovering",
+  "linCardinality", "linInvKnapsack", "linEqKnapsack", "linBinPacking",
+  "linKnapsack", "linIntKnapsack", "linMixedBinary", "linGeneral",
+  "components", "largestComponentVars", "isolatedVars",
+];
+
+/**
+ * Name the entries of a vector from SCIPApi.extractFeatures()
+ * @param {Float64Array} features
+ */
+export function featuresToObject(features) {
+  const out = {};
+  FEATURE_NAMES.forEach((name, i) => {
+    out[name] = features[i];
+  });
+  return out;
+}
+
 /**
  * SCIP API class with callback support
  */
@@ -114,6 +639,13 @@ export class SCIPApi {
     this._nodeCallback = null;
     this._pricerRedcostCallback = null;
     this._pricerFarkasCallback = null;
+    this._jsSpans = null;
+    this._arena = false;
+    this._callbackPtrs = null;
+    this._progressBuffer = null;
+    this._progressIntervalMs = 100;
+    this._mailbox = null;
+    this._mailboxSeen = 0;
     this._isInitialized = false;
   }
 
@@ -125,14 +657,29 @@ export class SCIPApi {
       return;
     }
 
+    // 'mimalloc' selects the variant linked with -sMALLOC=mimalloc, which keeps
+    // fragmentation flat when one instance is reused for many models
+    const allocator = options.allocator || "dlmalloc";
+    // dynamicLinking selects the -sMAIN_MODULE build that can load native plugins
+    const artifact = options.dynamicLinking
+      ? "scip-api-dynlink"
+      : allocator === "mimalloc" ? "scip-api-mimalloc" : "scip-api";
+
     const baseUrl = getBaseUrl();
-    let wasmPath = options.wasmPath || baseUrl + "scip-api.wasm";
+    let wasmPath = options.wasmPath || baseUrl + artifact + ".wasm";
     
     // Resolve WASM path for Node.js
     wasmPath = await resolveWasmPath(wasmPath);
 
     // Dynamic import of the API module
-    const createSCIPAPI = (await import("./scip-api.js")).default;
+    let createSCIPAPI;
+    if (artifact === "scip-api-dynlink") {
+      createSCIPAPI = (await import("./scip-api-dynlink.js")).default;
+    } else if (artifact === "scip-api-mimalloc") {
+      createSCIPAPI = (await import("./scip-api-mimalloc.js")).default;
+    } else {
+      createSCIPAPI = (await import("./scip-api.js")).default;
+    }
 
     // Build module options
     const moduleOptions = {
@@ -142,7 +689,7 @@ export class SCIPApi {
         }
         // For other files, resolve relative to base URL
         if (isNode()) {
-          return wasmPath.replace(/scip-api\.wasm$/, path);
+          return wasmPath.replace(/scip-api(-mimalloc|-dynlink)?\.wasm$/, path);
         }
         return baseUrl + path;
       }
@@ -162,34 +709,71 @@ export class SCIPApi {
       throw new Error("Failed to create SCIP instance");
     }
 
-    // Setup callbacks
-    this._module.onIncumbent = (objValue) => {
-      if (this._incumbentCallback) {
-        this._incumbentCallback(objValue);
-      }
-    };
-
-    this._module.onNode = (dualBound, primalBound, nodes) => {
-      if (this._nodeCallback) {
-        this._nodeCallback({ dualBound, primalBound, nodes });
-      }
-    };
+    // Setup callbacks: trampolines live in the wasm function table and C calls
+    // them through typed pointers; a 0 pointer disables the callback in C
+    this._callbackPtrs = {
+      incumbent: this._module.addFunction((objValue) => {
+        if (this._incumbentCallback) {
+          this._incumbentCallback(objValue);
+        }
+      }, "vd"),
+      node: this._module.addFunction((dualBound, primalBound, nodes) => {
+        if (this._nodeCallback) {
+          this._nodeCallback({ dualBound, primalBound, nodes });
+        }
+      }, "vddd"),
+      pricerRedcost: this._module.addFunction(() => {
+        if (this._pricerRedcostCallback) {
+          this._pricerRedcostCallback();
+        }
+      }, "vi"),
+      pricerFarkas: this._module.addFunction(() => {
+        if (this._pricerFarkasCallback) {
+          this._pricerFarkasCallback();
+        }
+      }, "vi"),
+      progress: this._module.addFunction((blockPtr) => {
+        const buffer = this._progressBuffer;
+        if (buffer) {
+          const offset = blockPtr >> 3;
+          writeProgress(buffer, this._module.HEAPF64.subarray(offset, offset + PROGRESS_FIELDS.length));
+        }
+      }, "vi"),
+      // Copy an unread mailbox post into C's buffer; a post racing the copy is
+      // picked up at the next node
+      mailbox: this._module.addFunction((outPtr, capacity) => {
+        const buffer = this._mailbox;
+        if (!buffer) {
+          return 0;
+        }
+        const header = new Int32Array(buffer, 0, 4);
+        const seq = Atomics.load(header, 0);
+        if (seq === this._mailboxSeen || (seq & 1)) {
+          return 0;
+        }
 
-    this._module.onPricerRedcost = () => {
-      if (this._pricerRedcostCallback) {
-        this._pricerRedcostCallback();
-      }
-    };
+        const heap = this._module.HEAPF64;
+        const out = outPtr >> 3;
+        let flags = header[2];
+        heap[out] = new Float64Array(buffer, 16, 1)[0];
+        if ((flags & MailboxFlag.SOLUTION) && header[3] === capacity) {
+          heap.set(new Float64Array(buffer, MAILBOX_HEADER_BYTES, capacity), out + 1);
+        } else {
+          flags &= ~MailboxFlag.SOLUTION;
+        }
 
-    this._module.onPricerFarkas = () => {
-      if (this._pricerFarkasCallback) {
-        this._pricerFarkasCallback();
-      }
+        if (Atomics.load(header, 0) !== seq) {
+          return 0;
+        }
+        this._mailboxSeen = seq;
+        return flags;
+      }, "iii"),
     };
 
     // Create virtual filesystem directories
     try { this._module.FS.mkdir("/problems"); } catch (e) { /* exists */ }
     try { this._module.FS.mkdir("/solutions"); } catch (e) { /* exists */ }
+    try { this._module.FS.mkdir("/plugins"); } catch (e) { /* exists */ }
 
     this._isInitialized = true;
   }
@@ -201,7 +785,7 @@ export class SCIPApi {
   onIncumbent(callback) {
     this._incumbentCallback = callback;
     if (this._module) {
-      this._module._scip_enable_incumbent_callback(callback ? 1 : 0);
+      this._module._scip_set_incumbent_callback(callback ? this._callbackPtrs.incumbent : 0);
     }
   }
 
@@ -212,30 +796,215 @@ export class SCIPApi {
   onNode(callback) {
     this._nodeCallback = callback;
     if (this._module) {
-      this._module._scip_enable_node_callback(callback ? 1 : 0);
+      this._module._scip_set_node_callback(callback ? this._callbackPtrs.node : 0);
     }
   }
 
   onPricerRedcost(callback) {
     this._pricerRedcostCallback = callback;
     if (this._module) {
-      this._module._scip_pricer_enable_redcost_callback(callback ? 1 : 0);
+      this._module._scip_pricer_set_redcost_callback(callback ? this._callbackPtrs.pricerRedcost : 0);
     }
   }
 
   onPricerFarkas(callback) {
     this._pricerFarkasCallback = callback;
     if (this._module) {
-      this._module._scip_pricer_enable_farkas_callback(callback ? 1 : 0);
+      this._module._scip_pricer_set_farkas_callback(callback ? this._callbackPtrs.pricerFarkas : 0);
+    }
+  }
+
+  /**
+   * Publish live solver state into a shared progress block, readable from any
+   * thread with readProgress() while solve() runs. Updated on phase changes
+   * and new incumbents, and after solved nodes at most every intervalMs.
+   * @param {SharedArrayBuffer} buffer - From createProgressBuffer() (allocated if omitted)
+   * @returns {SharedArrayBuffer}
+   */
+  attachProgress(buffer = createProgressBuffer(), { intervalMs = 100 } = {}) {
+    this._progressBuffer = buffer;
+    this._progressIntervalMs = intervalMs;
+    if (this._module) {
+      this._module._scip_set_progress_callback(this._callbackPtrs.progress, intervalMs);
+    }
+    return buffer;
+  }
+
+  detachProgress() {
+    this._progressBuffer = null;
+    if (this._module) {
+      this._module._scip_set_progress_callback(0, this._progressIntervalMs);
+    }
+  }
+
+  /**
+   * Poll a shared mailbox at every focused node of the next solves, so other
+   * threads can tighten the objective limit or inject incumbents mid-solve
+   * with postToMailbox()
+   * @param {SharedArrayBuffer} buffer - From createMailbox() (sized to the current problem if omitted)
+   * @returns {SharedArrayBuffer}
+   */
+  attachMailbox(buffer = createMailbox(this._module ? this._module._scip_get_nvars() : 0)) {
+    this._mailbox = buffer;
+    this._mailboxSeen = 0;
+    if (this._module) {
+      this._module._scip_set_mailbox_callback(this._callbackPtrs.mailbox);
     }
+    return buffer;
+  }
+
+  detachMailbox() {
+    this._mailbox = null;
+    if (this._module) {
+      this._module._scip_set_mailbox_callback(0);
+    }
+  }
+
+  /**
+   * Mailbox counters since the last reset
+   */
+  getMailboxStats() {
+    const ptr = this._alloc(4 * 8);
+    try {
+      this._module._scip_mailbox_stats(ptr);
+      const [polls, objlimits, solutionsTried, solutionsStored] = this._module.HEAPF64.slice(ptr >> 3, (ptr >> 3) + 4);
+      return { polls, objlimits, solutionsTried, solutionsStored };
+    } finally {
+      this._release(ptr);
+    }
+  }
+
+  resetMailboxStats() {
+    this._module._scip_mailbox_stats_reset();
+  }
+
+  /**
+   * Snapshot an interrupted solve (e.g. after a time limit): open nodes as
+   * bound changes, the best solutions, bounds and pseudocosts. Needs a model
+   * built through variable handles (loadModel or the problem builder API).
+   * @returns {Uint8Array|null} null if SCIP is not mid-solve
+   */
+  saveCheckpoint({ maxSolutions = 8 } = {}) {
+    const size = this._module._scip_checkpoint_save(maxSolutions);
+    if (size <= 0) {
+      return null;
+    }
+    const ptr = this._module._scip_checkpoint_data();
+    const checkpoint = this._module.HEAPU8.slice(ptr, ptr + size);
+    this._module._scip_checkpoint_free();
+    return checkpoint;
+  }
+
+  /**
+   * Resume from a checkpoint: load the same model first, then call this and
+   * solve. The next solve starts from the checkpoint's open nodes and incumbents.
+   * @param {Uint8Array|ArrayBuffer} checkpoint
+   * @returns {boolean} false if it does not match the loaded model
+   */
+  loadCheckpoint(checkpoint) {
+    const bytes = checkpoint instanceof Uint8Array ? checkpoint : new Uint8Array(checkpoint);
+    const ptr = this._alloc(bytes.length);
+    try {
+      this._module.HEAPU8.set(bytes, ptr);
+      return this._module._scip_checkpoint_load(ptr, bytes.length) === 1;
+    } finally {
+      this._release(ptr);
+    }
+  }
+
+  /**
+   * Export the globally valid cuts of the cut pool and the global conflict
+   * constraints of the current or finished solve (see decodeCutPack). Cuts
+   * stay valid for any objective when the solve ran with
+   * misc/allowstrongdualreds and misc/allowweakdualreds off; conflicts and
+   * cuts found under dual reductions are tied to the objective.
+   * @returns {Uint8Array|null} null if there is no solve to export from
+   */
+  exportCuts({ maxCuts = 10000, maxConflicts = 10000 } = {}) {
+    const size = this._module._scip_cuts_export(maxCuts, maxConflicts);
+    if (size <= 0) {
+      return null;
+    }
+    const ptr = this._module._scip_cuts_data();
+    const pack = this._module.HEAPU8.slice(ptr, ptr + size);
+    this._module._scip_cuts_free();
+    return pack;
+  }
+
+  /**
+   * Add a cut pack to a freshly loaded model with the same feasible region
+   * (e.g. only the objective changed) as initial, removable rows; applies at
+   * the next solve. Objective-dependent rows are skipped unless the objective
+   * is unchanged too, in which case the exporting solve's incumbent is added.
+   * @param {Uint8Array|ArrayBuffer} pack
+   * @returns {number} rows added, -1 if the pack does not match the model
+   */
+  importCuts(pack) {
+    const bytes = pack instanceof Uint8Array ? pack : new Uint8Array(pack);
+    const ptr = this._alloc(bytes.length);
+    try {
+      this._module.HEAPU8.set(bytes, ptr);
+      return this._module._scip_cuts_import(ptr, bytes.length);
+    } finally {
+      this._release(ptr);
+    }
+  }
+
+  /**
+   * Shape features of the loaded problem in one pass, before presolve: sizes,
+   * variable-type mix, density, coefficient ranges, linear row classes and
+   * connected components. Cheap enough to decide how to solve the model.
+   * @returns {Float64Array} FEATURE_NAMES.length entries (empty without a problem)
+   */
+  extractFeatures() {
+    const count = this._module._scip_feature_count();
+    const ptr = this._alloc(count * 8);
+    try {
+      const written = this._module._scip_extract_features(ptr, count);
+      return this._module.HEAPF64.slice(ptr >> 3, (ptr >> 3) + written);
+    } finally {
+      this._release(ptr);
+    }
+  }
+
+  // Scratch buffers for bridge calls; with the arena enabled they come from the
+  // per-model arena and must be released in reverse allocation order
+  _alloc(bytes) {
+    return this._arena ? this._module._scip_bridge_alloc(bytes) : this._module._malloc(bytes);
+  }
+
+  _release(ptr) {
+    if (this._arena) {
+      this._module._scip_bridge_free(ptr);
+    } else {
+      this._module._free(ptr);
+    }
+  }
+
+  // Point C at the registered trampolines (problem clear resets the pricer ones)
+  _syncCallbacks() {
+    const ptrs = this._callbackPtrs;
+    this._module._scip_set_incumbent_callback(this._incumbentCallback ? ptrs.incumbent : 0);
+    this._module._scip_set_node_callback(this._nodeCallback ? ptrs.node : 0);
+    this._module._scip_pricer_set_redcost_callback(this._pricerRedcostCallback ? ptrs.pricerRedcost : 0);
+    this._module._scip_pricer_set_farkas_callback(this._pricerFarkasCallback ? ptrs.pricerFarkas : 0);
+    this._module._scip_set_progress_callback(this._progressBuffer ? ptrs.progress : 0, this._progressIntervalMs);
+    this._module._scip_set_mailbox_callback(this._mailbox ? ptrs.mailbox : 0);
   }
 
   _withCString(value, fn) {
-    const ptr = this._module.allocateUTF8(value);
+    let ptr;
+    if (this._arena) {
+      const bytes = this._module.lengthBytesUTF8(value) + 1;
+      ptr = this._alloc(bytes);
+      this._module.stringToUTF8(value, ptr, bytes);
+    } else {
+      ptr = this._module.allocateUTF8(value);
+    }
     try {
       return fn(ptr);
     } finally {
-      this._module._free(ptr);
+      this._release(ptr);
     }
   }
 
@@ -336,7 +1105,7 @@ export class SCIPApi {
     if (n <= 0) {
       return [];
     }
-    const outPtr = this._module._malloc(n * 8);
+    const outPtr = this._alloc(n * 8);
     try {
       const count = this._module._scip_ctx_get_lp_row_duals_batch(outPtr, n);
       if (count <= 0) {
@@ -349,7 +1118,7 @@ export class SCIPApi {
       }
       return out;
     } finally {
-      this._module._free(outPtr);
+      this._release(outPtr);
     }
   }
 
@@ -357,7 +1126,7 @@ export class SCIPApi {
     if (n <= 0) {
       return [];
     }
-    const outPtr = this._module._malloc(n * 8);
+    const outPtr = this._alloc(n * 8);
     try {
       const count = this._module._scip_ctx_get_lp_row_farkas_batch(outPtr, n);
       if (count <= 0) {
@@ -370,7 +1139,7 @@ export class SCIPApi {
       }
       return out;
     } finally {
-      this._module._free(outPtr);
+      this._release(outPtr);
     }
   }
 
@@ -378,114 +1147,652 @@ export class SCIPApi {
     return this._module._scip_ctx_get_var_lp_value(varId);
   }
 
-  getVarRedcost(varId) {
-    return this._module._scip_ctx_get_var_redcost(varId);
+  getVarRedcost(varId) {
+    return this._module._scip_ctx_get_var_redcost(varId);
+  }
+
+  addVarToRowsBatch(varId, rowIds, vals) {
+    if (rowIds.length !== vals.length) {
+      throw new Error("rowIds and vals length mismatch");
+    }
+    const nnz = rowIds.length;
+    const rowPtr = this._alloc(nnz * 4);
+    const valPtr = this._alloc(nnz * 8);
+    try {
+      let rowOffset = rowPtr >> 2;
+      let valOffset = valPtr >> 3;
+      for (let i = 0; i < nnz; i += 1) {
+        this._module.HEAP32[rowOffset + i] = rowIds[i];
+        this._module.HEAPF64[valOffset + i] = vals[i];
+      }
+      const ok = this._module._scip_pricer_add_var_to_rows_batch(varId, rowPtr, valPtr, nnz);
+      return ok === 1;
+    } finally {
+      this._release(valPtr);
+      this._release(rowPtr);
+    }
+  }
+
+  addVarToConssBatch(varId, consIds, vals) {
+    if (consIds.length !== vals.length) {
+      throw new Error("consIds and vals length mismatch");
+    }
+    const nnz = consIds.length;
+    const consPtr = this._alloc(nnz * 4);
+    const valPtr = this._alloc(nnz * 8);
+    try {
+      let consOffset = consPtr >> 2;
+      let valOffset = valPtr >> 3;
+      for (let i = 0; i < nnz; i += 1) {
+        this._module.HEAP32[consOffset + i] = consIds[i];
+        this._module.HEAPF64[valOffset + i] = vals[i];
+      }
+      const ok = this._module._scip_pricer_add_var_to_conss_batch(varId, consPtr, valPtr, nnz);
+      return ok === 1;
+    } finally {
+      this._release(valPtr);
+      this._release(consPtr);
+    }
+  }
+
+  addPricedVar({ name, lb = 0, ub = 1e20, obj = 0, vartype = 3, initial = 1, removable = 1 }) {
+    return this._withCString(name, (ptr) => this._module._scip_pricer_add_priced_var(ptr, lb, ub, obj, vartype, initial, removable));
+  }
+
+  includePricer({ name = "js_pricer", desc = "JavaScript pricer", priority = 0, delay = true } = {}) {
+    return this._withCString(name, (namePtr) => {
+      return this._withCString(desc, (descPtr) => this._module._scip_pricer_include(namePtr, descPtr, priority, delay ? 1 : 0) === 1);
+    });
+  }
+
+  activatePricer() {
+    return this._module._scip_pricer_activate() === 1;
+  }
+
+  deactivatePricer() {
+    return this._module._scip_pricer_deactivate() === 1;
+  }
+
+  isPricerActive() {
+    return this._module._scip_pricer_is_active() === 1;
+  }
+
+  setPricerResult(resultCode) {
+    this._module._scip_pricer_set_result(resultCode);
+  }
+
+  setPricerLowerbound(value) {
+    this._module._scip_pricer_set_lowerbound(value);
+  }
+
+  setPricerStopEarly(flag) {
+    this._module._scip_pricer_set_stopearly(flag ? 1 : 0);
+  }
+
+  abortPricingRound() {
+    this._module._scip_pricer_abort_round();
+  }
+
+  getAddedPricedVarCountThisCall() {
+    return this._module._scip_pricer_get_n_added_vars_this_call();
+  }
+
+  getLastPricingResult() {
+    return this._module._scip_pricer_get_last_result();
+  }
+
+  getLastPricingMode() {
+    return this._module._scip_pricer_get_last_mode();
+  }
+
+  getPricerRedcostCalls() {
+    return this._module._scip_pricer_get_redcost_calls();
+  }
+
+  getPricerFarkasCalls() {
+    return this._module._scip_pricer_get_farkas_calls();
+  }
+
+  getPricerRound() {
+    return this._module._scip_pricer_get_round();
+  }
+
+  /**
+   * Stabilize the duals the redcost pricer reads through getConsDualLinear,
+   * getRowDual and getLPRowDualsBatch (registered linear constraints only;
+   * getVarRedcost stays on the LP duals). When the pricer adds no column at
+   * stabilized duals with a negative reduced cost at the LP duals (coefficients
+   * added through the bridge), the bridge calls it again within the same round,
+   * closer to the LP duals, until it finds one or prices on the LP duals themselves.
+   * @param {Object} options
+   * @param {string} options.mode - 'smoothing' (Wentges), 'boxstep' or 'none'
+   * @param {number} options.alpha - Smoothing weight of the stability center, in [0, 1)
+   * @param {number} options.width - Box half-width around the center
+   * @param {boolean} options.adaptive - Adjust alpha / width to the mispricings
+   * @returns {boolean}
+   */
+  setDualStabilization({ mode = "smoothing", alpha = 0.5, width = 1, adaptive = true } = {}) {
+    const modes = { none: 0, smoothing: 1, boxstep: 2 };
+    if (!(mode in modes)) {
+      throw new Error(`Unknown stabilization mode: ${mode}`);
+    }
+    const param = mode === "boxstep" ? width : alpha;
+    return this._module._scip_pricer_set_stabilization(modes[mode], param, adaptive ? 1 : 0) === 1;
+  }
+
+  getDualStabilizationStats() {
+    const ptr = this._alloc(4 * 8);
+    try {
+      this._module._scip_pricer_get_stabilization_stats(ptr);
+      const [rounds, mispricings, fallbacks, value] = this._module.HEAPF64.slice(ptr >> 3, (ptr >> 3) + 4);
+      return { rounds, mispricings, fallbacks, value };
+    } finally {
+      this._release(ptr);
+    }
+  }
+
+  /**
+   * Add a MIP pricing subproblem solved natively by the bridge pricer (include
+   * and activate it with includePricer()/activatePricer()). The template is
+   * built once in its own SCIP instance from a compiled model whose objective
+   * is the column cost per template variable. On every pricing round its
+   * objective is set to the reduced costs under the current duals, and its
+   * improving solutions y become master columns with coefficient
+   * sum(coef * y[var]) in each mapped constraint, without calling into JS.
+   * Template columns are continuous and templates do not see branching
+   * decisions, so they price the LP relaxation (column generation at the root,
+   * or price-and-branch); a round whose template solve stops on a limit
+   * without a column reports didnotrun instead of a proven LP bound.
+   * Templates last until the master problem is cleared.
+   * @param {ModelBuilder|ArrayBuffer|Uint8Array} model
+   * @param {Object} options
+   * @param {Object} options.column - Column map: parallel consIds (master
+   *   constraint handles), vars (template variable, -1 for a constant) and coefs
+   * @param {number} options.constCost - Cost of every column on top of the objective
+   * @param {number} options.timeLimit - Seconds per template solve (0: none)
+   * @param {number} options.maxColumns - Improving solutions added per round
+   * @returns {number} Template index
+   */
+  addPricingTemplate(model, { column, constCost = 0, timeLimit = 0, maxColumns = 1 } = {}) {
+    if (!(timeLimit >= 0) || !Number.isInteger(maxColumns) || maxColumns < 1) {
+      throw new Error("Invalid pricing template limits");
+    }
+    const blob = typeof model.compile === "function" ? model.compile() : model;
+    const bytes = blob instanceof Uint8Array ? blob : new Uint8Array(blob);
+    const { consIds, vars, coefs } = column;
+    const n = consIds.length;
+    if (vars.length !== n || coefs.length !== n) {
+      throw new Error("column consIds, vars and coefs length mismatch");
+    }
+
+    const blobPtr = this._alloc(bytes.length);
+    let index;
+    try {
+      this._module.HEAPU8.set(bytes, blobPtr);
+      index = this._module._scip_pricing_template_add(blobPtr, bytes.length, constCost);
+    } finally {
+      this._release(blobPtr);
+    }
+    if (index < 0) {
+      throw new Error("Failed to build the pricing template");
+    }
+
+    // A rejected column map or limits must not leave the template registered
+    const consPtr = this._alloc(n * 4);
+    const varPtr = this._alloc(n * 4);
+    const coefPtr = this._alloc(n * 8);
+    let error = null;
+    try {
+      this._module.HEAP32.set(consIds, consPtr >> 2);
+      this._module.HEAP32.set(vars, varPtr >> 2);
+      this._module.HEAPF64.set(coefs, coefPtr >> 3);
+      if (this._module._scip_pricing_template_set_column(index, consPtr, varPtr, coefPtr, n) !== 1) {
+        error = "Invalid pricing template column map";
+      } else if (this._module._scip_pricing_template_set_limits(index, timeLimit, maxColumns) !== 1) {
+        error = "Invalid pricing template limits";
+      }
+    } finally {
+      this._release(coefPtr);
+      this._release(varPtr);
+      this._release(consPtr);
+    }
+    if (error !== null) {
+      this._module._scip_pricing_template_pop(index);
+      throw new Error(error);
+    }
+    return index;
+  }
+
+  getPricingTemplateStats(index) {
+    const ptr = this._alloc(4 * 8);
+    try {
+      if (this._module._scip_pricing_template_stats(index, ptr) !== 1) {
+        return null;
+      }
+      const [solves, columns, seconds, bestRedcost] = this._module.HEAPF64.slice(ptr >> 3, (ptr >> 3) + 4);
+      return { solves, columns, seconds, bestRedcost: Number.isNaN(bestRedcost) ? null : bestRedcost };
+    } finally {
+      this._release(ptr);
+    }
+  }
+
+  clearPricingTemplates() {
+    this._module._scip_pricing_templates_clear();
+  }
+
+  /**
+   * Keep the restricted master small: removable columns (addPricedVar's default)
+   * age by one every LP solve that leaves them at zero, i.e. nonbasic or with
+   * positive reduced cost, and leave the LP once older than ageLimit. They stay
+   * in the problem as a pool that SCIP prices before calling the pricer, so a
+   * column whose reduced cost turns negative again re-enters without a round.
+   * @param {Object} options
+   * @param {number} options.ageLimit - LP solves at zero before removal (-1: never)
+   * @param {boolean} options.cleanupRoot - Also drop new nonbasic columns after the root LP
+   * @param {boolean} options.cleanupNodes - Also drop new nonbasic columns after other node LPs
+   * @returns {boolean}
+   */
+  setColumnAging({ ageLimit = 10, cleanupRoot = false, cleanupNodes = false } = {}) {
+    return this._module._scip_pricer_set_column_aging(ageLimit, cleanupRoot ? 1 : 0, cleanupNodes ? 1 : 0) === 1;
+  }
+
+  /**
+   * Removable columns in the LP and in the pool, with the ages of those in the LP
+   */
+  getColumnStats() {
+    const ptr = this._alloc(4 * 8);
+    try {
+      this._module._scip_pricer_get_column_stats(ptr);
+      const [inLP, pooled, meanAge, maxAge] = this._module.HEAPF64.slice(ptr >> 3, (ptr >> 3) + 4);
+      return { inLP, pooled, meanAge, maxAge };
+    } finally {
+      this._release(ptr);
+    }
+  }
+
+  /**
+   * Record every pricer call of subsequent solves (LP size, columns added,
+   * pool size) into a bounded buffer
+   * @param {number} capacity - Maximum number of pricer calls kept per solve
+   */
+  enablePricingTrace(capacity = 65536) {
+    return this._module._scip_pricing_trace_enable(capacity) === 1;
+  }
+
+  disablePricingTrace() {
+    this._module._scip_pricing_trace_enable(0);
+  }
+
+  getPricingTraceDropped() {
+    return this._module._scip_pricing_trace_get_dropped();
+  }
+
+  /**
+   * Copy the pricing trace of the last solve out of the wasm heap
+   * @returns {ArrayBuffer} Packed 48-byte records, see decodePricingTrace()
+   */
+  getPricingTrace() {
+    const size = this._module._scip_pricing_trace_get_size();
+    const recordSize = this._module._scip_pricing_trace_record_size();
+    const ptr = this._module._scip_pricing_trace_get_data();
+    if (size <= 0 || ptr === 0) {
+      return new ArrayBuffer(0);
+    }
+    return this._module.HEAPU8.slice(ptr, ptr + size * recordSize).buffer;
+  }
+
+  /**
+   * Pricing trace of the last solve as JSON-friendly records
+   */
+  exportPricingTraceJSON() {
+    return {
+      dropped: this.getPricingTraceDropped(),
+      rounds: decodePricingTrace(this.getPricingTrace()),
+    };
+  }
+
+  /**
+   * Record branch-and-bound nodes of subsequent solves into a bounded buffer
+   * @param {number} capacity - Maximum number of node records kept per solve
+   */
+  enableTreeTrace(capacity = 65536) {
+    return this._module._scip_tree_trace_enable(capacity) === 1;
+  }
+
+  disableTreeTrace() {
+    this._module._scip_tree_trace_enable(0);
+  }
+
+  getTreeTraceDropped() {
+    return this._module._scip_tree_trace_get_dropped();
+  }
+
+  /**
+   * Copy the tree trace of the last solve out of the wasm heap
+   * @returns {ArrayBuffer} Packed 48-byte records, see decodeTreeTrace()
+   */
+  getTreeTrace() {
+    const size = this._module._scip_tree_trace_get_size();
+    const recordSize = this._module._scip_tree_trace_record_size();
+    const ptr = this._module._scip_tree_trace_get_data();
+    if (size <= 0 || ptr === 0) {
+      return new ArrayBuffer(0);
+    }
+    return this._module.HEAPU8.slice(ptr, ptr + size * recordSize).buffer;
+  }
+
+  _getTreeTraceVarNames(buffer) {
+    const names = [];
+    for (const rec of decodeTreeTrace(buffer)) {
+      if (rec.branchVar >= 0 && names[rec.branchVar] === undefined) {
+        names[rec.branchVar] = this._module.UTF8ToString(this._module._scip_tree_trace_var_name(rec.branchVar));
+      }
+    }
+    return names;
+  }
+
+  /**
+   * Tree trace of the last solve as JSON-friendly records
+   */
+  exportTreeTraceJSON() {
+    const buffer = this.getTreeTrace();
+    return {
+      dropped: this.getTreeTraceDropped(),
+      nodes: decodeTreeTrace(buffer, this._getTreeTraceVarNames(buffer)),
+    };
+  }
+
+  /**
+   * Tree trace of the last solve in VBC format
+   */
+  exportTreeTraceVbc() {
+    const buffer = this.getTreeTrace();
+    return treeTraceToVbc(buffer, this._getTreeTraceVarNames(buffer));
+  }
+
+  /**
+   * Record solver phase spans (read, presolve, root LP, pricing rounds,
+   * JS callbacks, branch-and-bound, extraction) for exportChromeTrace()
+   * @param {number} capacity - Maximum number of spans kept in the wasm heap
+   */
+  enableProfiling(capacity = 65536) {
+    this._jsSpans = [];
+    return this._module._scip_profile_enable(capacity) === 1;
+  }
+
+  disableProfiling() {
+    this._jsSpans = null;
+    this._module._scip_profile_enable(0);
+  }
+
+  clearProfile() {
+    if (this._jsSpans) {
+      this._jsSpans = [];
+    }
+    this._module._scip_profile_clear();
   }
 
-  addVarToRowsBatch(varId, rowIds, vals) {
-    if (rowIds.length !== vals.length) {
-      throw new Error("rowIds and vals length mismatch");
+  _endJsSpan(name, start) {
+    if (this._jsSpans) {
+      this._jsSpans.push({ name, start, duration: now() - start });
     }
-    const nnz = rowIds.length;
-    const rowPtr = this._module._malloc(nnz * 4);
-    const valPtr = this._module._malloc(nnz * 8);
+  }
+
+  _getPluginTimes() {
+    const count = this._module._scip_profile_plugin_count();
+    const outPtr = this._alloc(24);
+    const plugins = [];
     try {
-      let rowOffset = rowPtr >> 2;
-      let valOffset = valPtr >> 3;
-      for (let i = 0; i < nnz; i += 1) {
-        this._module.HEAP32[rowOffset + i] = rowIds[i];
-        this._module.HEAPF64[valOffset + i] = vals[i];
+      for (let i = 0; i < count; i += 1) {
+        const namePtr = this._module._scip_profile_plugin_info(i, outPtr, outPtr + 8, outPtr + 16);
+        if (!namePtr) {
+          continue;
+        }
+        const seconds = this._module.HEAPF64[(outPtr + 8) >> 3];
+        const calls = this._module.HEAPF64[(outPtr + 16) >> 3];
+        if (calls > 0 || seconds > 0) {
+          plugins.push({
+            name: this._module.UTF8ToString(namePtr),
+            kind: PROFILE_PLUGIN_KINDS[this._module.HEAP32[outPtr >> 2]],
+            seconds,
+            calls,
+          });
+        }
       }
-      const ok = this._module._scip_pricer_add_var_to_rows_batch(varId, rowPtr, valPtr, nnz);
-      return ok === 1;
     } finally {
-      this._module._free(rowPtr);
-      this._module._free(valPtr);
+      this._release(outPtr);
     }
+    return plugins;
   }
 
-  addVarToConssBatch(varId, consIds, vals) {
-    if (consIds.length !== vals.length) {
-      throw new Error("consIds and vals length mismatch");
-    }
-    const nnz = consIds.length;
-    const consPtr = this._module._malloc(nnz * 4);
-    const valPtr = this._module._malloc(nnz * 8);
-    try {
-      let consOffset = consPtr >> 2;
-      let valOffset = valPtr >> 3;
-      for (let i = 0; i < nnz; i += 1) {
-        this._module.HEAP32[consOffset + i] = consIds[i];
-        this._module.HEAPF64[valOffset + i] = vals[i];
+  /**
+   * Export recorded spans as Chrome trace-event JSON (Perfetto, chrome://tracing).
+   * Timestamps are performance.now() of this thread in microseconds, so they
+   * line up with spans recorded by the surrounding JS code.
+   * @param {Object} options
+   * @param {number} options.pid - Process id used for the events
+   * @param {number} options.tid - Thread id used for the events
+   * @param {boolean} options.absolute - Add performance.timeOrigin to align workers
+   */
+  exportChromeTrace({ pid = 1, tid = 1, absolute = false } = {}) {
+    const origin = absolute && typeof performance !== "undefined" ? performance.timeOrigin : 0;
+    const toMicros = (ms) => Math.round((origin + ms) * 1000);
+    const traceEvents = [];
+
+    const size = this._module._scip_profile_get_size();
+    const ptr = this._module._scip_profile_get_data();
+    if (size > 0 && ptr !== 0) {
+      const bytes = this._module.HEAPU8.slice(ptr, ptr + size * PROFILE_SPAN_SIZE);
+      const view = new DataView(bytes.buffer);
+      for (let i = 0; i < size; i += 1) {
+        const base = i * PROFILE_SPAN_SIZE;
+        const span = view.getInt32(base + 16, true);
+        const arg = view.getInt32(base + 20, true);
+        const event = {
+          name: PROFILE_SPAN_NAMES[span] || `span ${span}`,
+          cat: "scip",
+          ph: "X",
+          ts: toMicros(view.getFloat64(base, true)),
+          dur: Math.round(view.getFloat64(base + 8, true) * 1000),
+          pid,
+          tid,
+        };
+        if (span === 9) {
+          event.name = PROFILE_CALLBACK_NAMES[arg] || event.name;
+          event.cat = "scip.callback";
+        } else if (span === 7 || span === 8) {
+          event.args = { round: arg };
+        } else if (span === 0 || span === 1) {
+          event.args = { ok: arg === 1 };
+        }
+        traceEvents.push(event);
       }
-      const ok = this._module._scip_pricer_add_var_to_conss_batch(varId, consPtr, valPtr, nnz);
-      return ok === 1;
-    } finally {
-      this._module._free(consPtr);
-      this._module._free(valPtr);
     }
-  }
 
-  addPricedVar({ name, lb = 0, ub = 1e20, obj = 0, vartype = 3, initial = 1, removable = 1 }) {
-    return this._withCString(name, (ptr) => this._module._scip_pricer_add_priced_var(ptr, lb, ub, obj, vartype, initial, removable));
+    for (const span of this._jsSpans || []) {
+      traceEvents.push({
+        name: span.name,
+        cat: "scip.js",
+        ph: "X",
+        ts: toMicros(span.start),
+        dur: Math.round(span.duration * 1000),
+        pid,
+        tid,
+      });
+    }
+
+    traceEvents.sort((a, b) => a.ts - b.ts);
+    return {
+      traceEvents,
+      displayTimeUnit: "ms",
+      otherData: {
+        droppedSpans: this._module._scip_profile_get_dropped(),
+        pluginTimes: this._getPluginTimes(),
+      },
+    };
   }
 
-  includePricer({ name = "js_pricer", desc = "JavaScript pricer", priority = 0, delay = true } = {}) {
-    return this._withCString(name, (namePtr) => {
-      return this._withCString(desc, (descPtr) => this._module._scip_pricer_include(namePtr, descPtr, priority, delay ? 1 : 0) === 1);
-    });
+  /**
+   * Sample SCIP and wasm heap memory at phase boundaries and every N nodes
+   * @param {Object} options
+   * @param {number} options.capacity - Samples kept (oldest are overwritten)
+   * @param {number} options.everyNodes - Node interval between samples (0: phases only)
+   */
+  enableMemorySampling({ capacity = 4096, everyNodes = 1000 } = {}) {
+    return this._module._scip_memory_sampling_enable(capacity, everyNodes) === 1;
   }
 
-  activatePricer() {
-    return this._module._scip_pricer_activate() === 1;
+  disableMemorySampling() {
+    this._module._scip_memory_sampling_enable(0, 0);
   }
 
-  deactivatePricer() {
-    return this._module._scip_pricer_deactivate() === 1;
+  clearMemorySamples() {
+    this._module._scip_memory_sampling_clear();
   }
 
-  isPricerActive() {
-    return this._module._scip_pricer_is_active() === 1;
+  _decodeMemorySample(data, offset) {
+    const sample = {};
+    for (let j = 0; j < MEMORY_SAMPLE_FIELDS.length; j += 1) {
+      sample[MEMORY_SAMPLE_FIELDS[j]] = data[offset + j];
+    }
+    sample.phase = MemoryPhase[sample.phase] || "unknown";
+    return sample;
   }
 
-  setPricerResult(resultCode) {
-    this._module._scip_pricer_set_result(resultCode);
+  /**
+   * Memory time series, oldest first
+   * @returns {{ fields: string[], stride: number, data: Float64Array, total: number }}
+   */
+  getMemorySamples() {
+    const stride = this._module._scip_memory_sample_fields();
+    const total = this._module._scip_memory_get_total_samples();
+    const max = Math.min(total, 1 << 16);
+    if (max <= 0) {
+      return { fields: MEMORY_SAMPLE_FIELDS, stride, data: new Float64Array(0), total };
+    }
+    const outPtr = this._alloc(max * stride * 8);
+    try {
+      const count = this._module._scip_memory_get_samples(outPtr, max);
+      const data = this._module.HEAPF64.slice(outPtr >> 3, (outPtr >> 3) + count * stride);
+      return { fields: MEMORY_SAMPLE_FIELDS, stride, data, total };
+    } finally {
+      this._release(outPtr);
+    }
   }
 
-  setPricerLowerbound(value) {
-    this._module._scip_pricer_set_lowerbound(value);
+  /**
+   * Memory time series as an array of objects
+   */
+  getMemoryTimeline() {
+    const { stride, data } = this.getMemorySamples();
+    const out = [];
+    for (let i = 0; i < data.length; i += stride) {
+      out.push(this._decodeMemorySample(data, i));
+    }
+    return out;
   }
 
-  setPricerStopEarly(flag) {
-    this._module._scip_pricer_set_stopearly(flag ? 1 : 0);
+  /**
+   * Take a memory sample right now
+   */
+  sampleMemory() {
+    const stride = MEMORY_SAMPLE_FIELDS.length;
+    const outPtr = this._alloc(stride * 8);
+    try {
+      this._module._scip_memory_sample_now(outPtr);
+      return this._decodeMemorySample(this._module.HEAPF64, outPtr >> 3);
+    } finally {
+      this._release(outPtr);
+    }
   }
 
-  abortPricingRound() {
-    this._module._scip_pricer_abort_round();
+  /**
+   * Limit SCIP's memory (limits/memory, in MB); the solve stops with status
+   * "unknown" when the limit is hit instead of growing the heap further
+   */
+  setMemoryLimit(megabytes) {
+    return this.setParamReal("limits/memory", megabytes);
   }
 
-  getAddedPricedVarCountThisCall() {
-    return this._module._scip_pricer_get_n_added_vars_this_call();
+  /**
+   * Serve the bridge's per-problem allocations (handle registries, solution
+   * hints, name strings and batch buffers) from a bump arena that is released
+   * in one step when the problem is cleared. Only switchable between problems.
+   * @param {Object} options
+   * @param {number} options.bytes - Arena size; allocations beyond it fall back to malloc
+   * @param {boolean} options.timing - Also measure time spent in bridge allocations
+   */
+  enableArena({ bytes = 4 << 20, timing = false } = {}) {
+    if (this._module._scip_arena_enable(bytes) !== 1) {
+      return false;
+    }
+    this._module._scip_bridge_alloc_stats_reset(timing ? 1 : 0);
+    this._arena = true;
+    return true;
   }
 
-  getLastPricingResult() {
-    return this._module._scip_pricer_get_last_result();
+  disableArena() {
+    if (this._module._scip_arena_enable(0) !== 1) {
+      return false;
+    }
+    this._arena = false;
+    return true;
   }
 
-  getLastPricingMode() {
-    return this._module._scip_pricer_get_last_mode();
+  /**
+   * Bridge allocation counters since enableArena() / resetAllocStats()
+   */
+  getAllocStats() {
+    // Plain malloc so reading the counters does not count as a bridge allocation
+    const outPtr = this._module._malloc(this._module._scip_bridge_alloc_stats_fields() * 8);
+    try {
+      this._module._scip_bridge_alloc_stats(outPtr);
+      const f = this._module.HEAPF64;
+      const o = outPtr >> 3;
+      return {
+        allocs: f[o],
+        frees: f[o + 1],
+        reallocs: f[o + 2],
+        bytes: f[o + 3],
+        timeMs: f[o + 4],
+        arenaCapacity: f[o + 5],
+        arenaUsed: f[o + 6],
+        arenaHighWater: f[o + 7],
+        arenaResets: f[o + 8],
+        arenaFallbacks: f[o + 9],
+      };
+    } finally {
+      this._module._free(outPtr);
+    }
   }
 
-  getPricerRedcostCalls() {
-    return this._module._scip_pricer_get_redcost_calls();
+  resetAllocStats({ timing = false } = {}) {
+    this._module._scip_bridge_alloc_stats_reset(timing ? 1 : 0);
   }
 
-  getPricerFarkasCalls() {
-    return this._module._scip_pricer_get_farkas_calls();
+  /**
+   * Load a native plugin (wasm side module exporting scipjs_plugin_init, see
+   * scipjs_plugin.h). Needs init({ dynamicLinking: true }); load plugins once,
+   * before the first solve.
+   * @param {Uint8Array|ArrayBuffer} bytes - Side module binary
+   * @param {string} name - File name used inside the virtual filesystem
+   * @returns {number} Plugin id
+   */
+  loadPlugin(bytes, name = `plugin${this._module._scip_plugin_count() + 1}`) {
+    const path = `/plugins/${name.endsWith(".wasm") ? name : name + ".wasm"}`;
+    this._module.FS.writeFile(path, bytes instanceof Uint8Array ? bytes : new Uint8Array(bytes));
+    const id = this._withCString(path, (pathPtr) => this._module._scip_plugin_load(pathPtr));
+    if (id <= 0) {
+      throw new Error(`Failed to load plugin: ${this._module.UTF8ToString(this._module._scip_plugin_last_error())}`);
+    }
+    return id;
   }
 
-  getPricerRound() {
-    return this._module._scip_pricer_get_round();
+  /**
+   * Activate a pricer included by a native plugin for the current problem
+   */
+  activatePluginPricer(name) {
+    return this._withCString(name, (namePtr) => this._module._scip_plugin_activate_pricer(namePtr) === 1);
   }
 
   setParamInt(name, value) {
@@ -496,6 +1803,10 @@ export class SCIPApi {
     return this._withCString(name, (namePtr) => this._module._scip_set_param_real(namePtr, value) === 1);
   }
 
+  setParamLongint(name, value) {
+    return this._withCString(name, (namePtr) => this._module._scip_set_param_longint(namePtr, value) === 1);
+  }
+
   setParamBool(name, value) {
     return this._withCString(name, (namePtr) => this._module._scip_set_param_bool(namePtr, value ? 1 : 0) === 1);
   }
@@ -506,6 +1817,100 @@ export class SCIPApi {
     });
   }
 
+  /**
+   * Apply a settings profile on top of the current parameters, in order:
+   * emphasis, meta settings, then individual parameters.
+   * @param {Object} profile
+   * @param {string|number} profile.emphasis - Emphasis name (see Emphasis)
+   * @param {string|number} profile.heuristics - 'default' | 'aggressive' | 'fast' | 'off'
+   * @param {string|number} profile.presolving - Same values
+   * @param {string|number} profile.separating - Same values
+   * @param {Object} profile.params - name -> value; integral numbers are tried
+   *   as int, then longint parameters, then as real
+   * @returns {string[]} Parameters that could not be set
+   */
+  applySettings(profile = {}) {
+    const failed = [];
+    if (profile.emphasis !== undefined && !this._module._scip_set_emphasis(settingCode(Emphasis, profile.emphasis, "emphasis"))) {
+      failed.push("emphasis");
+    }
+    META_GROUPS.forEach((group, index) => {
+      if (profile[group] !== undefined && !this._module._scip_set_meta_setting(index, settingCode(ParamSetting, profile[group], group))) {
+        failed.push(group);
+      }
+    });
+    for (const [name, value] of Object.entries(profile.params || {})) {
+      let ok;
+      if (typeof value === "boolean") {
+        ok = this.setParamBool(name, value);
+      } else if (typeof value === "string") {
+        ok = this.setParamString(name, value);
+      } else {
+        ok = (Number.isInteger(value) && (this.setParamInt(name, value) || this.setParamLongint(name, value)))
+          || this.setParamReal(name, value);
+      }
+      if (!ok) {
+        failed.push(name);
+      }
+    }
+    return failed;
+  }
+
+  /**
+   * Current parameters as SCIP settings file text (readable by `scip -s`)
+   * @param {Object} options
+   * @param {boolean} options.onlyChanged - Only parameters off SCIP's defaults (default true)
+   */
+  saveSettings({ onlyChanged = true } = {}) {
+    const ok = this._withCString(SETTINGS_FILE, (pathPtr) => this._module._scip_write_params(pathPtr, onlyChanged ? 1 : 0));
+    if (!ok) {
+      return null;
+    }
+    const text = this._module.FS.readFile(SETTINGS_FILE, { encoding: "utf8" });
+    this._module.FS.unlink(SETTINGS_FILE);
+    return text;
+  }
+
+  /**
+   * Apply settings file text from saveSettings() or SCIP itself
+   */
+  loadSettings(text) {
+    this._module.FS.writeFile(SETTINGS_FILE, text);
+    try {
+      return this._withCString(SETTINGS_FILE, (pathPtr) => this._module._scip_read_params(pathPtr)) === 1;
+    } finally {
+      this._module.FS.unlink(SETTINGS_FILE);
+    }
+  }
+
+  /**
+   * Reset every parameter to SCIP's default
+   */
+  resetSettings() {
+    return this._module._scip_reset_params() === 1;
+  }
+
+  // Run fn under a settings profile, then restore the parameters in effect before
+  async _withSettings(profile, fn) {
+    if (!profile) {
+      return fn();
+    }
+    const saved = this.saveSettings();
+    const failed = this.applySettings(profile);
+    try {
+      const result = await fn();
+      if (failed.length > 0) {
+        result.settingsFailed = failed;
+      }
+      return result;
+    } finally {
+      this.resetSettings();
+      if (saved) {
+        this.loadSettings(saved);
+      }
+    }
+  }
+
   getResultCodeSuccess() {
     return this._module._scip_result_success();
   }
@@ -604,8 +2009,8 @@ export class SCIPApi {
       throw new Error("varIds and vals length mismatch");
     }
     const nnz = varIds.length;
-    const varPtr = this._module._malloc(nnz * 4);
-    const valPtr = this._module._malloc(nnz * 8);
+    const varPtr = this._alloc(nnz * 4);
+    const valPtr = this._alloc(nnz * 8);
     try {
       let varOffset = varPtr >> 2;
       let valOffset = valPtr >> 3;
@@ -615,8 +2020,324 @@ export class SCIPApi {
       }
       return this._module._scip_add_coef_linear_batch(consId, varPtr, valPtr, nnz) === 1;
     } finally {
-      this._module._free(varPtr);
-      this._module._free(valPtr);
+      this._release(valPtr);
+      this._release(varPtr);
+    }
+  }
+
+  /**
+   * Replace the current problem with a compiled model in one transfer. A
+   * SharedArrayBuffer blob (shareModel()) is copied straight into the heap.
+   * @param {ModelBuilder|ArrayBuffer|SharedArrayBuffer|Uint8Array} model - ModelBuilder or its compile() output
+   * @returns {boolean} Variable j then has handle j + 1, row i constraint handle i + 1
+   */
+  loadModel(model) {
+    const blob = typeof model.compile === "function" ? model.compile() : model;
+    const bytes = blob instanceof Uint8Array ? blob : new Uint8Array(blob);
+    // Not through the arena: the load starts a new problem, which resets the
+    // arena while the blob is still being read
+    const ptr = this._module._malloc(bytes.length);
+    try {
+      this._module.HEAPU8.set(bytes, ptr);
+      return this._module._scip_problem_load_blob(ptr, bytes.length) === 1;
+    } finally {
+      this._module._free(ptr);
+    }
+  }
+
+  /**
+   * Change the bounds of many variables in one call, e.g. to fix a
+   * neighbourhood before re-solving the loaded model. NaN keeps a bound.
+   * Drops a solved problem's transformed state, so the next solve starts over.
+   * @param {ArrayLike<number>} handles - Variable handles (model index + 1)
+   * @param {ArrayLike<number>} lb
+   * @param {ArrayLike<number>} ub
+   * @returns {number} Variables changed
+   */
+  setVarBounds(handles, lb, ub) {
+    const n = handles.length;
+    if (n === 0) {
+      return 0;
+    }
+    const idsPtr = this._alloc(n * 4);
+    const lbPtr = this._alloc(n * 8);
+    const ubPtr = this._alloc(n * 8);
+    try {
+      this._module.HEAP32.set(handles, idsPtr >> 2);
+      this._module.HEAPF64.set(lb, lbPtr >> 3);
+      this._module.HEAPF64.set(ub, ubPtr >> 3);
+      return this._module._scip_set_var_bounds_batch(idsPtr, lbPtr, ubPtr, n);
+    } finally {
+      this._release(ubPtr);
+      this._release(lbPtr);
+      this._release(idsPtr);
+    }
+  }
+
+  /**
+   * Connected components of a compiled model's constraint matrix (union-find
+   * in C over the blob's CSR); no problem needs to be loaded.
+   * @returns {{count: number, varLabels: Int32Array, rowLabels: Int32Array}|null}
+   *   Labels 0..count-1; -1 for variables in no row and for empty rows.
+   *   null if the blob is malformed.
+   */
+  modelComponents(model) {
+    const blob = typeof model.compile === "function" ? model.compile() : model;
+    const bytes = blob instanceof Uint8Array ? blob : new Uint8Array(blob);
+    if (bytes.length < 64) {
+      return null;
+    }
+    const [, , , nvars, nrows] = new Int32Array(bytes.buffer, bytes.byteOffset, 5);
+    // Every variable and row takes more than a byte of the blob; a header
+    // claiming more must not size the label buffer
+    if (nvars < 0 || nrows < 0 || nvars + nrows > bytes.length) {
+      return null;
+    }
+    const ptr = this._alloc(bytes.length);
+    const labelsPtr = this._alloc(Math.max(1, nvars + nrows) * 4);
+    try {
+      this._module.HEAPU8.set(bytes, ptr);
+      const count = this._module._scip_blob_components(ptr, bytes.length, labelsPtr);
+      if (count < 0) {
+        return null;
+      }
+      const labels = this._module.HEAP32.slice(labelsPtr >> 2, (labelsPtr >> 2) + nvars + nrows);
+      return { count, varLabels: labels.subarray(0, nvars), rowLabels: labels.subarray(nvars) };
+    } finally {
+      this._release(labelsPtr);
+      this._release(ptr);
+    }
+  }
+
+  /**
+   * Run SCIP's presolve only and return the reduced model as a model blob
+   * (readModel() gives its CSR arrays; solveModel() solves it) with the
+   * postsolve map back to the original variable handles (postsolveSolution).
+   * The reduced model always minimizes. The current problem stays presolved.
+   * Symmetry handling is off during this presolve.
+   * @param {ModelBuilder|ArrayBuffer|Uint8Array} [model] - Loaded first when given
+   * @returns {Object} status ('unknown' once presolved, or optimal / infeasible /
+   *   unbounded when presolve decided the problem), `model`, `postsolve` and
+   *   statistics; when presolve solved it, the reduced model is empty and
+   *   `objective` and `values` are the solution
+   */
+  presolveOnly(model = null) {
+    if (model && !this.loadModel(model)) {
+      return { status: Status.ERROR, error: "Failed to load model" };
+    }
+    const start = now();
+    const code = this._module._scip_presolve_only();
+    const presolvingTime = (now() - start) / 1000;
+    if (code === -1 || code === -2) {
+      return { status: code === -1 ? Status.INFEASIBLE : Status.UNBOUNDED, model: null, postsolve: null };
+    }
+    if (code !== 1 && code !== 2) {
+      return {
+        status: Status.ERROR,
+        error: code === -3 ? "Presolved problem has constraints without a linear form" : "Presolve failed",
+      };
+    }
+    const copy = (ptr, size) => this._module.HEAPU8.slice(ptr, ptr + size);
+    const reduced = copy(this._module._scip_presolve_model(), this._module._scip_presolve_model_size());
+    const postsolve = copy(this._module._scip_presolve_map(), this._module._scip_presolve_map_size());
+    this._module._scip_presolve_free();
+    const [, , , vars, rows, nonzeros] = new Int32Array(reduced.buffer, 0, 6);
+    const map = decodePostsolveMap(postsolve);
+    const { nvars, fixed, aggregated, multiAggregated } = map;
+    const result = {
+      status: code === 2 ? Status.OPTIMAL : Status.UNKNOWN,
+      model: reduced,
+      postsolve,
+      statistics: { presolvingTime, originalVars: nvars, vars, rows, nonzeros, fixed, aggregated, multiAggregated },
+    };
+    if (code === 2) {
+      // Every variable is fixed; the empty reduced model has objective 0
+      Object.assign(result, postsolveSolution(map, [], 0));
+    }
+    return result;
+  }
+
+  /**
+   * Best-solution values of the first n variables in handle order
+   * @returns {Float64Array} Empty when there is no solution
+   */
+  getVarValues(n = this._module._scip_get_nvars()) {
+    if (n <= 0) {
+      return new Float64Array(0);
+    }
+    const outPtr = this._alloc(n * 8);
+    try {
+      const count = this._module._scip_get_var_values_batch(outPtr, n);
+      return this._module.HEAPF64.slice(outPtr >> 3, (outPtr >> 3) + count);
+    } finally {
+      this._release(outPtr);
+    }
+  }
+
+  /**
+   * Offer a start solution by variable handle order (e.g. a previous incumbent).
+   * NaN entries are unknown: before the solve, SCIP completes such a partial
+   * solution itself.
+   * @param {ArrayLike<number>} values
+   * @returns {boolean} Whether SCIP stored it
+   */
+  addSolutionValues(values) {
+    const n = values.length;
+    if (n === 0) {
+      return false;
+    }
+    const ptr = this._alloc(n * 8);
+    try {
+      this._module.HEAPF64.set(values, ptr >> 3);
+      return this._module._scip_add_solution_values(ptr, n) === 1;
+    } finally {
+      this._release(ptr);
+    }
+  }
+
+  /**
+   * Load a model with loadModel() and solve it. `values` follows the model's
+   * variable order; `variables` is keyed by name when a ModelBuilder is given.
+   * options.initialValues seeds a start solution in the same order.
+   * options.resumeFrom continues from a checkpoint of the same model; with
+   * options.checkpoint an interrupted solve returns result.checkpoint.
+   * options.reuseCuts imports a cut pack of a related solve (importCuts); with
+   * options.exportCuts the solve returns its own as result.cuts.
+   * options.settings applies a profile (see applySettings) for this solve only.
+   */
+  async solveModel(model, options = {}) {
+    if (!this._isInitialized) {
+      await this.init(options);
+    }
+    if (options.settings) {
+      return this._withSettings(options.settings, () => this.solveModel(model, { ...options, settings: null }));
+    }
+
+    const blob = typeof model.compile === "function" ? model.compile() : model;
+    if (!this.loadModel(blob)) {
+      return {
+        status: Status.ERROR,
+        error: "Failed to load model",
+      };
+    }
+
+    const nvars = new Int32Array(blob instanceof Uint8Array ? blob.buffer : blob, blob.byteOffset || 0, 4)[3];
+    if (options.resumeFrom && !this.loadCheckpoint(options.resumeFrom)) {
+      return {
+        status: Status.ERROR,
+        error: "Checkpoint does not match the model",
+      };
+    }
+    if (options.initialValues) {
+      this.addSolutionValues(options.initialValues);
+    }
+    const cutsImported = options.reuseCuts ? this.importCuts(options.reuseCuts) : undefined;
+    const result = await this.solveCurrentModel({ ...options, extractVariables: false });
+    result.values = this.getVarValues(nvars);
+    if (options.resumeFrom) {
+      result.resumedNodes = this._module._scip_checkpoint_resumed_nodes();
+    }
+    if (options.checkpoint && result.status !== Status.OPTIMAL && result.status !== Status.INFEASIBLE) {
+      result.checkpoint = this.saveCheckpoint();
+    }
+    if (cutsImported !== undefined) {
+      result.cutsImported = cutsImported;
+    }
+    if (options.exportCuts) {
+      result.cuts = this.exportCuts();
+    }
+
+    if (typeof model.compile === "function" && result.values.length === nvars) {
+      const names = model.varNames;
+      for (let j = 0; j < nvars; j += 1) {
+        result.variables[names[j]] = result.values[j];
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Two-stage model through SCIP's default Benders decomposition. The master
+   * and each subproblem are compiled blobs with names; subproblem variables
+   * named like a master variable are its copies (the linking variables).
+   * Runs on separate SCIP instances, leaving the current problem untouched.
+   * @param {ModelBuilder|ArrayBuffer|Uint8Array} master
+   * @param {Array<ModelBuilder|ArrayBuffer|Uint8Array>} subproblems
+   * @param {Object} options
+   * @param {number} options.timeLimit - Seconds (default 3600)
+   * @returns {Promise<Object>} status, objective, master `values`, statistics and benders counters
+   */
+  async solveBenders(master, subproblems, options = {}) {
+    if (!this._isInitialized) {
+      await this.init(options);
+    }
+    const { timeLimit = 3600 } = options;
+    const blobs = [master, ...subproblems].map((model) => {
+      const blob = typeof model.compile === "function" ? model.compile() : model;
+      const bytes = blob instanceof Uint8Array ? blob : new Uint8Array(blob);
+      if ((new Int32Array(bytes.buffer, bytes.byteOffset, 3)[2] & 2) === 0) {
+        throw new Error("Benders models need variable names to link master and subproblems");
+      }
+      return bytes;
+    });
+
+    const load = (bytes, fn) => {
+      const ptr = this._alloc(bytes.length);
+      try {
+        this._module.HEAPU8.set(bytes, ptr);
+        return fn(ptr, bytes.length);
+      } finally {
+        this._release(ptr);
+      }
+    };
+
+    try {
+      if (!load(blobs[0], (ptr, size) => this._module._scip_benders_begin(ptr, size, subproblems.length))) {
+        return { status: Status.ERROR, error: "Failed to load the master model" };
+      }
+      for (let s = 1; s < blobs.length; s += 1) {
+        if (!load(blobs[s], (ptr, size) => this._module._scip_benders_set_subproblem(s - 1, ptr, size))) {
+          return { status: Status.ERROR, error: `Failed to load subproblem ${s - 1}` };
+        }
+      }
+
+      const statusCode = this._module._scip_benders_solve(timeLimit);
+      const statusMap = {
+        0: Status.OPTIMAL,
+        1: Status.INFEASIBLE,
+        2: Status.UNBOUNDED,
+        3: Status.TIME_LIMIT,
+        4: Status.UNKNOWN,
+        [-1]: Status.ERROR,
+      };
+
+      const nvars = new Int32Array(blobs[0].buffer, blobs[0].byteOffset, 4)[3];
+      const ptr = this._alloc(Math.max(6, nvars) * 8);
+      try {
+        if (!this._module._scip_benders_result(ptr)) {
+          return { status: statusMap[statusCode] || Status.ERROR, error: "Benders solve failed" };
+        }
+        const [objective, dualBound, solvingTime, nodes, calls, cuts] = this._module.HEAPF64.slice(ptr >> 3, (ptr >> 3) + 6);
+        const count = this._module._scip_benders_values(ptr, nvars);
+        const values = this._module.HEAPF64.slice(ptr >> 3, (ptr >> 3) + count);
+        return {
+          status: statusMap[statusCode] || Status.UNKNOWN,
+          objective,
+          values,
+          statistics: {
+            solvingTime,
+            nodes,
+            gap: Math.abs(objective - dualBound) / Math.max(Math.abs(objective), 1e-9),
+            dualBound,
+            primalBound: objective,
+          },
+          benders: { subproblems: subproblems.length, calls, cuts },
+        };
+      } finally {
+        this._release(ptr);
+      }
+    } finally {
+      this._module._scip_benders_free();
     }
   }
 
@@ -624,12 +2345,16 @@ export class SCIPApi {
     if (!this._isInitialized) {
       await this.init(options);
     }
+    if (options.settings) {
+      return this._withSettings(options.settings, () => this.solveCurrentModel({ ...options, settings: null }));
+    }
 
     const {
       timeLimit = 3600,
       gap = null,
       initialSolution = null,
       cutoff = null,
+      extractVariables = true,
     } = options;
 
     this._module._scip_set_time_limit(timeLimit);
@@ -647,15 +2372,10 @@ export class SCIPApi {
         .map(([name, value]) => `${name}=${value}`)
         .join(";");
 
-      const solutionPtr = this._module.allocateUTF8(solutionStr);
-      this._module._scip_add_solution_hint(solutionPtr);
-      this._module._free(solutionPtr);
+      this._withCString(solutionStr, (solutionPtr) => this._module._scip_add_solution_hint(solutionPtr));
     }
 
-    this._module._scip_enable_incumbent_callback(this._incumbentCallback ? 1 : 0);
-    this._module._scip_enable_node_callback(this._nodeCallback ? 1 : 0);
-    this._module._scip_pricer_enable_redcost_callback(this._pricerRedcostCallback ? 1 : 0);
-    this._module._scip_pricer_enable_farkas_callback(this._pricerFarkasCallback ? 1 : 0);
+    this._syncCallbacks();
 
     const statusCode = this._module._scip_solve();
 
@@ -676,20 +2396,20 @@ export class SCIPApi {
     const dualBound = this._module._scip_get_dual_bound();
     const primalBound = this._module._scip_get_primal_bound();
 
+    const extractStart = now();
     const variables = {};
     const varNamesPtr = this._module._scip_get_var_names();
-    const varNamesStr = this._module.UTF8ToString(varNamesPtr);
+    const varNamesStr = extractVariables ? this._module.UTF8ToString(varNamesPtr) : "";
 
     if (varNamesStr) {
       const varNames = varNamesStr.split(",");
       for (const name of varNames) {
         if (name) {
-          const namePtr = this._module.allocateUTF8(name);
-          variables[name] = this._module._scip_get_var_value(namePtr);
-          this._module._free(namePtr);
+          variables[name] = this._withCString(name, (namePtr) => this._module._scip_get_var_value(namePtr));
         }
       }
     }
+    this._endJsSpan("extract", extractStart);
 
     return {
       status,
@@ -714,12 +2434,16 @@ export class SCIPApi {
    * @param {number} options.gap - Relative gap tolerance
    * @param {Object} options.initialSolution - Initial solution hint {varName: value}
    * @param {number} options.cutoff - Cutoff bound for pruning
+   * @param {Object} options.settings - Settings profile for this solve only (see applySettings)
    * @returns {Promise<Object>} Solution
    */
   async solve(problem, options = {}) {
     if (!this._isInitialized) {
       await this.init(options);
     }
+    if (options.settings) {
+      return this._withSettings(options.settings, () => this.solve(problem, { ...options, settings: null }));
+    }
 
     const {
       format = "lp",
@@ -736,12 +2460,12 @@ export class SCIPApi {
     const formatExtMap = { mps: "mps", zpl: "zpl", cip: "cip", lp: "lp" };
     const ext = formatExtMap[format] || "lp";
     const problemFile = `/problems/problem.${ext}`;
+    const writeStart = now();
     this._module.FS.writeFile(problemFile, problem);
+    this._endJsSpan("write problem", writeStart);
 
     // Read problem
-    const problemFilePtr = this._module.allocateUTF8(problemFile);
-    const readOk = this._module._scip_read_problem(problemFilePtr);
-    this._module._free(problemFilePtr);
+    const readOk = this._withCString(problemFile, (problemFilePtr) => this._module._scip_read_problem(problemFilePtr));
 
     if (!readOk) {
       return {
@@ -767,16 +2491,11 @@ export class SCIPApi {
         .map(([name, value]) => `${name}=${value}`)
         .join(";");
       
-      const solutionPtr = this._module.allocateUTF8(solutionStr);
-      this._module._scip_add_solution_hint(solutionPtr);
-      this._module._free(solutionPtr);
+      this._withCString(solutionStr, (solutionPtr) => this._module._scip_add_solution_hint(solutionPtr));
     }
 
     // Enable callbacks if registered
-    this._module._scip_enable_incumbent_callback(this._incumbentCallback ? 1 : 0);
-    this._module._scip_enable_node_callback(this._nodeCallback ? 1 : 0);
-    this._module._scip_pricer_enable_redcost_callback(this._pricerRedcostCallback ? 1 : 0);
-    this._module._scip_pricer_enable_farkas_callback(this._pricerFarkasCallback ? 1 : 0);
+    this._syncCallbacks();
 
     // Solve
     const statusCode = this._module._scip_solve();
@@ -801,6 +2520,7 @@ export class SCIPApi {
     const primalBound = this._module._scip_get_primal_bound();
 
     // Get variable values
+    const extractStart = now();
     const variables = {};
     const varNamesPtr = this._module._scip_get_var_names();
     const varNamesStr = this._module.UTF8ToString(varNamesPtr);
@@ -809,12 +2529,11 @@ export class SCIPApi {
       const varNames = varNamesStr.split(",");
       for (const name of varNames) {
         if (name) {
-          const namePtr = this._module.allocateUTF8(name);
-          variables[name] = this._module._scip_get_var_value(namePtr);
-          this._module._free(namePtr);
+          variables[name] = this._withCString(name, (namePtr) => this._module._scip_get_var_value(namePtr));
         }
       }
     }
+    this._endJsSpan("extract", extractStart);
 
     // Cleanup
     try { this._module.FS.unlink(problemFile); } catch (e) { /* ignore */ }
@@ -839,6 +2558,10 @@ export class SCIPApi {
   destroy() {
     if (this._module) {
       this._module._scip_free();
+      for (const ptr of Object.values(this._callbackPtrs || {})) {
+        this._module.removeFunction(ptr);
+      }
+      this._callbackPtrs = null;
       this._module = null;
       this._isInitialized = false;
     }
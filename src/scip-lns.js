@@ -0,0 +1,379 @@
+/**
+ * SCIP.js large-neighbourhood search (Node.js)
+ *
+ * Improves an incumbent of a large MIP by solving many small sub-MIPs on a
+ * SolverPool: each iteration fixes most integer variables to their incumbent
+ * values and lets SCIP search the rest under tight time and node limits.
+ * Workers keep the base model loaded and only swap fixings (one batched
+ * bound change per iteration). Several neighbourhoods run in parallel; an
+ * improvement becomes the incumbent of every later iteration at once and is
+ * posted as a cutoff to the iterations still running. Neighbourhoods are
+ * chosen by a UCB1 bandit on their recent improvements, and each adapts its
+ * fix rate: smaller when its sub-MIPs are solved without gain, larger when
+ * they run out of time.
+ *
+ * @example
+ * import { SolverPool } from 'scip.js/server';
+ * import { LNSEngine } from 'scip.js/lns';
+ *
+ * const pool = new SolverPool({ size: 4 });
+ * const lns = new LNSEngine(pool, model.compile(), { timeLimit: 60, subTimeLimit: 2 });
+ * const { objective, values, neighbourhoods } = await lns.run();
+ */
+
+import { readModel, shareModel } from './scip-model-builder.js';
+
+/**
+ * Built-in neighbourhoods
+ */
+export const Neighbourhood = {
+  // Fix a uniformly random subset of the integer variables
+  RANDOM: 'random',
+  // Free the variables of a random row and of rows sharing variables with it (BFS)
+  CONSTRAINT: 'constraint',
+  // Free the variables contributing most to the objective, plus random ones
+  OBJECTIVE: 'objective',
+  // Fix the variables on which the best solutions found agree
+  CROSSOVER: 'crossover',
+};
+
+const CONTINUOUS = 3;
+const POOL_SOLUTIONS = 5;
+
+function mulberry32(seed) {
+  return function () {
+    seed |= 0;
+    seed = (seed + 0x6d2b79f5) | 0;
+    let t = Math.imul(seed ^ (seed >>> 15), 1 | seed);
+    t = (t + Math.imul(t ^ (t >>> 7), 61 | t)) ^ t;
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+export class LNSEngine {
+  /**
+   * @param {SolverPool} pool
+   * @param {ModelBuilder|ArrayBuffer|SharedArrayBuffer|Uint8Array} model - Base model blob
+   * @param {Object} options
+   * @param {string[]} options.neighbourhoods - Subset of Neighbourhood values
+   * @param {number} options.timeLimit - Seconds for the whole search
+   * @param {number} options.maxIterations - Sub-MIPs to solve at most
+   * @param {number} options.subTimeLimit - Seconds per sub-MIP
+   * @param {number} options.subNodeLimit - Nodes per sub-MIP
+   * @param {number} options.fixRate - Initial share of integer variables fixed
+   * @param {number} options.parallel - Sub-MIPs in flight (default: pool size)
+   * @param {ArrayLike<number>} options.initialValues - Start incumbent; otherwise
+   *   found by a solve of the full model limited to initialTimeLimit
+   * @param {number} options.initialTimeLimit - Seconds for that first solve
+   * @param {number} options.exploration - UCB1 exploration weight
+   * @param {number} options.seed
+   * @param {Function} options.onImprove - ({ objective, values, neighbourhood, iteration }) on every new incumbent
+   */
+  constructor(pool, model, {
+    neighbourhoods = Object.values(Neighbourhood),
+    timeLimit = 60,
+    maxIterations = Infinity,
+    subTimeLimit = 2,
+    subNodeLimit = 5000,
+    fixRate = 0.7,
+    parallel = pool.size,
+    initialValues = null,
+    initialTimeLimit = 5,
+    exploration = Math.SQRT2,
+    seed = 1,
+    onImprove = null,
+  } = {}) {
+    this.pool = pool;
+    this.blob = shareModel(model);
+    this.model = readModel(this.blob);
+    this.timeLimit = timeLimit;
+    this.maxIterations = maxIterations;
+    this.subTimeLimit = subTimeLimit;
+    this.subNodeLimit = subNodeLimit;
+    this.parallel = Math.max(1, parallel);
+    this.initialValues = initialValues;
+    this.initialTimeLimit = initialTimeLimit;
+    this.exploration = exploration;
+    this.onImprove = onImprove;
+    this._rand = mulberry32(seed);
+    this._key = `lns${seed}-${Date.now().toString(36)}-${Math.floor(this._rand() * 1e9).toString(36)}`;
+
+    const { nvars, vartype } = this.model;
+    this._integers = Int32Array.from({ length: nvars }, (_, j) => j).filter((j) => vartype[j] !== CONTINUOUS);
+    this._arms = neighbourhoods.map((name) => ({
+      name,
+      fixRate,
+      runs: 0,
+      improvements: 0,
+      reward: 0,
+      totalGain: 0,
+    }));
+    this._colRows = null;
+
+    this.best = null;
+    this.bestValues = null;
+    this._solutions = [];
+  }
+
+  _better(a, b) {
+    if (b === null) {
+      return true;
+    }
+    const eps = 1e-9 * Math.max(1, Math.abs(b));
+    return this.model.maximize ? a > b + eps : a < b - eps;
+  }
+
+  // Whether a solution differs from every pooled one on some integer variable;
+  // copies of the incumbent would leave crossover nothing to disagree on
+  _distinct(values) {
+    return this._solutions.every((sol) => this._integers.some((j) => Math.abs(sol.values[j] - values[j]) > 1e-6));
+  }
+
+  _accept(objective, values, neighbourhood, iteration) {
+    if (this._distinct(values)) {
+      this._solutions.push({ objective, values });
+      this._solutions.sort((a, b) => (this.model.maximize ? b.objective - a.objective : a.objective - b.objective));
+      this._solutions.length = Math.min(this._solutions.length, POOL_SOLUTIONS);
+    }
+    if (!this._better(objective, this.best)) {
+      return null;
+    }
+    const previous = this.best;
+    this.best = objective;
+    this.bestValues = values;
+    this.history.push({ ms: performance.now() - this._started, objective, neighbourhood, iteration });
+    // Running sub-MIPs can stop as soon as they cannot beat the new incumbent
+    this.pool.postCutoff(this._key, { objlimit: objective });
+    if (this.onImprove) {
+      this.onImprove({ objective, values, neighbourhood, iteration });
+    }
+    // Relative gain over the incumbent it replaces
+    return previous === null ? 1 : Math.abs(objective - previous) / Math.max(1, Math.abs(previous));
+  }
+
+  // UCB1 over the neighbourhoods; untried ones first
+  _chooseArm() {
+    const total = this._arms.reduce((sum, arm) => sum + arm.runs, 0);
+    let best = null;
+    let bestScore = -Infinity;
+    for (const arm of this._arms) {
+      const score = arm.runs === 0
+        ? Infinity
+        : arm.reward / arm.runs + this.exploration * Math.sqrt(Math.log(total) / arm.runs);
+      if (score > bestScore) {
+        best = arm;
+        bestScore = score;
+      }
+    }
+    return best;
+  }
+
+  _sample(count) {
+    const pick = this._integers.slice();
+    for (let i = 0; i < count && i < pick.length - 1; i += 1) {
+      const k = i + Math.floor(this._rand() * (pick.length - i));
+      [pick[i], pick[k]] = [pick[k], pick[i]];
+    }
+    return pick.subarray(0, count);
+  }
+
+  // Integer variables to keep free for a neighbourhood
+  _freeSet(arm) {
+    const nint = this._integers.length;
+    const target = Math.max(1, Math.round(nint * (1 - arm.fixRate)));
+    const free = new Uint8Array(this.model.nvars);
+
+    if (arm.name === Neighbourhood.CONSTRAINT && this.model.nrows > 0) {
+      const { rowStart, colIdx, vartype } = this.model;
+      const colRows = this._columnRows();
+      const seenRow = new Uint8Array(this.model.nrows);
+      const queue = [Math.floor(this._rand() * this.model.nrows)];
+      seenRow[queue[0]] = 1;
+      let freed = 0;
+      for (let q = 0; q < queue.length && freed < target; q += 1) {
+        const row = queue[q];
+        for (let k = rowStart[row]; k < rowStart[row + 1] && freed < target; k += 1) {
+          const j = colIdx[k];
+          if (free[j] || vartype[j] === CONTINUOUS) {
+            continue;
+          }
+          free[j] = 1;
+          freed += 1;
+          for (let p = colRows.start[j]; p < colRows.start[j + 1]; p += 1) {
+            const next = colRows.rows[p];
+            if (!seenRow[next]) {
+              seenRow[next] = 1;
+              queue.push(next);
+            }
+          }
+        }
+      }
+      return free;
+    }
+
+    if (arm.name === Neighbourhood.OBJECTIVE) {
+      const { obj } = this.model;
+      const values = this.bestValues;
+      const sign = this.model.maximize ? -1 : 1;
+      const byCost = this._integers.slice().sort((a, b) => sign * (obj[b] * values[b] - obj[a] * values[a]));
+      const half = Math.ceil(target / 2);
+      byCost.subarray(0, half).forEach((j) => {
+        free[j] = 1;
+      });
+      this._sample(target - half).forEach((j) => {
+        free[j] = 1;
+      });
+      return free;
+    }
+
+    if (arm.name === Neighbourhood.CROSSOVER && this._solutions.length >= 2) {
+      // Free where the best solutions disagree, topped up at random
+      const [a, b] = this._solutions;
+      let freed = 0;
+      for (const j of this._integers) {
+        if (Math.abs(a.values[j] - b.values[j]) > 1e-6) {
+          free[j] = 1;
+          freed += 1;
+        }
+      }
+      if (freed < target) {
+        this._sample(target - freed).forEach((j) => {
+          free[j] = 1;
+        });
+      }
+      return free;
+    }
+
+    this._sample(target).forEach((j) => {
+      free[j] = 1;
+    });
+    return free;
+  }
+
+  // Column -> rows index of the base model, built on first use
+  _columnRows() {
+    if (!this._colRows) {
+      const { nvars, nrows, rowStart, colIdx } = this.model;
+      const start = new Int32Array(nvars + 1);
+      for (let k = 0; k < colIdx.length; k += 1) {
+        start[colIdx[k] + 1] += 1;
+      }
+      for (let j = 0; j < nvars; j += 1) {
+        start[j + 1] += start[j];
+      }
+      const next = start.slice(0, nvars);
+      const rows = new Int32Array(colIdx.length);
+      for (let i = 0; i < nrows; i += 1) {
+        for (let k = rowStart[i]; k < rowStart[i + 1]; k += 1) {
+          rows[next[colIdx[k]]++] = i;
+        }
+      }
+      this._colRows = { start, rows };
+    }
+    return this._colRows;
+  }
+
+  async _initial() {
+    if (this.initialValues) {
+      const values = Float64Array.from(this.initialValues);
+      const objective = values.reduce((sum, v, j) => sum + v * this.model.obj[j], 0);
+      this._accept(objective, values, 'initial', 0);
+      return;
+    }
+    const result = await this.pool.submit(this.blob, {
+      budgetMs: this.initialTimeLimit * 1000 + 5000,
+      solveOptions: { timeLimit: this.initialTimeLimit },
+    });
+    if (!result.values || result.values.length !== this.model.nvars) {
+      throw new Error(`No initial solution within ${this.initialTimeLimit}s (${result.status})`);
+    }
+    this._accept(result.objective, result.values, 'initial', 0);
+  }
+
+  async _iterate(iteration, remainingSeconds) {
+    const arm = this._chooseArm();
+    const free = this._freeSet(arm);
+    const fixVars = this._integers.filter((j) => !free[j]);
+    const fixValues = Float64Array.from(fixVars, (j) => Math.round(this.bestValues[j]));
+    const timeLimit = Math.max(0.1, Math.min(this.subTimeLimit, remainingSeconds));
+
+    arm.runs += 1;
+    let result;
+    try {
+      result = await this.pool.submit(this.blob, {
+        op: 'lns',
+        group: this._key,
+        budgetMs: timeLimit * 1000 + 5000,
+        solveOptions: {
+          timeLimit,
+          key: this._key,
+          fixVars,
+          fixValues,
+          incumbent: this.bestValues,
+          settings: { params: { 'limits/nodes': this.subNodeLimit } },
+        },
+      });
+    } catch (error) {
+      this.failures += 1;
+      return;
+    }
+
+    const solved = result.values && result.values.length === this.model.nvars;
+    const gain = solved ? this._accept(result.objective, result.values, arm.name, iteration) : null;
+    if (gain !== null) {
+      arm.improvements += 1;
+      arm.totalGain += gain;
+      arm.reward += 0.5 + 0.5 * Math.min(1, gain / 0.01);
+    } else if (result.status === 'optimal' || result.status === 'infeasible') {
+      // Searched to the end without gain: free more next time
+      arm.fixRate = Math.max(0.1, arm.fixRate - 0.05);
+    } else {
+      // Ran out of time: fix more
+      arm.fixRate = Math.min(0.98, arm.fixRate + 0.03);
+    }
+  }
+
+  /**
+   * Run until the time limit or iteration limit
+   * @returns {Promise<Object>} objective, values, iterations, history and per-neighbourhood stats
+   */
+  async run() {
+    this._started = performance.now();
+    this.history = [];
+    this.failures = 0;
+    const deadline = this._started + this.timeLimit * 1000;
+
+    await this._initial();
+
+    const inFlight = new Set();
+    let iterations = 0;
+    while (performance.now() < deadline && iterations < this.maxIterations) {
+      while (inFlight.size < this.parallel && iterations < this.maxIterations && performance.now() < deadline) {
+        iterations += 1;
+        const task = this._iterate(iterations, (deadline - performance.now()) / 1000).finally(() => inFlight.delete(task));
+        inFlight.add(task);
+      }
+      if (inFlight.size === 0) {
+        break;
+      }
+      await Promise.race(inFlight);
+    }
+    await Promise.all(inFlight);
+
+    return {
+      objective: this.best,
+      values: this.bestValues,
+      iterations,
+      failures: this.failures,
+      seconds: (performance.now() - this._started) / 1000,
+      history: this.history,
+      neighbourhoods: this._arms.map((arm) => ({
+        name: arm.name,
+        runs: arm.runs,
+        improvements: arm.improvements,
+        meanGain: arm.improvements > 0 ? arm.totalGain / arm.improvements : 0,
+        fixRate: arm.fixRate,
+      })),
+    };
+  }
+}
@@ -0,0 +1,185 @@
+/**
+ * SCIP.js load generator for the solve server
+ *
+ * Sends random multi-knapsack model blobs (built with ModelBuilder) to a
+ * running scip-server at a fixed concurrency and reports throughput, status
+ * codes and client-side p50/p99 latency. Offline and dependency free.
+ *
+ * @example
+ * node dist/scip-loadgen.js --url http://127.0.0.1:8787 --concurrency 16 --requests 1000
+ * node dist/scip-loadgen.js --socket /tmp/scip.sock --vars 200 --rows 20 --budget 2000
+ */
+
+import http from 'http';
+import { fileURLToPath } from 'url';
+import { ModelBuilder, VarType } from './scip-model-builder.js';
+import { LatencyWindow } from './scip-pool.js';
+
+function mulberry32(seed) {
+  return function () {
+    seed |= 0;
+    seed = (seed + 0x6d2b79f5) | 0;
+    let t = Math.imul(seed ^ (seed >>> 15), 1 | seed);
+    t = (t + Math.imul(t ^ (t >>> 7), 61 | t)) ^ t;
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+/**
+ * Random multi-knapsack: maximize sum p_j x_j, rows with about `density` fill
+ */
+export function randomKnapsack(rand, { vars = 50, rows = 5, density = 0.5 } = {}) {
+  const model = new ModelBuilder({ maximize: true, capacity: vars });
+  model.addVars(vars, { ub: 1, vartype: VarType.BINARY });
+  for (let j = 0; j < vars; j += 1) {
+    model.setObjective(j, 1 + Math.floor(rand() * 20));
+  }
+  for (let i = 0; i < rows; i += 1) {
+    const cols = [];
+    const vals = [];
+    let total = 0;
+    for (let j = 0; j < vars; j += 1) {
+      if (rand() < density) {
+        const w = 1 + Math.floor(rand() * 15);
+        cols.push(j);
+        vals.push(w);
+        total += w;
+      }
+    }
+    const row = model.addRow({ rhs: Math.max(1, Math.floor(total / 2)) });
+    model.addCoefs(row, cols, vals);
+  }
+  return model.compile();
+}
+
+function post(target, body, budgetMs, agent) {
+  return new Promise((resolve, reject) => {
+    const req = http.request({
+      ...target,
+      agent,
+      method: 'POST',
+      path: '/solve',
+      headers: {
+        'content-type': 'application/octet-stream',
+        'content-length': body.byteLength,
+        'x-scip-budget-ms': String(budgetMs),
+      },
+    }, (res) => {
+      res.resume();
+      res.on('end', () => resolve(res.statusCode));
+    });
+    req.on('error', reject);
+    req.end(Buffer.from(body));
+  });
+}
+
+function fetchMetrics(target, agent) {
+  return new Promise((resolve, reject) => {
+    http.get({ ...target, agent, path: '/metrics' }, (res) => {
+      const chunks = [];
+      res.on('data', (c) => chunks.push(c));
+      res.on('end', () => resolve(JSON.parse(Buffer.concat(chunks).toString('utf8'))));
+    }).on('error', reject);
+  });
+}
+
+/**
+ * Run a closed-loop load test
+ * @param {Object} options
+ * @param {string} options.url - Server URL (http://host:port)
+ * @param {string} options.socketPath - Unix socket instead of url
+ * @param {number} options.concurrency - Requests in flight
+ * @param {number} options.requests - Total requests
+ * @param {number} options.vars - Variables per model
+ * @param {number} options.rows - Rows per model
+ * @param {number} options.budgetMs - x-scip-budget-ms per request
+ * @param {number} options.seed - PRNG seed
+ */
+export async function runLoad({
+  url = 'http://127.0.0.1:8787',
+  socketPath = null,
+  concurrency = 8,
+  requests = 200,
+  vars = 50,
+  rows = 5,
+  budgetMs = 5000,
+  seed = 1,
+} = {}) {
+  const target = socketPath ? { socketPath } : { hostname: new URL(url).hostname, port: new URL(url).port };
+  const agent = new http.Agent({ keepAlive: true, maxSockets: concurrency });
+  const rand = mulberry32(seed);
+
+  // Build the payloads up front so the client does not throttle itself
+  const distinct = Math.min(requests, 64);
+  const payloads = [];
+  for (let i = 0; i < distinct; i += 1) {
+    payloads.push(randomKnapsack(rand, { vars, rows }));
+  }
+
+  const latency = new LatencyWindow(Math.max(1024, requests));
+  const statuses = {};
+  let errors = 0;
+  let next = 0;
+  const start = performance.now();
+
+  async function lane() {
+    while (next < requests) {
+      const body = payloads[next % distinct];
+      next += 1;
+      const t = performance.now();
+      try {
+        const status = await post(target, body, budgetMs, agent);
+        statuses[status] = (statuses[status] || 0) + 1;
+        if (status === 200) {
+          latency.add(performance.now() - t);
+        }
+      } catch (error) {
+        errors += 1;
+      }
+    }
+  }
+
+  await Promise.all(Array.from({ length: concurrency }, lane));
+  const elapsed = (performance.now() - start) / 1000;
+  const server = await fetchMetrics(target, agent).catch(() => null);
+  agent.destroy();
+
+  return {
+    requests,
+    concurrency,
+    seconds: elapsed,
+    throughput: requests / elapsed,
+    statuses,
+    errors,
+    latencyMs: latency.summary(),
+    server,
+  };
+}
+
+// CLI: node scip-loadgen.js [--url u | --socket p] [--concurrency n] [--requests n] [--vars n] [--rows n] [--budget ms]
+if (process.argv[1] && fileURLToPath(import.meta.url) === process.argv[1]) {
+  const args = {};
+  const argv = process.argv.slice(2);
+  for (let i = 0; i < argv.length; i += 2) {
+    args[argv[i].replace(/^--/, '')] = argv[i + 1];
+  }
+  const num = (key) => (args[key] !== undefined ? Number(args[key]) : undefined);
+
+  const report = await runLoad({
+    url: args.url,
+    socketPath: args.socket || null,
+    concurrency: num('concurrency'),
+    requests: num('requests'),
+    vars: num('vars'),
+    rows: num('rows'),
+    budgetMs: num('budget'),
+    seed: num('seed'),
+  });
+
+  console.log(`${report.requests} requests, concurrency ${report.concurrency}, ${report.throughput.toFixed(1)} req/s`);
+  console.log('status codes:', report.statuses, report.errors ? `(${report.errors} connection errors)` : '');
+  console.log('client latency ms:', report.latencyMs);
+  if (report.server) {
+    console.log('server latency ms:', report.server.latencyMs, 'queue wait ms:', report.server.queueWaitMs);
+  }
+}
@@ -0,0 +1,462 @@
+/**
+ * Columnar model builder
+ *
+ * Accumulates variables, rows and coefficients in growable typed-array columns
+ * without touching wasm, then compiles them into one model blob that
+ * SCIPApi.loadModel() / solveModel() hands to the bridge in a single copy.
+ * Pure JS, so a model can be built in one worker and solved in another
+ * (the compiled ArrayBuffer is transferable; compile({ shared: true }) returns
+ * a SharedArrayBuffer that any number of workers can load without cloning).
+ *
+ * @example
+ * const model = new ModelBuilder({ maximize: true });
+ * const x = model.addVar({ name: 'x', ub: 4, obj: 3, vartype: VarType.INTEGER });
+ * const y = model.addVar({ name: 'y', ub: 5, obj: 2 });
+ * const c = model.addRow({ name: 'cap', rhs: 10 });
+ * model.addCoefs(c, [x, y], [2, 1]);
+ * const result = await solver.solveModel(model);
+ * result.values; // Float64Array in variable order
+ */
+
+// Blob layout, mirrored by scip_problem_load_blob() in scip_api.c
+const BLOB_MAGIC = 0x424a4353; // "SCJB"
+const BLOB_VERSION = 1;
+const BLOB_HEADER_INTS = 16;
+const BLOB_FLAG_MAXIMIZE = 1;
+const BLOB_FLAG_NAMES = 2;
+const ROW_MODIFIABLE = 1;
+const ROW_REMOVABLE = 2;
+
+const INFINITY = 1e20;
+
+/**
+ * SCIP variable types
+ */
+export const VarType = {
+  BINARY: 0,
+  INTEGER: 1,
+  IMPLINT: 2,
+  CONTINUOUS: 3,
+};
+
+function grow(array, needed) {
+  if (needed <= array.length) {
+    return array;
+  }
+  let capacity = array.length || 16;
+  while (capacity < needed) {
+    capacity *= 2;
+  }
+  const next = new array.constructor(capacity);
+  next.set(array);
+  return next;
+}
+
+/**
+ * Copy a compiled blob into a SharedArrayBuffer once, so posting it to several
+ * workers shares the memory instead of structured-cloning it per worker.
+ * Shared blobs are returned as-is.
+ * @param {ModelBuilder|ArrayBuffer|Uint8Array|SharedArrayBuffer} model
+ * @returns {SharedArrayBuffer}
+ */
+export function shareModel(model) {
+  if (model instanceof SharedArrayBuffer) {
+    return model;
+  }
+  if (typeof model.compile === "function") {
+    return model.compile({ shared: true });
+  }
+  const bytes = model instanceof Uint8Array ? model : new Uint8Array(model);
+  if (bytes.buffer instanceof SharedArrayBuffer && bytes.byteOffset === 0 && bytes.length === bytes.buffer.byteLength) {
+    return bytes.buffer;
+  }
+  const shared = new SharedArrayBuffer(bytes.length);
+  new Uint8Array(shared).set(bytes);
+  return shared;
+}
+
+/**
+ * Typed-array views of a compiled blob's sections (no copy)
+ * @param {ArrayBuffer|SharedArrayBuffer|Uint8Array} blob
+ */
+export function readModel(blob) {
+  const bytes = blob instanceof Uint8Array ? blob : new Uint8Array(blob);
+  const header = new Int32Array(bytes.buffer, bytes.byteOffset, BLOB_HEADER_INTS);
+  if (header[0] !== BLOB_MAGIC || header[1] !== BLOB_VERSION) {
+    throw new Error("Not a SCIP.js model blob");
+  }
+  const [, , flags, nvars, nrows, nnz, nameBytes] = header;
+  let off = bytes.byteOffset + BLOB_HEADER_INTS * 4;
+  const view = (Type, count) => {
+    const array = new Type(bytes.buffer, off, count);
+    off += count * Type.BYTES_PER_ELEMENT;
+    return array;
+  };
+  const model = {
+    maximize: (flags & BLOB_FLAG_MAXIMIZE) !== 0,
+    nvars,
+    nrows,
+    nnz,
+    lb: view(Float64Array, nvars),
+    ub: view(Float64Array, nvars),
+    obj: view(Float64Array, nvars),
+    lhs: view(Float64Array, nrows),
+    rhs: view(Float64Array, nrows),
+    vals: view(Float64Array, nnz),
+    rowStart: view(Int32Array, nrows + 1),
+    colIdx: view(Int32Array, nnz),
+    vartype: view(Uint8Array, nvars),
+    rowflags: view(Uint8Array, nrows),
+    name: "js_problem",
+    varNames: null,
+    rowNames: null,
+  };
+  if (flags & BLOB_FLAG_NAMES) {
+    const names = new TextDecoder().decode(view(Uint8Array, nameBytes)).split("\0");
+    model.name = names[0];
+    model.varNames = names.slice(1, 1 + nvars);
+    model.rowNames = names.slice(1 + nvars, 1 + nvars + nrows);
+  }
+  return model;
+}
+
+/**
+ * Compile the submodel on the given variables and rows of a blob. Rows must
+ * only touch the given variables (e.g. one connected component) or variables
+ * with a value in `fixed`, whose terms are moved into the row sides; variable
+ * k of the submodel is vars[k] of the original.
+ * @param {ArrayBuffer|SharedArrayBuffer|Uint8Array|Object} blob - Blob or readModel() result
+ * @param {ArrayLike<number>} vars - Original variable indices
+ * @param {ArrayLike<number>} rows - Original row indices
+ * @param {Float64Array} fixed - Values of fixed original variables (NaN: not fixed)
+ * @returns {ArrayBuffer}
+ */
+export function extractSubmodel(blob, vars, rows, fixed = null) {
+  const src = blob.rowStart ? blob : readModel(blob);
+  const local = new Int32Array(src.nvars).fill(-1);
+  const sub = new ModelBuilder({ name: src.name, maximize: src.maximize, capacity: Math.max(1, vars.length) });
+  for (let k = 0; k < vars.length; k += 1) {
+    const j = vars[k];
+    local[j] = sub.addVar({
+      name: src.varNames ? src.varNames[j] : undefined,
+      lb: src.lb[j],
+      ub: src.ub[j],
+      obj: src.obj[j],
+      vartype: src.vartype[j],
+    });
+  }
+  for (let r = 0; r < rows.length; r += 1) {
+    const i = rows[r];
+    const begin = src.rowStart[i];
+    const end = src.rowStart[i + 1];
+    const cols = [];
+    const vals = [];
+    let activity = 0;
+    for (let k = begin; k < end; k += 1) {
+      const j = src.colIdx[k];
+      if (local[j] >= 0) {
+        cols.push(local[j]);
+        vals.push(src.vals[k]);
+      } else if (fixed && !Number.isNaN(fixed[j])) {
+        activity += src.vals[k] * fixed[j];
+      } else {
+        throw new Error(`Row ${i} uses variable ${j} outside the submodel`);
+      }
+    }
+    const row = sub.addRow({
+      name: src.rowNames ? src.rowNames[i] : undefined,
+      lhs: src.lhs[i] <= -INFINITY ? src.lhs[i] : src.lhs[i] - activity,
+      rhs: src.rhs[i] >= INFINITY ? src.rhs[i] : src.rhs[i] - activity,
+      modifiable: (src.rowflags[i] & ROW_MODIFIABLE) !== 0,
+      removable: (src.rowflags[i] & ROW_REMOVABLE) !== 0,
+    });
+    sub.addCoefs(row, cols, vals);
+  }
+  return sub.compile();
+}
+
+export class ModelBuilder {
+  /**
+   * @param {Object} options
+   * @param {string} options.name - Problem name
+   * @param {boolean} options.maximize - Objective sense
+   * @param {number} options.capacity - Initial column capacity (grows by doubling)
+   */
+  constructor({ name = "js_problem", maximize = false, capacity = 64 } = {}) {
+    this.name = name;
+    this.maximize = maximize;
+
+    this._nvars = 0;
+    this._lb = new Float64Array(capacity);
+    this._ub = new Float64Array(capacity);
+    this._obj = new Float64Array(capacity);
+    this._vartype = new Uint8Array(capacity);
+    this._varNames = [];
+
+    this._nrows = 0;
+    this._lhs = new Float64Array(capacity);
+    this._rhs = new Float64Array(capacity);
+    this._rowflags = new Uint8Array(capacity);
+    this._rowNames = [];
+
+    // Coefficients in COO form, turned into CSR by compile()
+    this._nnz = 0;
+    this._cooRow = new Int32Array(capacity * 4);
+    this._cooCol = new Int32Array(capacity * 4);
+    this._cooVal = new Float64Array(capacity * 4);
+
+    this._hasNames = false;
+  }
+
+  get numVars() {
+    return this._nvars;
+  }
+
+  get numRows() {
+    return this._nrows;
+  }
+
+  get numCoefs() {
+    return this._nnz;
+  }
+
+  /**
+   * Variable names in index order (defaults are x<index>)
+   */
+  get varNames() {
+    const names = new Array(this._nvars);
+    for (let j = 0; j < this._nvars; j += 1) {
+      names[j] = this._varNames[j] ?? `x${j}`;
+    }
+    return names;
+  }
+
+  /**
+   * @returns {number} Variable index
+   */
+  addVar({ name, lb = 0, ub = INFINITY, obj = 0, vartype = VarType.CONTINUOUS } = {}) {
+    const j = this._nvars;
+    if (j === this._lb.length) {
+      this._lb = grow(this._lb, j + 1);
+      this._ub = grow(this._ub, j + 1);
+      this._obj = grow(this._obj, j + 1);
+      this._vartype = grow(this._vartype, j + 1);
+    }
+    this._lb[j] = lb;
+    this._ub[j] = ub;
+    this._obj[j] = obj;
+    this._vartype[j] = vartype;
+    if (name !== undefined) {
+      this._varNames[j] = name;
+      this._hasNames = true;
+    }
+    this._nvars = j + 1;
+    return j;
+  }
+
+  /**
+   * Add `count` variables sharing bounds, objective and type
+   * @returns {number} Index of the first new variable
+   */
+  addVars(count, { lb = 0, ub = INFINITY, obj = 0, vartype = VarType.CONTINUOUS } = {}) {
+    const first = this._nvars;
+    const end = first + count;
+    this._lb = grow(this._lb, end);
+    this._ub = grow(this._ub, end);
+    this._obj = grow(this._obj, end);
+    this._vartype = grow(this._vartype, end);
+    this._lb.fill(lb, first, end);
+    this._ub.fill(ub, first, end);
+    this._obj.fill(obj, first, end);
+    this._vartype.fill(vartype, first, end);
+    this._nvars = end;
+    return first;
+  }
+
+  setObjective(varIndex, obj) {
+    this._obj[varIndex] = obj;
+  }
+
+  setBounds(varIndex, lb, ub) {
+    this._lb[varIndex] = lb;
+    this._ub[varIndex] = ub;
+  }
+
+  /**
+   * Add a linear row lhs <= a x <= rhs
+   * @returns {number} Row index
+   */
+  addRow({ name, lhs = -INFINITY, rhs = INFINITY, modifiable = false, removable = false } = {}) {
+    const i = this._nrows;
+    if (i === this._lhs.length) {
+      this._lhs = grow(this._lhs, i + 1);
+      this._rhs = grow(this._rhs, i + 1);
+      this._rowflags = grow(this._rowflags, i + 1);
+    }
+    this._lhs[i] = lhs;
+    this._rhs[i] = rhs;
+    this._rowflags[i] = (modifiable ? ROW_MODIFIABLE : 0) | (removable ? ROW_REMOVABLE : 0);
+    if (name !== undefined) {
+      this._rowNames[i] = name;
+      this._hasNames = true;
+    }
+    this._nrows = i + 1;
+    return i;
+  }
+
+  /**
+   * Add a coefficient; repeated (row, var) pairs are summed by SCIP
+   */
+  addCoef(rowIndex, varIndex, val) {
+    const k = this._nnz;
+    if (k === this._cooVal.length) {
+      this._growCoefs(k + 1);
+    }
+    this._cooRow[k] = rowIndex;
+    this._cooCol[k] = varIndex;
+    this._cooVal[k] = val;
+    this._nnz = k + 1;
+  }
+
+  /**
+   * Add coefficients of one row
+   * @param {number} rowIndex
+   * @param {ArrayLike<number>} varIndices
+   * @param {ArrayLike<number>} vals
+   */
+  addCoefs(rowIndex, varIndices, vals) {
+    const n = varIndices.length;
+    if (vals.length !== n) {
+      throw new Error("varIndices and vals length mismatch");
+    }
+    const start = this._nnz;
+    this._growCoefs(start + n);
+    this._cooRow.fill(rowIndex, start, start + n);
+    this._cooCol.set(varIndices, start);
+    this._cooVal.set(vals, start);
+    this._nnz = start + n;
+  }
+
+  _growCoefs(needed) {
+    this._cooRow = grow(this._cooRow, needed);
+    this._cooCol = grow(this._cooCol, needed);
+    this._cooVal = grow(this._cooVal, needed);
+  }
+
+  /**
+   * COO -> CSR with a two-pass LSD radix (counting) sort: by column, then
+   * stably by row, so each row ends up with ascending column indices.
+   * O(nnz + nvars + nrows).
+   */
+  _toCSR() {
+    const nnz = this._nnz;
+    const nvars = this._nvars;
+    const nrows = this._nrows;
+    const rows = this._cooRow;
+    const cols = this._cooCol;
+    const vals = this._cooVal;
+
+    for (let k = 0; k < nnz; k += 1) {
+      if (rows[k] < 0 || rows[k] >= nrows || cols[k] < 0 || cols[k] >= nvars) {
+        throw new Error(`Coefficient ${k} refers to row ${rows[k]}, var ${cols[k]} out of range`);
+      }
+    }
+
+    // Pass 1: order by column
+    const colCount = new Int32Array(nvars + 1);
+    for (let k = 0; k < nnz; k += 1) {
+      colCount[cols[k] + 1] += 1;
+    }
+    for (let j = 0; j < nvars; j += 1) {
+      colCount[j + 1] += colCount[j];
+    }
+    const byCol = new Int32Array(nnz);
+    for (let k = 0; k < nnz; k += 1) {
+      byCol[colCount[cols[k]]++] = k;
+    }
+
+    // Pass 2: stable by row
+    const rowStart = new Int32Array(nrows + 1);
+    for (let k = 0; k < nnz; k += 1) {
+      rowStart[rows[k] + 1] += 1;
+    }
+    for (let i = 0; i < nrows; i += 1) {
+      rowStart[i + 1] += rowStart[i];
+    }
+    const next = rowStart.slice(0, nrows);
+    const colIdx = new Int32Array(nnz);
+    const csrVals = new Float64Array(nnz);
+    for (let p = 0; p < nnz; p += 1) {
+      const k = byCol[p];
+      const dst = next[rows[k]]++;
+      colIdx[dst] = cols[k];
+      csrVals[dst] = vals[k];
+    }
+
+    return { rowStart, colIdx, vals: csrVals };
+  }
+
+  _encodeNames() {
+    if (!this._hasNames) {
+      return null;
+    }
+    const parts = [this.name];
+    for (let j = 0; j < this._nvars; j += 1) {
+      parts.push(this._varNames[j] ?? `x${j}`);
+    }
+    for (let i = 0; i < this._nrows; i += 1) {
+      parts.push(this._rowNames[i] ?? `c${i}`);
+    }
+    return new TextEncoder().encode(parts.join("\0") + "\0");
+  }
+
+  /**
+   * Compile the model into a blob for SCIPApi.loadModel()
+   * @param {Object} options
+   * @param {boolean} options.shared - Write the blob into a SharedArrayBuffer
+   * @returns {ArrayBuffer|SharedArrayBuffer}
+   */
+  compile({ shared = false } = {}) {
+    const nvars = this._nvars;
+    const nrows = this._nrows;
+    const nnz = this._nnz;
+    const { rowStart, colIdx, vals } = this._toCSR();
+    const names = this._encodeNames();
+    const nameBytes = names ? names.length : 0;
+
+    const f64Bytes = 8 * (3 * nvars + 2 * nrows + nnz);
+    const i32Bytes = 4 * (nrows + 1 + nnz);
+    const size = BLOB_HEADER_INTS * 4 + f64Bytes + i32Bytes + nvars + nrows + nameBytes;
+    const buffer = shared ? new SharedArrayBuffer(size) : new ArrayBuffer(size);
+
+    const header = new Int32Array(buffer, 0, BLOB_HEADER_INTS);
+    header[0] = BLOB_MAGIC;
+    header[1] = BLOB_VERSION;
+    header[2] = (this.maximize ? BLOB_FLAG_MAXIMIZE : 0) | (names ? BLOB_FLAG_NAMES : 0);
+    header[3] = nvars;
+    header[4] = nrows;
+    header[5] = nnz;
+    header[6] = nameBytes;
+
+    let off = BLOB_HEADER_INTS * 4;
+    const put = (Type, src, count) => {
+      new Type(buffer, off, count).set(src.subarray(0, count));
+      off += count * Type.BYTES_PER_ELEMENT;
+    };
+    put(Float64Array, this._lb, nvars);
+    put(Float64Array, this._ub, nvars);
+    put(Float64Array, this._obj, nvars);
+    put(Float64Array, this._lhs, nrows);
+    put(Float64Array, this._rhs, nrows);
+    put(Float64Array, vals, nnz);
+    put(Int32Array, rowStart, nrows + 1);
+    put(Int32Array, colIdx, nnz);
+    put(Uint8Array, this._vartype, nvars);
+    put(Uint8Array, this._rowflags, nrows);
+    if (names) {
+      put(Uint8Array, names, nameBytes);
+    }
+
+    return buffer;
+  }
+}
@@ -0,0 +1,146 @@
+/**
+ * SCIP.js pool worker (worker_threads)
+ * Owns one SCIPApi instance and solves the jobs posted by SolverPool.
+ * Keeps the last incumbent of each recently seen model family and offers it as
+ * a start solution when the family comes back (the pool routes it here).
+ * Each job may carry a shared mailbox through which the pool tightens its
+ * cutoff mid-solve; with shareCutoffs the worker reports its incumbents back.
+ * Jobs with op 'components' only label the blob's connected components; op
+ * 'benders' solves a master blob with options.subproblems by Benders. Op 'lns'
+ * keeps its base model loaded across iterations and only swaps the
+ * neighbourhood's fixings (scip-lns.js).
+ */
+
+import { parentPort, workerData } from 'worker_threads';
+import { SCIPApi, createProgressBuffer } from './scip-api-wrapper.js';
+import { readModel } from './scip-model-builder.js';
+
+const solver = new SCIPApi();
+await solver.init(workerData?.initOptions || {});
+solver.setParamInt('display/verblevel', 0);
+// Live state for SolverPool.progress(), read by the pool without messages
+const progress = solver.attachProgress(createProgressBuffer(), {
+  intervalMs: workerData?.progressIntervalMs ?? 100,
+});
+
+// family -> last incumbent values, in LRU order
+const warm = new Map();
+const warmSize = workerData?.familyCacheSize ?? 64;
+
+function remember(family, values) {
+  warm.delete(family);
+  warm.set(family, values.slice());
+  if (warm.size > warmSize) {
+    warm.delete(warm.keys().next().value);
+  }
+}
+
+// Base model of the LNS run loaded in the solver, with its original bounds
+let lnsBase = null;
+
+async function solveNeighbourhood(model, { key, fixVars, fixValues, incumbent, ...options }) {
+  if (!lnsBase || lnsBase.key !== key) {
+    lnsBase = null;
+    if (!solver.loadModel(model)) {
+      throw new Error('Failed to load the LNS base model');
+    }
+    const base = readModel(model);
+    lnsBase = { key, lb: base.lb.slice(), ub: base.ub.slice(), nvars: base.nvars, maximize: base.maximize };
+  }
+  const handles = Int32Array.from(fixVars, (j) => j + 1);
+  solver.setVarBounds(handles, fixValues, fixValues);
+  try {
+    if (incumbent) {
+      solver.addSolutionValues(incumbent);
+    }
+    // Cutoffs posted through the mailbox must not outlive this iteration
+    const result = await solver.solveCurrentModel({
+      ...options,
+      cutoff: lnsBase.maximize ? -1e20 : 1e20,
+      extractVariables: false,
+    });
+    result.variables = undefined;
+    result.values = solver.getVarValues(lnsBase.nvars);
+    return result;
+  } finally {
+    solver.setVarBounds(handles, Float64Array.from(fixVars, (j) => lnsBase.lb[j]), Float64Array.from(fixVars, (j) => lnsBase.ub[j]));
+  }
+}
+
+// Job currently solving, for incumbent reports
+let current = null;
+solver.onIncumbent((objective) => {
+  if (current && current.shareCutoffs) {
+    parentPort.postMessage({ type: 'incumbent', id: current.id, objective });
+  }
+});
+
+parentPort.on('message', async ({ id, op, model, format, family, mailbox, shareCutoffs, options }) => {
+  if (op === 'components') {
+    const components = solver.modelComponents(model);
+    if (components) {
+      parentPort.postMessage({ id, ok: true, result: components });
+    } else {
+      parentPort.postMessage({ id, ok: false, error: 'malformed model blob' });
+    }
+    return;
+  }
+
+  if (op === 'benders') {
+    try {
+      const { subproblems, ...rest } = options;
+      const result = await solver.solveBenders(model, subproblems, rest);
+      parentPort.postMessage({ id, ok: true, result }, result.values ? [result.values.buffer] : []);
+    } catch (error) {
+      parentPort.postMessage({ id, ok: false, error: error.message });
+    }
+    return;
+  }
+
+  current = { id, shareCutoffs };
+  if (mailbox) {
+    solver.attachMailbox(mailbox);
+  }
+  try {
+    let result;
+    if (op === 'lns') {
+      result = await solveNeighbourhood(model, options);
+    } else if (typeof model === 'string') {
+      lnsBase = null;
+      result = await solver.solve(model, { ...options, format });
+    } else {
+      lnsBase = null;
+      const start = family != null ? warm.get(family) : undefined;
+      const nvars = new Int32Array(model instanceof Uint8Array ? model.buffer : model, model.byteOffset || 0, 4)[3];
+      result = await solver.solveModel(model, {
+        ...options,
+        extractVariables: false,
+        initialValues: start && start.length === nvars ? start : undefined,
+      });
+      // By-index values are enough for blob models; skip the name map
+      result.variables = undefined;
+      result.warmStart = start !== undefined;
+      if (family != null && result.values && result.values.length === nvars) {
+        remember(family, result.values);
+      }
+    }
+
+    const transfer = result.values ? [result.values.buffer] : [];
+    if (result.checkpoint) {
+      transfer.push(result.checkpoint.buffer);
+    }
+    if (result.cuts) {
+      transfer.push(result.cuts.buffer);
+    }
+    parentPort.postMessage({ id, ok: true, result }, transfer);
+  } catch (error) {
+    parentPort.postMessage({ id, ok: false, error: error.message });
+  } finally {
+    current = null;
+    if (mailbox) {
+      solver.detachMailbox();
+    }
+  }
+});
+
+parentPort.postMessage({ type: 'ready', progress });
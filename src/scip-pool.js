@@ -0,0 +1,884 @@
+/**
+ * SCIP.js solver pool (Node.js)
+ *
+ * A fixed set of worker_threads, each owning one SCIPApi instance, fed from a
+ * bounded FIFO queue. Admission control rejects work once the queue is full
+ * instead of letting latency grow without bound, and every job carries a
+ * deadline: queue time counts against it, the remainder becomes SCIP's time
+ * limit, and a worker that overruns it by more than the grace period is
+ * terminated and replaced.
+ *
+ * Jobs of the same model family (a caller key, or a hash of the model's
+ * structure) are routed by consistent hashing to the same worker, which keeps
+ * the family's last incumbent as a start solution. A job waits for its home
+ * worker for at most spillAfterMs, then spills to the next idle worker along
+ * the ring.
+ *
+ * Every job gets a shared mailbox: postCutoff() tightens the objective limit
+ * of the running (or still queued) jobs of a group, and with shareCutoffs a
+ * new incumbent in one job is posted to the rest of its group at once.
+ *
+ * Large blobs are copied once into a SharedArrayBuffer and posted by
+ * reference, so submitting one model to many workers does not clone it per job.
+ *
+ * solveComponents() splits a blob into the connected components of its
+ * constraint matrix, solves them on separate workers at once and merges the
+ * results back into the original variable order.
+ */
+
+import { Worker } from 'worker_threads';
+import { availableParallelism, cpus } from 'os';
+import { shareModel, readModel, extractSubmodel } from './scip-model-builder.js';
+import { readProgress, createMailbox, postToMailbox } from './scip-api-wrapper.js';
+
+/**
+ * Error codes of rejected jobs (error.code)
+ */
+export const PoolError = {
+  QUEUE_FULL: 'QUEUE_FULL',
+  DEADLINE: 'DEADLINE',
+  BUDGET_EXCEEDED: 'BUDGET_EXCEEDED',
+  CLOSED: 'CLOSED',
+  WORKER: 'WORKER',
+  INVALID_MODEL: 'INVALID_MODEL',
+};
+
+function poolError(code, message) {
+  const error = new Error(message);
+  error.code = code;
+  return error;
+}
+
+// 32-bit FNV-1a
+function fnv1a(bytes, hash = 0x811c9dc5) {
+  for (let i = 0; i < bytes.length; i += 1) {
+    hash ^= bytes[i];
+    hash = Math.imul(hash, 0x01000193);
+  }
+  return hash >>> 0;
+}
+
+// FNV-1a with the murmur3 finalizer, so similar short keys spread over the ring
+function hashString(text) {
+  let hash = fnv1a(new TextEncoder().encode(text));
+  hash = Math.imul(hash ^ (hash >>> 16), 0x85ebca6b);
+  hash = Math.imul(hash ^ (hash >>> 13), 0xc2b2ae35);
+  return (hash ^ (hash >>> 16)) >>> 0;
+}
+
+const BLOB_MAGIC = 0x424a4353; // "SCJB", see scip-model-builder.js
+const BLOB_VERSION = 1;
+
+// Why a binary payload is not a model blob (null if it is one): checked before
+// the header sizes any hashing or mailbox allocation
+function blobError(bytes) {
+  if (bytes.byteLength < 64) {
+    return 'model blob is shorter than its header';
+  }
+  const header = new DataView(bytes.buffer, bytes.byteOffset, 64);
+  const field = (i) => header.getInt32(4 * i, true);
+  if (field(0) !== BLOB_MAGIC || field(1) !== BLOB_VERSION) {
+    return 'not a SCIP.js model blob';
+  }
+  const [nvars, nrows, nnz, nameBytes] = [field(3), field(4), field(5), field(6)];
+  if (nvars < 0 || nrows < 0 || nnz < 0 || nameBytes < 0) {
+    return 'model blob has negative section sizes';
+  }
+  const size = 64 + 8 * (3 * nvars + 2 * nrows + nnz) + 4 * (nrows + 1 + nnz) + nvars + nrows + nameBytes;
+  if (size > bytes.byteLength) {
+    return `model blob header needs ${size} bytes, got ${bytes.byteLength}`;
+  }
+  return null;
+}
+
+/**
+ * Family key of a model: for ModelBuilder blobs a hash of the sparsity pattern,
+ * variable types and row flags (so re-solves with new data share a family),
+ * for problem text a hash of the text.
+ */
+export function modelFamilyKey(model) {
+  if (typeof model === 'string') {
+    return `t${hashString(model).toString(16)}`;
+  }
+  const bytes = model instanceof Uint8Array ? model : new Uint8Array(model);
+  const problem = blobError(bytes);
+  if (problem) {
+    throw poolError(PoolError.INVALID_MODEL, problem);
+  }
+  const header = new DataView(bytes.buffer, bytes.byteOffset, 64);
+  const [nvars, nrows, nnz] = [3, 4, 5].map((i) => header.getInt32(4 * i, true));
+  const structure = 64 + 8 * (3 * nvars + 2 * nrows + nnz);
+  const length = 4 * (nrows + 1 + nnz) + nvars + nrows;
+  let hash = fnv1a(bytes.subarray(8, 24));
+  hash = fnv1a(bytes.subarray(structure, structure + length), hash);
+  return `m${hash.toString(16)}`;
+}
+
+// Optimal value of a variable that appears in no row: its best bound by the
+// objective sense (rounded inward for integers), infinite if unbounded
+function bestBoundValue(src, j) {
+  const huge = 1e19;
+  const obj = src.maximize ? -src.obj[j] : src.obj[j];
+  const integral = src.vartype[j] !== 3;
+  const lb = integral ? Math.ceil(src.lb[j] - 1e-9) : src.lb[j];
+  const ub = integral ? Math.floor(src.ub[j] + 1e-9) : src.ub[j];
+  if (obj > 0) {
+    return lb <= -huge ? -Infinity : lb;
+  }
+  if (obj < 0) {
+    return ub >= huge ? Infinity : ub;
+  }
+  // Zero cost: any feasible value, closest to 0
+  return Math.min(Math.max(0, lb > -huge ? lb : -Infinity), ub < huge ? ub : Infinity);
+}
+
+/**
+ * Consistent-hash ring over worker slots with virtual nodes
+ */
+export class HashRing {
+  constructor(slots, vnodes = 64) {
+    const points = [];
+    for (let slot = 0; slot < slots; slot += 1) {
+      for (let v = 0; v < vnodes; v += 1) {
+        points.push({ hash: hashString(`${slot}#${v}`), slot });
+      }
+    }
+    points.sort((a, b) => a.hash - b.hash);
+    this._hashes = Uint32Array.from(points, (p) => p.hash);
+    this._slots = Int32Array.from(points, (p) => p.slot);
+    this.slots = slots;
+  }
+
+  /**
+   * Distinct worker slots in ring order starting at the key's position
+   */
+  preference(key) {
+    const hash = hashString(key);
+    let lo = 0;
+    let hi = this._hashes.length;
+    while (lo < hi) {
+      const mid = (lo + hi) >>> 1;
+      if (this._hashes[mid] < hash) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    const order = [];
+    const seen = new Uint8Array(this.slots);
+    for (let i = 0; i < this._slots.length && order.length < this.slots; i += 1) {
+      const slot = this._slots[(lo + i) % this._slots.length];
+      if (!seen[slot]) {
+        seen[slot] = 1;
+        order.push(slot);
+      }
+    }
+    return order;
+  }
+}
+
+/**
+ * Fixed-size window of recent latencies with percentile queries
+ */
+export class LatencyWindow {
+  constructor(size = 2048) {
+    this._samples = new Float64Array(size);
+    this._count = 0;
+  }
+
+  add(ms) {
+    this._samples[this._count % this._samples.length] = ms;
+    this._count += 1;
+  }
+
+  get count() {
+    return this._count;
+  }
+
+  percentile(p) {
+    const n = Math.min(this._count, this._samples.length);
+    if (n === 0) {
+      return 0;
+    }
+    const sorted = this._samples.slice(0, n).sort();
+    return sorted[Math.min(n - 1, Math.floor((p / 100) * n))];
+  }
+
+  summary() {
+    return {
+      count: this._count,
+      p50: this.percentile(50),
+      p90: this.percentile(90),
+      p99: this.percentile(99),
+      max: this.percentile(100),
+    };
+  }
+}
+
+export class SolverPool {
+  /**
+   * @param {Object} options
+   * @param {number} options.size - Number of workers (default: CPU count)
+   * @param {number} options.maxQueue - Jobs waiting for a worker before QUEUE_FULL
+   * @param {number} options.defaultBudgetMs - Deadline of jobs that do not set one
+   * @param {number} options.graceMs - Overrun tolerated before a worker is killed
+   * @param {Object} options.initOptions - Passed to SCIPApi.init() in each worker
+   * @param {URL|string} options.workerUrl - Worker entry (default scip-pool-worker.js)
+   * @param {string} options.routing - 'sticky' (consistent hashing by family) or 'fifo'
+   * @param {number} options.spillAfterMs - How long a job waits for its busy home worker
+   * @param {number} options.familyCacheSize - Families each worker keeps warm
+   * @param {number} options.maxFamilies - Families tracked in the per-family metrics
+   * @param {number} options.shareThreshold - Blobs of at least this many bytes are shared, not cloned
+   * @param {number} options.progressIntervalMs - Minimum interval of mid-solve progress updates
+   * @param {boolean} options.shareCutoffs - Post each job's incumbents to the other jobs of its group
+   */
+  constructor({
+    size = typeof availableParallelism === 'function' ? availableParallelism() : cpus().length,
+    maxQueue = 64,
+    defaultBudgetMs = 30000,
+    graceMs = 2000,
+    initOptions = {},
+    workerUrl = new URL('./scip-pool-worker.js', import.meta.url),
+    routing = 'sticky',
+    spillAfterMs = 50,
+    familyCacheSize = 64,
+    maxFamilies = 1024,
+    shareThreshold = 1 << 20,
+    progressIntervalMs = 100,
+    shareCutoffs = false,
+  } = {}) {
+    this.size = Math.max(1, size);
+    this.maxQueue = maxQueue;
+    this.defaultBudgetMs = defaultBudgetMs;
+    this.graceMs = graceMs;
+    this._initOptions = initOptions;
+    this._workerUrl = workerUrl;
+    this.routing = routing;
+    this.spillAfterMs = spillAfterMs;
+    this.familyCacheSize = familyCacheSize;
+    this.maxFamilies = maxFamilies;
+    this._ring = new HashRing(this.size);
+    this._families = new Map();
+    this._spillTimer = null;
+    this.shareThreshold = shareThreshold;
+    // source blob -> its SharedArrayBuffer copy, so repeat submits share one copy
+    this._shared = new WeakMap();
+    this.progressIntervalMs = progressIntervalMs;
+    this.shareCutoffs = shareCutoffs;
+
+    this._workers = [];
+    this._idle = [];
+    this._queue = [];
+    this._nextId = 0;
+    this._closed = false;
+
+    this.latency = new LatencyWindow();
+    this.queueWait = new LatencyWindow();
+    this.counters = {
+      submitted: 0,
+      completed: 0,
+      failed: 0,
+      rejectedQueueFull: 0,
+      rejectedInvalid: 0,
+      expiredInQueue: 0,
+      budgetExceeded: 0,
+      workerRestarts: 0,
+      affinityHits: 0,
+      affinityMisses: 0,
+      spills: 0,
+      cutoffsShared: 0,
+    };
+
+    for (let i = 0; i < this.size; i += 1) {
+      this._spawn(i);
+    }
+  }
+
+  _spawn(slot) {
+    const worker = new Worker(this._workerUrl, {
+      workerData: {
+        initOptions: this._initOptions,
+        familyCacheSize: this.familyCacheSize,
+        progressIntervalMs: this.progressIntervalMs,
+      },
+    });
+    // families: what this worker has warm, in LRU order (mirrors the worker's cache)
+    const entry = { slot, worker, job: null, timer: null, ready: false, families: new Map(), progress: null };
+    this._workers[slot] = entry;
+
+    worker.on('message', (message) => {
+      if (message.type === 'ready') {
+        entry.ready = true;
+        entry.progress = message.progress || null;
+        this._release(entry);
+        return;
+      }
+      if (message.type === 'incumbent') {
+        this._shareIncumbent(entry, message);
+        return;
+      }
+      this._finish(entry, message);
+    });
+
+    worker.on('error', (error) => {
+      this._fail(entry, poolError(PoolError.WORKER, error.message));
+    });
+
+    worker.on('exit', () => {
+      if (this._workers[slot] === entry && !this._closed) {
+        this._fail(entry, poolError(PoolError.WORKER, 'worker exited'));
+      }
+    });
+  }
+
+  _restart(entry) {
+    this.counters.workerRestarts += 1;
+    this._workers[entry.slot] = null;
+    this._idle = this._idle.filter((e) => e !== entry);
+    entry.worker.removeAllListeners('exit');
+    entry.worker.terminate();
+    if (!this._closed) {
+      this._spawn(entry.slot);
+    }
+  }
+
+  _fail(entry, error) {
+    const job = entry.job;
+    clearTimeout(entry.timer);
+    entry.job = null;
+    if (job) {
+      this.counters.failed += 1;
+      job.reject(error);
+    }
+    this._restart(entry);
+  }
+
+  _finish(entry, message) {
+    const job = entry.job;
+    clearTimeout(entry.timer);
+    entry.job = null;
+    if (job && message.id === job.id) {
+      const elapsed = performance.now() - job.submitted;
+      this.latency.add(elapsed);
+      if (job.familyStats) {
+        job.familyStats.latency.add(elapsed);
+      }
+      if (message.ok) {
+        this.counters.completed += 1;
+        message.result.timing = { queueMs: job.started - job.submitted, totalMs: elapsed };
+        message.result.routing = { family: job.family, worker: entry.slot, hit: job.hit, spilled: job.spilled };
+        job.resolve(message.result);
+      } else {
+        this.counters.failed += 1;
+        job.reject(poolError(PoolError.WORKER, message.error));
+      }
+    }
+    this._release(entry);
+  }
+
+  _release(entry) {
+    if (this._workers[entry.slot] !== entry) {
+      return;
+    }
+    this._idle.push(entry);
+    this._dispatch();
+  }
+
+  /**
+   * Next (job, worker) pair: the oldest job whose home worker is idle, else the
+   * oldest job that has waited spillAfterMs, on the first idle worker in its
+   * ring order. FIFO routing takes the oldest job for any idle worker.
+   */
+  _pick(now) {
+    const idleBySlot = new Map(this._idle.map((entry) => [entry.slot, entry]));
+
+    for (let q = 0; q < this._queue.length; q += 1) {
+      const job = this._queue[q];
+      if (job.pref === null) {
+        return { q, entry: this._idle[0], spilled: false };
+      }
+      const home = idleBySlot.get(job.pref[0]);
+      if (home) {
+        return { q, entry: home, spilled: false };
+      }
+    }
+
+    for (let q = 0; q < this._queue.length; q += 1) {
+      const job = this._queue[q];
+      if (now - job.submitted >= this.spillAfterMs || now >= job.deadline) {
+        for (const slot of job.pref) {
+          const entry = idleBySlot.get(slot);
+          if (entry) {
+            return { q, entry, spilled: true };
+          }
+        }
+      }
+    }
+    return null;
+  }
+
+  _dispatch() {
+    clearTimeout(this._spillTimer);
+    this._spillTimer = null;
+
+    while (this._idle.length > 0 && this._queue.length > 0) {
+      const now = performance.now();
+      const pick = this._pick(now);
+      if (pick === null) {
+        // Jobs wait for busy home workers; re-check once the oldest may spill
+        const wait = this.spillAfterMs - (now - this._queue[0].submitted);
+        this._spillTimer = setTimeout(() => this._dispatch(), Math.max(1, wait));
+        return;
+      }
+
+      const [job] = this._queue.splice(pick.q, 1);
+      const entry = pick.entry;
+      this._idle.splice(this._idle.indexOf(entry), 1);
+      const remaining = job.deadline - now;
+      this.queueWait.add(now - job.submitted);
+
+      if (remaining <= 0) {
+        this.counters.expiredInQueue += 1;
+        this._idle.push(entry);
+        job.reject(poolError(PoolError.DEADLINE, 'time budget spent waiting in queue'));
+        continue;
+      }
+
+      if (job.family !== null) {
+        this._route(job, entry, pick.spilled);
+      }
+
+      entry.job = job;
+      job.started = now;
+
+      const options = { ...job.options, timeLimit: Math.min(job.options.timeLimit ?? Infinity, remaining / 1000) };
+      const transfer = job.model instanceof ArrayBuffer && job.transfer ? [job.model] : [];
+      entry.worker.postMessage({
+        id: job.id,
+        op: job.op,
+        model: job.model,
+        format: job.format,
+        family: job.family,
+        mailbox: job.mailbox,
+        shareCutoffs: this.shareCutoffs && job.group !== null,
+        options,
+      }, transfer);
+
+      // SCIP honours the time limit between nodes; a stuck solve is cut off here
+      entry.timer = setTimeout(() => {
+        if (entry.job === job) {
+          this.counters.budgetExceeded += 1;
+          this._fail(entry, poolError(PoolError.BUDGET_EXCEEDED, 'time budget exceeded'));
+        }
+      }, remaining + this.graceMs);
+    }
+  }
+
+  // Affinity bookkeeping for a job about to run on `entry`
+  _route(job, entry, spilled) {
+    job.hit = entry.families.has(job.family);
+    job.spilled = spilled;
+    this.counters[job.hit ? 'affinityHits' : 'affinityMisses'] += 1;
+    if (spilled) {
+      this.counters.spills += 1;
+    }
+
+    entry.families.delete(job.family);
+    entry.families.set(job.family, true);
+    if (entry.families.size > this.familyCacheSize) {
+      entry.families.delete(entry.families.keys().next().value);
+    }
+
+    const stats = this._familyStats(job.family);
+    stats.jobs += 1;
+    stats.hits += job.hit ? 1 : 0;
+    stats.spills += spilled ? 1 : 0;
+    job.familyStats = stats;
+  }
+
+  _familyStats(family) {
+    let stats = this._families.get(family);
+    if (stats) {
+      this._families.delete(family);
+    } else {
+      stats = { jobs: 0, hits: 0, spills: 0, latency: new LatencyWindow(256) };
+      if (this._families.size >= this.maxFamilies) {
+        this._families.delete(this._families.keys().next().value);
+      }
+    }
+    this._families.set(family, stats);
+    return stats;
+  }
+
+  // Jobs of a group that are queued or running
+  _groupJobs(group) {
+    if (group === null || group === undefined) {
+      return [];
+    }
+    const running = this._workers.filter((entry) => entry && entry.job).map((entry) => entry.job);
+    return running.concat(this._queue).filter((job) => job.group === group);
+  }
+
+  _shareIncumbent(entry, { id, objective }) {
+    const job = entry.job;
+    if (!job || job.id !== id || job.group === null) {
+      return;
+    }
+    for (const other of this._groupJobs(job.group)) {
+      if (other !== job) {
+        postToMailbox(other.mailbox, { objlimit: objective });
+      }
+    }
+    this.counters.cutoffsShared += 1;
+  }
+
+  /**
+   * Tighten the objective limit of every queued or running job of a group,
+   * optionally with a full solution (variable order) to inject. Takes effect
+   * at the next node of a running solve.
+   * @param {string} group - Group given to submit()
+   * @param {Object} message
+   * @param {number} message.objlimit - Objective limit in the original space
+   * @param {ArrayLike<number>} message.values - Solution to try in the jobs
+   * @returns {number} Jobs notified
+   */
+  postCutoff(group, { objlimit, values } = {}) {
+    const jobs = this._groupJobs(group);
+    for (const job of jobs) {
+      const capacity = new Int32Array(job.mailbox, 0, 4)[1];
+      postToMailbox(job.mailbox, { objlimit, values: values && values.length === capacity ? values : undefined });
+    }
+    return jobs.length;
+  }
+
+  // What gets posted: text and shared blobs as-is, large blobs via a cached
+  // SharedArrayBuffer copy, small views as a transferable ArrayBuffer copy
+  _payload(model) {
+    if (typeof model === 'string' || model instanceof SharedArrayBuffer) {
+      return model;
+    }
+    if (model instanceof Uint8Array && model.buffer instanceof SharedArrayBuffer) {
+      return shareModel(model);
+    }
+    if (model.byteLength >= this.shareThreshold) {
+      let shared = this._shared.get(model);
+      if (!shared) {
+        shared = shareModel(model);
+        this._shared.set(model, shared);
+      }
+      return shared;
+    }
+    return model instanceof Uint8Array
+      ? model.buffer.slice(model.byteOffset, model.byteOffset + model.byteLength)
+      : model;
+  }
+
+  /**
+   * Queue a solve
+   * @param {ArrayBuffer|SharedArrayBuffer|Uint8Array|string} model - Model blob (ModelBuilder.compile()) or problem text
+   * @param {Object} options
+   * @param {string} options.format - Format of problem text ('lp', 'mps', 'zpl', 'cip')
+   * @param {number} options.budgetMs - Deadline for queueing plus solving
+   * @param {boolean} options.transfer - Transfer the ArrayBuffer to the worker instead of copying
+   * @param {string} options.family - Routing key; defaults to modelFamilyKey(model) with sticky routing
+   * @param {string} options.group - Jobs solving the same model (racing, restarts) for postCutoff()/shareCutoffs
+   * @param {Object} options.solveOptions - Passed to solveModel()/solve() in the worker
+   * @returns {Promise<Object>} Solve result; rejects with error.code from PoolError
+   */
+  submit(model, { format = 'lp', budgetMs = this.defaultBudgetMs, transfer = false, solveOptions = {}, family, group = null, op = 'solve' } = {}) {
+    if (this._closed) {
+      return Promise.reject(poolError(PoolError.CLOSED, 'pool is closed'));
+    }
+    this.counters.submitted += 1;
+    if (this._queue.length >= this.maxQueue) {
+      this.counters.rejectedQueueFull += 1;
+      return Promise.reject(poolError(PoolError.QUEUE_FULL, 'solve queue is full'));
+    }
+    if (typeof model !== 'string') {
+      const problem = blobError(model instanceof Uint8Array ? model : new Uint8Array(model));
+      if (problem) {
+        this.counters.rejectedInvalid += 1;
+        return Promise.reject(poolError(PoolError.INVALID_MODEL, problem));
+      }
+    }
+
+    const payload = this._payload(model);
+
+    const key = this.routing === 'sticky' && op === 'solve' ? String(family ?? modelFamilyKey(payload)) : null;
+    // Blobs get room for a full solution (bounded by the validated blob size), problem text only for cutoffs
+    const nvars = typeof payload === 'string' || op !== 'solve' ? 0 : new Int32Array(payload, 0, 4)[3];
+
+    return new Promise((resolve, reject) => {
+      const submitted = performance.now();
+      this._queue.push({
+        id: ++this._nextId,
+        family: key,
+        pref: key === null ? null : this._ring.preference(key),
+        hit: false,
+        spilled: false,
+        familyStats: null,
+        group,
+        op,
+        mailbox: createMailbox(op === 'solve' ? nvars : 0),
+        model: payload,
+        format,
+        options: solveOptions,
+        transfer: transfer || payload !== model,
+        submitted,
+        started: 0,
+        deadline: submitted + budgetMs,
+        resolve,
+        reject,
+      });
+      this._dispatch();
+    });
+  }
+
+  /**
+   * Solve a blob by its connected components in parallel. Components are found
+   * on a worker (union-find over the CSR), packed largest first into at most
+   * maxParts submodels and solved at once; variables in no row are set to
+   * their best bound here. The merged result follows the original variable
+   * order; the objective is the sum over the parts.
+   * @param {ModelBuilder|ArrayBuffer|SharedArrayBuffer|Uint8Array} model
+   * @param {Object} options
+   * @param {number} options.budgetMs - Deadline of the whole solve
+   * @param {Object} options.solveOptions - Passed to every part's solve
+   * @param {number} options.maxParts - Upper bound on jobs (default: pool size)
+   */
+  async solveComponents(model, { budgetMs = this.defaultBudgetMs, solveOptions = {}, maxParts = this.size } = {}) {
+    const started = performance.now();
+    const blob = typeof model.compile === 'function' ? model.compile() : model;
+    const src = readModel(blob);
+    const detected = await this.submit(blob, { op: 'components', budgetMs });
+    const { count, varLabels, rowLabels } = detected;
+    const remaining = () => Math.max(1, budgetMs - (performance.now() - started));
+
+    if (count <= 1 && varLabels.every((label) => label >= 0)) {
+      const result = await this.submit(blob, { budgetMs: remaining(), solveOptions });
+      result.components = { count, parts: 1, isolatedVars: 0 };
+      return result;
+    }
+
+    // Component sizes, then largest-first packing into the least loaded part
+    const sizes = new Float64Array(count);
+    for (let j = 0; j < src.nvars; j += 1) {
+      if (varLabels[j] >= 0) {
+        sizes[varLabels[j]] += 1;
+      }
+    }
+    for (let i = 0; i < src.nrows; i += 1) {
+      if (rowLabels[i] >= 0) {
+        sizes[rowLabels[i]] += src.rowStart[i + 1] - src.rowStart[i];
+      }
+    }
+    const nparts = Math.max(1, Math.min(maxParts, count));
+    const partOf = new Int32Array(count);
+    const load = new Float64Array(nparts);
+    Array.from({ length: count }, (_, c) => c)
+      .sort((a, b) => sizes[b] - sizes[a])
+      .forEach((c) => {
+        let best = 0;
+        for (let p = 1; p < nparts; p += 1) {
+          if (load[p] < load[best]) {
+            best = p;
+          }
+        }
+        partOf[c] = best;
+        load[best] += sizes[c];
+      });
+
+    const partVars = Array.from({ length: nparts }, () => []);
+    const partRows = Array.from({ length: nparts }, () => []);
+    const isolated = [];
+    for (let j = 0; j < src.nvars; j += 1) {
+      if (varLabels[j] >= 0) {
+        partVars[partOf[varLabels[j]]].push(j);
+      } else {
+        isolated.push(j);
+      }
+    }
+    let emptyRowsFeasible = true;
+    for (let i = 0; i < src.nrows; i += 1) {
+      if (rowLabels[i] >= 0) {
+        partRows[partOf[rowLabels[i]]].push(i);
+      } else if (src.lhs[i] > 1e-9 || src.rhs[i] < -1e-9) {
+        emptyRowsFeasible = false;
+      }
+    }
+
+    // Part p of a model family keeps its own family, so re-solves find it warm
+    const family = modelFamilyKey(blob);
+    const parts = partVars.map((vars, p) => ({ vars: Int32Array.from(vars), rows: Int32Array.from(partRows[p]) }));
+    const results = await Promise.all(parts.map((part, p) => this.submit(extractSubmodel(src, part.vars, part.rows), {
+      budgetMs: remaining(),
+      solveOptions,
+      family: `${family}/${p}`,
+    })));
+
+    const values = new Float64Array(src.nvars);
+    let objective = 0;
+    let dualBound = 0;
+    let unbounded = false;
+    for (const j of isolated) {
+      const value = bestBoundValue(src, j);
+      if (!Number.isFinite(value)) {
+        unbounded = true;
+        continue;
+      }
+      values[j] = value;
+      objective += src.obj[j] * value;
+      dualBound += src.obj[j] * value;
+    }
+
+    const statuses = results.map((r) => r.status);
+    let status = 'optimal';
+    if (!emptyRowsFeasible || statuses.includes('infeasible')) {
+      status = 'infeasible';
+    } else if (unbounded || statuses.includes('unbounded')) {
+      status = 'unbounded';
+    } else if (statuses.includes('error')) {
+      status = 'error';
+    } else if (statuses.includes('timelimit')) {
+      status = 'timelimit';
+    } else if (statuses.some((s) => s !== 'optimal')) {
+      status = 'unknown';
+    }
+
+    let nodes = 0;
+    let solvingTime = 0;
+    let complete = true;
+    results.forEach((result, p) => {
+      const part = parts[p];
+      if (result.values && result.values.length === part.vars.length) {
+        for (let k = 0; k < part.vars.length; k += 1) {
+          values[part.vars[k]] = result.values[k];
+        }
+      } else {
+        complete = false;
+      }
+      objective += result.objective;
+      dualBound += result.statistics ? result.statistics.dualBound : NaN;
+      nodes += result.statistics ? result.statistics.nodes : 0;
+      solvingTime = Math.max(solvingTime, result.statistics ? result.statistics.solvingTime : 0);
+    });
+
+    const gap = Math.abs(objective - dualBound) / Math.max(Math.abs(objective), 1e-9);
+    return {
+      status,
+      objective: complete ? objective : NaN,
+      values: complete ? values : new Float64Array(0),
+      statistics: {
+        solvingTime,
+        nodes,
+        gap: status === 'optimal' ? 0 : gap,
+        dualBound,
+        primalBound: complete ? objective : NaN,
+      },
+      components: {
+        count,
+        parts: nparts,
+        isolatedVars: isolated.length,
+        results: results.map((result, p) => ({
+          vars: parts[p].vars.length,
+          rows: parts[p].rows.length,
+          status: result.status,
+          objective: result.objective,
+          worker: result.routing ? result.routing.worker : null,
+          solveMs: result.timing ? result.timing.totalMs : null,
+        })),
+      },
+      timing: { totalMs: performance.now() - started, detectMs: detected.timing ? detected.timing.totalMs : 0 },
+    };
+  }
+
+  /**
+   * Solve a two-stage model with SCIP's default Benders decomposition on one
+   * worker (see SCIPApi.solveBenders); several decompositions run on separate
+   * workers at once. Large subproblem blobs are shared like model blobs.
+   * @param {ModelBuilder|ArrayBuffer|Uint8Array} master
+   * @param {Array<ModelBuilder|ArrayBuffer|Uint8Array>} subproblems
+   * @param {Object} options
+   * @param {number} options.budgetMs - Deadline for queueing plus solving
+   * @param {Object} options.solveOptions - Passed to solveBenders (timeLimit)
+   */
+  solveBenders(master, subproblems, { budgetMs = this.defaultBudgetMs, solveOptions = {} } = {}) {
+    const compile = (model) => this._payload(typeof model.compile === 'function' ? model.compile() : model);
+    return this.submit(compile(master), {
+      op: 'benders',
+      budgetMs,
+      solveOptions: { ...solveOptions, subproblems: subproblems.map(compile) },
+    });
+  }
+
+  /**
+   * Per-family routing and latency metrics, most jobs first
+   * @param {number} limit - Number of families to report
+   */
+  familyStats(limit = 20) {
+    return [...this._families.entries()]
+      .sort((a, b) => b[1].jobs - a[1].jobs)
+      .slice(0, limit)
+      .map(([family, stats]) => ({
+        family,
+        jobs: stats.jobs,
+        hitRatio: stats.jobs > 0 ? stats.hits / stats.jobs : 0,
+        spills: stats.spills,
+        latencyMs: stats.latency.summary(),
+      }));
+  }
+
+  /**
+   * Live state of every worker's current solve, read from the workers' shared
+   * progress blocks (no messages, safe to poll at UI rates)
+   */
+  progress() {
+    return this._workers.map((entry, slot) => {
+      const job = entry && entry.job;
+      return {
+        worker: slot,
+        busy: Boolean(job),
+        jobId: job ? job.id : null,
+        family: job ? job.family : null,
+        runningMs: job ? performance.now() - job.started : 0,
+        solver: entry && entry.progress ? readProgress(entry.progress) : null,
+      };
+    });
+  }
+
+  /**
+   * Current load and latency percentiles (ms)
+   */
+  stats() {
+    const routed = this.counters.affinityHits + this.counters.affinityMisses;
+    return {
+      workers: this.size,
+      busy: this._workers.filter((e) => e && e.job).length,
+      queued: this._queue.length,
+      maxQueue: this.maxQueue,
+      counters: { ...this.counters },
+      latencyMs: this.latency.summary(),
+      queueWaitMs: this.queueWait.summary(),
+      routing: this.routing,
+      hitRatio: routed > 0 ? this.counters.affinityHits / routed : 0,
+      families: this.familyStats(),
+    };
+  }
+
+  async close() {
+    this._closed = true;
+    clearTimeout(this._spillTimer);
+    for (const job of this._queue.splice(0)) {
+      job.reject(poolError(PoolError.CLOSED, 'pool is closed'));
+    }
+    await Promise.all(this._workers.filter(Boolean).map((entry) => {
+      clearTimeout(entry.timer);
+      if (entry.job) {
+        entry.job.reject(poolError(PoolError.CLOSED, 'pool is closed'));
+      }
+      return entry.worker.terminate();
+    }));
+    this._workers = [];
+    this._idle = [];
+  }
+}
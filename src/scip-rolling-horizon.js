@@ -0,0 +1,231 @@
+/**
+ * SCIP.js rolling-horizon decomposition
+ *
+ * Solves a time-indexed model window by window instead of monolithically.
+ * Every variable and row carries a period label; each window holds the next
+ * `window` periods, of which the first `step` are committed (fixed) before the
+ * window moves on, so consecutive windows overlap by `window - step` periods.
+ * Committed variables are folded into the row sides of later windows, and the
+ * overlap of the previous window seeds the next one as a partial start
+ * solution. Only one window is loaded into SCIP at a time, so the WASM heap is
+ * bounded by the window size rather than by the horizon.
+ *
+ * @example
+ * import { SCIPApi, solveRollingHorizon } from 'scip.js';
+ *
+ * const solver = new SCIPApi();
+ * await solver.init();
+ * const { status, objective, values, windows } = await solveRollingHorizon(solver, model, {
+ *   varPeriods,          // week of each variable
+ *   window: 8, step: 4,  // 8-week windows, 4 weeks committed per window
+ * });
+ */
+
+import { readModel, extractSubmodel } from './scip-model-builder.js';
+import { Status } from './scip-api-wrapper.js';
+
+const CONTINUOUS = 3;
+
+/**
+ * Row period: the latest period of its variables (a row is enforced once
+ * all of its variables are in a window)
+ */
+function defaultRowPeriods(model, varPeriods) {
+  const periods = new Float64Array(model.nrows);
+  for (let i = 0; i < model.nrows; i += 1) {
+    let latest = -Infinity;
+    for (let k = model.rowStart[i]; k < model.rowStart[i + 1]; k += 1) {
+      latest = Math.max(latest, varPeriods[model.colIdx[k]]);
+    }
+    periods[i] = latest;
+  }
+  return periods;
+}
+
+// Whether a row holds at the committed values (feasibility tolerance scaled by the side)
+function rowSatisfied(model, i, values) {
+  let activity = 0;
+  for (let k = model.rowStart[i]; k < model.rowStart[i + 1]; k += 1) {
+    activity += model.vals[k] * values[model.colIdx[k]];
+  }
+  const tol = (side) => 1e-6 * Math.max(1, Math.abs(side));
+  return activity >= model.lhs[i] - tol(model.lhs[i]) && activity <= model.rhs[i] + tol(model.rhs[i]);
+}
+
+/**
+ * Solve a time-indexed model by overlapping windows
+ * @param {SCIPApi} solver - Initialized solver; its current problem is replaced
+ * @param {ModelBuilder|ArrayBuffer|SharedArrayBuffer|Uint8Array} model
+ * @param {Object} options
+ * @param {ArrayLike<number>} options.varPeriods - Period label of each variable (any ordered numbers)
+ * @param {ArrayLike<number>} options.rowPeriods - Period label of each row (default: latest period of its variables)
+ * @param {number} options.window - Periods per window (default 4)
+ * @param {number} options.step - Periods committed per window (default: half the window)
+ * @param {number} options.windowTimeLimit - Seconds per window (default 60)
+ * @param {number} options.timeLimit - Seconds for the whole horizon
+ * @param {Object} options.settings - Settings profile for every window (see applySettings)
+ * @param {Function} options.onWindow - Called with each window's summary as it is committed
+ * @returns {Promise<Object>} objective and `values` of the stitched solution, per-window
+ *   summaries; status is optimal when every window was solved to optimality and no
+ *   row closed between windows (`violatedRows`) is violated, unknown otherwise
+ */
+export async function solveRollingHorizon(solver, model, {
+  varPeriods,
+  rowPeriods = null,
+  window = 4,
+  step = Math.max(1, Math.floor(window / 2)),
+  windowTimeLimit = 60,
+  timeLimit = Infinity,
+  settings = null,
+  onWindow = null,
+} = {}) {
+  const src = readModel(typeof model.compile === "function" ? model.compile() : model);
+  if (!varPeriods || varPeriods.length !== src.nvars) {
+    throw new Error(`varPeriods must label all ${src.nvars} variables`);
+  }
+  if (rowPeriods && rowPeriods.length !== src.nrows) {
+    throw new Error(`rowPeriods must label all ${src.nrows} rows`);
+  }
+  if (step < 1 || step > window) {
+    throw new Error("step must be between 1 and window");
+  }
+
+  // Period labels -> positions 0..P-1
+  const labels = Array.from(new Set(Array.from(varPeriods))).sort((a, b) => a - b);
+  const position = new Map(labels.map((label, p) => [label, p]));
+  const varPos = Int32Array.from(varPeriods, (label) => position.get(label));
+  const rowLabels = rowPeriods || defaultRowPeriods(src, varPeriods);
+  // Rows labelled after the last variable period belong to the last window
+  const rowPos = Int32Array.from(rowLabels, (label) => {
+    let p = 0;
+    while (p + 1 < labels.length && labels[p + 1] <= label) {
+      p += 1;
+    }
+    return p;
+  });
+
+  const fixed = new Float64Array(src.nvars).fill(NaN);
+  // Values of the previous window for variables not committed yet
+  const carried = new Float64Array(src.nvars).fill(NaN);
+  const rowDone = new Uint8Array(src.nrows);
+  const violatedRows = [];
+  const windows = [];
+  const started = performance.now();
+  let status = Status.OPTIMAL;
+
+  for (let first = 0; first < labels.length; first += step) {
+    const end = Math.min(first + window, labels.length);
+    const last = end === labels.length;
+    const commitEnd = last ? labels.length : first + step;
+
+    // Rows due by the end of the window that still have free variables; their
+    // free variables of later periods join the window without being committed
+    const inWindow = new Uint8Array(src.nvars);
+    const rows = [];
+    for (let i = 0; i < src.nrows; i += 1) {
+      if (rowDone[i] || rowPos[i] >= end) {
+        continue;
+      }
+      let open = false;
+      for (let k = src.rowStart[i]; k < src.rowStart[i + 1]; k += 1) {
+        const j = src.colIdx[k];
+        if (Number.isNaN(fixed[j])) {
+          inWindow[j] = 1;
+          open = true;
+        }
+      }
+      if (open) {
+        rows.push(i);
+      } else {
+        // Every variable was committed in earlier windows (rowPeriods later
+        // than its variables): no window enforced it, so check it now
+        rowDone[i] = 1;
+        if (!rowSatisfied(src, i, fixed)) {
+          violatedRows.push(i);
+        }
+      }
+    }
+    for (let j = 0; j < src.nvars; j += 1) {
+      if (varPos[j] < end && Number.isNaN(fixed[j])) {
+        inWindow[j] = 1;
+      }
+    }
+    const vars = [];
+    for (let j = 0; j < src.nvars; j += 1) {
+      if (inWindow[j]) {
+        vars.push(j);
+      }
+    }
+
+    const remaining = timeLimit - (performance.now() - started) / 1000;
+    if (remaining <= 0) {
+      status = Status.TIME_LIMIT;
+      break;
+    }
+    const sub = extractSubmodel(src, vars, rows, fixed);
+    const start = Float64Array.from(vars, (j) => carried[j]);
+    const result = await solver.solveModel(sub, {
+      timeLimit: Math.min(windowTimeLimit, remaining),
+      settings,
+      initialValues: start.some((v) => !Number.isNaN(v)) ? start : undefined,
+    });
+    const summary = {
+      periods: [labels[first], labels[end - 1]],
+      committed: [labels[first], labels[commitEnd - 1]],
+      vars: vars.length,
+      rows: rows.length,
+      status: result.status,
+      objective: result.objective,
+      seconds: result.statistics?.solvingTime ?? 0,
+    };
+    windows.push(summary);
+
+    if (!result.values || result.values.length !== vars.length) {
+      // No solution for this window: the horizon cannot be stitched
+      status = result.status === Status.INFEASIBLE ? Status.INFEASIBLE : result.status || Status.ERROR;
+      break;
+    }
+    if (result.status !== Status.OPTIMAL) {
+      status = Status.TIME_LIMIT;
+    }
+
+    for (let k = 0; k < vars.length; k += 1) {
+      const j = vars[k];
+      const value = src.vartype[j] === CONTINUOUS ? result.values[k] : Math.round(result.values[k]);
+      if (varPos[j] < commitEnd) {
+        fixed[j] = value;
+      } else {
+        carried[j] = value;
+      }
+    }
+    if (onWindow) {
+      onWindow(summary);
+    }
+    if (last) {
+      break;
+    }
+  }
+
+  const complete = !fixed.some(Number.isNaN);
+  let objective = 0;
+  for (let j = 0; j < src.nvars; j += 1) {
+    objective += src.obj[j] * fixed[j];
+  }
+  // A violated row makes the stitched solution infeasible for the full model,
+  // though the model itself may not be
+  if (violatedRows.length > 0 && (status === Status.OPTIMAL || status === Status.TIME_LIMIT)) {
+    status = Status.UNKNOWN;
+  }
+  return {
+    status: complete ? status : status === Status.OPTIMAL ? Status.UNKNOWN : status,
+    objective: complete ? objective : NaN,
+    values: fixed,
+    violatedRows,
+    windows,
+    statistics: {
+      solvingTime: (performance.now() - started) / 1000,
+      windows: windows.length,
+      periods: labels.length,
+    },
+  };
+}
@@ -0,0 +1,235 @@
+/**
+ * SCIP.js local solve server (Node.js)
+ *
+ * HTTP over TCP or a Unix socket, backed by a SolverPool of worker_threads.
+ * Fully offline; no dependencies beyond Node itself.
+ *
+ * Endpoints:
+ *   POST /solve     body: model blob (application/octet-stream, ModelBuilder.compile())
+ *                   or problem text (text/plain, ?format=lp|mps|zpl|cip)
+ *                   header x-scip-budget-ms: deadline for queueing plus solving
+ *                   header x-scip-family: routing key (default: hash of the model)
+ *                   header x-scip-group: jobs racing on one model, for /cutoff
+ *                   Accept: application/octet-stream returns values as raw float64
+ *   GET  /metrics   pool load, counters and p50/p99 latency
+ *   GET  /progress  live bounds, gap and node counts of the running solves
+ *   POST /cutoff    ?group=g&objlimit=v: tighten the objective limit of a group's solves
+ *   GET  /health
+ *
+ * Overload answers 429 (queue full) or 504 (budget spent) instead of queueing
+ * without bound. /metrics reports the warm-worker hit ratio and p50/p99 per
+ * model family.
+ *
+ * @example
+ * import { createSolveServer } from 'scip.js/server';
+ * const server = await createSolveServer({ port: 8787, workers: 4, maxQueue: 32 });
+ *
+ * // CLI
+ * node dist/scip-server.js --port 8787 --workers 4 --queue 32
+ * node dist/scip-server.js --socket /tmp/scip.sock
+ */
+
+import http from 'http';
+import { fileURLToPath } from 'url';
+import { SolverPool, PoolError } from './scip-pool.js';
+
+export { SolverPool, PoolError, LatencyWindow, HashRing, modelFamilyKey } from './scip-pool.js';
+
+const STATUS_BY_ERROR = {
+  [PoolError.QUEUE_FULL]: 429,
+  [PoolError.DEADLINE]: 504,
+  [PoolError.BUDGET_EXCEEDED]: 504,
+  [PoolError.CLOSED]: 503,
+  [PoolError.WORKER]: 500,
+  [PoolError.INVALID_MODEL]: 400,
+};
+
+function sendJson(res, status, body, headers = {}) {
+  const data = JSON.stringify(body);
+  res.writeHead(status, { 'content-type': 'application/json', 'content-length': Buffer.byteLength(data), ...headers });
+  res.end(data);
+}
+
+function readBody(req, limit) {
+  return new Promise((resolve, reject) => {
+    const chunks = [];
+    let size = 0;
+    req.on('data', (chunk) => {
+      size += chunk.length;
+      if (size > limit) {
+        reject(Object.assign(new Error('payload too large'), { status: 413 }));
+        req.destroy();
+        return;
+      }
+      chunks.push(chunk);
+    });
+    req.on('end', () => resolve(Buffer.concat(chunks, size)));
+    req.on('error', reject);
+  });
+}
+
+/**
+ * Start a solve server
+ * @param {Object} options
+ * @param {number} options.port - TCP port (ignored when socketPath is set)
+ * @param {string} options.host - Bind address (default 127.0.0.1)
+ * @param {string} options.socketPath - Unix socket / named pipe path
+ * @param {number} options.workers - Pool size
+ * @param {number} options.maxQueue - Queued jobs before 429
+ * @param {number} options.defaultBudgetMs - Budget when the request sets none
+ * @param {number} options.maxBudgetMs - Upper bound for x-scip-budget-ms
+ * @param {number} options.maxBodyBytes - Larger payloads get 413
+ * @param {Object} options.initOptions - SCIPApi.init() options for the workers
+ * @returns {Promise<{ server: http.Server, pool: SolverPool, address: string, close: () => Promise<void> }>}
+ */
+export async function createSolveServer({
+  port = 8787,
+  host = '127.0.0.1',
+  socketPath = null,
+  workers,
+  maxQueue = 64,
+  defaultBudgetMs = 30000,
+  maxBudgetMs = 300000,
+  maxBodyBytes = 64 << 20,
+  initOptions = {},
+  pool = null,
+} = {}) {
+  const solverPool = pool || new SolverPool({ size: workers, maxQueue, defaultBudgetMs, initOptions });
+  const started = Date.now();
+
+  const server = http.createServer(async (req, res) => {
+    const url = new URL(req.url, 'http://localhost');
+
+    if (req.method === 'GET' && url.pathname === '/health') {
+      sendJson(res, 200, { ok: true });
+      return;
+    }
+
+    if (req.method === 'GET' && url.pathname === '/metrics') {
+      sendJson(res, 200, { uptimeMs: Date.now() - started, ...solverPool.stats() });
+      return;
+    }
+
+    if (req.method === 'GET' && url.pathname === '/progress') {
+      sendJson(res, 200, { workers: solverPool.progress() });
+      return;
+    }
+
+    if (req.method === 'POST' && url.pathname === '/cutoff') {
+      const objlimit = Number(url.searchParams.get('objlimit'));
+      if (!url.searchParams.get('group') || !Number.isFinite(objlimit)) {
+        sendJson(res, 400, { error: 'group and objlimit are required' });
+        return;
+      }
+      req.resume();
+      sendJson(res, 200, { notified: solverPool.postCutoff(url.searchParams.get('group'), { objlimit }) });
+      return;
+    }
+
+    if (req.method !== 'POST' || url.pathname !== '/solve') {
+      sendJson(res, 404, { error: 'not found' });
+      return;
+    }
+
+    // Shed load before reading the body
+    const stats = solverPool.stats();
+    if (stats.queued >= stats.maxQueue) {
+      solverPool.counters.submitted += 1;
+      solverPool.counters.rejectedQueueFull += 1;
+      req.resume();
+      sendJson(res, 429, { error: 'solve queue is full' }, { 'retry-after': '1' });
+      return;
+    }
+
+    try {
+      const body = await readBody(req, maxBodyBytes);
+      const isText = (req.headers['content-type'] || '').startsWith('text/');
+      const model = isText ? body.toString('utf8') : new Uint8Array(body.buffer, body.byteOffset, body.length);
+      const requested = Number(req.headers['x-scip-budget-ms'] || url.searchParams.get('budgetMs'));
+      const budgetMs = Math.min(requested > 0 ? requested : defaultBudgetMs, maxBudgetMs);
+
+      const result = await solverPool.submit(model, {
+        format: url.searchParams.get('format') || 'lp',
+        budgetMs,
+        family: req.headers['x-scip-family'] || url.searchParams.get('family') || undefined,
+        group: req.headers['x-scip-group'] || url.searchParams.get('group') || null,
+      });
+
+      if ((req.headers.accept || '').includes('application/octet-stream') && result.values) {
+        const values = Buffer.from(result.values.buffer, result.values.byteOffset, result.values.byteLength);
+        res.writeHead(200, {
+          'content-type': 'application/octet-stream',
+          'content-length': values.length,
+          'x-scip-status': result.status,
+          'x-scip-objective': String(result.objective),
+          'x-scip-solve-ms': String(result.timing.totalMs),
+          'x-scip-warm': result.routing && result.routing.hit ? '1' : '0',
+        });
+        res.end(values);
+        return;
+      }
+
+      sendJson(res, 200, {
+        ...result,
+        values: result.values ? Array.from(result.values) : undefined,
+      });
+    } catch (error) {
+      const status = error.status || STATUS_BY_ERROR[error.code] || 500;
+      sendJson(res, status, { error: error.message, code: error.code }, status === 429 ? { 'retry-after': '1' } : {});
+    }
+  });
+
+  await new Promise((resolve, reject) => {
+    server.once('error', reject);
+    if (socketPath) {
+      server.listen(socketPath, resolve);
+    } else {
+      server.listen(port, host, resolve);
+    }
+  });
+
+  const bound = server.address();
+  const address = typeof bound === 'string' ? bound : `http://${bound.address}:${bound.port}`;
+
+  return {
+    server,
+    pool: solverPool,
+    address,
+    close: async () => {
+      await new Promise((resolve) => server.close(resolve));
+      await solverPool.close();
+    },
+  };
+}
+
+function parseArgs(argv) {
+  const args = {};
+  for (let i = 0; i < argv.length; i += 1) {
+    if (argv[i].startsWith('--')) {
+      args[argv[i].slice(2)] = argv[i + 1];
+      i += 1;
+    }
+  }
+  return args;
+}
+
+// CLI: node scip-server.js [--port 8787] [--socket path] [--workers n] [--queue n] [--budget ms]
+if (process.argv[1] && fileURLToPath(import.meta.url) === process.argv[1]) {
+  const args = parseArgs(process.argv.slice(2));
+  const handle = await createSolveServer({
+    port: args.port ? Number(args.port) : undefined,
+    host: args.host,
+    socketPath: args.socket || null,
+    workers: args.workers ? Number(args.workers) : undefined,
+    maxQueue: args.queue ? Number(args.queue) : undefined,
+    defaultBudgetMs: args.budget ? Number(args.budget) : undefined,
+  });
+  console.log(`scip.js solve server listening on ${handle.address} (${handle.pool.size} workers)`);
+
+  const shutdown = async () => {
+    await handle.close();
+    process.exit(0);
+  };
+  process.on('SIGINT', shutdown);
+  process.on('SIGTERM', shutdown);
+}
@@ -11,11 +11,28 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
+#include <stdint.h>
+#include <unistd.h>
 #include <emscripten.h>
+#include <emscripten/heap.h>
+
+// mallinfo() is provided by dlmalloc and emmalloc but not by the mimalloc build
+#ifndef SCIPJS_MIMALLOC
+#include <malloc.h>
+#endif
 
 #include "scip/scip.h"
 #include "scip/scipdefplugins.h"
 #include "scip/cons_linear.h"
+#include "scip/misc_linear.h"
+
+#include "scipjs_plugin.h"
+
+// dlopen() is only available in the -sMAIN_MODULE build (scip-api-dynlink.*)
+#ifdef SCIPJS_DYNLINK
+#include <dlfcn.h>
+#endif
 
 // Global SCIP instance for API mode
 static SCIP* scip_instance = NULL;
@@ -26,11 +43,19 @@ static int current_pricing_mode = 0;
 // Diagnostics for priced variables added through this bridge
 static int priced_vars_added = 0;
 
-// JavaScript callback function pointer (set from JS)
-static int js_incumbent_callback = 0;
-static int js_node_callback = 0;
-static int js_pricer_redcost_callback = 0;
-static int js_pricer_farkas_callback = 0;
+// JavaScript callbacks, registered by JS in the wasm function table (addFunction)
+// and called directly through these typed pointers; NULL means disabled
+typedef void (*JS_INCUMBENT_CALLBACK)(double objval);
+typedef void (*JS_NODE_CALLBACK)(double dualbound, double primalbound, double nnodes);
+typedef void (*JS_PRICER_CALLBACK)(int round);
+typedef void (*JS_PROGRESS_CALLBACK)(double* block);
+typedef int (*JS_MAILBOX_CALLBACK)(double* out, int capacity);
+
+static JS_INCUMBENT_CALLBACK js_incumbent_callback = NULL;
+static JS_NODE_CALLBACK js_node_callback = NULL;
+static JS_PRICER_CALLBACK js_pricer_redcost_callback = NULL;
+static JS_PRICER_CALLBACK js_pricer_farkas_callback = NULL;
+static SCIP_Bool js_node_catching = FALSE;
 
 // JS pricer plugin handle
 static SCIP_PRICER* js_pricer = NULL;
@@ -49,6 +74,37 @@ static int last_pricing_mode = 0;
 static int last_pricing_result = (int)SCIP_DIDNOTRUN;
 static int added_vars_this_call = 0;
 
+// Dual stabilization of the duals handed to the redcost pricer, per constraint
+// handle; the LP-position copy serves the row-based dual getters
+#define STAB_NONE 0
+#define STAB_SMOOTHING 1
+#define STAB_BOXSTEP 2
+
+static int stab_mode = STAB_NONE;
+static double stab_param = 0.5;      // smoothing alpha or box half-width
+static SCIP_Bool stab_adaptive = FALSE;
+static double stab_value = 0.5;      // alpha / half-width in use
+static double* stab_center = NULL;
+static double* stab_out = NULL;      // LP duals, NaN for constraints without an LP row
+static double* stab_duals = NULL;    // duals handed to the pricer
+static SCIP_ROW** stab_rows = NULL;  // LP row of each constraint handle this round
+static int stab_size = 0;
+static SCIP_Bool stab_center_valid = FALSE;
+static double* stab_row_duals = NULL;
+static int stab_nrows = 0;
+static int stab_row_capacity = 0;
+static SCIP_Bool stab_active = FALSE;
+static SCIP_Longint stab_node = -1;
+static SCIP_Real stab_node_bound = SCIP_INVALID;
+static double stab_rounds = 0.0;
+static double stab_mispricings = 0.0;
+static double stab_fallbacks = 0.0;
+// Reduced costs at the LP duals of the columns added in the current redcost call
+static double* stab_added_redcost = NULL;
+static int stab_added_capacity = 0;
+static int stab_added = 0;
+static int stab_first_var = 0;       // handle of the first column added in the call
+
 // Simple handle registries for variables, constraints, and rows
 static SCIP_VAR** var_registry = NULL;
 static int var_registry_size = 0;
@@ -62,6 +118,413 @@ static SCIP_ROW** row_registry = NULL;
 static int row_registry_size = 0;
 static int row_registry_capacity = 0;
 
+// Branch-and-bound tree trace: fixed-size records in a bounded buffer
+#define TREE_TRACE_STATUS_FOCUSED 0
+#define TREE_TRACE_STATUS_BRANCHED 1
+#define TREE_TRACE_STATUS_INFEASIBLE 2
+#define TREE_TRACE_STATUS_PRUNED 3
+#define TREE_TRACE_STATUS_SOLUTION 4
+
+#define TREE_TRACE_DIR_NONE 0
+#define TREE_TRACE_DIR_DOWN 1
+#define TREE_TRACE_DIR_UP 2
+
+// 48 bytes, little-endian, decoded by decodeTreeTrace() in scip-api-wrapper.js
+typedef struct {
+    double time;            // seconds since solve start
+    double lowerbound;      // node lower bound (transformed space)
+    double branchbound;     // new bound imposed by the branching that created the node
+    unsigned int node;      // SCIP node number
+    unsigned int parent;    // parent node number (0 for the root)
+    int depth;
+    int branchvar;          // transformed problem index of the branching variable, -1 if none
+    unsigned int lpiters;   // LP iterations spent while the node was focused
+    unsigned char status;   // TREE_TRACE_STATUS_*
+    unsigned char direction; // TREE_TRACE_DIR_*
+    unsigned short reserved;
+} TREETRACERECORD;
+
+static TREETRACERECORD* tree_trace = NULL;
+static int tree_trace_capacity = 0;
+static int tree_trace_size = 0;
+static int tree_trace_dropped = 0;
+static double tree_trace_start = 0.0;
+static SCIP_Longint tree_trace_focus_lpiters = 0;
+static SCIP_Bool tree_trace_catching = FALSE;
+// Children created by branching, kept until the solve ends; those never focused were pruned
+static TREETRACERECORD* tree_trace_pending = NULL;
+static int tree_trace_pending_size = 0;
+
+// Pricing trace: one record per pricer call, in the same bounded scheme
+#define PRICING_TRACE_MODE_REDCOST 1
+#define PRICING_TRACE_MODE_FARKAS 2
+
+// 48 bytes, little-endian, decoded by decodePricingTrace() in scip-api-wrapper.js
+typedef struct {
+    double time;            // seconds since solve start
+    double lpobj;           // LP objective priced against (NaN for Farkas rounds)
+    unsigned int node;      // SCIP node number
+    int round;              // pricer round at the end of the call
+    int mode;               // PRICING_TRACE_MODE_*
+    int lpcols;             // columns in the LP
+    int lprows;             // rows in the LP
+    int added;              // columns added by the call
+    int pooled;             // problem variables outside the LP (re-enterable columns)
+    int mispricings;        // stabilized pricing repeats within the call
+} PRICINGTRACERECORD;
+
+static PRICINGTRACERECORD* pricing_trace = NULL;
+static int pricing_trace_capacity = 0;
+static int pricing_trace_size = 0;
+static int pricing_trace_dropped = 0;
+static double pricing_trace_start = 0.0;
+
+// Profiling spans, timestamps in milliseconds on the emscripten_get_now() clock
+// (performance.now() of the hosting thread). Span ids mirror PROFILE_SPAN_NAMES
+// in scip-api-wrapper.js.
+#define PROFILE_SPAN_READ 0
+#define PROFILE_SPAN_SOLVE 1
+#define PROFILE_SPAN_TRANSFORM 2
+#define PROFILE_SPAN_PRESOLVE 3
+#define PROFILE_SPAN_ROOT_LP 4
+#define PROFILE_SPAN_ROOT_NODE 5
+#define PROFILE_SPAN_BRANCH_AND_BOUND 6
+#define PROFILE_SPAN_PRICING_REDCOST 7
+#define PROFILE_SPAN_PRICING_FARKAS 8
+#define PROFILE_SPAN_JS_CALLBACK 9
+
+// Argument of PROFILE_SPAN_JS_CALLBACK spans
+#define PROFILE_CALLBACK_INCUMBENT 0
+#define PROFILE_CALLBACK_NODE 1
+#define PROFILE_CALLBACK_PRICER_REDCOST 2
+#define PROFILE_CALLBACK_PRICER_FARKAS 3
+
+typedef struct {
+    double start;
+    double duration;
+    int span;
+    int arg;
+} PROFILESPAN;
+
+static PROFILESPAN* profile_spans = NULL;
+static int profile_capacity = 0;
+static int profile_size = 0;
+static int profile_dropped = 0;
+
+// Open phase spans of the running solve
+static double profile_solve_start = 0.0;
+static double profile_presolve_start = 0.0;
+static double profile_root_start = 0.0;
+static double profile_bnb_start = 0.0;
+static SCIP_Bool profile_root_lp_done = FALSE;
+static SCIP_Bool profile_catching = FALSE;
+
+// Memory samples: MEMORY_SAMPLE_FIELDS doubles per sample in a ring buffer
+#define MEMORY_SAMPLE_FIELDS 10
+
+#define MEMORY_PHASE_READ 0
+#define MEMORY_PHASE_TRANSFORMED 1
+#define MEMORY_PHASE_PRESOLVED 2
+#define MEMORY_PHASE_ROOT 3
+#define MEMORY_PHASE_NODES 4
+#define MEMORY_PHASE_SOLVED 5
+#define MEMORY_PHASE_CLEARED 6
+#define MEMORY_PHASE_MANUAL 7
+
+static double* memory_samples = NULL;
+static int memory_capacity = 0;
+static int memory_count = 0;        // total samples taken, ring index is count % capacity
+static int memory_node_interval = 0;
+static SCIP_Bool memory_root_sampled = FALSE;
+static SCIP_Bool memory_catching = FALSE;
+
+// Live progress block: PROGRESS_FIELDS doubles, refreshed by the progress_js
+// event handler at most every progress_interval_ms and handed to the JS
+// callback, which publishes it into a SharedArrayBuffer seqlock
+#define PROGRESS_FIELDS 12
+
+static double progress_block[PROGRESS_FIELDS];
+static double progress_interval_ms = 100.0;
+static double progress_last = 0.0;
+static double progress_start = 0.0;
+static double progress_updates = 0.0;
+static JS_PROGRESS_CALLBACK js_progress_callback = NULL;
+static SCIP_Bool progress_catching = FALSE;
+
+// Mailbox polled at every focused node: the JS callback copies pending messages
+// from its SharedArrayBuffer into mailbox_buffer (objective limit, then one
+// value per registered variable) and returns MAILBOX_* flags
+#define MAILBOX_OBJLIMIT 1
+#define MAILBOX_SOLUTION 2
+
+static JS_MAILBOX_CALLBACK js_mailbox_callback = NULL;
+static double* mailbox_buffer = NULL;
+static int mailbox_capacity = 0;
+static SCIP_Bool mailbox_catching = FALSE;
+static double mailbox_polls = 0.0;
+static double mailbox_objlimits = 0.0;
+static double mailbox_sols_tried = 0.0;
+static double mailbox_sols_stored = 0.0;
+
+// Checkpoints: the open-node frontier as branching bound changes per node,
+// incumbents, dual bound and pseudocosts, all keyed by variable handle.
+// Layout (little-endian, sections 8-byte aligned):
+//   int32[16] header: magic, version, nvars, nnodes, nbdchgs, nsols, flags,
+//                     dropped bound changes (on variables without a handle),
+//                     region hash (lo, hi), objective hash (lo, hi) of the model
+//   float64[8] stats: dual bound, primal bound, solving time, nodes, LP iterations
+//   float64 nodelb[nnodes]   node lower bound (original space), SCIP_INVALID if unknown
+//   float64 bdval[nbdchgs]
+//   float64 sols[nsols * nvars]
+//   float64 pseudocost[4 * nvars]  down, up, down count, up count
+//   int32 nodestart[nnodes + 1], int32 bdvar[nbdchgs], uint8 bdtype[nbdchgs]
+#define CHECKPOINT_MAGIC 0x504B4353 // "SCKP"
+#define CHECKPOINT_VERSION 2
+#define CHECKPOINT_HEADER_INTS 16
+#define CHECKPOINT_STATS 8
+#define CHECKPOINT_FLAG_PSEUDOCOSTS 1
+
+typedef struct {
+    uint64_t nodelb;
+    uint64_t bdval;
+    uint64_t sols;
+    uint64_t pseudocost;
+    uint64_t nodestart;
+    uint64_t bdvar;
+    uint64_t bdtype;
+    uint64_t size;
+} CHECKPOINTLAYOUT;
+
+static unsigned char* checkpoint_data = NULL;
+static int checkpoint_size = 0;
+
+// Cut and conflict pack, see scip_cuts_export. Layout (little-endian, sections
+// 8-byte aligned):
+//   int32[16] header: magic, version, nvars, nrows, nnz, nsols, rows dropped
+//                     (nonlinear or on variables without a handle), reserved,
+//                     region hash (lo, hi), objective hash (lo, hi)
+//   float64 lhs[nrows], float64 rhs[nrows], float64 vals[nnz], float64 sols[nsols * nvars]
+//   int32 rowstart[nrows + 1], int32 colidx[nnz] (variable handle - 1), uint8 rowflags[nrows]
+#define CUTPACK_MAGIC 0x54554353 // "SCUT"
+#define CUTPACK_VERSION 1
+#define CUTPACK_HEADER_INTS 16
+#define CUTPACK_ROW_CONFLICT 1
+#define CUTPACK_ROW_OBJECTIVE 2 // only valid under the same objective (and its incumbent)
+
+typedef struct {
+    uint64_t lhs;
+    uint64_t rhs;
+    uint64_t vals;
+    uint64_t sols;
+    uint64_t rowstart;
+    uint64_t colidx;
+    uint64_t rowflags;
+    uint64_t size;
+} CUTPACKLAYOUT;
+
+static unsigned char* cutpack_data = NULL;
+static int cutpack_size = 0;
+// Objective-dependent rows were imported into the current problem
+static SCIP_Bool cutpack_imported_objective = FALSE;
+
+// Reduced model (model blob) and postsolve map of scip_presolve_only. Map
+// layout (little-endian): int32[16] header: magic, version, norig (variable
+// handles), nnz, fixed, aggregated (one term), multi-aggregated, reserved...;
+// float64 objscale, objoffset (original objective = objscale * reduced + objoffset),
+// float64 constant[norig], float64 scalar[nnz], int32 start[norig + 1],
+// int32 index[nnz] (reduced variable): x_i = constant[i] + sum scalar * y_index
+#define POSTSOLVE_MAGIC 0x4D504353 // "SCPM"
+#define POSTSOLVE_VERSION 1
+#define POSTSOLVE_HEADER_INTS 16
+
+static unsigned char* presolve_model = NULL;
+static int presolve_model_size = 0;
+static unsigned char* presolve_map = NULL;
+static int presolve_map_size = 0;
+static void presolveFree(void);
+
+// Standalone Benders master and subproblems, see scip_benders_begin
+static void bendersFree(void);
+
+// Native pricing subproblems, see scip_pricing_template_add
+static int pricing_ntemplates = 0;
+static SCIP_Bool pricing_templates_complete = TRUE;  // every template solve of the round was proven
+static void pricingTemplatesFree(void);
+static SCIP_RETCODE pricingTemplatesPrice(SCIP* scip, SCIP_Bool farkas);
+
+// Model hashes shared by checkpoints and cut packs, see cutpackModelHashes
+static int cutpackModelHashes(SCIP* scip, uint64_t* region, uint64_t* objective);
+
+// Checkpoint being resumed: applied by the checkpoint_js branching rule at the root
+static unsigned char* resume_data = NULL;
+static SCIP_Bool resume_pending = FALSE;
+static int resume_nodes_created = 0;
+
+// Per-model bump arena for bridge allocations (opt-in). Every block carries an
+// 8-byte header with its size so the most recent block can be popped or grown in
+// place; everything else is released at once by arenaReset() on problem clear.
+#define ARENA_HEADER 8
+#define BRIDGE_ALLOC_STATS_FIELDS 10
+
+static char* arena_base = NULL;
+static size_t arena_capacity = 0;
+static size_t arena_used = 0;
+static size_t arena_high_water = 0;
+
+// Bridge allocation counters, reported by scip_bridge_alloc_stats()
+static double bridge_allocs = 0.0;
+static double bridge_frees = 0.0;
+static double bridge_reallocs = 0.0;
+static double bridge_bytes = 0.0;
+static double bridge_time_ms = 0.0;
+static double arena_resets = 0.0;
+static double arena_fallbacks = 0.0;
+static SCIP_Bool bridge_alloc_timing = FALSE;
+
+// Native plugins (wasm side modules) loaded into the SCIP instance
+#define MAX_PLUGINS 32
+
+static void* plugin_handles[MAX_PLUGINS];
+static int plugin_count = 0;
+static char plugin_error[256] = "";
+
+static int arenaOwns(const void* ptr)
+{
+    return arena_base != NULL && (const char*)ptr >= arena_base && (const char*)ptr < arena_base + arena_capacity;
+}
+
+static size_t arenaBlockSize(const void* ptr)
+{
+    return *(const size_t*)((const char*)ptr - ARENA_HEADER);
+}
+
+static int arenaIsTop(const void* ptr)
+{
+    return (size_t)((const char*)ptr - arena_base) + ((arenaBlockSize(ptr) + 7) & ~(size_t)7) == arena_used;
+}
+
+static void* arenaAlloc(size_t size)
+{
+    size_t need = ARENA_HEADER + ((size + 7) & ~(size_t)7);
+    if (arena_base == NULL || arena_capacity - arena_used < need) {
+        return NULL;
+    }
+
+    char* block = arena_base + arena_used;
+    *(size_t*)block = size;
+    arena_used += need;
+    if (arena_used > arena_high_water) {
+        arena_high_water = arena_used;
+    }
+    return block + ARENA_HEADER;
+}
+
+static void freeArena(void)
+{
+    free(arena_base);
+    arena_base = NULL;
+    arena_capacity = 0;
+    arena_used = 0;
+    arena_high_water = 0;
+}
+
+static void arenaReset(void)
+{
+    if (arena_base == NULL) {
+        return;
+    }
+    arena_used = 0;
+    arena_resets += 1.0;
+}
+
+/**
+ * Allocation helpers for everything the bridge owns per problem. They fall back
+ * to malloc when the arena is disabled or full.
+ */
+static void* bridgeAlloc(size_t size)
+{
+    double start = bridge_alloc_timing ? emscripten_get_now() : 0.0;
+
+    void* ptr = arenaAlloc(size);
+    if (ptr == NULL) {
+        if (arena_base != NULL) {
+            arena_fallbacks += 1.0;
+        }
+        ptr = malloc(size);
+    }
+
+    bridge_allocs += 1.0;
+    bridge_bytes += (double)size;
+    if (bridge_alloc_timing) {
+        bridge_time_ms += emscripten_get_now() - start;
+    }
+    return ptr;
+}
+
+static void* bridgeRealloc(void* ptr, size_t size)
+{
+    if (ptr == NULL) {
+        return bridgeAlloc(size);
+    }
+
+    double start = bridge_alloc_timing ? emscripten_get_now() : 0.0;
+    void* next = NULL;
+
+    if (!arenaOwns(ptr)) {
+        next = realloc(ptr, size);
+    } else {
+        size_t oldsize = arenaBlockSize(ptr);
+        size_t offset = (size_t)((char*)ptr - arena_base);
+
+        // The top block grows in place, anything else is copied to a new block
+        if (arenaIsTop(ptr) && offset + ((size + 7) & ~(size_t)7) <= arena_capacity) {
+            *(size_t*)((char*)ptr - ARENA_HEADER) = size;
+            arena_used = offset + ((size + 7) & ~(size_t)7);
+            if (arena_used > arena_high_water) {
+                arena_high_water = arena_used;
+            }
+            next = ptr;
+        } else {
+            next = arenaAlloc(size);
+            if (next == NULL) {
+                arena_fallbacks += 1.0;
+                next = malloc(size);
+            }
+            if (next != NULL) {
+                memcpy(next, ptr, oldsize < size ? oldsize : size);
+            }
+        }
+    }
+
+    bridge_reallocs += 1.0;
+    bridge_bytes += (double)size;
+    if (bridge_alloc_timing) {
+        bridge_time_ms += emscripten_get_now() - start;
+    }
+    return next;
+}
+
+static void bridgeFree(void* ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+
+    double start = bridge_alloc_timing ? emscripten_get_now() : 0.0;
+
+    if (!arenaOwns(ptr)) {
+        free(ptr);
+    } else if (arenaIsTop(ptr)) {
+        // Scratch buffers are released in LIFO order, so pop them right away
+        arena_used = (size_t)((char*)ptr - arena_base) - ARENA_HEADER;
+    }
+
+    bridge_frees += 1.0;
+    if (bridge_alloc_timing) {
+        bridge_time_ms += emscripten_get_now() - start;
+    }
+}
+
 static int ensureVarRegistryCapacity(int needed)
 {
     if (needed <= var_registry_capacity) {
@@ -73,7 +536,7 @@ static int ensureVarRegistryCapacity(int needed)
         newcap *= 2;
     }
 
-    SCIP_VAR** next = (SCIP_VAR**)realloc(var_registry, (size_t)newcap * sizeof(SCIP_VAR*));
+    SCIP_VAR** next = (SCIP_VAR**)bridgeRealloc(var_registry, (size_t)newcap * sizeof(SCIP_VAR*));
     if (next == NULL) {
         return 0;
     }
@@ -94,7 +557,7 @@ static int ensureConsRegistryCapacity(int needed)
         newcap *= 2;
     }
 
-    SCIP_CONS** next = (SCIP_CONS**)realloc(cons_registry, (size_t)newcap * sizeof(SCIP_CONS*));
+    SCIP_CONS** next = (SCIP_CONS**)bridgeRealloc(cons_registry, (size_t)newcap * sizeof(SCIP_CONS*));
     if (next == NULL) {
         return 0;
     }
@@ -115,7 +578,7 @@ static int ensureRowRegistryCapacity(int needed)
         newcap *= 2;
     }
 
-    SCIP_ROW** next = (SCIP_ROW**)realloc(row_registry, (size_t)newcap * sizeof(SCIP_ROW*));
+    SCIP_ROW** next = (SCIP_ROW**)bridgeRealloc(row_registry, (size_t)newcap * sizeof(SCIP_ROW*));
     if (next == NULL) {
         return 0;
     }
@@ -127,22 +590,150 @@ static int ensureRowRegistryCapacity(int needed)
 
 static void clearRegistries(void)
 {
-    free(var_registry);
+    bridgeFree(var_registry);
     var_registry = NULL;
     var_registry_size = 0;
     var_registry_capacity = 0;
 
-    free(cons_registry);
+    bridgeFree(cons_registry);
     cons_registry = NULL;
     cons_registry_size = 0;
     cons_registry_capacity = 0;
 
-    free(row_registry);
+    bridgeFree(row_registry);
     row_registry = NULL;
     row_registry_size = 0;
     row_registry_capacity = 0;
 }
 
+static void freeTreeTrace(void)
+{
+    free(tree_trace);
+    tree_trace = NULL;
+    free(tree_trace_pending);
+    tree_trace_pending = NULL;
+    tree_trace_pending_size = 0;
+    tree_trace_capacity = 0;
+    tree_trace_size = 0;
+    tree_trace_dropped = 0;
+}
+
+static void freePricingTrace(void)
+{
+    free(pricing_trace);
+    pricing_trace = NULL;
+    pricing_trace_capacity = 0;
+    pricing_trace_size = 0;
+    pricing_trace_dropped = 0;
+}
+
+static void freeProfileSpans(void)
+{
+    free(profile_spans);
+    profile_spans = NULL;
+    profile_capacity = 0;
+    profile_size = 0;
+    profile_dropped = 0;
+}
+
+static double profileBegin(void)
+{
+    return profile_spans != NULL ? emscripten_get_now() : 0.0;
+}
+
+static void profileEnd(int span, double start, int arg)
+{
+    if (profile_spans == NULL) {
+        return;
+    }
+
+    if (profile_size >= profile_capacity) {
+        profile_dropped += 1;
+        return;
+    }
+
+    PROFILESPAN* rec = &profile_spans[profile_size];
+    rec->start = start;
+    rec->duration = emscripten_get_now() - start;
+    rec->span = span;
+    rec->arg = arg;
+    profile_size += 1;
+}
+
+static void freeMemorySamples(void)
+{
+    free(memory_samples);
+    memory_samples = NULL;
+    memory_capacity = 0;
+    memory_count = 0;
+}
+
+/**
+ * Layout: time (ms), phase, nodes, SCIP block memory used, SCIP memory total,
+ * wasm heap size, malloc bytes in use, malloc bytes free, SCIP external estimate,
+ * heap break (sbrk(0)). Without mallinfo() (mimalloc) in use and free are -1;
+ * the heap break still tracks how far the allocator has grown the heap.
+ */
+static void memoryFillSample(double* out, int phase)
+{
+    SCIP_STAGE stage = scip_instance != NULL ? SCIPgetStage(scip_instance) : SCIP_STAGE_INIT;
+
+    out[0] = emscripten_get_now();
+    out[1] = (double)phase;
+    out[2] = stage >= SCIP_STAGE_SOLVING && stage <= SCIP_STAGE_SOLVED ? (double)SCIPgetNNodes(scip_instance) : 0.0;
+    out[3] = scip_instance != NULL ? (double)SCIPgetMemUsed(scip_instance) : 0.0;
+    out[4] = scip_instance != NULL ? (double)SCIPgetMemTotal(scip_instance) : 0.0;
+    out[5] = (double)emscripten_get_heap_size();
+#ifndef SCIPJS_MIMALLOC
+    struct mallinfo mi = mallinfo();
+    out[6] = (double)mi.uordblks;
+    out[7] = (double)mi.fordblks;
+#else
+    out[6] = -1.0;
+    out[7] = -1.0;
+#endif
+    out[8] = scip_instance != NULL ? (double)SCIPgetMemExternEstim(scip_instance) : 0.0;
+    out[9] = (double)(size_t)sbrk(0);
+}
+
+static void progressPublish(SCIP* scip, SCIP_Bool force)
+{
+    double now = emscripten_get_now();
+    if (js_progress_callback == NULL || (!force && now - progress_last < progress_interval_ms)) {
+        return;
+    }
+
+    SCIP_STAGE stage = SCIPgetStage(scip);
+    SCIP_Bool solving = stage >= SCIP_STAGE_SOLVING && stage <= SCIP_STAGE_SOLVED;
+
+    progress_last = now;
+    progress_updates += 1.0;
+    progress_block[0] = now - progress_start;
+    progress_block[1] = (double)stage;
+    progress_block[2] = stage >= SCIP_STAGE_TRANSFORMED ? SCIPgetPrimalbound(scip) : SCIP_INVALID;
+    progress_block[3] = solving ? SCIPgetDualbound(scip) : SCIP_INVALID;
+    progress_block[4] = solving ? SCIPgetGap(scip) : SCIP_INVALID;
+    progress_block[5] = solving ? (double)SCIPgetNNodes(scip) : 0.0;
+    progress_block[6] = stage == SCIP_STAGE_SOLVING ? (double)SCIPgetNNodesLeft(scip) : 0.0;
+    progress_block[7] = solving ? (double)SCIPgetNLPIterations(scip) : 0.0;
+    progress_block[8] = stage >= SCIP_STAGE_TRANSFORMED ? (double)SCIPgetNSols(scip) : 0.0;
+    progress_block[9] = (double)SCIPgetMemUsed(scip);
+    progress_block[10] = (double)emscripten_get_heap_size();
+    progress_block[11] = progress_updates;
+
+    js_progress_callback(progress_block);
+}
+
+static void memorySample(int phase)
+{
+    if (memory_samples == NULL) {
+        return;
+    }
+
+    memoryFillSample(&memory_samples[(memory_count % memory_capacity) * MEMORY_SAMPLE_FIELDS], phase);
+    memory_count += 1;
+}
+
 static void resetPricingState(void)
 {
     pending_pricer_result = SCIP_SUCCESS;
@@ -157,10 +748,49 @@ static void resetPricingState(void)
     added_vars_this_call = 0;
     current_pricing_mode = 0;
     priced_vars_added = 0;
+
+    free(stab_center);
+    free(stab_out);
+    free(stab_duals);
+    free(stab_rows);
+    free(stab_row_duals);
+    free(stab_added_redcost);
+    stab_added_redcost = NULL;
+    stab_added_capacity = 0;
+    stab_added = 0;
+    stab_center = NULL;
+    stab_out = NULL;
+    stab_duals = NULL;
+    stab_rows = NULL;
+    stab_row_duals = NULL;
+    stab_size = 0;
+    stab_nrows = 0;
+    stab_row_capacity = 0;
+    stab_center_valid = FALSE;
+    stab_active = FALSE;
+    stab_node = -1;
+    stab_node_bound = SCIP_INVALID;
+    stab_value = stab_param;
+    stab_rounds = 0.0;
+    stab_mispricings = 0.0;
+    stab_fallbacks = 0.0;
+
+    // Templates map into the master's constraint handles, which go with it
+    pricingTemplatesFree();
+}
+
+static void freeResume(void)
+{
+    free(resume_data);
+    resume_data = NULL;
+    resume_pending = FALSE;
 }
 
 static void clearCurrentProblem(void)
 {
+    freeResume();
+    cutpack_imported_objective = FALSE;
+
     if (scip_instance == NULL) {
         return;
     }
@@ -240,6 +870,27 @@ static int registerRowHandle(SCIP_ROW* row)
     return row_registry_size;
 }
 
+// Registry appends for bulk loading: handles are known to be new, so skip the scan
+static int appendVarHandle(SCIP_VAR* var)
+{
+    if (!ensureVarRegistryCapacity(var_registry_size + 1)) {
+        return -1;
+    }
+    var_registry[var_registry_size] = var;
+    var_registry_size += 1;
+    return var_registry_size;
+}
+
+static int appendConsHandle(SCIP_CONS* cons)
+{
+    if (!ensureConsRegistryCapacity(cons_registry_size + 1)) {
+        return -1;
+    }
+    cons_registry[cons_registry_size] = cons;
+    cons_registry_size += 1;
+    return cons_registry_size;
+}
+
 static SCIP_VAR* getVarByHandle(int varId)
 {
     if (varId <= 0 || varId > var_registry_size) {
@@ -264,6 +915,17 @@ static SCIP_ROW* getRowByHandle(int rowId)
     return row_registry[rowId - 1];
 }
 
+static void closePlugins(void)
+{
+#ifdef SCIPJS_DYNLINK
+    // Only after SCIPfree: the instance holds pointers into the side modules
+    for (int i = 0; i < plugin_count; ++i) {
+        dlclose(plugin_handles[i]);
+    }
+#endif
+    plugin_count = 0;
+}
+
 // Event handler data
 typedef struct {
     int callback_id;
@@ -282,13 +944,10 @@ static SCIP_DECL_EVENTEXEC(eventExecBestSol)
         objval = SCIPgetSolOrigObj(scip, sol);
         
         // Call JavaScript callback if registered
-        if (js_incumbent_callback != 0) {
-            // Call JS function with objective value
-            EM_ASM({
-                if (Module.onIncumbent) {
-                    Module.onIncumbent($0);
-                }
-            }, objval);
+        if (js_incumbent_callback != NULL) {
+            double spanstart = profileBegin();
+            js_incumbent_callback(objval);
+            profileEnd(PROFILE_SPAN_JS_CALLBACK, spanstart, PROFILE_CALLBACK_INCUMBENT);
         }
     }
     
@@ -309,1355 +968,5826 @@ static SCIP_DECL_EVENTEXEC(eventExecNode)
     nnodes = SCIPgetNNodes(scip);
     
     // Call JavaScript callback if registered
-    if (js_node_callback != 0) {
-        EM_ASM({
-            if (Module.onNode) {
-                Module.onNode($0, $1, $2);
-            }
-        }, dualbound, primalbound, (double)nnodes);
+    if (js_node_callback != NULL) {
+        double spanstart = profileBegin();
+        js_node_callback(dualbound, primalbound, (double)nnodes);
+        profileEnd(PROFILE_SPAN_JS_CALLBACK, spanstart, PROFILE_CALLBACK_NODE);
     }
     
     return SCIP_OKAY;
 }
 
-// ============================================
-// Include event handlers
-// ============================================
-static SCIP_RETCODE includeEventHandlers(SCIP* scip)
+static SCIP_DECL_EVENTINITSOL(eventInitsolNode)
 {
-    SCIP_EVENTHDLR* eventhdlr;
-    
-    // Best solution found event
-    SCIP_CALL(SCIPincludeEventhdlrBasic(scip, &eventhdlr, "bestsol_js",
-        "JavaScript callback for best solution found",
-        eventExecBestSol, NULL));
-    SCIP_CALL(SCIPsetEventhdlrInit(scip, eventhdlr, NULL));
-    
+    if (js_node_callback != NULL) {
+        SCIP_CALL(SCIPcatchEvent(scip, SCIP_EVENTTYPE_NODEFOCUSED, eventhdlr, NULL, NULL));
+        js_node_catching = TRUE;
+    }
+    return SCIP_OKAY;
+}
+
+static SCIP_DECL_EVENTEXITSOL(eventExitsolNode)
+{
+    if (js_node_catching) {
+        SCIP_CALL(SCIPdropEvent(scip, SCIP_EVENTTYPE_NODEFOCUSED, eventhdlr, NULL, -1));
+        js_node_catching = FALSE;
+    }
     return SCIP_OKAY;
 }
 
 // ============================================
-// Pricer callbacks (JavaScript bridge)
+// Event Handler: Branch-and-bound tree trace
 // ============================================
-static SCIP_DECL_PRICERREDCOST(pricerRedcostJs)
+static void treeTraceFill(SCIP* scip, SCIP_NODE* node, int status, TREETRACERECORD* rec)
 {
-    (void)pricer;
-
-    current_pricing_mode = 1;
-    last_pricing_mode = 1;
-    pricer_redcost_calls += 1;
-    pricer_round += 1;
-    added_vars_this_call = 0;
-    pending_pricer_result = SCIP_SUCCESS;
-    pending_pricer_lowerbound = SCIP_INVALID;
-    pending_pricer_stopearly = FALSE;
-    pending_pricer_abortround = FALSE;
-
-    if (js_pricer_redcost_callback != 0) {
-        EM_ASM({
-            if (Module.onPricerRedcost) {
-                Module.onPricerRedcost();
-            }
-        });
+    SCIP_NODE* parent = SCIPnodeGetParent(node);
+    SCIP_VAR* branchvar = NULL;
+    SCIP_Real branchbound = 0.0;
+    SCIP_BOUNDTYPE boundtype = SCIP_BOUNDTYPE_LOWER;
+    int nbranchvars = 0;
+
+    SCIPnodeGetParentBranchings(node, &branchvar, &branchbound, &boundtype, &nbranchvars, 1);
+
+    rec->time = (emscripten_get_now() - tree_trace_start) / 1000.0;
+    rec->lowerbound = SCIPnodeGetLowerbound(node);
+    rec->node = (unsigned int)SCIPnodeGetNumber(node);
+    rec->parent = parent != NULL ? (unsigned int)SCIPnodeGetNumber(parent) : 0u;
+    rec->depth = SCIPnodeGetDepth(node);
+    rec->lpiters = (unsigned int)(SCIPgetNLPIterations(scip) - tree_trace_focus_lpiters);
+    rec->status = (unsigned char)status;
+    rec->reserved = 0;
+
+    if (nbranchvars > 0 && branchvar != NULL) {
+        rec->branchvar = SCIPvarGetProbindex(branchvar);
+        rec->branchbound = branchbound;
+        rec->direction = boundtype == SCIP_BOUNDTYPE_UPPER ? TREE_TRACE_DIR_DOWN : TREE_TRACE_DIR_UP;
+    } else {
+        rec->branchvar = -1;
+        rec->branchbound = 0.0;
+        rec->direction = TREE_TRACE_DIR_NONE;
     }
+}
 
-    if (pending_pricer_abortround) {
-        pending_pricer_result = SCIP_DIDNOTRUN;
-        pending_pricer_stopearly = TRUE;
-        SCIPinterruptSolve(scip);
+static void treeTraceAppend(SCIP* scip, SCIP_NODE* node, int status)
+{
+    if (tree_trace_size >= tree_trace_capacity) {
+        tree_trace_dropped += 1;
+        return;
     }
 
-    if (lowerbound != NULL && pending_pricer_lowerbound != SCIP_INVALID) {
-        *lowerbound = pending_pricer_lowerbound;
-    }
+    treeTraceFill(scip, node, status, &tree_trace[tree_trace_size]);
+    tree_trace_size += 1;
+}
 
-    if (stopearly != NULL) {
-        *stopearly = pending_pricer_stopearly;
+/**
+ * Remember the children of a branched node. SCIP frees children cut off by the
+ * incumbent without a node event, so they are only known to be pruned at the end.
+ */
+static void treeTraceAddChildren(SCIP* scip)
+{
+    SCIP_NODE** children = NULL;
+    int nchildren = 0;
+
+    if (SCIPgetChildren(scip, &children, &nchildren) != SCIP_OKAY) {
+        return;
     }
 
-    if (result != NULL) {
-        *result = pending_pricer_result;
+    for (int i = 0; i < nchildren; i++) {
+        if (tree_trace_pending_size >= tree_trace_capacity) {
+            tree_trace_dropped += 1;
+            continue;
+        }
+        treeTraceFill(scip, children[i], TREE_TRACE_STATUS_PRUNED, &tree_trace_pending[tree_trace_pending_size]);
+        tree_trace_pending[tree_trace_pending_size].lpiters = 0;
+        tree_trace_pending_size += 1;
     }
+}
 
-    last_pricing_result = (int)pending_pricer_result;
+static SCIP_RETCODE treeTraceMarkNodes(SCIP* scip, SCIP_HASHMAP* seen)
+{
+    SCIP_NODE** nodes = NULL;
+    int nnodes = 0;
 
-    current_pricing_mode = 0;
+    SCIP_CALL(SCIPgetLeaves(scip, &nodes, &nnodes));
+    for (int i = 0; i < nnodes; i++) {
+        SCIP_CALL(SCIPhashmapSetImageInt(seen, (void*)(size_t)SCIPnodeGetNumber(nodes[i]), 1));
+    }
+    SCIP_CALL(SCIPgetChildren(scip, &nodes, &nnodes));
+    for (int i = 0; i < nnodes; i++) {
+        SCIP_CALL(SCIPhashmapSetImageInt(seen, (void*)(size_t)SCIPnodeGetNumber(nodes[i]), 1));
+    }
+    SCIP_CALL(SCIPgetSiblings(scip, &nodes, &nnodes));
+    for (int i = 0; i < nnodes; i++) {
+        SCIP_CALL(SCIPhashmapSetImageInt(seen, (void*)(size_t)SCIPnodeGetNumber(nodes[i]), 1));
+    }
     return SCIP_OKAY;
 }
 
-static SCIP_DECL_PRICERFARKAS(pricerFarkasJs)
+/**
+ * At the end of a solve, record every child that was never focused and is not
+ * still open as pruned
+ */
+static SCIP_RETCODE treeTraceFlushPruned(SCIP* scip)
 {
-    (void)pricer;
+    SCIP_HASHMAP* seen = NULL;
 
-    current_pricing_mode = 2;
-    last_pricing_mode = 2;
-    pricer_farkas_calls += 1;
-    pricer_round += 1;
-    added_vars_this_call = 0;
-    pending_pricer_result = SCIP_SUCCESS;
-    pending_pricer_abortround = FALSE;
+    if (tree_trace_pending_size == 0) {
+        return SCIP_OKAY;
+    }
 
-    if (!SCIPhasCurrentNodeLP(scip)) {
-        pending_pricer_result = SCIP_DIDNOTRUN;
-        last_pricing_result = (int)pending_pricer_result;
-        current_pricing_mode = 0;
-        if (result != NULL) {
-            *result = pending_pricer_result;
+    SCIP_CALL(SCIPhashmapCreate(&seen, SCIPblkmem(scip), tree_trace_size + tree_trace_pending_size));
+    for (int i = 0; i < tree_trace_size; i++) {
+        if (tree_trace[i].status == TREE_TRACE_STATUS_FOCUSED) {
+            SCIP_CALL(SCIPhashmapSetImageInt(seen, (void*)(size_t)tree_trace[i].node, 1));
         }
-        return SCIP_OKAY;
+    }
+    // Interrupted solves keep their open nodes; those are unexplored, not pruned
+    if (SCIPgetStage(scip) == SCIP_STAGE_SOLVING) {
+        SCIP_CALL(treeTraceMarkNodes(scip, seen));
     }
 
-    if (js_pricer_farkas_callback != 0) {
-        EM_ASM({
-            if (Module.onPricerFarkas) {
-                Module.onPricerFarkas();
-            }
-        });
+    double now = (emscripten_get_now() - tree_trace_start) / 1000.0;
+    for (int i = 0; i < tree_trace_pending_size; i++) {
+        if (SCIPhashmapExists(seen, (void*)(size_t)tree_trace_pending[i].node)) {
+            continue;
+        }
+        if (tree_trace_size >= tree_trace_capacity) {
+            tree_trace_dropped += 1;
+            continue;
+        }
+        tree_trace[tree_trace_size] = tree_trace_pending[i];
+        tree_trace[tree_trace_size].time = now;
+        tree_trace_size += 1;
     }
 
-    if (pending_pricer_abortround) {
-        pending_pricer_result = SCIP_DIDNOTRUN;
-        SCIPinterruptSolve(scip);
+    SCIPhashmapFree(&seen);
+    tree_trace_pending_size = 0;
+    return SCIP_OKAY;
+}
+
+static SCIP_DECL_EVENTEXEC(eventExecTreeTrace)
+{
+    SCIP_EVENTTYPE type = SCIPeventGetType(event);
+    SCIP_NODE* node = SCIPeventGetNode(event);
+
+    if (node == NULL) {
+        return SCIP_OKAY;
     }
 
-    if (result != NULL) {
-        *result = pending_pricer_result;
+    if (type == SCIP_EVENTTYPE_NODEFOCUSED) {
+        tree_trace_focus_lpiters = SCIPgetNLPIterations(scip);
+        treeTraceAppend(scip, node, TREE_TRACE_STATUS_FOCUSED);
+    } else if (type == SCIP_EVENTTYPE_NODEBRANCHED) {
+        treeTraceAppend(scip, node, TREE_TRACE_STATUS_BRANCHED);
+        treeTraceAddChildren(scip);
+    } else if (type == SCIP_EVENTTYPE_NODEFEASIBLE) {
+        treeTraceAppend(scip, node, TREE_TRACE_STATUS_SOLUTION);
+    } else if (type == SCIP_EVENTTYPE_NODEINFEASIBLE) {
+        // Distinguish bound pruning from LP infeasibility
+        SCIP_Bool pruned = !SCIPisInfinity(scip, SCIPgetCutoffbound(scip))
+            && SCIPisGE(scip, SCIPnodeGetLowerbound(node), SCIPgetCutoffbound(scip));
+        treeTraceAppend(scip, node, pruned ? TREE_TRACE_STATUS_PRUNED : TREE_TRACE_STATUS_INFEASIBLE);
     }
 
-    last_pricing_result = (int)pending_pricer_result;
+    return SCIP_OKAY;
+}
 
-    current_pricing_mode = 0;
+static SCIP_DECL_EVENTINITSOL(eventInitsolTreeTrace)
+{
+    if (tree_trace_capacity > 0) {
+        SCIP_CALL(SCIPcatchEvent(scip, SCIP_EVENTTYPE_NODEEVENT, eventhdlr, NULL, NULL));
+        tree_trace_catching = TRUE;
+    }
+    return SCIP_OKAY;
+}
+
+static SCIP_DECL_EVENTEXITSOL(eventExitsolTreeTrace)
+{
+    if (tree_trace_catching) {
+        SCIP_CALL(SCIPdropEvent(scip, SCIP_EVENTTYPE_NODEEVENT, eventhdlr, NULL, -1));
+        tree_trace_catching = FALSE;
+    }
     return SCIP_OKAY;
 }
 
 // ============================================
-// Exported API Functions
+// Event Handler: Solver phase spans for profiling
 // ============================================
+static SCIP_DECL_EVENTINIT(eventInitProfile)
+{
+    // Called once the problem has been transformed; presolving starts next
+    if (profile_spans != NULL && profile_solve_start > 0.0) {
+        profileEnd(PROFILE_SPAN_TRANSFORM, profile_solve_start, 0);
+        profile_presolve_start = emscripten_get_now();
+    }
+    return SCIP_OKAY;
+}
+
+static SCIP_DECL_EVENTINITSOL(eventInitsolProfile)
+{
+    if (profile_spans == NULL) {
+        return SCIP_OKAY;
+    }
+
+    if (profile_presolve_start > 0.0) {
+        profileEnd(PROFILE_SPAN_PRESOLVE, profile_presolve_start, 0);
+        profile_presolve_start = 0.0;
+    }
+
+    profile_root_start = 0.0;
+    profile_bnb_start = 0.0;
+    profile_root_lp_done = FALSE;
+    SCIP_CALL(SCIPcatchEvent(scip, SCIP_EVENTTYPE_NODEFOCUSED | SCIP_EVENTTYPE_NODESOLVED | SCIP_EVENTTYPE_FIRSTLPSOLVED,
+        eventhdlr, NULL, NULL));
+    profile_catching = TRUE;
+    return SCIP_OKAY;
+}
+
+static SCIP_DECL_EVENTEXITSOL(eventExitsolProfile)
+{
+    if (!profile_catching) {
+        return SCIP_OKAY;
+    }
+
+    SCIP_CALL(SCIPdropEvent(scip, SCIP_EVENTTYPE_NODEFOCUSED | SCIP_EVENTTYPE_NODESOLVED | SCIP_EVENTTYPE_FIRSTLPSOLVED,
+        eventhdlr, NULL, -1));
+    profile_catching = FALSE;
+    return SCIP_OKAY;
+}
+
+static SCIP_DECL_EVENTEXEC(eventExecProfile)
+{
+    SCIP_EVENTTYPE type = SCIPeventGetType(event);
+
+    if (type == SCIP_EVENTTYPE_NODEFOCUSED) {
+        if (profile_root_start == 0.0 && SCIPgetDepth(scip) == 0) {
+            profile_root_start = emscripten_get_now();
+        }
+    } else if (type == SCIP_EVENTTYPE_FIRSTLPSOLVED) {
+        if (!profile_root_lp_done && profile_root_start > 0.0 && SCIPgetDepth(scip) == 0) {
+            profileEnd(PROFILE_SPAN_ROOT_LP, profile_root_start, 0);
+            profile_root_lp_done = TRUE;
+        }
+    } else if (profile_root_start > 0.0 && profile_bnb_start == 0.0) {
+        // First solved node is the root; everything after it is tree search
+        profileEnd(PROFILE_SPAN_ROOT_NODE, profile_root_start, 0);
+        profile_bnb_start = emscripten_get_now();
+    }
+    return SCIP_OKAY;
+}
+
+// ============================================
+// Event Handler: Memory samples at phase boundaries and every N nodes
+// ============================================
+static SCIP_DECL_EVENTINIT(eventInitMemory)
+{
+    memorySample(MEMORY_PHASE_TRANSFORMED);
+    return SCIP_OKAY;
+}
+
+static SCIP_DECL_EVENTINITSOL(eventInitsolMemory)
+{
+    if (memory_samples == NULL) {
+        return SCIP_OKAY;
+    }
+
+    memorySample(MEMORY_PHASE_PRESOLVED);
+    memory_root_sampled = FALSE;
+    SCIP_CALL(SCIPcatchEvent(scip, SCIP_EVENTTYPE_NODESOLVED, eventhdlr, NULL, NULL));
+    memory_catching = TRUE;
+    return SCIP_OKAY;
+}
+
+static SCIP_DECL_EVENTEXITSOL(eventExitsolMemory)
+{
+    if (memory_catching) {
+        SCIP_CALL(SCIPdropEvent(scip, SCIP_EVENTTYPE_NODESOLVED, eventhdlr, NULL, -1));
+        memory_catching = FALSE;
+    }
+    return SCIP_OKAY;
+}
+
+static SCIP_DECL_EVENTEXEC(eventExecMemory)
+{
+    if (!memory_root_sampled) {
+        memorySample(MEMORY_PHASE_ROOT);
+        memory_root_sampled = TRUE;
+    } else if (memory_node_interval > 0 && SCIPgetNNodes(scip) % memory_node_interval == 0) {
+        memorySample(MEMORY_PHASE_NODES);
+    }
+    return SCIP_OKAY;
+}
+
+// ============================================
+// Event Handler: Live progress block (rate-capped)
+// ============================================
+static SCIP_DECL_EVENTINIT(eventInitProgress)
+{
+    progress_start = emscripten_get_now();
+    progress_last = 0.0;
+    progressPublish(scip, TRUE);
+    return SCIP_OKAY;
+}
+
+static SCIP_DECL_EVENTINITSOL(eventInitsolProgress)
+{
+    if (js_progress_callback == NULL) {
+        return SCIP_OKAY;
+    }
+
+    progressPublish(scip, TRUE);
+    SCIP_CALL(SCIPcatchEvent(scip, SCIP_EVENTTYPE_NODESOLVED | SCIP_EVENTTYPE_BESTSOLFOUND, eventhdlr, NULL, NULL));
+    progress_catching = TRUE;
+    return SCIP_OKAY;
+}
+
+static SCIP_DECL_EVENTEXITSOL(eventExitsolProgress)
+{
+    if (progress_catching) {
+        SCIP_CALL(SCIPdropEvent(scip, SCIP_EVENTTYPE_NODESOLVED | SCIP_EVENTTYPE_BESTSOLFOUND, eventhdlr, NULL, -1));
+        progress_catching = FALSE;
+    }
+    return SCIP_OKAY;
+}
+
+static SCIP_DECL_EVENTEXEC(eventExecProgress)
+{
+    // New incumbents are published at once, node progress at the capped rate
+    progressPublish(scip, SCIPeventGetType(event) == SCIP_EVENTTYPE_BESTSOLFOUND);
+    return SCIP_OKAY;
+}
+
+// ============================================
+// Event Handler: Mailbox for live cutoffs and injected solutions
+// ============================================
+static SCIP_RETCODE mailboxApply(SCIP* scip, int flags)
+{
+    if (flags & MAILBOX_SOLUTION) {
+        SCIP_SOL* sol;
+        SCIP_Bool stored = FALSE;
+        SCIP_CALL(SCIPcreateOrigSol(scip, &sol, NULL));
+        for (int i = 0; i < mailbox_capacity; ++i) {
+            SCIP_CALL(SCIPsetSolVal(scip, sol, var_registry[i], mailbox_buffer[1 + i]));
+        }
+        SCIP_CALL(SCIPtrySolFree(scip, &sol, FALSE, FALSE, TRUE, TRUE, TRUE, &stored));
+        mailbox_sols_tried += 1.0;
+        mailbox_sols_stored += stored ? 1.0 : 0.0;
+    }
+
+    if (flags & MAILBOX_OBJLIMIT) {
+        // SCIP refuses to relax the limit once transformed, so only tighten it
+        SCIP_Real objlimit = mailbox_buffer[0];
+        if (SCIPgetStage(scip) == SCIP_STAGE_SOLVING) {
+            // SCIPsetObjlimit is not allowed while solving; the cutoff bound is
+            // the same limit in transformed (minimization) space
+            SCIP_Real cutoff = SCIPtransformObj(scip, objlimit);
+            if (cutoff < SCIPgetCutoffbound(scip)) {
+                SCIP_CALL(SCIPupdateCutoffbound(scip, cutoff));
+                mailbox_objlimits += 1.0;
+            }
+        } else {
+            SCIP_Real current = SCIPgetObjlimit(scip);
+            SCIP_Bool tighter = SCIPgetObjsense(scip) == SCIP_OBJSENSE_MINIMIZE ? objlimit < current : objlimit > current;
+            if (tighter) {
+                SCIP_CALL(SCIPsetObjlimit(scip, objlimit));
+                mailbox_objlimits += 1.0;
+            }
+        }
+    }
+    return SCIP_OKAY;
+}
+
+static SCIP_DECL_EVENTINITSOL(eventInitsolMailbox)
+{
+    if (js_mailbox_callback == NULL) {
+        return SCIP_OKAY;
+    }
+
+    mailbox_capacity = var_registry_size;
+    mailbox_buffer = (double*)malloc((size_t)(mailbox_capacity + 1) * sizeof(double));
+    if (mailbox_buffer == NULL) {
+        return SCIP_NOMEMORY;
+    }
+    SCIP_CALL(SCIPcatchEvent(scip, SCIP_EVENTTYPE_NODEFOCUSED, eventhdlr, NULL, NULL));
+    mailbox_catching = TRUE;
+    return SCIP_OKAY;
+}
+
+static SCIP_DECL_EVENTEXITSOL(eventExitsolMailbox)
+{
+    if (mailbox_catching) {
+        SCIP_CALL(SCIPdropEvent(scip, SCIP_EVENTTYPE_NODEFOCUSED, eventhdlr, NULL, -1));
+        mailbox_catching = FALSE;
+    }
+    free(mailbox_buffer);
+    mailbox_buffer = NULL;
+    mailbox_capacity = 0;
+    return SCIP_OKAY;
+}
+
+static SCIP_DECL_EVENTEXEC(eventExecMailbox)
+{
+    if (js_mailbox_callback == NULL) {
+        return SCIP_OKAY;
+    }
+
+    mailbox_polls += 1.0;
+    int flags = js_mailbox_callback(mailbox_buffer, mailbox_capacity);
+    if (flags != 0) {
+        SCIP_CALL(mailboxApply(scip, flags));
+    }
+    return SCIP_OKAY;
+}
+
+// ============================================
+// Include event handlers
+// ============================================
+static SCIP_RETCODE includeEventHandlers(SCIP* scip)
+{
+    SCIP_EVENTHDLR* eventhdlr;
+    
+    // Best solution found event
+    SCIP_CALL(SCIPincludeEventhdlrBasic(scip, &eventhdlr, "bestsol_js",
+        "JavaScript callback for best solution found",
+        eventExecBestSol, NULL));
+    SCIP_CALL(SCIPsetEventhdlrInit(scip, eventhdlr, NULL));
+    
+    // Node focus events for the JS node callback (caught only while one is set)
+    SCIP_CALL(SCIPincludeEventhdlrBasic(scip, &eventhdlr, "node_js",
+        "JavaScript callback for node selection",
+        eventExecNode, NULL));
+    SCIP_CALL(SCIPsetEventhdlrInitsol(scip, eventhdlr, eventInitsolNode));
+    SCIP_CALL(SCIPsetEventhdlrExitsol(scip, eventhdlr, eventExitsolNode));
+    
+    // Node events for the tree trace (caught only while tracing is enabled)
+    SCIP_CALL(SCIPincludeEventhdlrBasic(scip, &eventhdlr, "treetrace_js",
+        "Branch-and-bound tree trace recorder",
+        eventExecTreeTrace, NULL));
+    SCIP_CALL(SCIPsetEventhdlrInitsol(scip, eventhdlr, eventInitsolTreeTrace));
+    SCIP_CALL(SCIPsetEventhdlrExitsol(scip, eventhdlr, eventExitsolTreeTrace));
+    
+    // Solver phase boundaries for profiling spans
+    SCIP_CALL(SCIPincludeEventhdlrBasic(scip, &eventhdlr, "profile_js",
+        "Solver phase spans for profiling",
+        eventExecProfile, NULL));
+    SCIP_CALL(SCIPsetEventhdlrInit(scip, eventhdlr, eventInitProfile));
+    SCIP_CALL(SCIPsetEventhdlrInitsol(scip, eventhdlr, eventInitsolProfile));
+    SCIP_CALL(SCIPsetEventhdlrExitsol(scip, eventhdlr, eventExitsolProfile));
+    
+    // Memory samples at phase boundaries and every N nodes
+    SCIP_CALL(SCIPincludeEventhdlrBasic(scip, &eventhdlr, "memory_js",
+        "Memory usage sampling",
+        eventExecMemory, NULL));
+    SCIP_CALL(SCIPsetEventhdlrInit(scip, eventhdlr, eventInitMemory));
+    SCIP_CALL(SCIPsetEventhdlrInitsol(scip, eventhdlr, eventInitsolMemory));
+    SCIP_CALL(SCIPsetEventhdlrExitsol(scip, eventhdlr, eventExitsolMemory));
+    
+    // Live progress block for the JS progress callback (caught only while one is set)
+    SCIP_CALL(SCIPincludeEventhdlrBasic(scip, &eventhdlr, "progress_js",
+        "Live progress publishing",
+        eventExecProgress, NULL));
+    SCIP_CALL(SCIPsetEventhdlrInit(scip, eventhdlr, eventInitProgress));
+    SCIP_CALL(SCIPsetEventhdlrInitsol(scip, eventhdlr, eventInitsolProgress));
+    SCIP_CALL(SCIPsetEventhdlrExitsol(scip, eventhdlr, eventExitsolProgress));
+    
+    // Shared-memory mailbox polled at node boundaries (caught only while a callback is set)
+    SCIP_CALL(SCIPincludeEventhdlrBasic(scip, &eventhdlr, "mailbox_js",
+        "Live cutoff and solution injection",
+        eventExecMailbox, NULL));
+    SCIP_CALL(SCIPsetEventhdlrInitsol(scip, eventhdlr, eventInitsolMailbox));
+    SCIP_CALL(SCIPsetEventhdlrExitsol(scip, eventhdlr, eventExitsolMailbox));
+    
+    return SCIP_OKAY;
+}
+
+// ============================================
+// Dual stabilization for the redcost pricer
+// ============================================
+// Transformed counterpart of a registered linear constraint, NULL if none
+static SCIP_CONS* transformedLinearCons(SCIP* scip, SCIP_CONS* cons)
+{
+    if (cons == NULL) {
+        return NULL;
+    }
+    if (SCIPconsIsOriginal(cons)) {
+        SCIP_CONS* transcons = NULL;
+        if (SCIPgetTransformedCons(scip, cons, &transcons) != SCIP_OKAY || transcons == NULL) {
+            return NULL;
+        }
+        cons = transcons;
+    }
+    return strcmp(SCIPconshdlrGetName(SCIPconsGetHdlr(cons)), "linear") == 0 ? cons : NULL;
+}
+
+// LP row of a registered linear constraint, NULL if it has none in the LP
+static SCIP_ROW* stabConsRow(SCIP* scip, SCIP_CONS* cons)
+{
+    cons = transformedLinearCons(scip, cons);
+    if (cons == NULL) {
+        return NULL;
+    }
+    SCIP_ROW* row = SCIPgetRowLinear(scip, cons);
+    return row != NULL && SCIProwIsInLP(row) ? row : NULL;
+}
+
+static SCIP_Bool stabEnsureSize(int n)
+{
+    if (n <= stab_size) {
+        return TRUE;
+    }
+    double* center = (double*)realloc(stab_center, (size_t)n * sizeof(double));
+    if (center == NULL) {
+        return FALSE;
+    }
+    stab_center = center;
+    // Constraints registered since the last round have no center yet
+    for (int i = stab_size; i < n; ++i) {
+        stab_center[i] = NAN;
+    }
+    double* out = (double*)realloc(stab_out, (size_t)n * sizeof(double));
+    double* duals = out == NULL ? NULL : (double*)realloc(stab_duals, (size_t)n * sizeof(double));
+    SCIP_ROW** rows = duals == NULL ? NULL : (SCIP_ROW**)realloc(stab_rows, (size_t)n * sizeof(SCIP_ROW*));
+    stab_out = out != NULL ? out : stab_out;
+    stab_duals = duals != NULL ? duals : stab_duals;
+    stab_rows = rows != NULL ? rows : stab_rows;
+    if (rows == NULL) {
+        return FALSE;
+    }
+    stab_size = n;
+    return TRUE;
+}
+
+// Start of a redcost round: the LP duals of the registered linear constraints
+static SCIP_Bool stabBegin(SCIP* scip)
+{
+    if (stab_mode == STAB_NONE || cons_registry_size == 0 || !stabEnsureSize(cons_registry_size)) {
+        return FALSE;
+    }
+
+    SCIP_Longint node = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+    if (node != stab_node) {
+        stab_node = node;
+        stab_node_bound = SCIP_INVALID;
+    }
+    for (int i = 0; i < stab_size; ++i) {
+        stab_rows[i] = stabConsRow(scip, cons_registry[i]);
+        stab_out[i] = stab_rows[i] != NULL ? SCIProwGetDualsol(stab_rows[i]) : NAN;
+    }
+    return TRUE;
+}
+
+/**
+ * Hand the stabilized duals after k mispricings to the pricer: smoothing with
+ * alpha_k = 1 - (k + 1)(1 - alpha), or the box widened 2^k times. Returns FALSE
+ * once they coincide with the LP duals, which the pricer then sees unchanged.
+ */
+static SCIP_Bool stabApply(SCIP* scip, int k)
+{
+    SCIP_Bool differs = FALSE;
+    double alpha = 1.0 - (k + 1) * (1.0 - stab_value);
+    double width = ldexp(stab_value, k);
+    for (int i = 0; i < stab_size; ++i) {
+        double out = stab_out[i];
+        if (isnan(out)) {
+            stab_duals[i] = NAN;
+            continue;
+        }
+        double center = stab_center_valid && !isnan(stab_center[i]) ? stab_center[i] : out;
+        double dual;
+        if (stab_mode == STAB_SMOOTHING) {
+            dual = alpha > 0.0 ? alpha * center + (1.0 - alpha) * out : out;
+        } else {
+            dual = out < center - width ? center - width : out > center + width ? center + width : out;
+        }
+        stab_duals[i] = dual;
+        differs = differs || fabs(dual - out) > 1e-9 * (fabs(out) > 1.0 ? fabs(out) : 1.0);
+    }
+
+    stab_active = FALSE;
+    if (!differs) {
+        return FALSE;
+    }
+
+    // Same values by LP position for the row-based getters
+    int nrows = SCIPgetNLPRows(scip);
+    if (nrows > stab_row_capacity) {
+        double* grown = (double*)realloc(stab_row_duals, (size_t)nrows * sizeof(double));
+        if (grown == NULL) {
+            return FALSE;
+        }
+        stab_row_duals = grown;
+        stab_row_capacity = nrows;
+    }
+    SCIP_ROW** rows = SCIPgetLPRows(scip);
+    for (int r = 0; r < nrows; ++r) {
+        stab_row_duals[r] = SCIProwGetDualsol(rows[r]);
+    }
+    for (int i = 0; i < stab_size; ++i) {
+        int pos = stab_rows[i] != NULL ? SCIProwGetLPPos(stab_rows[i]) : -1;
+        if (pos >= 0 && pos < nrows) {
+            stab_row_duals[pos] = stab_duals[i];
+        }
+    }
+    stab_nrows = nrows;
+    stab_active = TRUE;
+    return TRUE;
+}
+
+/**
+ * End of a redcost round: the center moves to the point the pricer saw last
+ * unless the Lagrangian bound it reported there fell behind the node's best;
+ * with adaptive stabilization, mispricings weaken it and clean rounds firm it up.
+ */
+static void stabEnd(int mispricings, SCIP_Real lowerbound)
+{
+    SCIP_Bool move = lowerbound == SCIP_INVALID || stab_node_bound == SCIP_INVALID || lowerbound >= stab_node_bound - 1e-9;
+    if (lowerbound != SCIP_INVALID && (stab_node_bound == SCIP_INVALID || lowerbound > stab_node_bound)) {
+        stab_node_bound = lowerbound;
+    }
+    if (move) {
+        for (int i = 0; i < stab_size; ++i) {
+            stab_center[i] = stab_active ? stab_duals[i] : stab_out[i];
+        }
+        stab_center_valid = TRUE;
+    }
+
+    if (stab_adaptive) {
+        if (stab_mode == STAB_SMOOTHING) {
+            stab_value = mispricings > 0 ? fmax(0.0, stab_value - 0.1) : fmin(0.95, stab_value + 0.05);
+        } else {
+            stab_value = mispricings > 0 ? stab_value * 2.0 : fmax(1e-6, stab_value * 0.9);
+        }
+    }
+    stab_active = FALSE;
+}
+
+// LP dual of a constraint handle as read at the start of the round, 0 without an LP row
+static double stabOutDual(int consId)
+{
+    return consId >= 1 && consId <= stab_size && !isnan(stab_out[consId - 1]) ? stab_out[consId - 1] : 0.0;
+}
+
+/**
+ * Track a column added while pricing at stabilized duals: its reduced cost at
+ * the LP duals starts at `redcost` (the objective, before coefficients are added)
+ */
+static void stabTrackColumn(int varId, double redcost)
+{
+    if (!stab_active || varId < stab_first_var) {
+        return;
+    }
+    int index = varId - stab_first_var;
+    if (index >= stab_added_capacity) {
+        int capacity = index + 1 > 2 * stab_added_capacity ? index + 1 : 2 * stab_added_capacity;
+        double* grown = (double*)realloc(stab_added_redcost, (size_t)capacity * sizeof(double));
+        if (grown == NULL) {
+            return;
+        }
+        stab_added_redcost = grown;
+        stab_added_capacity = capacity;
+    }
+    for (int i = stab_added; i < index; ++i) {
+        stab_added_redcost[i] = 0.0;
+    }
+    stab_added_redcost[index] = redcost;
+    stab_added = index + 1 > stab_added ? index + 1 : stab_added;
+}
+
+static void stabTrackCoef(int varId, double dual, double coef)
+{
+    int index = varId - stab_first_var;
+    if (stab_active && index >= 0 && index < stab_added) {
+        stab_added_redcost[index] -= dual * coef;
+    }
+}
+
+// Whether a column added in this call prices out at the LP duals themselves
+static SCIP_Bool stabAddedImproving(SCIP* scip)
+{
+    for (int i = 0; i < stab_added; ++i) {
+        if (SCIPisDualfeasNegative(scip, stab_added_redcost[i])) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/**
+ * Record the LP size a pricer call worked on; columns it added are still in
+ * the price store, so the counts are those of the LP the call priced against
+ */
+static void pricingTraceAppend(SCIP* scip, int mode, int mispricings)
+{
+    if (pricing_trace_capacity <= 0) {
+        return;
+    }
+    if (pricing_trace_size >= pricing_trace_capacity) {
+        pricing_trace_dropped += 1;
+        return;
+    }
+
+    PRICINGTRACERECORD* rec = &pricing_trace[pricing_trace_size];
+    rec->time = (emscripten_get_now() - pricing_trace_start) / 1000.0;
+    rec->lpobj = mode == PRICING_TRACE_MODE_REDCOST ? SCIPgetLPObjval(scip) : NAN;
+    rec->node = (unsigned int)SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+    rec->round = pricer_round;
+    rec->mode = mode;
+    rec->lpcols = SCIPgetNLPCols(scip);
+    rec->lprows = SCIPgetNLPRows(scip);
+    rec->added = added_vars_this_call;
+    rec->pooled = SCIPgetNVars(scip) - rec->lpcols;
+    rec->mispricings = mispricings;
+    pricing_trace_size += 1;
+}
+
+// ============================================
+// Pricer callbacks (JavaScript bridge)
+// ============================================
+static SCIP_DECL_PRICERREDCOST(pricerRedcostJs)
+{
+    (void)pricer;
+
+    double roundstart = profileBegin();
+    current_pricing_mode = 1;
+    last_pricing_mode = 1;
+    pricer_redcost_calls += 1;
+    pricer_round += 1;
+    added_vars_this_call = 0;
+    pending_pricer_result = SCIP_SUCCESS;
+    pending_pricer_lowerbound = SCIP_INVALID;
+    pending_pricer_stopearly = FALSE;
+    pending_pricer_abortround = FALSE;
+
+    SCIP_Bool stabilized = stabBegin(scip);
+    stab_first_var = var_registry_size + 1;
+    stab_added = 0;
+    int mispricings = 0;
+    SCIP_Real bestbound = SCIP_INVALID;
+    if (stabilized && stabApply(scip, 0)) {
+        stab_rounds += 1.0;
+    }
+
+    for (;;) {
+        if (pricing_ntemplates > 0) {
+            SCIP_CALL(pricingTemplatesPrice(scip, FALSE));
+        }
+        if (js_pricer_redcost_callback != NULL) {
+            double spanstart = profileBegin();
+            js_pricer_redcost_callback(pricer_round);
+            profileEnd(PROFILE_SPAN_JS_CALLBACK, spanstart, PROFILE_CALLBACK_PRICER_REDCOST);
+        }
+        // Lagrangian bounds hold at any dual point; keep the best of the round
+        if (pending_pricer_lowerbound != SCIP_INVALID && (bestbound == SCIP_INVALID || pending_pricer_lowerbound > bestbound)) {
+            bestbound = pending_pricer_lowerbound;
+        }
+
+        // No column at stabilized duals that also improves at the LP duals is a
+        // mispricing: the LP would not move, so price again closer to the LP duals
+        if (!stab_active || pending_pricer_abortround || pending_pricer_result != SCIP_SUCCESS
+            || (added_vars_this_call > 0 && stabAddedImproving(scip))) {
+            break;
+        }
+        mispricings += 1;
+        stab_mispricings += 1.0;
+        pricer_round += 1;
+        pending_pricer_lowerbound = SCIP_INVALID;
+        if (!stabApply(scip, mispricings)) {
+            stab_fallbacks += 1.0;
+        }
+    }
+    pending_pricer_lowerbound = bestbound;
+    if (stabilized) {
+        stabEnd(mispricings, bestbound);
+    }
+    // A template stopped by a limit without a column does not prove the LP optimal
+    if (pricing_ntemplates > 0 && !pricing_templates_complete && added_vars_this_call == 0) {
+        pending_pricer_result = SCIP_DIDNOTRUN;
+    }
+
+    if (pending_pricer_abortround) {
+        pending_pricer_result = SCIP_DIDNOTRUN;
+        pending_pricer_stopearly = TRUE;
+        SCIPinterruptSolve(scip);
+    }
+
+    if (lowerbound != NULL && pending_pricer_lowerbound != SCIP_INVALID) {
+        *lowerbound = pending_pricer_lowerbound;
+    }
+
+    if (stopearly != NULL) {
+        *stopearly = pending_pricer_stopearly;
+    }
+
+    if (result != NULL) {
+        *result = pending_pricer_result;
+    }
+
+    last_pricing_result = (int)pending_pricer_result;
+    pricingTraceAppend(scip, PRICING_TRACE_MODE_REDCOST, mispricings);
+
+    current_pricing_mode = 0;
+    profileEnd(PROFILE_SPAN_PRICING_REDCOST, roundstart, pricer_round);
+    return SCIP_OKAY;
+}
+
+static SCIP_DECL_PRICERFARKAS(pricerFarkasJs)
+{
+    (void)pricer;
+
+    double roundstart = profileBegin();
+    current_pricing_mode = 2;
+    last_pricing_mode = 2;
+    pricer_farkas_calls += 1;
+    pricer_round += 1;
+    added_vars_this_call = 0;
+    pending_pricer_result = SCIP_SUCCESS;
+    pending_pricer_abortround = FALSE;
+
+    if (!SCIPhasCurrentNodeLP(scip)) {
+        pending_pricer_result = SCIP_DIDNOTRUN;
+        last_pricing_result = (int)pending_pricer_result;
+        current_pricing_mode = 0;
+        if (result != NULL) {
+            *result = pending_pricer_result;
+        }
+        profileEnd(PROFILE_SPAN_PRICING_FARKAS, roundstart, pricer_round);
+        return SCIP_OKAY;
+    }
+
+    if (pricing_ntemplates > 0) {
+        SCIP_CALL(pricingTemplatesPrice(scip, TRUE));
+    }
+    if (js_pricer_farkas_callback != NULL) {
+        double spanstart = profileBegin();
+        js_pricer_farkas_callback(pricer_round);
+        profileEnd(PROFILE_SPAN_JS_CALLBACK, spanstart, PROFILE_CALLBACK_PRICER_FARKAS);
+    }
+    if (pricing_ntemplates > 0 && !pricing_templates_complete && added_vars_this_call == 0) {
+        pending_pricer_result = SCIP_DIDNOTRUN;
+    }
+
+    if (pending_pricer_abortround) {
+        pending_pricer_result = SCIP_DIDNOTRUN;
+        SCIPinterruptSolve(scip);
+    }
+
+    if (result != NULL) {
+        *result = pending_pricer_result;
+    }
+
+    last_pricing_result = (int)pending_pricer_result;
+    pricingTraceAppend(scip, PRICING_TRACE_MODE_FARKAS, 0);
+
+    current_pricing_mode = 0;
+    profileEnd(PROFILE_SPAN_PRICING_FARKAS, roundstart, pricer_round);
+    return SCIP_OKAY;
+}
+
+// ============================================
+// Union-find over variable indices (path halving, union by size)
+// ============================================
+static int ufFind(int* parent, int x)
+{
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+static void ufUnion(int* parent, int* size, int a, int b)
+{
+    a = ufFind(parent, a);
+    b = ufFind(parent, b);
+    if (a == b) {
+        return;
+    }
+    if (size[a] < size[b]) {
+        int t = a;
+        a = b;
+        b = t;
+    }
+    parent[b] = a;
+    size[a] += size[b];
+}
+
+// ============================================
+// Checkpoint layout and resume branching rule
+// ============================================
+// Section offsets in 64 bits: on wasm32 a size_t product of header counts wraps
+static void checkpointLayout(const int* header, CHECKPOINTLAYOUT* layout)
+{
+    uint64_t nvars = (uint64_t)(uint32_t)header[2];
+    uint64_t nnodes = (uint64_t)(uint32_t)header[3];
+    uint64_t nbdchgs = (uint64_t)(uint32_t)header[4];
+    uint64_t nsols = (uint64_t)(uint32_t)header[5];
+
+    layout->nodelb = CHECKPOINT_HEADER_INTS * sizeof(int) + CHECKPOINT_STATS * sizeof(double);
+    layout->bdval = layout->nodelb + nnodes * sizeof(double);
+    layout->sols = layout->bdval + nbdchgs * sizeof(double);
+    layout->pseudocost = layout->sols + nsols * nvars * sizeof(double);
+    layout->nodestart = layout->pseudocost + 4 * nvars * sizeof(double);
+    layout->bdvar = layout->nodestart + (nnodes + 1) * sizeof(int);
+    layout->bdtype = layout->bdvar + nbdchgs * sizeof(int);
+    layout->size = layout->bdtype + nbdchgs;
+}
+
+/**
+ * Root branching of a resumed solve: one child per checkpointed open node with
+ * its bound changes. Bound changes on variables presolve removed are dropped,
+ * which only enlarges the child (its old lower bound is then not reused).
+ */
+static SCIP_RETCODE checkpointBranch(SCIP* scip, SCIP_RESULT* result)
+{
+    *result = SCIP_DIDNOTRUN;
+    if (resume_data == NULL || !resume_pending || SCIPgetDepth(scip) != 0) {
+        return SCIP_OKAY;
+    }
+    resume_pending = FALSE;
+
+    const int* header = (const int*)resume_data;
+    CHECKPOINTLAYOUT layout;
+    checkpointLayout(header, &layout);
+    int nvars = header[2];
+    int nnodes = header[3];
+    const double* nodelb = (const double*)(resume_data + layout.nodelb);
+    const double* bdval = (const double*)(resume_data + layout.bdval);
+    const double* pseudocost = (const double*)(resume_data + layout.pseudocost);
+    const int* nodestart = (const int*)(resume_data + layout.nodestart);
+    const int* bdvar = (const int*)(resume_data + layout.bdvar);
+    const unsigned char* bdtype = resume_data + layout.bdtype;
+
+    if (header[6] & CHECKPOINT_FLAG_PSEUDOCOSTS) {
+        for (int i = 0; i < nvars; ++i) {
+            SCIP_VAR* var = SCIPvarGetTransVar(var_registry[i]);
+            if (var == NULL || !SCIPvarIsActive(var)) {
+                continue;
+            }
+            if (pseudocost[2 * nvars + i] > 0.0) {
+                SCIP_CALL(SCIPupdateVarPseudocost(scip, var, -1.0, pseudocost[i], pseudocost[2 * nvars + i]));
+            }
+            if (pseudocost[3 * nvars + i] > 0.0) {
+                SCIP_CALL(SCIPupdateVarPseudocost(scip, var, 1.0, pseudocost[nvars + i], pseudocost[3 * nvars + i]));
+            }
+        }
+    }
+
+    // Nothing was open: the incumbent was optimal
+    if (nnodes == 0) {
+        *result = SCIP_CUTOFF;
+        return SCIP_OKAY;
+    }
+
+    for (int k = 0; k < nnodes; ++k) {
+        SCIP_Bool exact = nodelb[k] < SCIP_INVALID;
+        SCIP_Bool empty = FALSE;
+
+        // Children may not loosen global bounds; an empty box is skipped
+        for (int b = nodestart[k]; b < nodestart[k + 1]; ++b) {
+            SCIP_VAR* var = SCIPvarGetTransVar(var_registry[bdvar[b]]);
+            if (var == NULL || !SCIPvarIsActive(var)) {
+                exact = FALSE;
+            } else if (bdtype[b] == 0 ? SCIPisGT(scip, bdval[b], SCIPvarGetUbGlobal(var))
+                                      : SCIPisLT(scip, bdval[b], SCIPvarGetLbGlobal(var))) {
+                empty = TRUE;
+            }
+        }
+        if (empty) {
+            continue;
+        }
+
+        SCIP_Real lowerbound = exact ? SCIPtransformObj(scip, nodelb[k]) : SCIPgetLocalLowerbound(scip);
+        SCIP_NODE* child;
+        SCIP_CALL(SCIPcreateChild(scip, &child, 0.0, lowerbound));
+
+        for (int b = nodestart[k]; b < nodestart[k + 1]; ++b) {
+            SCIP_VAR* var = SCIPvarGetTransVar(var_registry[bdvar[b]]);
+            if (var == NULL || !SCIPvarIsActive(var)) {
+                continue;
+            }
+            if (bdtype[b] == 0 && SCIPisGT(scip, bdval[b], SCIPvarGetLbGlobal(var))) {
+                SCIP_CALL(SCIPchgVarLbNode(scip, child, var, bdval[b]));
+            } else if (bdtype[b] == 1 && SCIPisLT(scip, bdval[b], SCIPvarGetUbGlobal(var))) {
+                SCIP_CALL(SCIPchgVarUbNode(scip, child, var, bdval[b]));
+            }
+        }
+
+        if (exact) {
+            SCIP_CALL(SCIPupdateNodeLowerbound(scip, child, lowerbound));
+        }
+        resume_nodes_created += 1;
+    }
+
+    *result = resume_nodes_created > 0 ? SCIP_BRANCHED : SCIP_CUTOFF;
+    return SCIP_OKAY;
+}
+
+static SCIP_DECL_BRANCHEXECLP(branchExeclpCheckpoint)
+{
+    (void)branchrule;
+    (void)allowaddcons;
+    return checkpointBranch(scip, result);
+}
+
+static SCIP_DECL_BRANCHEXECPS(branchExecpsCheckpoint)
+{
+    (void)branchrule;
+    (void)allowaddcons;
+    return checkpointBranch(scip, result);
+}
+
+static SCIP_RETCODE includeCheckpointBranchrule(SCIP* scip)
+{
+    SCIP_BRANCHRULE* branchrule;
+
+    // Highest priority, root only; does nothing unless a checkpoint is being resumed
+    SCIP_CALL(SCIPincludeBranchruleBasic(scip, &branchrule, "checkpoint_js",
+        "Re-creates the open nodes of a checkpoint at the root", 1000000, 0, 1.0, NULL));
+    SCIP_CALL(SCIPsetBranchruleExecLp(scip, branchrule, branchExeclpCheckpoint));
+    SCIP_CALL(SCIPsetBranchruleExecPs(scip, branchrule, branchExecpsCheckpoint));
+    return SCIP_OKAY;
+}
+
+// ============================================
+// Exported API Functions
+// ============================================
+
+/**
+ * Create and initialize SCIP instance
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_create(void)
+{
+    if (scip_instance != NULL) {
+        return 0; // Already created
+    }
+    
+    SCIP_CALL(SCIPcreate(&scip_instance));
+    SCIP_CALL(SCIPincludeDefaultPlugins(scip_instance));
+    SCIP_CALL(includeEventHandlers(scip_instance));
+    SCIP_CALL(includeCheckpointBranchrule(scip_instance));
+    
+    // Catch best solution events
+    SCIP_CALL(SCIPcatchEvent(scip_instance, SCIP_EVENTTYPE_BESTSOLFOUND, 
+        SCIPfindEventhdlr(scip_instance, "bestsol_js"), NULL, NULL));
+    
+    return 1;
+}
+
+/**
+ * Free SCIP instance
+ */
+EMSCRIPTEN_KEEPALIVE
+void scip_free(void)
+{
+    if (scip_instance != NULL) {
+        clearCurrentProblem();
+        SCIPfree(&scip_instance);
+        scip_instance = NULL;
+    }
+    js_pricer = NULL;
+    js_pricer_redcost_callback = NULL;
+    js_pricer_farkas_callback = NULL;
+    resetPricingState();
+    clearRegistries();
+    freeArena();
+    closePlugins();
+    freeTreeTrace();
+    freePricingTrace();
+    freeProfileSpans();
+    freeMemorySamples();
+    free(checkpoint_data);
+    checkpoint_data = NULL;
+    checkpoint_size = 0;
+    free(cutpack_data);
+    cutpack_data = NULL;
+    cutpack_size = 0;
+    presolveFree();
+    bendersFree();
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_problem_clear(void)
+{
+    if (scip_instance == NULL) {
+        return 0;
+    }
+
+    clearCurrentProblem();
+    resetPricingState();
+    clearRegistries();
+    arenaReset();
+    js_pricer = NULL;
+    js_pricer_redcost_callback = NULL;
+    js_pricer_farkas_callback = NULL;
+    memorySample(MEMORY_PHASE_CLEARED);
+    return 1;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_problem_begin(const char* name, int maximize)
+{
+    if (scip_instance == NULL) {
+        return 0;
+    }
+
+    clearCurrentProblem();
+    resetPricingState();
+    clearRegistries();
+    arenaReset();
+    js_pricer = NULL;
+    js_pricer_redcost_callback = NULL;
+    js_pricer_farkas_callback = NULL;
+    memorySample(MEMORY_PHASE_CLEARED);
+
+    const char* problemname = (name != NULL && name[0] != '\0') ? name : "js_problem";
+    if (SCIPcreateProbBasic(scip_instance, problemname) != SCIP_OKAY) {
+        return 0;
+    }
+
+    SCIP_OBJSENSE sense = maximize ? SCIP_OBJSENSE_MAXIMIZE : SCIP_OBJSENSE_MINIMIZE;
+    if (SCIPsetObjsense(scip_instance, sense) != SCIP_OKAY) {
+        return 0;
+    }
+
+    return 1;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_add_cons_linear(
+    const char* name,
+    double lhs,
+    double rhs,
+    int initial,
+    int separate,
+    int enforce,
+    int check,
+    int propagate,
+    int local,
+    int modifiable,
+    int dynamic,
+    int removable,
+    int stickingatnode)
+{
+    if (scip_instance == NULL || name == NULL) {
+        return -1;
+    }
+
+    SCIP_CONS* cons = NULL;
+    SCIP_RETCODE ret = SCIPcreateConsLinear(
+        scip_instance,
+        &cons,
+        name,
+        0,
+        NULL,
+        NULL,
+        lhs,
+        rhs,
+        initial ? TRUE : FALSE,
+        separate ? TRUE : FALSE,
+        enforce ? TRUE : FALSE,
+        check ? TRUE : FALSE,
+        propagate ? TRUE : FALSE,
+        local ? TRUE : FALSE,
+        modifiable ? TRUE : FALSE,
+        dynamic ? TRUE : FALSE,
+        removable ? TRUE : FALSE,
+        stickingatnode ? TRUE : FALSE);
+
+    if (ret != SCIP_OKAY || cons == NULL) {
+        return -1;
+    }
+
+    ret = SCIPaddCons(scip_instance, cons);
+    if (ret != SCIP_OKAY) {
+        SCIPreleaseCons(scip_instance, &cons);
+        return -1;
+    }
+
+    int consId = registerConsHandle(cons);
+    SCIPreleaseCons(scip_instance, &cons);
+    return consId;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_set_cons_modifiable(int consId, int modifiable)
+{
+    if (scip_instance == NULL) {
+        return 0;
+    }
+
+    SCIP_CONS* cons = getConsByHandle(consId);
+    if (cons == NULL) {
+        return 0;
+    }
+
+    return SCIPsetConsModifiable(scip_instance, cons, modifiable ? TRUE : FALSE) == SCIP_OKAY ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_add_var(
+    const char* name,
+    double lb,
+    double ub,
+    double obj,
+    int vartype,
+    int initial,
+    int removable)
+{
+    if (scip_instance == NULL || name == NULL) {
+        return -1;
+    }
+
+    SCIP_VAR* var = NULL;
+    SCIP_RETCODE ret = SCIPcreateVarBasic(scip_instance, &var, name, lb, ub, obj, (SCIP_VARTYPE)vartype);
+    if (ret != SCIP_OKAY || var == NULL) {
+        return -1;
+    }
+
+    SCIP_CALL_ABORT(SCIPvarSetInitial(var, initial ? TRUE : FALSE));
+    SCIP_CALL_ABORT(SCIPvarSetRemovable(var, removable ? TRUE : FALSE));
+
+    ret = SCIPaddVar(scip_instance, var);
+    if (ret != SCIP_OKAY) {
+        SCIP_CALL_ABORT(SCIPreleaseVar(scip_instance, &var));
+        return -1;
+    }
+
+    int varId = registerVarHandle(var);
+    SCIP_CALL_ABORT(SCIPreleaseVar(scip_instance, &var));
+    return varId;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_add_coef_linear(int consId, int varId, double val)
+{
+    if (scip_instance == NULL) {
+        return 0;
+    }
+
+    SCIP_CONS* cons = getConsByHandle(consId);
+    SCIP_VAR* var = getVarByHandle(varId);
+    if (cons == NULL || var == NULL) {
+        return 0;
+    }
+
+    stabTrackCoef(varId, stabOutDual(consId), val);
+    return SCIPaddCoefLinear(scip_instance, cons, var, val) == SCIP_OKAY ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_add_coef_linear_batch(int consId, int* varIds, double* vals, int nnz)
+{
+    if (scip_instance == NULL || varIds == NULL || vals == NULL || nnz < 0) {
+        return 0;
+    }
+
+    SCIP_CONS* cons = getConsByHandle(consId);
+    if (cons == NULL) {
+        return 0;
+    }
+
+    for (int i = 0; i < nnz; ++i) {
+        SCIP_VAR* var = getVarByHandle(varIds[i]);
+        if (var == NULL) {
+            return 0;
+        }
+        stabTrackCoef(varIds[i], stabOutDual(consId), vals[i]);
+        if (SCIPaddCoefLinear(scip_instance, cons, var, vals[i]) != SCIP_OKAY) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * Read problem from file
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_read_problem(const char* filename)
+{
+    if (scip_instance == NULL) {
+        return 0;
+    }
+    
+    double spanstart = profileBegin();
+    SCIP_RETCODE retcode = SCIPreadProb(scip_instance, filename, NULL);
+    profileEnd(PROFILE_SPAN_READ, spanstart, retcode == SCIP_OKAY ? 1 : 0);
+    memorySample(MEMORY_PHASE_READ);
+    return retcode == SCIP_OKAY ? 1 : 0;
+}
+
+/**
+ * Set time limit
+ */
+EMSCRIPTEN_KEEPALIVE
+void scip_set_time_limit(double seconds)
+{
+    if (scip_instance != NULL) {
+        SCIPsetRealParam(scip_instance, "limits/time", seconds);
+    }
+}
+
+/**
+ * Set gap tolerance
+ */
+EMSCRIPTEN_KEEPALIVE
+void scip_set_gap(double gap)
+{
+    if (scip_instance != NULL) {
+        SCIPsetRealParam(scip_instance, "limits/gap", gap);
+    }
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_set_param_int(const char* name, int value)
+{
+    if (scip_instance == NULL || name == NULL) {
+        return 0;
+    }
+    return SCIPsetIntParam(scip_instance, name, value) == SCIP_OKAY ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_set_param_real(const char* name, double value)
+{
+    if (scip_instance == NULL || name == NULL) {
+        return 0;
+    }
+    return SCIPsetRealParam(scip_instance, name, value) == SCIP_OKAY ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_set_param_bool(const char* name, int value)
+{
+    if (scip_instance == NULL || name == NULL) {
+        return 0;
+    }
+    return SCIPsetBoolParam(scip_instance, name, value ? TRUE : FALSE) == SCIP_OKAY ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_set_param_string(const char* name, const char* value)
+{
+    if (scip_instance == NULL || name == NULL || value == NULL) {
+        return 0;
+    }
+    return SCIPsetStringParam(scip_instance, name, value) == SCIP_OKAY ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_set_param_longint(const char* name, double value)
+{
+    if (scip_instance == NULL || name == NULL) {
+        return 0;
+    }
+    return SCIPsetLongintParam(scip_instance, name, (SCIP_Longint)value) == SCIP_OKAY ? 1 : 0;
+}
+
+/**
+ * Apply a SCIP emphasis (SCIP_PARAMEMPHASIS: 0 default, 2 easycip,
+ * 3 feasibility, 4 hardlp, 5 optimality, ...). Default resets every parameter.
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_set_emphasis(int emphasis)
+{
+    if (scip_instance == NULL || emphasis < 0) {
+        return 0;
+    }
+    return SCIPsetEmphasis(scip_instance, (SCIP_PARAMEMPHASIS)emphasis, TRUE) == SCIP_OKAY ? 1 : 0;
+}
+
+/**
+ * Apply a meta setting (SCIP_PARAMSETTING: 0 default, 1 aggressive, 2 fast,
+ * 3 off) to one plugin group: 0 heuristics, 1 presolving, 2 separating
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_set_meta_setting(int group, int setting)
+{
+    if (scip_instance == NULL || setting < SCIP_PARAMSETTING_DEFAULT || setting > SCIP_PARAMSETTING_OFF) {
+        return 0;
+    }
+
+    SCIP_RETCODE retcode;
+    switch (group) {
+        case 0:
+            retcode = SCIPsetHeuristics(scip_instance, (SCIP_PARAMSETTING)setting, TRUE);
+            break;
+        case 1:
+            retcode = SCIPsetPresolving(scip_instance, (SCIP_PARAMSETTING)setting, TRUE);
+            break;
+        case 2:
+            retcode = SCIPsetSeparating(scip_instance, (SCIP_PARAMSETTING)setting, TRUE);
+            break;
+        default:
+            return 0;
+    }
+    return retcode == SCIP_OKAY ? 1 : 0;
+}
+
+/**
+ * Write parameters as a SCIP settings file (MEMFS path); with onlychanged
+ * only those differing from SCIP's defaults
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_write_params(const char* path, int onlychanged)
+{
+    if (scip_instance == NULL || path == NULL) {
+        return 0;
+    }
+    return SCIPwriteParams(scip_instance, path, FALSE, onlychanged ? TRUE : FALSE) == SCIP_OKAY ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_read_params(const char* path)
+{
+    if (scip_instance == NULL || path == NULL) {
+        return 0;
+    }
+    return SCIPreadParams(scip_instance, path) == SCIP_OKAY ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_reset_params(void)
+{
+    if (scip_instance == NULL) {
+        return 0;
+    }
+    return SCIPresetParams(scip_instance) == SCIP_OKAY ? 1 : 0;
+}
+
+/**
+ * Add initial solution hint
+ * Variables are passed as name,value pairs separated by semicolons
+ * Example: "x=1;y=2;z=3"
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_add_solution_hint(const char* solution_str)
+{
+    if (scip_instance == NULL || solution_str == NULL) {
+        return 0;
+    }
+    
+    SCIP_SOL* sol;
+    SCIP_Bool stored;
+    
+    // Create solution
+    SCIP_CALL_ABORT(SCIPcreateSol(scip_instance, &sol, NULL));
+    
+    // Parse solution string
+    size_t len = strlen(solution_str);
+    char* str = (char*)bridgeAlloc(len + 1);
+    if (str == NULL) {
+        SCIP_CALL_ABORT(SCIPfreeSol(scip_instance, &sol));
+        return 0;
+    }
+    memcpy(str, solution_str, len + 1);
+    char* token = strtok(str, ";");
+    
+    while (token != NULL) {
+        char varname[256];
+        double value;
+        
+        if (sscanf(token, "%255[^=]=%lf", varname, &value) == 2) {
+            SCIP_VAR* var = SCIPfindVar(scip_instance, varname);
+            if (var != NULL) {
+                SCIPsetSolVal(scip_instance, sol, var, value);
+            }
+        }
+        
+        token = strtok(NULL, ";");
+    }
+    
+    bridgeFree(str);
+    
+    // Try to add solution
+    SCIP_CALL_ABORT(SCIPtrySol(scip_instance, sol, FALSE, FALSE, FALSE, FALSE, FALSE, &stored));
+    SCIP_CALL_ABORT(SCIPfreeSol(scip_instance, &sol));
+    
+    return stored ? 1 : 0;
+}
+
+/**
+ * Set cutoff bound (prune nodes with worse bounds)
+ */
+EMSCRIPTEN_KEEPALIVE
+void scip_set_cutoff(double cutoff)
+{
+    if (scip_instance != NULL) {
+        SCIPsetObjlimit(scip_instance, cutoff);
+    }
+}
+
+// Bridge status code of a finished solve: 0 optimal, 1 infeasible, 2 unbounded, 3 time limit, 4 other
+static int solveStatusCode(SCIP* scip)
+{
+    switch (SCIPgetStatus(scip)) {
+        case SCIP_STATUS_OPTIMAL:
+            return 0;
+        case SCIP_STATUS_INFEASIBLE:
+            return 1;
+        case SCIP_STATUS_UNBOUNDED:
+            return 2;
+        case SCIP_STATUS_TIMELIMIT:
+            return 3;
+        default:
+            return 4;
+    }
+}
+
+/**
+ * Solve the problem
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_solve(void)
+{
+    if (scip_instance == NULL) {
+        return -1;
+    }
+
+    current_pricing_mode = 0;
+    added_vars_this_call = 0;
+    tree_trace_size = 0;
+    tree_trace_dropped = 0;
+    tree_trace_pending_size = 0;
+    tree_trace_start = emscripten_get_now();
+    pricing_trace_size = 0;
+    pricing_trace_dropped = 0;
+    pricing_trace_start = tree_trace_start;
+    profile_solve_start = profileBegin();
+    profile_presolve_start = 0.0;
+    if (profile_catching && profile_root_start > 0.0 && SCIPgetStage(scip_instance) == SCIP_STAGE_SOLVING
+        && SCIPgetNNodes(scip_instance) > 0) {
+        // Resuming an interrupted solve: the root is done, this call is all tree search
+        profile_bnb_start = emscripten_get_now();
+    }
+    
+    SCIP_RETCODE retcode = SCIPsolve(scip_instance);
+    // The search ends here, not at EXITSOL (next free or reload)
+    if (profile_bnb_start > 0.0) {
+        profileEnd(PROFILE_SPAN_BRANCH_AND_BOUND, profile_bnb_start, 0);
+        profile_bnb_start = 0.0;
+    }
+    memorySample(MEMORY_PHASE_SOLVED);
+    // Final snapshot while nodes, dual bound and gap are still valid
+    progressPublish(scip_instance, TRUE);
+    if (retcode == SCIP_OKAY && tree_trace_capacity > 0) {
+        retcode = treeTraceFlushPruned(scip_instance);
+    }
+    profileEnd(PROFILE_SPAN_SOLVE, profile_solve_start, retcode == SCIP_OKAY ? 1 : 0);
+    profile_solve_start = 0.0;
+    
+    if (retcode != SCIP_OKAY) {
+        return -1;
+    }
+    
+    return solveStatusCode(scip_instance);
+}
+
+/**
+ * Get objective value
+ */
+EMSCRIPTEN_KEEPALIVE
+double scip_get_objective(void)
+{
+    if (scip_instance == NULL) {
+        return 0.0;
+    }
+    
+    SCIP_SOL* sol = SCIPgetBestSol(scip_instance);
+    if (sol == NULL) {
+        return 0.0;
+    }
+    
+    return SCIPgetSolOrigObj(scip_instance, sol);
+}
+
+/**
+ * Get solution value for a variable
+ */
+EMSCRIPTEN_KEEPALIVE
+double scip_get_var_value(const char* varname)
+{
+    if (scip_instance == NULL || varname == NULL) {
+        return 0.0;
+    }
+    
+    SCIP_SOL* sol = SCIPgetBestSol(scip_instance);
+    if (sol == NULL) {
+        return 0.0;
+    }
+    
+    SCIP_VAR* var = SCIPfindVar(scip_instance, varname);
+    if (var == NULL) {
+        return 0.0;
+    }
+    
+    return SCIPgetSolVal(scip_instance, sol, var);
+}
+
+/**
+ * Get number of variables
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_get_nvars(void)
+{
+    if (scip_instance == NULL) {
+        return 0;
+    }
+    return SCIPgetNVars(scip_instance);
+}
+
+/**
+ * Get all variable names (comma separated)
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* scip_get_var_names(void)
+{
+    static char buffer[65536];
+    buffer[0] = '\0';
+    
+    if (scip_instance == NULL) {
+        return buffer;
+    }
+    
+    SCIP_VAR** vars = SCIPgetVars(scip_instance);
+    int nvars = SCIPgetNVars(scip_instance);
+    
+    int pos = 0;
+    for (int i = 0; i < nvars && pos < 65000; i++) {
+        const char* name = SCIPvarGetName(vars[i]);
+        if (i > 0) {
+            buffer[pos++] = ',';
+        }
+        int len = strlen(name);
+        memcpy(buffer + pos, name, len);
+        pos += len;
+    }
+    buffer[pos] = '\0';
+    
+    return buffer;
+}
+
+EMSCRIPTEN_KEEPALIVE
+double scip_ctx_get_var_lp_value(int varId)
+{
+    if (scip_instance == NULL) {
+        return 0.0;
+    }
+
+    if (SCIPgetStage(scip_instance) != SCIP_STAGE_SOLVING) {
+        return 0.0;
+    }
+
+    SCIP_VAR* var = getVarByHandle(varId);
+    if (var == NULL) {
+        return 0.0;
+    }
+
+    return SCIPgetVarSol(scip_instance, var);
+}
+
+EMSCRIPTEN_KEEPALIVE
+double scip_ctx_get_var_redcost(int varId)
+{
+    if (scip_instance == NULL) {
+        return 0.0;
+    }
+
+    if (SCIPgetStage(scip_instance) != SCIP_STAGE_SOLVING) {
+        return 0.0;
+    }
+
+    SCIP_VAR* var = getVarByHandle(varId);
+    if (var == NULL) {
+        return 0.0;
+    }
+
+    return SCIPgetVarRedcost(scip_instance, var);
+}
+
+/**
+ * Get solving statistics
+ */
+EMSCRIPTEN_KEEPALIVE
+double scip_get_solving_time(void)
+{
+    if (scip_instance == NULL) return 0.0;
+    return SCIPgetSolvingTime(scip_instance);
+}
+
+EMSCRIPTEN_KEEPALIVE
+long long scip_get_nnodes(void)
+{
+    if (scip_instance == NULL) return 0;
+    return SCIPgetNNodes(scip_instance);
+}
+
+EMSCRIPTEN_KEEPALIVE
+double scip_get_gap(void)
+{
+    if (scip_instance == NULL) return 0.0;
+    return SCIPgetGap(scip_instance);
+}
+
+EMSCRIPTEN_KEEPALIVE
+double scip_get_dual_bound(void)
+{
+    if (scip_instance == NULL) return 0.0;
+    return SCIPgetDualbound(scip_instance);
+}
+
+EMSCRIPTEN_KEEPALIVE
+double scip_get_primal_bound(void)
+{
+    if (scip_instance == NULL) return 0.0;
+    return SCIPgetPrimalbound(scip_instance);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_ctx_get_stage(void)
+{
+    if (scip_instance == NULL) {
+        return -1;
+    }
+    return (int)SCIPgetStage(scip_instance);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_ctx_has_lp(void)
+{
+    if (scip_instance == NULL) {
+        return 0;
+    }
+
+    if (SCIPgetStage(scip_instance) != SCIP_STAGE_SOLVING) {
+        return 0;
+    }
+
+    return SCIPhasCurrentNodeLP(scip_instance) ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_ctx_get_lp_solstat(void)
+{
+    if (scip_instance == NULL) {
+        return -1;
+    }
+
+    if (SCIPgetStage(scip_instance) != SCIP_STAGE_SOLVING) {
+        return -1;
+    }
+
+    return (int)SCIPgetLPSolstat(scip_instance);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_ctx_get_pricing_mode(void)
+{
+    return current_pricing_mode;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_ctx_is_transformed(void)
+{
+    if (scip_instance == NULL) {
+        return 0;
+    }
+    return SCIPisTransformed(scip_instance) ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_var_find_id(const char* name)
+{
+    if (scip_instance == NULL || name == NULL) {
+        return -1;
+    }
+
+    SCIP_VAR* var = SCIPfindVar(scip_instance, name);
+    return registerVarHandle(var);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_cons_find_id(const char* name)
+{
+    if (scip_instance == NULL || name == NULL) {
+        return -1;
+    }
+
+    SCIP_CONS* cons = SCIPfindCons(scip_instance, name);
+    return registerConsHandle(cons);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_var_get_transformed(int varId)
+{
+    if (scip_instance == NULL) {
+        return -1;
+    }
+
+    if (!SCIPisTransformed(scip_instance)) {
+        return -1;
+    }
+
+    SCIP_VAR* var = getVarByHandle(varId);
+    if (var == NULL) {
+        return -1;
+    }
+
+    if (SCIPvarIsTransformed(var)) {
+        return varId;
+    }
+
+    SCIP_VAR* transvar = NULL;
+    SCIP_RETCODE ret = SCIPgetTransformedVar(scip_instance, var, &transvar);
+    if (ret != SCIP_OKAY || transvar == NULL) {
+        return -1;
+    }
+
+    return registerVarHandle(transvar);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_cons_get_transformed(int consId)
+{
+    if (scip_instance == NULL) {
+        return -1;
+    }
+
+    if (!SCIPisTransformed(scip_instance)) {
+        return -1;
+    }
+
+    SCIP_CONS* cons = getConsByHandle(consId);
+    if (cons == NULL) {
+        return -1;
+    }
+
+    if (SCIPconsIsTransformed(cons)) {
+        return consId;
+    }
+
+    SCIP_CONS* transcons = NULL;
+    SCIP_RETCODE ret = SCIPgetTransformedCons(scip_instance, cons, &transcons);
+    if (ret != SCIP_OKAY || transcons == NULL) {
+        return -1;
+    }
+
+    return registerConsHandle(transcons);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_cons_get_row(int consId)
+{
+    if (scip_instance == NULL) {
+        return -1;
+    }
+
+    SCIP_CONS* cons = getConsByHandle(consId);
+    if (cons == NULL) {
+        return -1;
+    }
+
+    SCIP_ROW* row = SCIPgetRowLinear(scip_instance, cons);
+    if (row == NULL) {
+        return -1;
+    }
+
+    return registerRowHandle(row);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_cons_is_in_lp(int consId)
+{
+    int rowId = scip_cons_get_row(consId);
+    if (rowId <= 0) {
+        return 0;
+    }
+
+    SCIP_ROW* row = getRowByHandle(rowId);
+    if (row == NULL) {
+        return 0;
+    }
+
+    return SCIProwIsInLP(row) ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+double scip_cons_get_dual_linear(int consId)
+{
+    if (scip_instance == NULL) {
+        return 0.0;
+    }
+
+    SCIP_CONS* cons = getConsByHandle(consId);
+    if (cons == NULL) {
+        return 0.0;
+    }
+
+    if (stab_active && consId <= stab_size && !isnan(stab_duals[consId - 1])) {
+        return stab_duals[consId - 1];
+    }
+    return SCIPgetDualsolLinear(scip_instance, cons);
+}
+
+EMSCRIPTEN_KEEPALIVE
+double scip_cons_get_farkas_linear(int consId)
+{
+    if (scip_instance == NULL) {
+        return 0.0;
+    }
+
+    SCIP_CONS* cons = getConsByHandle(consId);
+    if (cons == NULL) {
+        return 0.0;
+    }
+
+    return SCIPgetDualfarkasLinear(scip_instance, cons);
+}
+
+EMSCRIPTEN_KEEPALIVE
+double scip_row_get_dual(int rowId)
+{
+    SCIP_ROW* row = getRowByHandle(rowId);
+    if (row == NULL) {
+        return 0.0;
+    }
+    if (stab_active) {
+        int pos = SCIProwGetLPPos(row);
+        if (pos >= 0 && pos < stab_nrows) {
+            return stab_row_duals[pos];
+        }
+    }
+    return SCIProwGetDualsol(row);
+}
+
+EMSCRIPTEN_KEEPALIVE
+double scip_row_get_farkas(int rowId)
+{
+    SCIP_ROW* row = getRowByHandle(rowId);
+    if (row == NULL) {
+        return 0.0;
+    }
+    return SCIProwGetDualfarkas(row);
+}
+
+EMSCRIPTEN_KEEPALIVE
+double scip_row_get_lhs(int rowId)
+{
+    SCIP_ROW* row = getRowByHandle(rowId);
+    if (row == NULL) {
+        return 0.0;
+    }
+    return SCIProwGetLhs(row);
+}
+
+EMSCRIPTEN_KEEPALIVE
+double scip_row_get_rhs(int rowId)
+{
+    SCIP_ROW* row = getRowByHandle(rowId);
+    if (row == NULL) {
+        return 0.0;
+    }
+    return SCIProwGetRhs(row);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_row_get_lppos(int rowId)
+{
+    SCIP_ROW* row = getRowByHandle(rowId);
+    if (row == NULL) {
+        return -1;
+    }
+    return SCIProwGetLPPos(row);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_row_is_in_lp(int rowId)
+{
+    SCIP_ROW* row = getRowByHandle(rowId);
+    if (row == NULL) {
+        return 0;
+    }
+    return SCIProwIsInLP(row) ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_row_is_local(int rowId)
+{
+    SCIP_ROW* row = getRowByHandle(rowId);
+    if (row == NULL) {
+        return 0;
+    }
+    return SCIProwIsLocal(row) ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+const char* scip_row_get_name(int rowId)
+{
+    SCIP_ROW* row = getRowByHandle(rowId);
+    if (row == NULL) {
+        return "";
+    }
+    return SCIProwGetName(row);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_ctx_get_n_lp_rows(void)
+{
+    if (scip_instance == NULL) {
+        return 0;
+    }
+
+    if (SCIPgetStage(scip_instance) != SCIP_STAGE_SOLVING) {
+        return 0;
+    }
+
+    if (!SCIPisLPConstructed(scip_instance)) {
+        return 0;
+    }
+
+    return SCIPgetNLPRows(scip_instance);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_ctx_get_lp_row_duals_batch(double* out, int n)
+{
+    if (scip_instance == NULL || out == NULL || n <= 0) {
+        return -1;
+    }
+
+    int nrows = scip_ctx_get_n_lp_rows();
+    if (nrows <= 0) {
+        return 0;
+    }
+
+    SCIP_ROW** rows = SCIPgetLPRows(scip_instance);
+    int count = n < nrows ? n : nrows;
+
+    for (int i = 0; i < count; ++i) {
+        out[i] = stab_active && i < stab_nrows ? stab_row_duals[i] : SCIProwGetDualsol(rows[i]);
+        registerRowHandle(rows[i]);
+    }
+
+    return count;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_ctx_get_lp_row_farkas_batch(double* out, int n)
+{
+    if (scip_instance == NULL || out == NULL || n <= 0) {
+        return -1;
+    }
+
+    int nrows = scip_ctx_get_n_lp_rows();
+    if (nrows <= 0) {
+        return 0;
+    }
+
+    SCIP_ROW** rows = SCIPgetLPRows(scip_instance);
+    int count = n < nrows ? n : nrows;
+
+    for (int i = 0; i < count; ++i) {
+        out[i] = SCIProwGetDualfarkas(rows[i]);
+        registerRowHandle(rows[i]);
+    }
+
+    return count;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_pricer_add_var_to_rows_batch(int varId, int* rowIds, double* vals, int nnz)
+{
+    if (scip_instance == NULL || rowIds == NULL || vals == NULL || nnz < 0) {
+        pending_pricer_abortround = TRUE;
+        pending_pricer_result = SCIP_DIDNOTRUN;
+        return -1;
+    }
+
+    SCIP_VAR* var = getVarByHandle(varId);
+    if (var == NULL) {
+        pending_pricer_abortround = TRUE;
+        pending_pricer_result = SCIP_DIDNOTRUN;
+        return -1;
+    }
+
+    for (int i = 0; i < nnz; ++i) {
+        if (getRowByHandle(rowIds[i]) == NULL) {
+            pending_pricer_abortround = TRUE;
+            pending_pricer_result = SCIP_DIDNOTRUN;
+            return -1;
+        }
+    }
+
+    for (int i = 0; i < nnz; ++i) {
+        SCIP_ROW* row = getRowByHandle(rowIds[i]);
+        SCIP_RETCODE ret = SCIPaddVarToRow(scip_instance, row, var, vals[i]);
+        stabTrackCoef(varId, SCIProwIsInLP(row) ? SCIProwGetDualsol(row) : 0.0, vals[i]);
+        if (ret != SCIP_OKAY) {
+            pending_pricer_abortround = TRUE;
+            pending_pricer_result = SCIP_DIDNOTRUN;
+            pending_pricer_stopearly = TRUE;
+            SCIPinterruptSolve(scip_instance);
+            return -1;
+        }
+    }
+
+    return 1;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_pricer_add_var_to_conss_batch(int varId, int* consIds, double* vals, int nnz)
+{
+    if (scip_instance == NULL || consIds == NULL || vals == NULL || nnz < 0) {
+        pending_pricer_abortround = TRUE;
+        pending_pricer_result = SCIP_DIDNOTRUN;
+        return -1;
+    }
+
+    SCIP_VAR* var = getVarByHandle(varId);
+    if (var == NULL) {
+        pending_pricer_abortround = TRUE;
+        pending_pricer_result = SCIP_DIDNOTRUN;
+        return -1;
+    }
+
+    for (int i = 0; i < nnz; ++i) {
+        if (getConsByHandle(consIds[i]) == NULL) {
+            pending_pricer_abortround = TRUE;
+            pending_pricer_result = SCIP_DIDNOTRUN;
+            return -1;
+        }
+    }
+
+    for (int i = 0; i < nnz; ++i) {
+        SCIP_CONS* cons = getConsByHandle(consIds[i]);
+        SCIP_RETCODE ret = SCIPaddCoefLinear(scip_instance, cons, var, vals[i]);
+        stabTrackCoef(varId, stabOutDual(consIds[i]), vals[i]);
+        if (ret != SCIP_OKAY) {
+            pending_pricer_abortround = TRUE;
+            pending_pricer_result = SCIP_DIDNOTRUN;
+            pending_pricer_stopearly = TRUE;
+            SCIPinterruptSolve(scip_instance);
+            return -1;
+        }
+    }
+
+    return 1;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_pricer_add_priced_var(const char* name, double lb, double ub, double obj, int vartype, int initial, int removable)
+{
+    if (scip_instance == NULL || name == NULL) {
+        pending_pricer_abortround = TRUE;
+        pending_pricer_result = SCIP_DIDNOTRUN;
+        return -1;
+    }
+
+    SCIP_VAR* var = NULL;
+    SCIP_RETCODE ret = SCIPcreateVarBasic(scip_instance, &var, name, lb, ub, obj, (SCIP_VARTYPE)vartype);
+    if (ret != SCIP_OKAY || var == NULL) {
+        pending_pricer_abortround = TRUE;
+        pending_pricer_result = SCIP_DIDNOTRUN;
+        return -1;
+    }
+
+    SCIP_CALL_ABORT(SCIPvarSetInitial(var, initial ? TRUE : FALSE));
+    SCIP_CALL_ABORT(SCIPvarSetRemovable(var, removable ? TRUE : FALSE));
+
+    ret = SCIPaddPricedVar(scip_instance, var, 1.0);
+    if (ret != SCIP_OKAY) {
+        pending_pricer_abortround = TRUE;
+        pending_pricer_result = SCIP_DIDNOTRUN;
+        SCIP_CALL_ABORT(SCIPreleaseVar(scip_instance, &var));
+        return -1;
+    }
+
+    int varId = registerVarHandle(var);
+    stabTrackColumn(varId, obj);
+    priced_vars_added += 1;
+    added_vars_this_call += 1;
+    SCIP_CALL_ABORT(SCIPreleaseVar(scip_instance, &var));
+    return varId;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_pricer_get_n_added_vars(void)
+{
+    return priced_vars_added;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_pricer_get_n_added_vars_this_call(void)
+{
+    return added_vars_this_call;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_pricer_get_last_result(void)
+{
+    return last_pricing_result;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_pricer_get_last_mode(void)
+{
+    return last_pricing_mode;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_pricer_get_redcost_calls(void)
+{
+    return pricer_redcost_calls;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_pricer_get_farkas_calls(void)
+{
+    return pricer_farkas_calls;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_pricer_get_round(void)
+{
+    return pricer_round;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void scip_pricer_abort_round(void)
+{
+    pending_pricer_abortround = TRUE;
+    pending_pricer_result = SCIP_DIDNOTRUN;
+    pending_pricer_stopearly = TRUE;
+    if (scip_instance != NULL) {
+        SCIPinterruptSolve(scip_instance);
+    }
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_model_write_lp(const char* filename)
+{
+    if (scip_instance == NULL || filename == NULL) {
+        return 0;
+    }
+    return SCIPwriteLP(scip_instance, filename) == SCIP_OKAY ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_model_write_mip(const char* filename, int genericnames, int origobj, int lazyconss)
+{
+    if (scip_instance == NULL || filename == NULL) {
+        return 0;
+    }
+    return SCIPwriteMIP(scip_instance, filename,
+        genericnames ? TRUE : FALSE,
+        origobj ? TRUE : FALSE,
+        lazyconss ? TRUE : FALSE) == SCIP_OKAY ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_model_write_lp_snapshot(const char* prefix)
+{
+    if (scip_instance == NULL || prefix == NULL) {
+        return 0;
+    }
+
+    char filename[512];
+    snprintf(filename, sizeof(filename), "%s_%d_%d.lp", prefix, current_pricing_mode, pricer_round);
+    return SCIPwriteLP(scip_instance, filename) == SCIP_OKAY ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_pricer_include(const char* name, const char* desc, int priority, int delay)
+{
+    if (scip_instance == NULL || name == NULL || desc == NULL) {
+        return 0;
+    }
+
+    if (js_pricer != NULL) {
+        return 1;
+    }
+
+    SCIP_RETCODE ret = SCIPincludePricerBasic(
+        scip_instance,
+        &js_pricer,
+        name,
+        desc,
+        priority,
+        delay ? TRUE : FALSE,
+        pricerRedcostJs,
+        pricerFarkasJs,
+        NULL
+    );
+
+    return ret == SCIP_OKAY ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_pricer_activate(void)
+{
+    if (scip_instance == NULL || js_pricer == NULL) {
+        return 0;
+    }
+
+    return SCIPactivatePricer(scip_instance, js_pricer) == SCIP_OKAY ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_pricer_deactivate(void)
+{
+    if (scip_instance == NULL || js_pricer == NULL) {
+        return 0;
+    }
+
+    return SCIPdeactivatePricer(scip_instance, js_pricer) == SCIP_OKAY ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_pricer_is_active(void)
+{
+    if (js_pricer == NULL) {
+        return 0;
+    }
+    return SCIPpricerIsActive(js_pricer) ? 1 : 0;
+}
+
+/**
+ * Register pricer callbacks by function table index (from addFunction, signature
+ * 'vi', called with the pricing round); 0 disables
+ */
+EMSCRIPTEN_KEEPALIVE
+void scip_pricer_set_redcost_callback(int fnptr)
+{
+    js_pricer_redcost_callback = (JS_PRICER_CALLBACK)(intptr_t)fnptr;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void scip_pricer_set_farkas_callback(int fnptr)
+{
+    js_pricer_farkas_callback = (JS_PRICER_CALLBACK)(intptr_t)fnptr;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void scip_pricer_set_result(int resultcode)
+{
+    pending_pricer_result = (SCIP_RESULT)resultcode;
+    last_pricing_result = resultcode;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void scip_pricer_set_lowerbound(double lowerbound)
+{
+    pending_pricer_lowerbound = lowerbound;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void scip_pricer_set_stopearly(int stopearly)
+{
+    pending_pricer_stopearly = stopearly ? TRUE : FALSE;
+}
+
+/**
+ * Stabilize the duals the redcost pricer reads (cons and row dual getters)
+ * for the registered linear constraints. mode 1: Wentges smoothing towards
+ * the stability center with weight param (alpha in [0, 1)); mode 2: box-step,
+ * duals kept within param of the center; 0 disables. With adaptive set,
+ * alpha / the box width follow the mispricings. A round whose pricer finds
+ * no column at stabilized duals is repeated closer to the LP duals, down to
+ * the LP duals themselves, so pricing only ends on the true duals.
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_pricer_set_stabilization(int mode, double param, int adaptive)
+{
+    if (mode < STAB_NONE || mode > STAB_BOXSTEP) {
+        return 0;
+    }
+    if (mode == STAB_SMOOTHING && (param < 0.0 || param >= 1.0)) {
+        return 0;
+    }
+    if (mode == STAB_BOXSTEP && param <= 0.0) {
+        return 0;
+    }
+
+    stab_mode = mode;
+    stab_param = param;
+    stab_value = param;
+    stab_adaptive = adaptive ? TRUE : FALSE;
+    stab_center_valid = FALSE;
+    return 1;
+}
+
+/**
+ * Stabilization counters: out[0] stabilized rounds, [1] mispricings,
+ * [2] rounds that fell back to the LP duals, [3] current alpha / box width
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_pricer_get_stabilization_stats(double* out)
+{
+    if (out == NULL) {
+        return 0;
+    }
+
+    out[0] = stab_rounds;
+    out[1] = stab_mispricings;
+    out[2] = stab_fallbacks;
+    out[3] = stab_value;
+    return 1;
+}
+
+/**
+ * Column management for the restricted master. Removable columns age by one
+ * every LP solve that leaves them at zero, i.e. nonbasic at their lower bound,
+ * which includes every column with positive reduced cost, and are deleted from
+ * the LP once older than agelimit (-1: never). cleanupRoot / cleanupNodes also
+ * drop new removable columns that end up nonbasic at zero after the root / a
+ * non-root node LP. Deleted columns stay in the problem as a pool: SCIP prices
+ * them before calling the pricers and re-enters those with negative reduced
+ * cost without a pricing round.
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_pricer_set_column_aging(int agelimit, int cleanupRoot, int cleanupNodes)
+{
+    if (scip_instance == NULL || agelimit < -1) {
+        return 0;
+    }
+
+    if (SCIPsetIntParam(scip_instance, "lp/colagelimit", agelimit) != SCIP_OKAY
+        || SCIPsetBoolParam(scip_instance, "lp/cleanupcolsroot", cleanupRoot ? TRUE : FALSE) != SCIP_OKAY
+        || SCIPsetBoolParam(scip_instance, "lp/cleanupcols", cleanupNodes ? TRUE : FALSE) != SCIP_OKAY) {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Removable columns right now: out[0] in the LP, [1] pooled outside it,
+ * [2] mean and [3] maximum age of those in the LP
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_pricer_get_column_stats(double* out)
+{
+    if (out == NULL) {
+        return 0;
+    }
+
+    out[0] = 0.0;
+    out[1] = 0.0;
+    out[2] = 0.0;
+    out[3] = 0.0;
+    if (scip_instance == NULL
+        || (SCIPgetStage(scip_instance) != SCIP_STAGE_SOLVING && SCIPgetStage(scip_instance) != SCIP_STAGE_SOLVED)) {
+        return 1;
+    }
+
+    SCIP_VAR** vars = SCIPgetVars(scip_instance);
+    int nvars = SCIPgetNVars(scip_instance);
+    double agesum = 0.0;
+    for (int j = 0; j < nvars; ++j) {
+        if (!SCIPvarIsRemovable(vars[j])) {
+            continue;
+        }
+        if (SCIPvarIsInLP(vars[j])) {
+            int age = SCIPcolGetAge(SCIPvarGetCol(vars[j]));
+            out[0] += 1.0;
+            agesum += age;
+            out[3] = fmax(out[3], (double)age);
+        } else {
+            out[1] += 1.0;
+        }
+    }
+    out[2] = out[0] > 0.0 ? agesum / out[0] : 0.0;
+    return 1;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_result_success(void)
+{
+    return (int)SCIP_SUCCESS;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_result_didnotrun(void)
+{
+    return (int)SCIP_DIDNOTRUN;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_result_didnotfind(void)
+{
+    return (int)SCIP_DIDNOTFIND;
+}
+
+/**
+ * Reset for new problem
+ */
+EMSCRIPTEN_KEEPALIVE
+void scip_reset(void)
+{
+    clearCurrentProblem();
+    resetPricingState();
+    clearRegistries();
+    arenaReset();
+    js_pricer = NULL;
+    js_pricer_redcost_callback = NULL;
+    js_pricer_farkas_callback = NULL;
+    memorySample(MEMORY_PHASE_CLEARED);
+}
+
+/**
+ * Set incumbent callback by function table index (signature 'vd': objective); 0 disables
+ */
+EMSCRIPTEN_KEEPALIVE
+void scip_set_incumbent_callback(int fnptr)
+{
+    js_incumbent_callback = (JS_INCUMBENT_CALLBACK)(intptr_t)fnptr;
+}
+
+/**
+ * Set node callback by function table index (signature 'vddd': dual bound,
+ * primal bound, node count); 0 disables. Takes effect at the next solve.
+ */
+EMSCRIPTEN_KEEPALIVE
+void scip_set_node_callback(int fnptr)
+{
+    js_node_callback = (JS_NODE_CALLBACK)(intptr_t)fnptr;
+}
+
+/**
+ * Set progress callback by function table index (signature 'vi': pointer to
+ * PROGRESS_FIELDS doubles, valid only during the call); 0 disables. Called
+ * on phase changes and new incumbents, and after solved nodes at most every
+ * `interval_ms`. Takes effect at the next solve.
+ */
+EMSCRIPTEN_KEEPALIVE
+void scip_set_progress_callback(int fnptr, double interval_ms)
+{
+    js_progress_callback = (JS_PROGRESS_CALLBACK)(intptr_t)fnptr;
+    progress_interval_ms = interval_ms > 0.0 ? interval_ms : 0.0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_progress_fields(void)
+{
+    return PROGRESS_FIELDS;
+}
+
+/**
+ * Set mailbox callback by function table index (signature 'iii': output
+ * buffer, variable capacity; returns MAILBOX_* flags); 0 disables. Polled
+ * whenever a node is focused: an objective limit is applied if it is tighter,
+ * a solution (values in variable handle order) goes through SCIPtrySol.
+ * Takes effect at the next solve.
+ */
+EMSCRIPTEN_KEEPALIVE
+void scip_set_mailbox_callback(int fnptr)
+{
+    js_mailbox_callback = (JS_MAILBOX_CALLBACK)(intptr_t)fnptr;
+}
+
+/**
+ * Mailbox counters: polls, objective limits applied, solutions tried, solutions stored
+ */
+EMSCRIPTEN_KEEPALIVE
+void scip_mailbox_stats(double* out)
+{
+    out[0] = mailbox_polls;
+    out[1] = mailbox_objlimits;
+    out[2] = mailbox_sols_tried;
+    out[3] = mailbox_sols_stored;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void scip_mailbox_stats_reset(void)
+{
+    mailbox_polls = 0.0;
+    mailbox_objlimits = 0.0;
+    mailbox_sols_tried = 0.0;
+    mailbox_sols_stored = 0.0;
+}
+
+/**
+ * Callback crossing microbenchmark: calls a 'vi' function `iterations` times,
+ * either through the function table (fnptr != 0) or, for comparison, through
+ * the EM_ASM property lookup on Module.onBenchCallback. Returns elapsed ms.
+ */
+EMSCRIPTEN_KEEPALIVE
+double scip_bench_callback(int fnptr, int iterations)
+{
+    double start = emscripten_get_now();
+
+    if (fnptr != 0) {
+        JS_PRICER_CALLBACK fn = (JS_PRICER_CALLBACK)(intptr_t)fnptr;
+        for (int i = 0; i < iterations; ++i) {
+            fn(i);
+        }
+    } else {
+        for (int i = 0; i < iterations; ++i) {
+            EM_ASM({
+                if (Module.onBenchCallback) {
+                    Module.onBenchCallback($0);
+                }
+            }, i);
+        }
+    }
+
+    return emscripten_get_now() - start;
+}
+
+// ============================================
+// Branch-and-bound tree trace
+// ============================================
+
+/**
+ * Enable tree tracing with room for `capacity` node records.
+ * Nodes beyond the capacity are counted as dropped; 0 disables tracing.
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_tree_trace_enable(int capacity)
+{
+    freeTreeTrace();
+
+    if (capacity <= 0) {
+        return 1;
+    }
+
+    tree_trace = (TREETRACERECORD*)malloc((size_t)capacity * sizeof(TREETRACERECORD));
+    tree_trace_pending = (TREETRACERECORD*)malloc((size_t)capacity * sizeof(TREETRACERECORD));
+    if (tree_trace == NULL || tree_trace_pending == NULL) {
+        freeTreeTrace();
+        return 0;
+    }
+
+    tree_trace_capacity = capacity;
+    return 1;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void scip_tree_trace_clear(void)
+{
+    tree_trace_size = 0;
+    tree_trace_dropped = 0;
+    tree_trace_pending_size = 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+const TREETRACERECORD* scip_tree_trace_get_data(void)
+{
+    return tree_trace;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_tree_trace_get_size(void)
+{
+    return tree_trace_size;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_tree_trace_get_dropped(void)
+{
+    return tree_trace_dropped;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_tree_trace_record_size(void)
+{
+    return (int)sizeof(TREETRACERECORD);
+}
+
+/**
+ * Name of a transformed problem variable referenced by a trace record
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* scip_tree_trace_var_name(int probindex)
+{
+    if (scip_instance == NULL || !SCIPisTransformed(scip_instance)) {
+        return "";
+    }
+
+    if (probindex < 0 || probindex >= SCIPgetNVars(scip_instance)) {
+        return "";
+    }
+
+    return SCIPvarGetName(SCIPgetVars(scip_instance)[probindex]);
+}
+
+// ============================================
+// Pricing trace
+// ============================================
+
+/**
+ * Enable the pricing trace with room for `capacity` pricer calls per solve.
+ * Calls beyond the capacity are counted as dropped; 0 disables tracing.
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_pricing_trace_enable(int capacity)
+{
+    freePricingTrace();
+
+    if (capacity <= 0) {
+        return 1;
+    }
+
+    pricing_trace = (PRICINGTRACERECORD*)malloc((size_t)capacity * sizeof(PRICINGTRACERECORD));
+    if (pricing_trace == NULL) {
+        return 0;
+    }
+
+    pricing_trace_capacity = capacity;
+    return 1;
+}
+
+EMSCRIPTEN_KEEPALIVE
+const PRICINGTRACERECORD* scip_pricing_trace_get_data(void)
+{
+    return pricing_trace;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_pricing_trace_get_size(void)
+{
+    return pricing_trace_size;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_pricing_trace_get_dropped(void)
+{
+    return pricing_trace_dropped;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_pricing_trace_record_size(void)
+{
+    return (int)sizeof(PRICINGTRACERECORD);
+}
+
+// ============================================
+// Profiling spans
+// ============================================
+
+/**
+ * Enable span recording with room for `capacity` spans; 0 disables.
+ * Spans accumulate across solves until cleared.
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_profile_enable(int capacity)
+{
+    freeProfileSpans();
+
+    if (capacity <= 0) {
+        return 1;
+    }
+
+    profile_spans = (PROFILESPAN*)malloc((size_t)capacity * sizeof(PROFILESPAN));
+    if (profile_spans == NULL) {
+        return 0;
+    }
+
+    profile_capacity = capacity;
+    return 1;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void scip_profile_clear(void)
+{
+    profile_size = 0;
+    profile_dropped = 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+const PROFILESPAN* scip_profile_get_data(void)
+{
+    return profile_spans;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_profile_get_size(void)
+{
+    return profile_size;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_profile_get_dropped(void)
+{
+    return profile_dropped;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_profile_span_size(void)
+{
+    return (int)sizeof(PROFILESPAN);
+}
+
+/**
+ * Cumulative time spent in SCIP's own plugins (heuristics, separators,
+ * propagators, presolvers, branching rules) of the current problem.
+ * Their calls are not hooked individually, so they are reported as totals.
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_profile_plugin_count(void)
+{
+    if (scip_instance == NULL) {
+        return 0;
+    }
+    return SCIPgetNHeurs(scip_instance) + SCIPgetNSepas(scip_instance) + SCIPgetNProps(scip_instance)
+        + SCIPgetNPresols(scip_instance) + SCIPgetNBranchrules(scip_instance);
+}
+
+/**
+ * Fill name/kind/time/calls of plugin `index`; returns 0 if out of range.
+ * Kinds: 0 heuristic, 1 separator, 2 propagator, 3 presolver, 4 branching rule.
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* scip_profile_plugin_info(int index, int* kind, double* seconds, double* calls)
+{
+    if (scip_instance == NULL || index < 0 || kind == NULL || seconds == NULL || calls == NULL) {
+        return NULL;
+    }
+
+    int n = SCIPgetNHeurs(scip_instance);
+    if (index < n) {
+        SCIP_HEUR* heur = SCIPgetHeurs(scip_instance)[index];
+        *kind = 0;
+        *seconds = SCIPheurGetTime(heur);
+        *calls = (double)SCIPheurGetNCalls(heur);
+        return SCIPheurGetName(heur);
+    }
+    index -= n;
+
+    n = SCIPgetNSepas(scip_instance);
+    if (index < n) {
+        SCIP_SEPA* sepa = SCIPgetSepas(scip_instance)[index];
+        *kind = 1;
+        *seconds = SCIPsepaGetTime(sepa);
+        *calls = (double)SCIPsepaGetNCalls(sepa);
+        return SCIPsepaGetName(sepa);
+    }
+    index -= n;
+
+    n = SCIPgetNProps(scip_instance);
+    if (index < n) {
+        SCIP_PROP* prop = SCIPgetProps(scip_instance)[index];
+        *kind = 2;
+        *seconds = SCIPpropGetTime(prop);
+        *calls = (double)SCIPpropGetNCalls(prop);
+        return SCIPpropGetName(prop);
+    }
+    index -= n;
+
+    n = SCIPgetNPresols(scip_instance);
+    if (index < n) {
+        SCIP_PRESOL* presol = SCIPgetPresols(scip_instance)[index];
+        *kind = 3;
+        *seconds = SCIPpresolGetTime(presol);
+        *calls = (double)SCIPpresolGetNCalls(presol);
+        return SCIPpresolGetName(presol);
+    }
+    index -= n;
+
+    n = SCIPgetNBranchrules(scip_instance);
+    if (index < n) {
+        SCIP_BRANCHRULE* branchrule = SCIPgetBranchrules(scip_instance)[index];
+        *kind = 4;
+        *seconds = SCIPbranchruleGetTime(branchrule);
+        *calls = (double)(SCIPbranchruleGetNLPCalls(branchrule) + SCIPbranchruleGetNPseudoCalls(branchrule)
+            + SCIPbranchruleGetNExternCalls(branchrule));
+        return SCIPbranchruleGetName(branchrule);
+    }
+
+    return NULL;
+}
+
+// ============================================
+// Memory sampling
+// ============================================
+
+/**
+ * Keep the last `capacity` memory samples, taken at phase boundaries and
+ * every `node_interval` solved nodes (0: phase boundaries only).
+ * Samples survive problem clears so leaks across reused instances show up.
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_memory_sampling_enable(int capacity, int node_interval)
+{
+    freeMemorySamples();
+    memory_node_interval = node_interval > 0 ? node_interval : 0;
+
+    if (capacity <= 0) {
+        return 1;
+    }
+
+    memory_samples = (double*)malloc((size_t)capacity * MEMORY_SAMPLE_FIELDS * sizeof(double));
+    if (memory_samples == NULL) {
+        return 0;
+    }
+
+    memory_capacity = capacity;
+    return 1;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void scip_memory_sampling_clear(void)
+{
+    memory_count = 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_memory_sample_fields(void)
+{
+    return MEMORY_SAMPLE_FIELDS;
+}
+
+/**
+ * Copy samples oldest first into `out` (room for `max` samples); returns the count
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_memory_get_samples(double* out, int max)
+{
+    if (memory_samples == NULL || out == NULL || max <= 0) {
+        return 0;
+    }
+
+    int n = memory_count < memory_capacity ? memory_count : memory_capacity;
+    int first = memory_count - n;
+    if (n > max) {
+        first += n - max;
+        n = max;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        int slot = (first + i) % memory_capacity;
+        memcpy(&out[i * MEMORY_SAMPLE_FIELDS], &memory_samples[slot * MEMORY_SAMPLE_FIELDS],
+            MEMORY_SAMPLE_FIELDS * sizeof(double));
+    }
+
+    return n;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_memory_get_total_samples(void)
+{
+    return memory_count;
+}
 
 /**
- * Create and initialize SCIP instance
+ * Take a sample right now; written to `out` and, if sampling is enabled, recorded too
  */
 EMSCRIPTEN_KEEPALIVE
-int scip_create(void)
+void scip_memory_sample_now(double* out)
 {
-    if (scip_instance != NULL) {
-        return 0; // Already created
+    memorySample(MEMORY_PHASE_MANUAL);
+    if (out != NULL) {
+        memoryFillSample(out, MEMORY_PHASE_MANUAL);
     }
-    
-    SCIP_CALL(SCIPcreate(&scip_instance));
-    SCIP_CALL(SCIPincludeDefaultPlugins(scip_instance));
-    SCIP_CALL(includeEventHandlers(scip_instance));
-    
-    // Catch best solution events
-    SCIP_CALL(SCIPcatchEvent(scip_instance, SCIP_EVENTTYPE_BESTSOLFOUND, 
-        SCIPfindEventhdlr(scip_instance, "bestsol_js"), NULL, NULL));
-    
-    return 1;
 }
 
+// ============================================
+// Bridge Allocation Arena
+// ============================================
+
 /**
- * Free SCIP instance
+ * Route per-problem bridge allocations (registries, solution hints and the JS
+ * wrapper's scratch buffers) through a bump arena of the given size, released
+ * wholesale by scip_problem_clear / scip_problem_begin / scip_reset.
+ * Pass 0 to go back to plain malloc. Fails while arena blocks are still live.
  */
 EMSCRIPTEN_KEEPALIVE
-void scip_free(void)
+int scip_arena_enable(int bytes)
 {
-    if (scip_instance != NULL) {
-        clearCurrentProblem();
-        SCIPfree(&scip_instance);
-        scip_instance = NULL;
+    if (bytes < 0 || arena_used > 0) {
+        return 0;
     }
-    js_pricer = NULL;
-    js_pricer_redcost_callback = 0;
-    js_pricer_farkas_callback = 0;
-    resetPricingState();
-    clearRegistries();
+
+    freeArena();
+    if (bytes == 0) {
+        return 1;
+    }
+
+    arena_base = (char*)malloc((size_t)bytes);
+    if (arena_base == NULL) {
+        return 0;
+    }
+    arena_capacity = (size_t)bytes;
+    return 1;
 }
 
 EMSCRIPTEN_KEEPALIVE
-int scip_problem_clear(void)
+void* scip_bridge_alloc(int bytes)
 {
-    if (scip_instance == NULL) {
-        return 0;
+    return bytes >= 0 ? bridgeAlloc((size_t)bytes) : NULL;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void scip_bridge_free(void* ptr)
+{
+    bridgeFree(ptr);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_bridge_alloc_stats_fields(void)
+{
+    return BRIDGE_ALLOC_STATS_FIELDS;
+}
+
+/**
+ * Layout: allocs, frees, reallocs, bytes requested, time (ms, only while timing
+ * is on), arena capacity, arena used, arena high water, arena resets, malloc
+ * fallbacks because the arena was full.
+ */
+EMSCRIPTEN_KEEPALIVE
+void scip_bridge_alloc_stats(double* out)
+{
+    if (out == NULL) {
+        return;
     }
 
-    clearCurrentProblem();
-    resetPricingState();
-    clearRegistries();
-    js_pricer = NULL;
-    js_pricer_redcost_callback = 0;
-    js_pricer_farkas_callback = 0;
-    return 1;
+    out[0] = bridge_allocs;
+    out[1] = bridge_frees;
+    out[2] = bridge_reallocs;
+    out[3] = bridge_bytes;
+    out[4] = bridge_time_ms;
+    out[5] = (double)arena_capacity;
+    out[6] = (double)arena_used;
+    out[7] = (double)arena_high_water;
+    out[8] = arena_resets;
+    out[9] = arena_fallbacks;
 }
 
+/**
+ * Zero the counters. Timing adds two clock reads per call, so it is opt-in.
+ */
 EMSCRIPTEN_KEEPALIVE
-int scip_problem_begin(const char* name, int maximize)
+void scip_bridge_alloc_stats_reset(int timing)
 {
-    if (scip_instance == NULL) {
+    bridge_allocs = 0.0;
+    bridge_frees = 0.0;
+    bridge_reallocs = 0.0;
+    bridge_bytes = 0.0;
+    bridge_time_ms = 0.0;
+    arena_resets = 0.0;
+    arena_fallbacks = 0.0;
+    arena_high_water = arena_used;
+    bridge_alloc_timing = timing ? TRUE : FALSE;
+}
+
+// ============================================
+// Native Plugins (dynamic linking)
+// ============================================
+
+static const SCIPJS_PLUGINHOST plugin_host = {
+    SCIPJS_PLUGIN_ABI_VERSION,
+    getVarByHandle,
+    getConsByHandle,
+    getRowByHandle,
+    registerVarHandle,
+    registerConsHandle,
+    registerRowHandle
+};
+
+/**
+ * Load a wasm side module from the virtual filesystem and run its
+ * scipjs_plugin_init() against the current SCIP instance.
+ * Returns the plugin id (>= 1) or 0; see scip_plugin_last_error().
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_plugin_load(const char* path)
+{
+    plugin_error[0] = '\0';
+
+    if (scip_instance == NULL || path == NULL) {
+        snprintf(plugin_error, sizeof(plugin_error), "SCIP instance not created");
         return 0;
     }
 
-    clearCurrentProblem();
-    resetPricingState();
-    clearRegistries();
-    js_pricer = NULL;
-    js_pricer_redcost_callback = 0;
-    js_pricer_farkas_callback = 0;
+#ifdef SCIPJS_DYNLINK
+    if (plugin_count >= MAX_PLUGINS) {
+        snprintf(plugin_error, sizeof(plugin_error), "too many plugins (max %d)", MAX_PLUGINS);
+        return 0;
+    }
 
-    const char* problemname = (name != NULL && name[0] != '\0') ? name : "js_problem";
-    if (SCIPcreateProbBasic(scip_instance, problemname) != SCIP_OKAY) {
+    if (SCIPgetStage(scip_instance) > SCIP_STAGE_PROBLEM) {
+        snprintf(plugin_error, sizeof(plugin_error), "plugins must be loaded before solving");
         return 0;
     }
 
-    SCIP_OBJSENSE sense = maximize ? SCIP_OBJSENSE_MAXIMIZE : SCIP_OBJSENSE_MINIMIZE;
-    if (SCIPsetObjsense(scip_instance, sense) != SCIP_OKAY) {
+    void* handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (handle == NULL) {
+        const char* err = dlerror();
+        snprintf(plugin_error, sizeof(plugin_error), "%s", err != NULL ? err : "dlopen failed");
         return 0;
     }
 
-    return 1;
+    SCIPJS_PLUGIN_INIT init = (SCIPJS_PLUGIN_INIT)dlsym(handle, SCIPJS_PLUGIN_INIT_SYMBOL);
+    if (init == NULL) {
+        snprintf(plugin_error, sizeof(plugin_error), "%s does not export %s", path, SCIPJS_PLUGIN_INIT_SYMBOL);
+        dlclose(handle);
+        return 0;
+    }
+
+    if (!init(scip_instance, &plugin_host)) {
+        // The plugin may already have included parts of itself; keep it mapped
+        snprintf(plugin_error, sizeof(plugin_error), "%s: %s failed", path, SCIPJS_PLUGIN_INIT_SYMBOL);
+        plugin_handles[plugin_count++] = handle;
+        return 0;
+    }
+
+    plugin_handles[plugin_count] = handle;
+    plugin_count += 1;
+    return plugin_count;
+#else
+    (void)plugin_host;
+    snprintf(plugin_error, sizeof(plugin_error), "built without dynamic linking, use the scip-api-dynlink module");
+    return 0;
+#endif
 }
 
 EMSCRIPTEN_KEEPALIVE
-int scip_add_cons_linear(
-    const char* name,
-    double lhs,
-    double rhs,
-    int initial,
-    int separate,
-    int enforce,
-    int check,
-    int propagate,
-    int local,
-    int modifiable,
-    int dynamic,
-    int removable,
-    int stickingatnode)
+const char* scip_plugin_last_error(void)
+{
+    return plugin_error;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_plugin_count(void)
+{
+    return plugin_count;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int scip_plugin_abi_version(void)
+{
+#ifdef SCIPJS_DYNLINK
+    return SCIPJS_PLUGIN_ABI_VERSION;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Activate a pricer included by a plugin for the current problem
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_plugin_activate_pricer(const char* name)
 {
     if (scip_instance == NULL || name == NULL) {
-        return -1;
+        return 0;
     }
 
-    SCIP_CONS* cons = NULL;
-    SCIP_RETCODE ret = SCIPcreateConsLinear(
-        scip_instance,
-        &cons,
-        name,
-        0,
-        NULL,
-        NULL,
-        lhs,
-        rhs,
-        initial ? TRUE : FALSE,
-        separate ? TRUE : FALSE,
-        enforce ? TRUE : FALSE,
-        check ? TRUE : FALSE,
-        propagate ? TRUE : FALSE,
-        local ? TRUE : FALSE,
-        modifiable ? TRUE : FALSE,
-        dynamic ? TRUE : FALSE,
-        removable ? TRUE : FALSE,
-        stickingatnode ? TRUE : FALSE);
-
-    if (ret != SCIP_OKAY || cons == NULL) {
-        return -1;
+    SCIP_PRICER* pricer = SCIPfindPricer(scip_instance, name);
+    if (pricer == NULL) {
+        return 0;
     }
 
-    ret = SCIPaddCons(scip_instance, cons);
-    if (ret != SCIP_OKAY) {
-        SCIPreleaseCons(scip_instance, &cons);
-        return -1;
+    if (SCIPpricerIsActive(pricer)) {
+        return 1;
     }
 
-    int consId = registerConsHandle(cons);
-    SCIPreleaseCons(scip_instance, &cons);
-    return consId;
+    return SCIPactivatePricer(scip_instance, pricer) == SCIP_OKAY ? 1 : 0;
 }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_set_cons_modifiable(int consId, int modifiable)
+// ============================================
+// Bulk Model Loading
+// ============================================
+
+// Model blob written by ModelBuilder.compile() (scip-model-builder.js), little-endian:
+// int32 header[MODEL_BLOB_HEADER_INTS] = magic, version, flags, nvars, nrows, nnz,
+// name bytes, reserved...; then lb, ub, obj (f64 x nvars), lhs, rhs (f64 x nrows),
+// vals (f64 x nnz), rowstart (i32 x nrows + 1), colidx (i32 x nnz),
+// vartype (u8 x nvars), rowflags (u8 x nrows) and, with MODEL_BLOB_FLAG_NAMES,
+// NUL-terminated names: problem, variables, rows.
+#define MODEL_BLOB_MAGIC 0x424A4353 // "SCJB"
+#define MODEL_BLOB_VERSION 1
+#define MODEL_BLOB_HEADER_INTS 16
+
+#define MODEL_BLOB_FLAG_MAXIMIZE 1
+#define MODEL_BLOB_FLAG_NAMES 2
+
+#define MODEL_BLOB_ROW_MODIFIABLE 1
+#define MODEL_BLOB_ROW_REMOVABLE 2
+
+static const char* blobNextName(const char** cursor, const char* end)
 {
-    if (scip_instance == NULL) {
+    const char* name = *cursor;
+    const char* nul = memchr(name, '\0', (size_t)(end - name));
+    if (nul == NULL) {
+        return NULL;
+    }
+    *cursor = nul + 1;
+    return name;
+}
+
+/**
+ * Validated view of a model blob. Section sizes are summed in 64 bits (size_t
+ * is 32 bits on wasm32 and would wrap on a crafted header) and checked against
+ * the blob size before any section is read; the CSR is checked to be
+ * well-formed (rowstart from 0 to nnz, non-decreasing, column indices in
+ * range) and variable types to be SCIP_VARTYPE values.
+ */
+typedef struct {
+    int flags;
+    int nvars;
+    int nrows;
+    int nnz;
+    int maxrowlen;
+    const double* lb;
+    const double* ub;
+    const double* obj;
+    const double* lhs;
+    const double* rhs;
+    const double* vals;
+    const int* rowstart;
+    const int* colidx;
+    const unsigned char* vartype;
+    const unsigned char* rowflags;
+    const char* names;
+    const char* namesend;
+} MODELBLOB;
+
+static int modelBlobParse(const unsigned char* blob, int size, MODELBLOB* b)
+{
+    if (blob == NULL || size < MODEL_BLOB_HEADER_INTS * 4) {
         return 0;
     }
 
-    SCIP_CONS* cons = getConsByHandle(consId);
-    if (cons == NULL) {
+    const int* header = (const int*)blob;
+    int nvars = header[3];
+    int nrows = header[4];
+    int nnz = header[5];
+    int namebytes = header[6];
+    if (header[0] != MODEL_BLOB_MAGIC || header[1] != MODEL_BLOB_VERSION
+        || nvars < 0 || nrows < 0 || nnz < 0 || namebytes < 0) {
+        return 0;
+    }
+    uint64_t need = (uint64_t)MODEL_BLOB_HEADER_INTS * 4
+        + ((uint64_t)3 * (uint64_t)nvars + (uint64_t)2 * (uint64_t)nrows + (uint64_t)nnz) * 8
+        + ((uint64_t)nrows + 1 + (uint64_t)nnz) * 4 + (uint64_t)nvars + (uint64_t)nrows + (uint64_t)namebytes;
+    if (need > (uint64_t)size) {
         return 0;
     }
 
-    return SCIPsetConsModifiable(scip_instance, cons, modifiable ? TRUE : FALSE) == SCIP_OKAY ? 1 : 0;
+    b->flags = header[2];
+    b->nvars = nvars;
+    b->nrows = nrows;
+    b->nnz = nnz;
+    b->lb = (const double*)(blob + MODEL_BLOB_HEADER_INTS * 4);
+    b->ub = b->lb + nvars;
+    b->obj = b->ub + nvars;
+    b->lhs = b->obj + nvars;
+    b->rhs = b->lhs + nrows;
+    b->vals = b->rhs + nrows;
+    b->rowstart = (const int*)(b->vals + nnz);
+    b->colidx = b->rowstart + nrows + 1;
+    b->vartype = (const unsigned char*)(b->colidx + nnz);
+    b->rowflags = b->vartype + nvars;
+    b->names = (const char*)(b->rowflags + nrows);
+    b->namesend = b->names + namebytes;
+
+    if (b->rowstart[0] != 0 || b->rowstart[nrows] != nnz) {
+        return 0;
+    }
+    b->maxrowlen = 0;
+    for (int i = 0; i < nrows; ++i) {
+        int len = b->rowstart[i + 1] - b->rowstart[i];
+        if (len < 0) {
+            return 0;
+        }
+        if (len > b->maxrowlen) {
+            b->maxrowlen = len;
+        }
+    }
+    for (int k = 0; k < nnz; ++k) {
+        if (b->colidx[k] < 0 || b->colidx[k] >= nvars) {
+            return 0;
+        }
+    }
+    for (int j = 0; j < nvars; ++j) {
+        if (b->vartype[j] > SCIP_VARTYPE_CONTINUOUS) {
+            return 0;
+        }
+    }
+    return 1;
 }
 
+/**
+ * Replace the current problem with the model in `blob`. Variable j gets handle
+ * j + 1 and row i gets constraint handle i + 1. Returns 1 on success, 0 if the
+ * blob is malformed or SCIP rejects the model; a model rejected partway is
+ * freed, so no problem is left loaded.
+ */
 EMSCRIPTEN_KEEPALIVE
-int scip_add_var(
-    const char* name,
-    double lb,
-    double ub,
-    double obj,
-    int vartype,
-    int initial,
-    int removable)
+int scip_problem_load_blob(const unsigned char* blob, int size)
 {
-    if (scip_instance == NULL || name == NULL) {
-        return -1;
+    MODELBLOB b;
+    if (scip_instance == NULL || !modelBlobParse(blob, size, &b)) {
+        return 0;
     }
 
-    SCIP_VAR* var = NULL;
-    SCIP_RETCODE ret = SCIPcreateVarBasic(scip_instance, &var, name, lb, ub, obj, (SCIP_VARTYPE)vartype);
-    if (ret != SCIP_OKAY || var == NULL) {
-        return -1;
+    const char* names = b.names;
+    SCIP_Bool hasnames = (b.flags & MODEL_BLOB_FLAG_NAMES) != 0;
+    const char* problemname = hasnames ? blobNextName(&names, b.namesend) : "js_problem";
+    if (problemname == NULL || !scip_problem_begin(problemname, b.flags & MODEL_BLOB_FLAG_MAXIMIZE)) {
+        return 0;
     }
 
-    SCIP_CALL_ABORT(SCIPvarSetInitial(var, initial ? TRUE : FALSE));
-    SCIP_CALL_ABORT(SCIPvarSetRemovable(var, removable ? TRUE : FALSE));
+    SCIP_VAR** rowvars = NULL;
+    int ok = ensureVarRegistryCapacity(b.nvars) && ensureConsRegistryCapacity(b.nrows);
 
-    ret = SCIPaddVar(scip_instance, var);
-    if (ret != SCIP_OKAY) {
+    char namebuf[32];
+    for (int j = 0; ok && j < b.nvars; ++j) {
+        const char* name = namebuf;
+        if (hasnames) {
+            name = blobNextName(&names, b.namesend);
+        } else {
+            snprintf(namebuf, sizeof(namebuf), "x%d", j);
+        }
+
+        SCIP_VAR* var = NULL;
+        if (name == NULL
+            || SCIPcreateVarBasic(scip_instance, &var, name, b.lb[j], b.ub[j], b.obj[j], (SCIP_VARTYPE)b.vartype[j]) != SCIP_OKAY) {
+            ok = 0;
+            break;
+        }
+        if (SCIPaddVar(scip_instance, var) != SCIP_OKAY) {
+            SCIP_CALL_ABORT(SCIPreleaseVar(scip_instance, &var));
+            ok = 0;
+            break;
+        }
+        appendVarHandle(var);
         SCIP_CALL_ABORT(SCIPreleaseVar(scip_instance, &var));
-        return -1;
     }
 
-    int varId = registerVarHandle(var);
-    SCIP_CALL_ABORT(SCIPreleaseVar(scip_instance, &var));
-    return varId;
-}
+    if (ok) {
+        rowvars = (SCIP_VAR**)bridgeAlloc((size_t)(b.maxrowlen > 0 ? b.maxrowlen : 1) * sizeof(SCIP_VAR*));
+        ok = rowvars != NULL;
+    }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_add_coef_linear(int consId, int varId, double val)
-{
-    if (scip_instance == NULL) {
-        return 0;
+    for (int i = 0; ok && i < b.nrows; ++i) {
+        const char* name = namebuf;
+        if (hasnames) {
+            name = blobNextName(&names, b.namesend);
+            if (name == NULL) {
+                ok = 0;
+                break;
+            }
+        } else {
+            snprintf(namebuf, sizeof(namebuf), "c%d", i);
+        }
+
+        int begin = b.rowstart[i];
+        int len = b.rowstart[i + 1] - begin;
+        for (int k = 0; k < len; ++k) {
+            rowvars[k] = var_registry[b.colidx[begin + k]];
+        }
+
+        SCIP_CONS* cons = NULL;
+        SCIP_RETCODE ret = SCIPcreateConsLinear(scip_instance, &cons, name, len, rowvars, (SCIP_Real*)&b.vals[begin],
+            b.lhs[i], b.rhs[i], TRUE, TRUE, TRUE, TRUE, TRUE, FALSE,
+            (b.rowflags[i] & MODEL_BLOB_ROW_MODIFIABLE) ? TRUE : FALSE, FALSE,
+            (b.rowflags[i] & MODEL_BLOB_ROW_REMOVABLE) ? TRUE : FALSE, FALSE);
+        if (ret != SCIP_OKAY || SCIPaddCons(scip_instance, cons) != SCIP_OKAY) {
+            if (cons != NULL) {
+                SCIPreleaseCons(scip_instance, &cons);
+            }
+            ok = 0;
+            break;
+        }
+        appendConsHandle(cons);
+        SCIPreleaseCons(scip_instance, &cons);
     }
 
-    SCIP_CONS* cons = getConsByHandle(consId);
-    SCIP_VAR* var = getVarByHandle(varId);
-    if (cons == NULL || var == NULL) {
+    if (rowvars != NULL) {
+        bridgeFree(rowvars);
+    }
+    if (!ok) {
+        // Leave no half-built model behind
+        clearCurrentProblem();
+        clearRegistries();
         return 0;
     }
-
-    return SCIPaddCoefLinear(scip_instance, cons, var, val) == SCIP_OKAY ? 1 : 0;
+    memorySample(MEMORY_PHASE_READ);
+    return 1;
 }
 
+/**
+ * Connected components of a model blob's constraint matrix, by union-find over
+ * its CSR; needs no problem loaded. Writes labels[nvars + nrows]: the component
+ * of each variable, then of each row, numbered 0.. in order of first variable.
+ * Variables in no row and empty rows get -1. Returns the number of components,
+ * -1 if the blob is malformed.
+ */
 EMSCRIPTEN_KEEPALIVE
-int scip_add_coef_linear_batch(int consId, int* varIds, double* vals, int nnz)
+int scip_blob_components(const unsigned char* blob, int size, int* labels)
 {
-    if (scip_instance == NULL || varIds == NULL || vals == NULL || nnz < 0) {
-        return 0;
+    MODELBLOB b;
+    if (labels == NULL || !modelBlobParse(blob, size, &b)) {
+        return -1;
+    }
+
+    int nvars = b.nvars;
+    int nrows = b.nrows;
+    const int* rowstart = b.rowstart;
+    const int* colidx = b.colidx;
+
+    int* parent = (int*)malloc((size_t)(nvars > 0 ? nvars : 1) * sizeof(int));
+    int* compsize = (int*)malloc((size_t)(nvars > 0 ? nvars : 1) * sizeof(int));
+    if (parent == NULL || compsize == NULL) {
+        free(parent);
+        free(compsize);
+        return -1;
+    }
+    for (int j = 0; j < nvars; ++j) {
+        parent[j] = j;
+        compsize[j] = 1;
+        labels[j] = -1;
+    }
+
+    for (int i = 0; i < nrows; ++i) {
+        int begin = rowstart[i];
+        for (int k = begin; k < rowstart[i + 1]; ++k) {
+            // Mark the variable as covered; labels are assigned below
+            labels[colidx[k]] = 0;
+            if (k > begin) {
+                ufUnion(parent, compsize, colidx[begin], colidx[k]);
+            }
+        }
     }
 
-    SCIP_CONS* cons = getConsByHandle(consId);
-    if (cons == NULL) {
-        return 0;
+    // Number the roots in variable order; compsize is reused as root -> label
+    int ncomponents = 0;
+    for (int j = 0; j < nvars; ++j) {
+        compsize[j] = -1;
     }
-
-    for (int i = 0; i < nnz; ++i) {
-        SCIP_VAR* var = getVarByHandle(varIds[i]);
-        if (var == NULL) {
-            return 0;
+    for (int j = 0; j < nvars; ++j) {
+        if (labels[j] < 0) {
+            continue;
         }
-        if (SCIPaddCoefLinear(scip_instance, cons, var, vals[i]) != SCIP_OKAY) {
-            return 0;
+        int root = ufFind(parent, j);
+        if (compsize[root] < 0) {
+            compsize[root] = ncomponents++;
         }
+        labels[j] = compsize[root];
+    }
+    for (int i = 0; i < nrows; ++i) {
+        labels[nvars + i] = rowstart[i] < rowstart[i + 1] ? labels[colidx[rowstart[i]]] : -1;
     }
 
-    return 1;
+    free(parent);
+    free(compsize);
+    return ncomponents;
 }
 
 /**
- * Read problem from file
+ * Best-solution values of the first n registered variables (handle order).
+ * Returns the number written, 0 without a solution.
  */
 EMSCRIPTEN_KEEPALIVE
-int scip_read_problem(const char* filename)
+int scip_get_var_values_batch(double* out, int n)
 {
-    if (scip_instance == NULL) {
+    if (scip_instance == NULL || out == NULL || n <= 0) {
         return 0;
     }
-    
-    SCIP_RETCODE retcode = SCIPreadProb(scip_instance, filename, NULL);
-    return retcode == SCIP_OKAY ? 1 : 0;
-}
 
-/**
- * Set time limit
- */
-EMSCRIPTEN_KEEPALIVE
-void scip_set_time_limit(double seconds)
-{
-    if (scip_instance != NULL) {
-        SCIPsetRealParam(scip_instance, "limits/time", seconds);
+    SCIP_SOL* sol = SCIPgetBestSol(scip_instance);
+    if (sol == NULL) {
+        return 0;
     }
-}
 
-/**
- * Set gap tolerance
- */
-EMSCRIPTEN_KEEPALIVE
-void scip_set_gap(double gap)
-{
-    if (scip_instance != NULL) {
-        SCIPsetRealParam(scip_instance, "limits/gap", gap);
+    int count = n < var_registry_size ? n : var_registry_size;
+    for (int i = 0; i < count; ++i) {
+        out[i] = SCIPgetSolVal(scip_instance, sol, var_registry[i]);
     }
+    return count;
 }
 
+/**
+ * Offer values for the first n registered variables (handle order) as a start
+ * solution, e.g. the previous incumbent of a repeated model. NaN marks a value
+ * as unknown: before the solve such a solution is stored as a partial solution
+ * that SCIP's completesol heuristic completes. Returns 1 if SCIP stored it.
+ */
 EMSCRIPTEN_KEEPALIVE
-int scip_set_param_int(const char* name, int value)
+int scip_add_solution_values(const double* vals, int n)
 {
-    if (scip_instance == NULL || name == NULL) {
+    if (scip_instance == NULL || vals == NULL || n <= 0) {
         return 0;
     }
-    return SCIPsetIntParam(scip_instance, name, value) == SCIP_OKAY ? 1 : 0;
-}
 
-EMSCRIPTEN_KEEPALIVE
-int scip_set_param_real(const char* name, double value)
-{
-    if (scip_instance == NULL || name == NULL) {
+    int count = n < var_registry_size ? n : var_registry_size;
+    SCIP_Bool partial = FALSE;
+    for (int i = 0; i < count && !partial; ++i) {
+        partial = isnan(vals[i]);
+    }
+    if (partial && SCIPgetStage(scip_instance) != SCIP_STAGE_PROBLEM) {
         return 0;
     }
-    return SCIPsetRealParam(scip_instance, name, value) == SCIP_OKAY ? 1 : 0;
-}
 
-EMSCRIPTEN_KEEPALIVE
-int scip_set_param_bool(const char* name, int value)
-{
-    if (scip_instance == NULL || name == NULL) {
-        return 0;
+    SCIP_SOL* sol;
+    SCIP_Bool stored = FALSE;
+    if (partial) {
+        SCIP_CALL_ABORT(SCIPcreatePartialSol(scip_instance, &sol, NULL));
+    } else {
+        SCIP_CALL_ABORT(SCIPcreateSol(scip_instance, &sol, NULL));
     }
-    return SCIPsetBoolParam(scip_instance, name, value ? TRUE : FALSE) == SCIP_OKAY ? 1 : 0;
-}
 
-EMSCRIPTEN_KEEPALIVE
-int scip_set_param_string(const char* name, const char* value)
-{
-    if (scip_instance == NULL || name == NULL || value == NULL) {
-        return 0;
+    for (int i = 0; i < count; ++i) {
+        if (!isnan(vals[i])) {
+            SCIP_CALL_ABORT(SCIPsetSolVal(scip_instance, sol, var_registry[i], vals[i]));
+        }
     }
-    return SCIPsetStringParam(scip_instance, name, value) == SCIP_OKAY ? 1 : 0;
+
+    SCIP_CALL_ABORT(SCIPaddSolFree(scip_instance, &sol, &stored));
+    return stored ? 1 : 0;
 }
 
 /**
- * Add initial solution hint
- * Variables are passed as name,value pairs separated by semicolons
- * Example: "x=1;y=2;z=3"
+ * Change the bounds of n variables by handle in one call (NaN keeps a bound),
+ * e.g. to fix a neighbourhood for the next solve. A transformed or solved
+ * problem is dropped first, so the next scip_solve starts over on the changed
+ * original problem. Returns the number of variables changed.
  */
 EMSCRIPTEN_KEEPALIVE
-int scip_add_solution_hint(const char* solution_str)
+int scip_set_var_bounds_batch(const int* varIds, const double* lb, const double* ub, int n)
 {
-    if (scip_instance == NULL || solution_str == NULL) {
+    if (scip_instance == NULL || varIds == NULL || lb == NULL || ub == NULL || n < 0) {
         return 0;
     }
-    
-    SCIP_SOL* sol;
-    SCIP_Bool stored;
-    
-    // Create solution
-    SCIP_CALL_ABORT(SCIPcreateSol(scip_instance, &sol, NULL));
-    
-    // Parse solution string
-    char* str = strdup(solution_str);
-    char* token = strtok(str, ";");
-    
-    while (token != NULL) {
-        char varname[256];
-        double value;
-        
-        if (sscanf(token, "%255[^=]=%lf", varname, &value) == 2) {
-            SCIP_VAR* var = SCIPfindVar(scip_instance, varname);
-            if (var != NULL) {
-                SCIPsetSolVal(scip_instance, sol, var, value);
+    if (SCIPgetStage(scip_instance) > SCIP_STAGE_PROBLEM && SCIPfreeTransform(scip_instance) != SCIP_OKAY) {
+        return 0;
+    }
+
+    int changed = 0;
+    for (int i = 0; i < n; ++i) {
+        SCIP_VAR* var = getVarByHandle(varIds[i]);
+        if (var == NULL) {
+            continue;
+        }
+        SCIP_Bool setlb = lb[i] == lb[i];
+        SCIP_Bool setub = ub[i] == ub[i];
+        // Raise the upper bound first when the new lower bound would cross the old one
+        if (setlb && setub && lb[i] > SCIPvarGetUbOriginal(var)) {
+            if (SCIPchgVarUb(scip_instance, var, ub[i]) != SCIP_OKAY || SCIPchgVarLb(scip_instance, var, lb[i]) != SCIP_OKAY) {
+                continue;
             }
+        } else if ((setlb && SCIPchgVarLb(scip_instance, var, lb[i]) != SCIP_OKAY)
+            || (setub && SCIPchgVarUb(scip_instance, var, ub[i]) != SCIP_OKAY)) {
+            continue;
         }
-        
-        token = strtok(NULL, ";");
+        changed += 1;
     }
-    
-    free(str);
-    
-    // Try to add solution
-    SCIP_CALL_ABORT(SCIPtrySol(scip_instance, sol, FALSE, FALSE, FALSE, FALSE, FALSE, &stored));
-    SCIP_CALL_ABORT(SCIPfreeSol(scip_instance, &sol));
-    
-    return stored ? 1 : 0;
+    return changed;
 }
 
-/**
- * Set cutoff bound (prune nodes with worse bounds)
- */
-EMSCRIPTEN_KEEPALIVE
-void scip_set_cutoff(double cutoff)
+// ============================================
+// Checkpoint and Resume
+// ============================================
+
+// Branching decisions from the root to `node`, reduced to the tightest lower
+// and upper bound per variable handle; appended to the growable bd* arrays
+static int checkpointCollectNode(SCIP_NODE* node, const int* handleof, int ntransvars,
+    SCIP_VAR*** vars, SCIP_Real** bounds, SCIP_BOUNDTYPE** types, int* capacity,
+    int** bdvar, double** bdval, unsigned char** bdtype, int* nbd, int* bdcapacity, int* skipped)
 {
-    if (scip_instance != NULL) {
-        SCIPsetObjlimit(scip_instance, cutoff);
+    int n = 0;
+    SCIPnodeGetAncestorBranchings(node, *vars, *bounds, *types, &n, *capacity);
+    if (n > *capacity) {
+        *capacity = n;
+        *vars = (SCIP_VAR**)realloc(*vars, (size_t)n * sizeof(SCIP_VAR*));
+        *bounds = (SCIP_Real*)realloc(*bounds, (size_t)n * sizeof(SCIP_Real));
+        *types = (SCIP_BOUNDTYPE*)realloc(*types, (size_t)n * sizeof(SCIP_BOUNDTYPE));
+        if (*vars == NULL || *bounds == NULL || *types == NULL) {
+            return 0;
+        }
+        SCIPnodeGetAncestorBranchings(node, *vars, *bounds, *types, &n, *capacity);
+    }
+
+    if (*nbd + n > *bdcapacity) {
+        int grown = (*nbd + n) * 2;
+        *bdvar = (int*)realloc(*bdvar, (size_t)grown * sizeof(int));
+        *bdval = (double*)realloc(*bdval, (size_t)grown * sizeof(double));
+        *bdtype = (unsigned char*)realloc(*bdtype, (size_t)grown);
+        if (*bdvar == NULL || *bdval == NULL || *bdtype == NULL) {
+            return 0;
+        }
+        *bdcapacity = grown;
     }
+
+    int first = *nbd;
+    for (int i = 0; i < n; ++i) {
+        int probindex = SCIPvarGetProbindex((*vars)[i]);
+        int handle = probindex >= 0 && probindex < ntransvars ? handleof[probindex] : -1;
+        unsigned char type = (*types)[i] == SCIP_BOUNDTYPE_LOWER ? 0 : 1;
+        if (handle < 0) {
+            *skipped += 1;
+            continue;
+        }
+
+        int b = first;
+        while (b < *nbd && ((*bdvar)[b] != handle || (*bdtype)[b] != type)) {
+            ++b;
+        }
+        if (b == *nbd) {
+            (*bdvar)[b] = handle;
+            (*bdtype)[b] = type;
+            (*bdval)[b] = (*bounds)[i];
+            *nbd += 1;
+        } else if (type == 0 ? (*bounds)[i] > (*bdval)[b] : (*bounds)[i] < (*bdval)[b]) {
+            (*bdval)[b] = (*bounds)[i];
+        }
+    }
+    return 1;
 }
 
 /**
- * Solve the problem
+ * Snapshot an interrupted solve (SOLVING stage, e.g. after a time limit): open
+ * nodes, up to `maxsols` best solutions, bounds and pseudocosts, keyed by
+ * variable handle. Returns the size in bytes (read it with
+ * scip_checkpoint_data) or 0 if there is nothing to snapshot.
  */
 EMSCRIPTEN_KEEPALIVE
-int scip_solve(void)
+int scip_checkpoint_save(int maxsols)
 {
-    if (scip_instance == NULL) {
-        return -1;
+    free(checkpoint_data);
+    checkpoint_data = NULL;
+    checkpoint_size = 0;
+
+    if (scip_instance == NULL || SCIPgetStage(scip_instance) != SCIP_STAGE_SOLVING) {
+        return 0;
     }
 
-    current_pricing_mode = 0;
-    added_vars_this_call = 0;
-    
-    SCIP_RETCODE retcode = SCIPsolve(scip_instance);
-    
-    if (retcode != SCIP_OKAY) {
-        return -1;
+    SCIP* scip = scip_instance;
+    int nvars = var_registry_size;
+    int ntransvars = SCIPgetNVars(scip);
+
+    // Active transformed variable -> handle of the original variable
+    int* handleof = (int*)malloc((size_t)(ntransvars > 0 ? ntransvars : 1) * sizeof(int));
+    if (handleof == NULL) {
+        return 0;
     }
-    
-    SCIP_STATUS status = SCIPgetStatus(scip_instance);
-    
-    switch (status) {
-        case SCIP_STATUS_OPTIMAL:
-            return 0;
-        case SCIP_STATUS_INFEASIBLE:
-            return 1;
-        case SCIP_STATUS_UNBOUNDED:
-            return 2;
-        case SCIP_STATUS_TIMELIMIT:
-            return 3;
-        default:
-            return 4;
+    for (int j = 0; j < ntransvars; ++j) {
+        handleof[j] = -1;
+    }
+    for (int i = 0; i < nvars; ++i) {
+        SCIP_VAR* transvar = SCIPvarGetTransVar(var_registry[i]);
+        int probindex = transvar != NULL && SCIPvarIsActive(transvar) ? SCIPvarGetProbindex(transvar) : -1;
+        if (probindex >= 0 && probindex < ntransvars) {
+            handleof[probindex] = i;
+        }
     }
-}
 
-/**
- * Get objective value
- */
-EMSCRIPTEN_KEEPALIVE
-double scip_get_objective(void)
-{
-    if (scip_instance == NULL) {
-        return 0.0;
+    SCIP_NODE** leaves;
+    SCIP_NODE** children;
+    SCIP_NODE** siblings;
+    int nleaves = 0;
+    int nchildren = 0;
+    int nsiblings = 0;
+    if (SCIPgetOpenNodesData(scip, &leaves, &children, &siblings, &nleaves, &nchildren, &nsiblings) != SCIP_OKAY) {
+        free(handleof);
+        return 0;
     }
-    
-    SCIP_SOL* sol = SCIPgetBestSol(scip_instance);
-    if (sol == NULL) {
-        return 0.0;
+
+    int nnodes = nleaves + nchildren + nsiblings;
+    double* nodelb = (double*)malloc((size_t)(nnodes > 0 ? nnodes : 1) * sizeof(double));
+    int* nodestart = (int*)malloc((size_t)(nnodes + 1) * sizeof(int));
+    SCIP_VAR** vars = NULL;
+    SCIP_Real* bounds = NULL;
+    SCIP_BOUNDTYPE* types = NULL;
+    int capacity = 0;
+    int* bdvar = NULL;
+    double* bdval = NULL;
+    unsigned char* bdtype = NULL;
+    int nbd = 0;
+    int bdcapacity = 0;
+    int skipped = 0;
+    int ok = nodelb != NULL && nodestart != NULL;
+
+    for (int k = 0; ok && k < nnodes; ++k) {
+        SCIP_NODE* node = k < nleaves ? leaves[k]
+            : k < nleaves + nchildren ? children[k - nleaves] : siblings[k - nleaves - nchildren];
+        int before = skipped;
+        nodestart[k] = nbd;
+        ok = checkpointCollectNode(node, handleof, ntransvars, &vars, &bounds, &types, &capacity,
+            &bdvar, &bdval, &bdtype, &nbd, &bdcapacity, &skipped);
+        // A node with dropped bound changes is larger on resume; its bound no longer holds
+        nodelb[k] = skipped == before ? SCIPretransformObj(scip, SCIPnodeGetLowerbound(node)) : SCIP_INVALID;
+    }
+    if (ok) {
+        nodestart[nnodes] = nbd;
+    }
+
+    int nsols = SCIPgetNSols(scip) < maxsols ? SCIPgetNSols(scip) : maxsols;
+    if (nsols < 0) {
+        nsols = 0;
+    }
+
+    int header[CHECKPOINT_HEADER_INTS] = { 0 };
+    header[0] = CHECKPOINT_MAGIC;
+    header[1] = CHECKPOINT_VERSION;
+    header[2] = nvars;
+    header[3] = nnodes;
+    header[4] = nbd;
+    header[5] = nsols;
+    header[6] = CHECKPOINT_FLAG_PSEUDOCOSTS;
+    header[7] = skipped;
+
+    uint64_t region = 0;
+    uint64_t objective = 0;
+    ok = ok && cutpackModelHashes(scip, &region, &objective);
+    header[8] = (int)(uint32_t)region;
+    header[9] = (int)(uint32_t)(region >> 32);
+    header[10] = (int)(uint32_t)objective;
+    header[11] = (int)(uint32_t)(objective >> 32);
+
+    CHECKPOINTLAYOUT layout;
+    checkpointLayout(header, &layout);
+    unsigned char* data = ok && layout.size <= (uint64_t)INT32_MAX ? (unsigned char*)calloc((size_t)layout.size, 1) : NULL;
+
+    if (data != NULL) {
+        memcpy(data, header, sizeof(header));
+
+        double* stats = (double*)(data + CHECKPOINT_HEADER_INTS * sizeof(int));
+        stats[0] = SCIPgetDualbound(scip);
+        stats[1] = SCIPgetPrimalbound(scip);
+        stats[2] = SCIPgetSolvingTime(scip);
+        stats[3] = (double)SCIPgetNNodes(scip);
+        stats[4] = (double)SCIPgetNLPIterations(scip);
+
+        memcpy(data + layout.nodelb, nodelb, (size_t)nnodes * sizeof(double));
+        memcpy(data + layout.bdval, bdval, (size_t)nbd * sizeof(double));
+        memcpy(data + layout.nodestart, nodestart, (size_t)(nnodes + 1) * sizeof(int));
+        memcpy(data + layout.bdvar, bdvar, (size_t)nbd * sizeof(int));
+        memcpy(data + layout.bdtype, bdtype, (size_t)nbd);
+
+        SCIP_SOL** sols = SCIPgetSols(scip);
+        double* solvals = (double*)(data + layout.sols);
+        for (int s = 0; s < nsols; ++s) {
+            for (int i = 0; i < nvars; ++i) {
+                solvals[(size_t)s * nvars + i] = SCIPgetSolVal(scip, sols[s], var_registry[i]);
+            }
+        }
+
+        double* pseudocost = (double*)(data + layout.pseudocost);
+        for (int i = 0; i < nvars; ++i) {
+            SCIP_VAR* transvar = SCIPvarGetTransVar(var_registry[i]);
+            if (transvar == NULL || !SCIPvarIsActive(transvar)) {
+                continue;
+            }
+            pseudocost[i] = SCIPgetVarPseudocost(scip, transvar, SCIP_BRANCHDIR_DOWNWARDS);
+            pseudocost[nvars + i] = SCIPgetVarPseudocost(scip, transvar, SCIP_BRANCHDIR_UPWARDS);
+            pseudocost[2 * nvars + i] = SCIPgetVarPseudocostCount(scip, transvar, SCIP_BRANCHDIR_DOWNWARDS);
+            pseudocost[3 * nvars + i] = SCIPgetVarPseudocostCount(scip, transvar, SCIP_BRANCHDIR_UPWARDS);
+        }
+
+        checkpoint_data = data;
+        checkpoint_size = (int)layout.size;
     }
-    
-    return SCIPgetSolOrigObj(scip_instance, sol);
+
+    free(handleof);
+    free(nodelb);
+    free(nodestart);
+    free(vars);
+    free(bounds);
+    free(types);
+    free(bdvar);
+    free(bdval);
+    free(bdtype);
+    return checkpoint_size;
 }
 
 /**
- * Get solution value for a variable
+ * Pointer to the last checkpoint written by scip_checkpoint_save (NULL if none)
  */
 EMSCRIPTEN_KEEPALIVE
-double scip_get_var_value(const char* varname)
+unsigned char* scip_checkpoint_data(void)
 {
-    if (scip_instance == NULL || varname == NULL) {
-        return 0.0;
-    }
-    
-    SCIP_SOL* sol = SCIPgetBestSol(scip_instance);
-    if (sol == NULL) {
-        return 0.0;
-    }
-    
-    SCIP_VAR* var = SCIPfindVar(scip_instance, varname);
-    if (var == NULL) {
-        return 0.0;
-    }
-    
-    return SCIPgetSolVal(scip_instance, sol, var);
+    return checkpoint_data;
 }
 
-/**
- * Get number of variables
- */
 EMSCRIPTEN_KEEPALIVE
-int scip_get_nvars(void)
+void scip_checkpoint_free(void)
 {
-    if (scip_instance == NULL) {
-        return 0;
-    }
-    return SCIPgetNVars(scip_instance);
+    free(checkpoint_data);
+    checkpoint_data = NULL;
+    checkpoint_size = 0;
 }
 
 /**
- * Get all variable names (comma separated)
+ * Resume from a checkpoint on the same model, loaded afresh (PROBLEM stage,
+ * same variable handles). The model must hash the same as the one saved
+ * (feasible region and objective); the node bound changes are validated
+ * before anything is applied. The stored solutions are added as start
+ * solutions and the next solve re-creates the open nodes at the root.
  */
 EMSCRIPTEN_KEEPALIVE
-const char* scip_get_var_names(void)
+int scip_checkpoint_load(const unsigned char* data, int size)
 {
-    static char buffer[65536];
-    buffer[0] = '\0';
-    
-    if (scip_instance == NULL) {
-        return buffer;
-    }
-    
-    SCIP_VAR** vars = SCIPgetVars(scip_instance);
-    int nvars = SCIPgetNVars(scip_instance);
-    
-    int pos = 0;
-    for (int i = 0; i < nvars && pos < 65000; i++) {
-        const char* name = SCIPvarGetName(vars[i]);
-        if (i > 0) {
-            buffer[pos++] = ',';
-        }
-        int len = strlen(name);
-        memcpy(buffer + pos, name, len);
-        pos += len;
+    if (scip_instance == NULL || data == NULL || size < (int)(CHECKPOINT_HEADER_INTS * sizeof(int))) {
+        return 0;
     }
-    buffer[pos] = '\0';
-    
-    return buffer;
-}
-
-EMSCRIPTEN_KEEPALIVE
-double scip_ctx_get_var_lp_value(int varId)
-{
-    if (scip_instance == NULL) {
-        return 0.0;
+    if (SCIPgetStage(scip_instance) != SCIP_STAGE_PROBLEM) {
+        return 0;
     }
 
-    if (SCIPgetStage(scip_instance) != SCIP_STAGE_SOLVING) {
-        return 0.0;
+    const int* header = (const int*)data;
+    CHECKPOINTLAYOUT layout;
+    if (header[0] != CHECKPOINT_MAGIC || header[1] != CHECKPOINT_VERSION || header[2] != var_registry_size
+        || header[3] < 0 || header[4] < 0 || header[5] < 0) {
+        return 0;
     }
-
-    SCIP_VAR* var = getVarByHandle(varId);
-    if (var == NULL) {
-        return 0.0;
+    checkpointLayout(header, &layout);
+    if (layout.size != (uint64_t)size) {
+        return 0;
     }
 
-    return SCIPgetVarSol(scip_instance, var);
-}
+    uint64_t region = 0;
+    uint64_t objective = 0;
+    if (!cutpackModelHashes(scip_instance, &region, &objective)
+        || (uint32_t)header[8] != (uint32_t)region || (uint32_t)header[9] != (uint32_t)(region >> 32)
+        || (uint32_t)header[10] != (uint32_t)objective || (uint32_t)header[11] != (uint32_t)(objective >> 32)) {
+        return 0;
+    }
 
-EMSCRIPTEN_KEEPALIVE
-double scip_ctx_get_var_redcost(int varId)
-{
-    if (scip_instance == NULL) {
-        return 0.0;
+    int nnodes = header[3];
+    int nbdchgs = header[4];
+    const int* nodestart = (const int*)(data + layout.nodestart);
+    const int* bdvar = (const int*)(data + layout.bdvar);
+    const unsigned char* bdtype = data + layout.bdtype;
+    if (nodestart[0] != 0 || nodestart[nnodes] != nbdchgs) {
+        return 0;
+    }
+    for (int k = 0; k < nnodes; ++k) {
+        if (nodestart[k + 1] < nodestart[k]) {
+            return 0;
+        }
+    }
+    for (int b = 0; b < nbdchgs; ++b) {
+        if (bdvar[b] < 0 || bdvar[b] >= header[2] || bdtype[b] > 1) {
+            return 0;
+        }
     }
 
-    if (SCIPgetStage(scip_instance) != SCIP_STAGE_SOLVING) {
-        return 0.0;
+    freeResume();
+    resume_data = (unsigned char*)malloc((size_t)size);
+    if (resume_data == NULL) {
+        return 0;
     }
+    memcpy(resume_data, data, (size_t)size);
 
-    SCIP_VAR* var = getVarByHandle(varId);
-    if (var == NULL) {
-        return 0.0;
+    const double* solvals = (const double*)(resume_data + layout.sols);
+    for (int s = 0; s < header[5]; ++s) {
+        SCIP_SOL* sol;
+        SCIP_Bool stored = FALSE;
+        if (SCIPcreateSol(scip_instance, &sol, NULL) != SCIP_OKAY) {
+            break;
+        }
+        for (int i = 0; i < header[2]; ++i) {
+            SCIPsetSolVal(scip_instance, sol, var_registry[i], solvals[(size_t)s * header[2] + i]);
+        }
+        SCIPaddSolFree(scip_instance, &sol, &stored);
     }
 
-    return SCIPgetVarRedcost(scip_instance, var);
+    resume_pending = TRUE;
+    resume_nodes_created = 0;
+    return 1;
 }
 
 /**
- * Get solving statistics
+ * Open nodes re-created by the last resume (0 until its root has branched)
  */
 EMSCRIPTEN_KEEPALIVE
-double scip_get_solving_time(void)
+int scip_checkpoint_resumed_nodes(void)
 {
-    if (scip_instance == NULL) return 0.0;
-    return SCIPgetSolvingTime(scip_instance);
+    return resume_nodes_created;
 }
 
-EMSCRIPTEN_KEEPALIVE
-long long scip_get_nnodes(void)
+// ============================================
+// Cut and Conflict Reuse
+// ============================================
+
+// In 64 bits like checkpointLayout
+static void cutpackLayout(const int* header, CUTPACKLAYOUT* layout)
 {
-    if (scip_instance == NULL) return 0;
-    return SCIPgetNNodes(scip_instance);
+    uint64_t nvars = (uint64_t)(uint32_t)header[2];
+    uint64_t nrows = (uint64_t)(uint32_t)header[3];
+    uint64_t nnz = (uint64_t)(uint32_t)header[4];
+    uint64_t nsols = (uint64_t)(uint32_t)header[5];
+
+    layout->lhs = CUTPACK_HEADER_INTS * sizeof(int);
+    layout->rhs = layout->lhs + nrows * sizeof(double);
+    layout->vals = layout->rhs + nrows * sizeof(double);
+    layout->sols = layout->vals + nnz * sizeof(double);
+    layout->rowstart = layout->sols + nsols * nvars * sizeof(double);
+    layout->colidx = layout->rowstart + (nrows + 1) * sizeof(int);
+    layout->rowflags = layout->colidx + nnz * sizeof(int);
+    layout->size = layout->rowflags + nrows;
 }
 
-EMSCRIPTEN_KEEPALIVE
-double scip_get_gap(void)
+// 64-bit FNV-1a
+static uint64_t fnv1a64(uint64_t hash, const void* data, size_t len)
 {
-    if (scip_instance == NULL) return 0.0;
-    return SCIPgetGap(scip_instance);
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
 }
 
-EMSCRIPTEN_KEEPALIVE
-double scip_get_dual_bound(void)
+static uint64_t fnv1a64Int(uint64_t hash, int value)
 {
-    if (scip_instance == NULL) return 0.0;
-    return SCIPgetDualbound(scip_instance);
+    return fnv1a64(hash, &value, sizeof(value));
 }
 
-EMSCRIPTEN_KEEPALIVE
-double scip_get_primal_bound(void)
+static uint64_t fnv1a64Real(uint64_t hash, double value)
 {
-    if (scip_instance == NULL) return 0.0;
-    return SCIPgetPrimalbound(scip_instance);
+    return fnv1a64(hash, &value, sizeof(value));
 }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_ctx_get_stage(void)
+// Original problem index of a variable, negated variables as -1 - index
+static int origVarIndex(SCIP_VAR* var)
 {
-    if (scip_instance == NULL) {
-        return -1;
+    if (SCIPvarGetStatus(var) == SCIP_VARSTATUS_NEGATED) {
+        return -1 - SCIPvarGetProbindex(SCIPvarGetNegationVar(var));
     }
-    return (int)SCIPgetStage(scip_instance);
+    return SCIPvarGetProbindex(var);
 }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_ctx_has_lp(void)
+/**
+ * Hashes of the original problem: `region` covers the variables (types and
+ * bounds) and the checked constraints, i.e. the feasible region; `objective`
+ * covers the sense and the coefficients. Unchecked constraints, imported cuts
+ * among them, do not count, so a re-solve that imported rows exports under
+ * the same hashes.
+ */
+static int cutpackModelHashes(SCIP* scip, uint64_t* region, uint64_t* objective)
 {
-    if (scip_instance == NULL) {
-        return 0;
-    }
+    int nvars = SCIPgetNOrigVars(scip);
+    int nconss = SCIPgetNOrigConss(scip);
+    SCIP_VAR** vars = SCIPgetOrigVars(scip);
+    SCIP_CONS** conss = SCIPgetOrigConss(scip);
+
+    *region = fnv1a64Int(0xcbf29ce484222325ULL, nvars);
+    *objective = fnv1a64Int(0xcbf29ce484222325ULL, (int)SCIPgetObjsense(scip));
+    for (int j = 0; j < nvars; ++j) {
+        *region = fnv1a64Int(*region, (int)SCIPvarGetType(vars[j]));
+        *region = fnv1a64Real(*region, SCIPvarGetLbOriginal(vars[j]));
+        *region = fnv1a64Real(*region, SCIPvarGetUbOriginal(vars[j]));
+        *objective = fnv1a64Real(*objective, SCIPvarGetObj(vars[j]));
+    }
+
+    SCIP_VAR** consvars = NULL;
+    SCIP_Real* consvals = NULL;
+    int capacity = 0;
+    for (int c = 0; c < nconss; ++c) {
+        SCIP_CONS* cons = conss[c];
+        if (!SCIPconsIsChecked(cons)) {
+            continue;
+        }
 
-    if (SCIPgetStage(scip_instance) != SCIP_STAGE_SOLVING) {
-        return 0;
+        const char* hdlr = SCIPconshdlrGetName(SCIPconsGetHdlr(cons));
+        *region = fnv1a64(*region, hdlr, strlen(hdlr) + 1);
+
+        SCIP_Bool success = FALSE;
+        int n = 0;
+        SCIPgetConsNVars(scip, cons, &n, &success);
+        if (!success) {
+            // No variable access: only the name identifies the constraint
+            const char* name = SCIPconsGetName(cons);
+            *region = fnv1a64(*region, name, strlen(name) + 1);
+            continue;
+        }
+        if (n > capacity) {
+            free(consvars);
+            free(consvals);
+            capacity = n;
+            consvars = (SCIP_VAR**)malloc((size_t)capacity * sizeof(SCIP_VAR*));
+            consvals = (SCIP_Real*)malloc((size_t)capacity * sizeof(SCIP_Real));
+            if (consvars == NULL || consvals == NULL) {
+                free(consvars);
+                free(consvals);
+                return 0;
+            }
+        }
+
+        *region = fnv1a64Int(*region, n);
+        SCIPgetConsVars(scip, cons, consvars, capacity, &success);
+        for (int k = 0; success && k < n; ++k) {
+            *region = fnv1a64Int(*region, origVarIndex(consvars[k]));
+        }
+        SCIPgetConsVals(scip, cons, consvals, capacity, &success);
+        for (int k = 0; success && k < n; ++k) {
+            *region = fnv1a64Real(*region, consvals[k]);
+        }
+        SCIP_Real lhs = SCIPconsGetLhs(scip, cons, &success);
+        if (success) {
+            *region = fnv1a64Real(*region, lhs);
+        }
+        SCIP_Real rhs = SCIPconsGetRhs(scip, cons, &success);
+        if (success) {
+            *region = fnv1a64Real(*region, rhs);
+        }
     }
 
-    return SCIPhasCurrentNodeLP(scip_instance) ? 1 : 0;
+    free(consvars);
+    free(consvals);
+    return 1;
 }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_ctx_get_lp_solstat(void)
+typedef struct {
+    double* lhs;
+    double* rhs;
+    int* rowstart;
+    unsigned char* rowflags;
+    int nrows;
+    int rowcapacity;
+    int* colidx;
+    double* vals;
+    int nnz;
+    int nnzcapacity;
+    double* dense;          // coefficient per column while a row is merged
+    int* touched;
+    int dropped;
+} SPARSEROWS;
+
+/**
+ * Append lhs <= sum vals[k] * vars[k] + constant <= rhs in CSR form over the
+ * columns `colof` assigns to active transformed variables (by probindex).
+ * Rows on multi-aggregated variables or variables without a column are
+ * counted as dropped, rows left without terms are skipped. Returns 0 on
+ * allocation failure.
+ */
+static int sparseRowsAdd(SCIP* scip, SPARSEROWS* b, const int* colof, int ntransvars,
+    SCIP_VAR** vars, const SCIP_Real* vals, int n, double constant, double lhs, double rhs, unsigned char flags)
 {
-    if (scip_instance == NULL) {
-        return -1;
+    if (b->nrows + 1 >= b->rowcapacity) {
+        int capacity = b->rowcapacity > 0 ? 2 * b->rowcapacity : 256;
+        double* newlhs = (double*)realloc(b->lhs, (size_t)capacity * sizeof(double));
+        if (newlhs != NULL) {
+            b->lhs = newlhs;
+        }
+        double* newrhs = (double*)realloc(b->rhs, (size_t)capacity * sizeof(double));
+        if (newrhs != NULL) {
+            b->rhs = newrhs;
+        }
+        int* newstart = (int*)realloc(b->rowstart, (size_t)capacity * sizeof(int));
+        if (newstart != NULL) {
+            b->rowstart = newstart;
+        }
+        unsigned char* newflags = (unsigned char*)realloc(b->rowflags, (size_t)capacity);
+        if (newflags != NULL) {
+            b->rowflags = newflags;
+        }
+        if (newlhs == NULL || newrhs == NULL || newstart == NULL || newflags == NULL) {
+            return 0;
+        }
+        b->rowcapacity = capacity;
+    }
+    if (b->nnz + n > b->nnzcapacity) {
+        int capacity = b->nnzcapacity > 0 ? b->nnzcapacity : 1024;
+        while (capacity < b->nnz + n) {
+            capacity *= 2;
+        }
+        int* newidx = (int*)realloc(b->colidx, (size_t)capacity * sizeof(int));
+        if (newidx != NULL) {
+            b->colidx = newidx;
+        }
+        double* newvals = (double*)realloc(b->vals, (size_t)capacity * sizeof(double));
+        if (newvals != NULL) {
+            b->vals = newvals;
+        }
+        // Touched handles of one row never exceed its length, hence the nnz capacity
+        int* newtouched = (int*)realloc(b->touched, (size_t)capacity * sizeof(int));
+        if (newtouched != NULL) {
+            b->touched = newtouched;
+        }
+        if (newidx == NULL || newvals == NULL || newtouched == NULL) {
+            return 0;
+        }
+        b->nnzcapacity = capacity;
+    }
+
+    int ntouched = 0;
+    SCIP_Bool ok = TRUE;
+    for (int k = 0; k < n && ok; ++k) {
+        SCIP_VAR* var = vars[k];
+        SCIP_Real scalar = vals[k];
+        SCIP_Real offset = 0.0;
+        if (SCIPgetProbvarSum(scip, &var, &scalar, &offset) != SCIP_OKAY) {
+            ok = FALSE;
+            break;
+        }
+        constant += offset;
+        if (scalar == 0.0 || var == NULL || SCIPvarGetStatus(var) == SCIP_VARSTATUS_FIXED) {
+            continue;
+        }
+        int probindex = SCIPvarIsActive(var) ? SCIPvarGetProbindex(var) : -1;
+        int col = probindex >= 0 && probindex < ntransvars ? colof[probindex] : -1;
+        if (col < 0) {
+            ok = FALSE;
+            break;
+        }
+        // A column whose terms cancelled may be listed twice; the second entry reads 0
+        if (b->dense[col] == 0.0) {
+            b->touched[ntouched] = col;
+            ntouched += 1;
+        }
+        b->dense[col] += scalar;
     }
 
-    if (SCIPgetStage(scip_instance) != SCIP_STAGE_SOLVING) {
-        return -1;
+    int begin = b->nnz;
+    for (int k = 0; k < ntouched; ++k) {
+        int col = b->touched[k];
+        if (ok && fabs(b->dense[col]) > 1e-12) {
+            b->colidx[b->nnz] = col;
+            b->vals[b->nnz] = b->dense[col];
+            b->nnz += 1;
+        }
+        b->dense[col] = 0.0;
+    }
+    if (!ok) {
+        b->nnz = begin;
+        b->dropped += 1;
+        return 1;
+    }
+    if (b->nnz == begin) {
+        return 1;
     }
 
-    return (int)SCIPgetLPSolstat(scip_instance);
+    b->lhs[b->nrows] = SCIPisInfinity(scip, -lhs) ? -SCIPinfinity(scip) : lhs - constant;
+    b->rhs[b->nrows] = SCIPisInfinity(scip, rhs) ? SCIPinfinity(scip) : rhs - constant;
+    b->rowstart[b->nrows] = begin;
+    b->rowflags[b->nrows] = flags;
+    b->nrows += 1;
+    b->rowstart[b->nrows] = b->nnz;
+    return 1;
 }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_ctx_get_pricing_mode(void)
+static void sparseRowsFree(SPARSEROWS* b)
 {
-    return current_pricing_mode;
+    free(b->lhs);
+    free(b->rhs);
+    free(b->rowstart);
+    free(b->rowflags);
+    free(b->colidx);
+    free(b->vals);
+    free(b->dense);
+    free(b->touched);
 }
 
+/**
+ * Export the globally valid cuts of the global cut pool (up to maxcuts) and
+ * the global conflict constraints (up to maxconflicts) of the current or
+ * finished solve, keyed by variable handle, with the model hashes and the
+ * incumbent. Cuts only depend on the feasible region when the solve ran
+ * without dual reductions (misc/allowstrongdualreds and
+ * misc/allowweakdualreds off); otherwise they, like all conflicts (which may
+ * rest on the cutoff bound), are flagged objective-dependent. Returns the size
+ * in bytes (read it with scip_cuts_data) or 0 if there is nothing to export.
+ */
 EMSCRIPTEN_KEEPALIVE
-int scip_ctx_is_transformed(void)
+int scip_cuts_export(int maxcuts, int maxconflicts)
 {
-    if (scip_instance == NULL) {
+    free(cutpack_data);
+    cutpack_data = NULL;
+    cutpack_size = 0;
+
+    if (scip_instance == NULL
+        || (SCIPgetStage(scip_instance) != SCIP_STAGE_SOLVING && SCIPgetStage(scip_instance) != SCIP_STAGE_SOLVED)) {
         return 0;
     }
-    return SCIPisTransformed(scip_instance) ? 1 : 0;
-}
 
-EMSCRIPTEN_KEEPALIVE
-int scip_var_find_id(const char* name)
-{
-    if (scip_instance == NULL || name == NULL) {
-        return -1;
+    SCIP* scip = scip_instance;
+    int nvars = var_registry_size;
+    int ntransvars = SCIPgetNVars(scip);
+    uint64_t region = 0;
+    uint64_t objective = 0;
+    if (!cutpackModelHashes(scip, &region, &objective)) {
+        return 0;
     }
 
-    SCIP_VAR* var = SCIPfindVar(scip_instance, name);
-    return registerVarHandle(var);
+    // Active transformed variable -> handle of the original variable
+    int* handleof = (int*)malloc((size_t)(ntransvars > 0 ? ntransvars : 1) * sizeof(int));
+    SPARSEROWS b;
+    memset(&b, 0, sizeof(b));
+    b.dense = (double*)calloc((size_t)(nvars > 0 ? nvars : 1), sizeof(double));
+    if (handleof == NULL || b.dense == NULL) {
+        free(handleof);
+        sparseRowsFree(&b);
+        return 0;
+    }
+    for (int j = 0; j < ntransvars; ++j) {
+        handleof[j] = -1;
+    }
+    for (int i = 0; i < nvars; ++i) {
+        SCIP_VAR* transvar = SCIPvarGetTransVar(var_registry[i]);
+        int probindex = transvar != NULL && SCIPvarIsActive(transvar) ? SCIPvarGetProbindex(transvar) : -1;
+        if (probindex >= 0 && probindex < ntransvars) {
+            handleof[probindex] = i;
+        }
+    }
+
+    SCIP_Bool strongdual = TRUE;
+    SCIP_Bool weakdual = TRUE;
+    SCIPgetBoolParam(scip, "misc/allowstrongdualreds", &strongdual);
+    SCIPgetBoolParam(scip, "misc/allowweakdualreds", &weakdual);
+    unsigned char cutflags = strongdual || weakdual || cutpack_imported_objective ? CUTPACK_ROW_OBJECTIVE : 0;
+
+    SCIP_VAR** rowvars = NULL;
+    SCIP_Real* rowvals = NULL;
+    int capacity = 0;
+    int ok = 1;
+
+    SCIP_CUT** cuts = SCIPgetPoolCuts(scip);
+    int ncuts = SCIPgetNPoolCuts(scip);
+    int nexported = 0;
+    for (int c = 0; c < ncuts && nexported < maxcuts && ok; ++c) {
+        SCIP_ROW* row = SCIPcutGetRow(cuts[c]);
+        if (SCIProwIsLocal(row) || SCIProwIsModifiable(row)) {
+            continue;
+        }
+        int len = SCIProwGetNNonz(row);
+        if (len > capacity) {
+            free(rowvars);
+            free(rowvals);
+            capacity = len;
+            rowvars = (SCIP_VAR**)malloc((size_t)capacity * sizeof(SCIP_VAR*));
+            rowvals = (SCIP_Real*)malloc((size_t)capacity * sizeof(SCIP_Real));
+            if (rowvars == NULL || rowvals == NULL) {
+                ok = 0;
+                break;
+            }
+        }
+        SCIP_COL** cols = SCIProwGetCols(row);
+        for (int k = 0; k < len; ++k) {
+            rowvars[k] = SCIPcolGetVar(cols[k]);
+        }
+        int before = b.nrows;
+        ok = sparseRowsAdd(scip, &b, handleof, ntransvars, rowvars, SCIProwGetVals(row), len,
+            SCIProwGetConstant(row), SCIProwGetLhs(row), SCIProwGetRhs(row), cutflags);
+        nexported += b.nrows - before;
+    }
+
+    SCIP_CONS** conss = SCIPgetConss(scip);
+    int nconss = SCIPgetNConss(scip);
+    nexported = 0;
+    for (int c = 0; c < nconss && nexported < maxconflicts && ok; ++c) {
+        SCIP_CONS* cons = conss[c];
+        if (!SCIPconsIsConflict(cons) || !SCIPconsIsGlobal(cons) || !SCIPconsIsActive(cons)) {
+            continue;
+        }
+        SCIP_Bool success = FALSE;
+        int len = 0;
+        SCIPgetConsNVars(scip, cons, &len, &success);
+        if (success && len > capacity) {
+            free(rowvars);
+            free(rowvals);
+            capacity = len;
+            rowvars = (SCIP_VAR**)malloc((size_t)capacity * sizeof(SCIP_VAR*));
+            rowvals = (SCIP_Real*)malloc((size_t)capacity * sizeof(SCIP_Real));
+            if (rowvars == NULL || rowvals == NULL) {
+                ok = 0;
+                break;
+            }
+        }
+        if (success) {
+            SCIPgetConsVars(scip, cons, rowvars, capacity, &success);
+        }
+        if (success) {
+            SCIPgetConsVals(scip, cons, rowvals, capacity, &success);
+        }
+        SCIP_Real lhs = success ? SCIPconsGetLhs(scip, cons, &success) : 0.0;
+        SCIP_Real rhs = success ? SCIPconsGetRhs(scip, cons, &success) : 0.0;
+        if (!success) {
+            // Not linear (e.g. bound disjunctions)
+            b.dropped += 1;
+            continue;
+        }
+        int before = b.nrows;
+        ok = sparseRowsAdd(scip, &b, handleof, ntransvars, rowvars, rowvals, len, 0.0, lhs, rhs,
+            CUTPACK_ROW_CONFLICT | CUTPACK_ROW_OBJECTIVE);
+        nexported += b.nrows - before;
+    }
+
+    SCIP_SOL* best = SCIPgetBestSol(scip);
+    int header[CUTPACK_HEADER_INTS] = { 0 };
+    header[0] = CUTPACK_MAGIC;
+    header[1] = CUTPACK_VERSION;
+    header[2] = nvars;
+    header[3] = b.nrows;
+    header[4] = b.nnz;
+    header[5] = best != NULL ? 1 : 0;
+    header[6] = b.dropped;
+    header[8] = (int)(uint32_t)region;
+    header[9] = (int)(uint32_t)(region >> 32);
+    header[10] = (int)(uint32_t)objective;
+    header[11] = (int)(uint32_t)(objective >> 32);
+
+    CUTPACKLAYOUT layout;
+    cutpackLayout(header, &layout);
+    unsigned char* data = ok && layout.size <= (uint64_t)INT32_MAX ? (unsigned char*)calloc((size_t)layout.size, 1) : NULL;
+
+    if (data != NULL) {
+        memcpy(data, header, sizeof(header));
+        if (b.nrows > 0) {
+            memcpy(data + layout.lhs, b.lhs, (size_t)b.nrows * sizeof(double));
+            memcpy(data + layout.rhs, b.rhs, (size_t)b.nrows * sizeof(double));
+            memcpy(data + layout.vals, b.vals, (size_t)b.nnz * sizeof(double));
+            memcpy(data + layout.rowstart, b.rowstart, (size_t)(b.nrows + 1) * sizeof(int));
+            memcpy(data + layout.colidx, b.colidx, (size_t)b.nnz * sizeof(int));
+            memcpy(data + layout.rowflags, b.rowflags, (size_t)b.nrows);
+        }
+        if (best != NULL) {
+            double* solvals = (double*)(data + layout.sols);
+            for (int i = 0; i < nvars; ++i) {
+                solvals[i] = SCIPgetSolVal(scip, best, var_registry[i]);
+            }
+        }
+
+        cutpack_data = data;
+        cutpack_size = (int)layout.size;
+    }
+
+    free(handleof);
+    free(rowvars);
+    free(rowvals);
+    sparseRowsFree(&b);
+    return cutpack_size;
 }
 
+/**
+ * Pointer to the last pack written by scip_cuts_export (NULL if none)
+ */
 EMSCRIPTEN_KEEPALIVE
-int scip_cons_find_id(const char* name)
+unsigned char* scip_cuts_data(void)
 {
-    if (scip_instance == NULL || name == NULL) {
-        return -1;
-    }
+    return cutpack_data;
+}
 
-    SCIP_CONS* cons = SCIPfindCons(scip_instance, name);
-    return registerConsHandle(cons);
+EMSCRIPTEN_KEEPALIVE
+void scip_cuts_free(void)
+{
+    free(cutpack_data);
+    cutpack_data = NULL;
+    cutpack_size = 0;
 }
 
+/**
+ * Import a cut pack into a freshly loaded model (PROBLEM stage, same variable
+ * handles) as initial, removable linear rows that are separated and
+ * propagated but never checked. The feasible region must hash the same;
+ * objective-dependent rows are only taken when the objective hashes the same
+ * too, and then the exporting solve's incumbent comes along as a start
+ * solution. Returns the number of rows added, -1 if the pack does not fit.
+ */
 EMSCRIPTEN_KEEPALIVE
-int scip_var_get_transformed(int varId)
+int scip_cuts_import(const unsigned char* data, int size)
 {
-    if (scip_instance == NULL) {
+    if (scip_instance == NULL || data == NULL || size < (int)(CUTPACK_HEADER_INTS * sizeof(int))) {
         return -1;
     }
-
-    if (!SCIPisTransformed(scip_instance)) {
+    if (SCIPgetStage(scip_instance) != SCIP_STAGE_PROBLEM) {
         return -1;
     }
 
-    SCIP_VAR* var = getVarByHandle(varId);
-    if (var == NULL) {
+    const int* header = (const int*)data;
+    CUTPACKLAYOUT layout;
+    if (header[0] != CUTPACK_MAGIC || header[1] != CUTPACK_VERSION || header[2] != var_registry_size
+        || header[3] < 0 || header[4] < 0 || header[5] < 0) {
+        return -1;
+    }
+    cutpackLayout(header, &layout);
+    if (layout.size != (uint64_t)size) {
         return -1;
     }
 
-    if (SCIPvarIsTransformed(var)) {
-        return varId;
+    uint64_t region = 0;
+    uint64_t objective = 0;
+    if (!cutpackModelHashes(scip_instance, &region, &objective)) {
+        return -1;
+    }
+    if ((uint32_t)header[8] != (uint32_t)region || (uint32_t)header[9] != (uint32_t)(region >> 32)) {
+        return -1;
+    }
+    SCIP_Bool sameobjective = (uint32_t)header[10] == (uint32_t)objective
+        && (uint32_t)header[11] == (uint32_t)(objective >> 32);
+
+    int nvars = header[2];
+    int nrows = header[3];
+    const double* lhs = (const double*)(data + layout.lhs);
+    const double* rhs = (const double*)(data + layout.rhs);
+    const double* vals = (const double*)(data + layout.vals);
+    const int* rowstart = (const int*)(data + layout.rowstart);
+    const int* colidx = (const int*)(data + layout.colidx);
+    const unsigned char* rowflags = data + layout.rowflags;
+
+    int maxlen = 0;
+    for (int i = 0; i < nrows; ++i) {
+        if (rowstart[i] < 0 || rowstart[i + 1] < rowstart[i] || rowstart[i + 1] > header[4]) {
+            return -1;
+        }
+        if (rowstart[i + 1] - rowstart[i] > maxlen) {
+            maxlen = rowstart[i + 1] - rowstart[i];
+        }
+    }
+    for (int k = 0; k < header[4]; ++k) {
+        if (colidx[k] < 0 || colidx[k] >= nvars) {
+            return -1;
+        }
     }
 
-    SCIP_VAR* transvar = NULL;
-    SCIP_RETCODE ret = SCIPgetTransformedVar(scip_instance, var, &transvar);
-    if (ret != SCIP_OKAY || transvar == NULL) {
+    SCIP_VAR** rowvars = (SCIP_VAR**)malloc((size_t)(maxlen > 0 ? maxlen : 1) * sizeof(SCIP_VAR*));
+    if (rowvars == NULL) {
         return -1;
     }
 
-    return registerVarHandle(transvar);
+    int added = 0;
+    SCIP_Bool objdependent = FALSE;
+    char name[64];
+    for (int i = 0; i < nrows; ++i) {
+        if ((rowflags[i] & CUTPACK_ROW_OBJECTIVE) && !sameobjective) {
+            continue;
+        }
+
+        int begin = rowstart[i];
+        int len = rowstart[i + 1] - begin;
+        for (int k = 0; k < len; ++k) {
+            rowvars[k] = var_registry[colidx[begin + k]];
+        }
+        snprintf(name, sizeof(name), "%s%d", (rowflags[i] & CUTPACK_ROW_CONFLICT) ? "reuse_conflict" : "reuse_cut", i);
+
+        SCIP_CONS* cons = NULL;
+        SCIP_RETCODE ret = SCIPcreateConsLinear(scip_instance, &cons, name, len, rowvars, (SCIP_Real*)&vals[begin],
+            lhs[i], rhs[i], TRUE, TRUE, FALSE, FALSE, TRUE, FALSE, FALSE, FALSE, TRUE, FALSE);
+        if (ret != SCIP_OKAY || SCIPaddCons(scip_instance, cons) != SCIP_OKAY) {
+            if (cons != NULL) {
+                SCIPreleaseCons(scip_instance, &cons);
+            }
+            break;
+        }
+        SCIPreleaseCons(scip_instance, &cons);
+        added += 1;
+        objdependent = objdependent || (rowflags[i] & CUTPACK_ROW_OBJECTIVE) != 0;
+    }
+    free(rowvars);
+
+    // Objective-dependent rows may cut off the incumbent they were derived against
+    if (objdependent) {
+        cutpack_imported_objective = TRUE;
+        const double* solvals = (const double*)(data + layout.sols);
+        for (int s = 0; s < header[5]; ++s) {
+            SCIP_SOL* sol;
+            SCIP_Bool stored = FALSE;
+            if (SCIPcreateSol(scip_instance, &sol, NULL) != SCIP_OKAY) {
+                break;
+            }
+            for (int j = 0; j < nvars; ++j) {
+                SCIPsetSolVal(scip_instance, sol, var_registry[j], solvals[(size_t)s * nvars + j]);
+            }
+            SCIPaddSolFree(scip_instance, &sol, &stored);
+        }
+    }
+
+    return added;
 }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_cons_get_transformed(int consId)
+// ============================================
+// Presolve Only
+// ============================================
+
+static void presolveFree(void)
 {
-    if (scip_instance == NULL) {
-        return -1;
-    }
+    free(presolve_model);
+    free(presolve_map);
+    presolve_model = NULL;
+    presolve_model_size = 0;
+    presolve_map = NULL;
+    presolve_map_size = 0;
+}
 
-    if (!SCIPisTransformed(scip_instance)) {
-        return -1;
+/**
+ * Postsolve map of the presolved problem: each variable handle as an affine
+ * function of the active transformed variables (reduced model columns). When
+ * presolve solved the problem, `solved` is its solution and every handle is a
+ * fixing to its value there.
+ */
+static unsigned char* presolveBuildMap(SCIP* scip, SCIP_SOL* solved, int* size)
+{
+    int norig = var_registry_size;
+    int capacity = 16;
+    int nnz = 0;
+    int nnzcapacity = norig > 0 ? norig : 1;
+    double* constant = (double*)malloc((size_t)(norig > 0 ? norig : 1) * sizeof(double));
+    int* start = (int*)malloc((size_t)(norig + 1) * sizeof(int));
+    double* scalar = (double*)malloc((size_t)nnzcapacity * sizeof(double));
+    int* index = (int*)malloc((size_t)nnzcapacity * sizeof(int));
+    SCIP_VAR** vars = (SCIP_VAR**)malloc((size_t)capacity * sizeof(SCIP_VAR*));
+    SCIP_Real* scalars = (SCIP_Real*)malloc((size_t)capacity * sizeof(SCIP_Real));
+    int header[POSTSOLVE_HEADER_INTS] = { 0 };
+    unsigned char* map = NULL;
+    int ok = constant != NULL && start != NULL && scalar != NULL && index != NULL && vars != NULL && scalars != NULL;
+
+    for (int i = 0; ok && solved != NULL && i < norig; ++i) {
+        start[i] = 0;
+        constant[i] = SCIPgetSolVal(scip, solved, var_registry[i]);
+        header[4] += 1;
+    }
+
+    for (int i = 0; ok && solved == NULL && i < norig; ++i) {
+        SCIP_VAR* transvar = SCIPvarIsOriginal(var_registry[i]) ? SCIPvarGetTransVar(var_registry[i]) : var_registry[i];
+        int n = 1;
+        int required = 0;
+        SCIP_Real offset = 0.0;
+        start[i] = nnz;
+        if (transvar == NULL) {
+            ok = 0;
+            break;
+        }
+        vars[0] = transvar;
+        scalars[0] = 1.0;
+        if (SCIPgetProbvarLinearSum(scip, vars, scalars, &n, capacity, &offset, &required, TRUE) != SCIP_OKAY) {
+            ok = 0;
+            break;
+        }
+        if (required > capacity) {
+            // Multi-aggregation longer than the buffers: grow them and resolve again
+            free(vars);
+            free(scalars);
+            capacity = required;
+            vars = (SCIP_VAR**)malloc((size_t)capacity * sizeof(SCIP_VAR*));
+            scalars = (SCIP_Real*)malloc((size_t)capacity * sizeof(SCIP_Real));
+            if (vars == NULL || scalars == NULL) {
+                ok = 0;
+                break;
+            }
+            vars[0] = transvar;
+            scalars[0] = 1.0;
+            n = 1;
+            offset = 0.0;
+            if (SCIPgetProbvarLinearSum(scip, vars, scalars, &n, capacity, &offset, &required, TRUE) != SCIP_OKAY) {
+                ok = 0;
+                break;
+            }
+        }
+
+        if (nnz + n > nnzcapacity) {
+            while (nnzcapacity < nnz + n) {
+                nnzcapacity *= 2;
+            }
+            double* newscalar = (double*)realloc(scalar, (size_t)nnzcapacity * sizeof(double));
+            if (newscalar != NULL) {
+                scalar = newscalar;
+            }
+            int* newindex = (int*)realloc(index, (size_t)nnzcapacity * sizeof(int));
+            if (newindex != NULL) {
+                index = newindex;
+            }
+            if (newscalar == NULL || newindex == NULL) {
+                ok = 0;
+                break;
+            }
+        }
+
+        constant[i] = offset;
+        for (int k = 0; k < n; ++k) {
+            scalar[nnz] = scalars[k];
+            index[nnz] = SCIPvarGetProbindex(vars[k]);
+            nnz += 1;
+        }
+        if (n == 0) {
+            header[4] += 1;
+        } else if (n > 1) {
+            header[6] += 1;
+        } else if (vars[0] != transvar) {
+            header[5] += 1;
+        }
     }
 
-    SCIP_CONS* cons = getConsByHandle(consId);
-    if (cons == NULL) {
-        return -1;
+    if (ok) {
+        start[norig] = nnz;
+        header[0] = POSTSOLVE_MAGIC;
+        header[1] = POSTSOLVE_VERSION;
+        header[2] = norig;
+        header[3] = nnz;
+
+        size_t bytes = sizeof(header) + 2 * sizeof(double) + (size_t)norig * sizeof(double) + (size_t)nnz * sizeof(double)
+            + (size_t)(norig + 1) * sizeof(int) + (size_t)nnz * sizeof(int);
+        map = (unsigned char*)malloc(bytes);
+        if (map != NULL) {
+            // The retransformation is affine: recover it from two points
+            double objoffset = SCIPretransformObj(scip, 0.0);
+            double objscale = SCIPretransformObj(scip, 1.0) - objoffset;
+            unsigned char* cursor = map;
+            memcpy(cursor, header, sizeof(header));
+            cursor += sizeof(header);
+            memcpy(cursor, &objscale, sizeof(double));
+            memcpy(cursor + sizeof(double), &objoffset, sizeof(double));
+            cursor += 2 * sizeof(double);
+            memcpy(cursor, constant, (size_t)norig * sizeof(double));
+            cursor += (size_t)norig * sizeof(double);
+            memcpy(cursor, scalar, (size_t)nnz * sizeof(double));
+            cursor += (size_t)nnz * sizeof(double);
+            memcpy(cursor, start, (size_t)(norig + 1) * sizeof(int));
+            cursor += (size_t)(norig + 1) * sizeof(int);
+            memcpy(cursor, index, (size_t)nnz * sizeof(int));
+            *size = (int)bytes;
+        }
     }
 
-    if (SCIPconsIsTransformed(cons)) {
-        return consId;
+    free(constant);
+    free(start);
+    free(scalar);
+    free(index);
+    free(vars);
+    free(scalars);
+    return map;
+}
+
+/**
+ * Reduced model of the presolved problem as a model blob: active transformed
+ * variables with their global bounds and (minimized) objective, and the
+ * linear form of every active constraint; empty if presolve solved the
+ * problem. Returns NULL, with *nonlinear set, if a constraint has no linear form.
+ */
+static unsigned char* presolveBuildModel(SCIP* scip, int* size, int* nonlinear)
+{
+    SCIP_Bool solved = SCIPgetStage(scip) == SCIP_STAGE_SOLVED;
+    int nvars = solved ? 0 : SCIPgetNVars(scip);
+    int nconss = solved ? 0 : SCIPgetNConss(scip);
+    SCIP_VAR** vars = SCIPgetVars(scip);
+    SCIP_CONS** conss = SCIPgetConss(scip);
+
+    SPARSEROWS b;
+    memset(&b, 0, sizeof(b));
+    b.dense = (double*)calloc((size_t)(nvars > 0 ? nvars : 1), sizeof(double));
+    int* colof = (int*)malloc((size_t)(nvars > 0 ? nvars : 1) * sizeof(int));
+    int* consof = (int*)malloc((size_t)(nconss > 0 ? nconss : 1) * sizeof(int));
+    SCIP_VAR** rowvars = NULL;
+    SCIP_Real* rowvals = NULL;
+    int capacity = 0;
+    int ok = b.dense != NULL && colof != NULL && consof != NULL;
+    unsigned char* blob = NULL;
+
+    for (int j = 0; ok && j < nvars; ++j) {
+        colof[j] = j;
+    }
+
+    *nonlinear = 0;
+    for (int c = 0; ok && c < nconss; ++c) {
+        SCIP_CONS* cons = conss[c];
+        SCIP_Bool success = FALSE;
+        int len = 0;
+        consof[c] = -1;
+        if (!SCIPconsIsActive(cons)) {
+            continue;
+        }
+        SCIPgetConsNVars(scip, cons, &len, &success);
+        if (success && len > capacity) {
+            free(rowvars);
+            free(rowvals);
+            capacity = len;
+            rowvars = (SCIP_VAR**)malloc((size_t)capacity * sizeof(SCIP_VAR*));
+            rowvals = (SCIP_Real*)malloc((size_t)capacity * sizeof(SCIP_Real));
+            if (rowvars == NULL || rowvals == NULL) {
+                ok = 0;
+                break;
+            }
+        }
+        if (success) {
+            SCIPgetConsVars(scip, cons, rowvars, capacity, &success);
+        }
+        if (success) {
+            SCIPgetConsVals(scip, cons, rowvals, capacity, &success);
+        }
+        SCIP_Real lhs = success ? SCIPconsGetLhs(scip, cons, &success) : 0.0;
+        SCIP_Real rhs = success ? SCIPconsGetRhs(scip, cons, &success) : 0.0;
+        if (!success) {
+            *nonlinear += 1;
+            continue;
+        }
+
+        int before = b.nrows;
+        unsigned char flags = (SCIPconsIsModifiable(cons) ? MODEL_BLOB_ROW_MODIFIABLE : 0)
+            | (SCIPconsIsRemovable(cons) ? MODEL_BLOB_ROW_REMOVABLE : 0);
+        ok = sparseRowsAdd(scip, &b, colof, nvars, rowvars, rowvals, len, 0.0, lhs, rhs, flags);
+        if (b.nrows > before) {
+            consof[c] = before;
+        }
+    }
+    if (b.dropped > 0) {
+        *nonlinear += b.dropped;
     }
 
-    SCIP_CONS* transcons = NULL;
-    SCIP_RETCODE ret = SCIPgetTransformedCons(scip_instance, cons, &transcons);
-    if (ret != SCIP_OKAY || transcons == NULL) {
-        return -1;
+    if (ok && *nonlinear == 0) {
+        // Names: problem, variables, rows
+        const char* probname = SCIPgetProbName(scip);
+        size_t namebytes = strlen(probname) + 1;
+        for (int j = 0; j < nvars; ++j) {
+            namebytes += strlen(SCIPvarGetName(vars[j])) + 1;
+        }
+        for (int c = 0; c < nconss; ++c) {
+            if (consof[c] >= 0) {
+                namebytes += strlen(SCIPconsGetName(conss[c])) + 1;
+            }
+        }
+
+        int nrows = b.nrows;
+        int nnz = b.nnz;
+        size_t bytes = MODEL_BLOB_HEADER_INTS * sizeof(int) + (size_t)(3 * nvars + 2 * nrows + nnz) * sizeof(double)
+            + (size_t)(nrows + 1 + nnz) * sizeof(int) + (size_t)nvars + (size_t)nrows + namebytes;
+        blob = (unsigned char*)calloc(bytes, 1);
+        if (blob != NULL) {
+            int* header = (int*)blob;
+            header[0] = MODEL_BLOB_MAGIC;
+            header[1] = MODEL_BLOB_VERSION;
+            header[2] = MODEL_BLOB_FLAG_NAMES;
+            header[3] = nvars;
+            header[4] = nrows;
+            header[5] = nnz;
+            header[6] = (int)namebytes;
+
+            double* lb = (double*)(blob + MODEL_BLOB_HEADER_INTS * sizeof(int));
+            double* ub = lb + nvars;
+            double* obj = ub + nvars;
+            double* rowlhs = obj + nvars;
+            double* rowrhs = rowlhs + nrows;
+            double* vals = rowrhs + nrows;
+            int* rowstart = (int*)(vals + nnz);
+            int* colidx = rowstart + nrows + 1;
+            unsigned char* vartype = (unsigned char*)(colidx + nnz);
+            unsigned char* rowflags = vartype + nvars;
+            char* names = (char*)(rowflags + nrows);
+
+            for (int j = 0; j < nvars; ++j) {
+                lb[j] = SCIPvarGetLbGlobal(vars[j]);
+                ub[j] = SCIPvarGetUbGlobal(vars[j]);
+                obj[j] = SCIPvarGetObj(vars[j]);
+                vartype[j] = (unsigned char)SCIPvarGetType(vars[j]);
+            }
+            if (nrows > 0) {
+                memcpy(rowlhs, b.lhs, (size_t)nrows * sizeof(double));
+                memcpy(rowrhs, b.rhs, (size_t)nrows * sizeof(double));
+                memcpy(vals, b.vals, (size_t)nnz * sizeof(double));
+                memcpy(rowstart, b.rowstart, (size_t)(nrows + 1) * sizeof(int));
+                memcpy(colidx, b.colidx, (size_t)nnz * sizeof(int));
+                memcpy(rowflags, b.rowflags, (size_t)nrows);
+            }
+
+            size_t len = strlen(probname) + 1;
+            memcpy(names, probname, len);
+            names += len;
+            for (int j = 0; j < nvars; ++j) {
+                len = strlen(SCIPvarGetName(vars[j])) + 1;
+                memcpy(names, SCIPvarGetName(vars[j]), len);
+                names += len;
+            }
+            for (int c = 0; c < nconss; ++c) {
+                if (consof[c] >= 0) {
+                    len = strlen(SCIPconsGetName(conss[c])) + 1;
+                    memcpy(names, SCIPconsGetName(conss[c]), len);
+                    names += len;
+                }
+            }
+            *size = (int)bytes;
+        }
     }
 
-    return registerConsHandle(transcons);
+    free(colof);
+    free(consof);
+    free(rowvars);
+    free(rowvals);
+    sparseRowsFree(&b);
+    return blob;
 }
 
+/**
+ * Presolve the loaded problem (PROBLEM stage) without solving it and export
+ * the reduced model as a model blob (scip_presolve_model) plus the postsolve
+ * map from variable handles to its columns (scip_presolve_map). The reduced
+ * model always minimizes; the map carries the affine retransformation of the
+ * objective. The problem stays presolved, so a following solve continues
+ * from here. Symmetry handling is off for the run, since its orbitope and
+ * symresack constraints have no linear form. Returns 1 on success, 2 if
+ * presolve solved the problem (empty reduced model, map of fixings), -1 if it
+ * proved infeasibility, -2 if it proved unboundedness, -3 if a constraint has
+ * no linear form, 0 on error.
+ */
 EMSCRIPTEN_KEEPALIVE
-int scip_cons_get_row(int consId)
+int scip_presolve_only(void)
 {
-    if (scip_instance == NULL) {
-        return -1;
+    presolveFree();
+
+    if (scip_instance == NULL || SCIPgetStage(scip_instance) != SCIP_STAGE_PROBLEM) {
+        return 0;
     }
 
-    SCIP_CONS* cons = getConsByHandle(consId);
-    if (cons == NULL) {
-        return -1;
+    SCIP* scip = scip_instance;
+    int usesymmetry = 0;
+    profile_presolve_start = 0.0;
+    if (SCIPgetIntParam(scip, "misc/usesymmetry", &usesymmetry) != SCIP_OKAY
+        || SCIPsetIntParam(scip, "misc/usesymmetry", 0) != SCIP_OKAY) {
+        return 0;
+    }
+    SCIP_RETCODE retcode = SCIPpresolve(scip);
+    // Restored for a following solve, which may add symmetry handling then
+    (void)SCIPsetIntParam(scip, "misc/usesymmetry", usesymmetry);
+    if (retcode != SCIP_OKAY) {
+        return 0;
     }
 
-    SCIP_ROW* row = SCIPgetRowLinear(scip_instance, cons);
-    if (row == NULL) {
+    SCIP_STATUS status = SCIPgetStatus(scip);
+    if (status == SCIP_STATUS_INFEASIBLE) {
         return -1;
     }
-
-    return registerRowHandle(row);
-}
-
-EMSCRIPTEN_KEEPALIVE
-int scip_cons_is_in_lp(int consId)
-{
-    int rowId = scip_cons_get_row(consId);
-    if (rowId <= 0) {
+    if (status == SCIP_STATUS_UNBOUNDED || status == SCIP_STATUS_INFORUNBD) {
+        return -2;
+    }
+    SCIP_SOL* solved = NULL;
+    if (SCIPgetStage(scip) == SCIP_STAGE_SOLVED) {
+        // Presolve removed every variable: the problem is solved
+        solved = SCIPgetBestSol(scip);
+        if (status != SCIP_STATUS_OPTIMAL || solved == NULL) {
+            return 0;
+        }
+    } else if (SCIPgetStage(scip) != SCIP_STAGE_PRESOLVED) {
         return 0;
     }
 
-    SCIP_ROW* row = getRowByHandle(rowId);
-    if (row == NULL) {
+    int nonlinear = 0;
+    presolve_model = presolveBuildModel(scip, &presolve_model_size, &nonlinear);
+    if (presolve_model == NULL) {
+        presolveFree();
+        return nonlinear > 0 ? -3 : 0;
+    }
+    presolve_map = presolveBuildMap(scip, solved, &presolve_map_size);
+    if (presolve_map == NULL) {
+        presolveFree();
         return 0;
     }
-
-    return SCIProwIsInLP(row) ? 1 : 0;
+    return solved != NULL ? 2 : 1;
 }
 
 EMSCRIPTEN_KEEPALIVE
-double scip_cons_get_dual_linear(int consId)
+unsigned char* scip_presolve_model(void)
 {
-    if (scip_instance == NULL) {
-        return 0.0;
-    }
-
-    SCIP_CONS* cons = getConsByHandle(consId);
-    if (cons == NULL) {
-        return 0.0;
-    }
-
-    return SCIPgetDualsolLinear(scip_instance, cons);
+    return presolve_model;
 }
 
 EMSCRIPTEN_KEEPALIVE
-double scip_cons_get_farkas_linear(int consId)
+int scip_presolve_model_size(void)
 {
-    if (scip_instance == NULL) {
-        return 0.0;
-    }
-
-    SCIP_CONS* cons = getConsByHandle(consId);
-    if (cons == NULL) {
-        return 0.0;
-    }
-
-    return SCIPgetDualfarkasLinear(scip_instance, cons);
+    return presolve_model_size;
 }
 
 EMSCRIPTEN_KEEPALIVE
-double scip_row_get_dual(int rowId)
+unsigned char* scip_presolve_map(void)
 {
-    SCIP_ROW* row = getRowByHandle(rowId);
-    if (row == NULL) {
-        return 0.0;
-    }
-    return SCIProwGetDualsol(row);
+    return presolve_map;
 }
 
 EMSCRIPTEN_KEEPALIVE
-double scip_row_get_farkas(int rowId)
+int scip_presolve_map_size(void)
 {
-    SCIP_ROW* row = getRowByHandle(rowId);
-    if (row == NULL) {
-        return 0.0;
-    }
-    return SCIProwGetDualfarkas(row);
+    return presolve_map_size;
 }
 
 EMSCRIPTEN_KEEPALIVE
-double scip_row_get_lhs(int rowId)
+void scip_presolve_free(void)
 {
-    SCIP_ROW* row = getRowByHandle(rowId);
-    if (row == NULL) {
-        return 0.0;
-    }
-    return SCIProwGetLhs(row);
+    presolveFree();
 }
 
-EMSCRIPTEN_KEEPALIVE
-double scip_row_get_rhs(int rowId)
+// ============================================
+// Instance Features
+// ============================================
+
+// Feature vector layout, mirrored by FEATURE_NAMES in scip-api-wrapper.js
+#define FEATURE_COUNT 43
+#define FEATURE_CLASS_BASE 23
+
+// Linear row classes, named after the constraint types SCIP upgrades linear rows to
+#define LINCLASS_EMPTY 0
+#define LINCLASS_FREE 1
+#define LINCLASS_SINGLETON 2
+#define LINCLASS_AGGREGATION 3
+#define LINCLASS_PRECEDENCE 4
+#define LINCLASS_VARBOUND 5
+#define LINCLASS_SETPARTITION 6
+#define LINCLASS_SETPACKING 7
+#define LINCLASS_SETCOVERING 8
+#define LINCLASS_CARDINALITY 9
+#define LINCLASS_INVKNAPSACK 10
+#define LINCLASS_EQKNAPSACK 11
+#define LINCLASS_BINPACKING 12
+#define LINCLASS_KNAPSACK 13
+#define LINCLASS_INTKNAPSACK 14
+#define LINCLASS_MIXEDBINARY 15
+#define LINCLASS_GENERAL 16
+
+static SCIP_Bool isIntegralValue(SCIP* scip, SCIP_Real value)
 {
-    SCIP_ROW* row = getRowByHandle(rowId);
-    if (row == NULL) {
-        return 0.0;
-    }
-    return SCIProwGetRhs(row);
+    return SCIPisEQ(scip, value, floor(value + 0.5));
 }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_row_get_lppos(int rowId)
+static int classifyLinearRow(SCIP* scip, SCIP_VAR** vars, SCIP_Real* vals, int n, SCIP_Real lhs, SCIP_Real rhs)
 {
-    SCIP_ROW* row = getRowByHandle(rowId);
-    if (row == NULL) {
-        return -1;
+    SCIP_Bool lhsinf = SCIPisInfinity(scip, -lhs);
+    SCIP_Bool rhsinf = SCIPisInfinity(scip, rhs);
+    SCIP_Bool equality = !lhsinf && !rhsinf && SCIPisEQ(scip, lhs, rhs);
+
+    if (n == 0) {
+        return LINCLASS_EMPTY;
+    }
+    if (lhsinf && rhsinf) {
+        return LINCLASS_FREE;
+    }
+    if (n == 1) {
+        return LINCLASS_SINGLETON;
+    }
+    if (n == 2) {
+        SCIP_VARTYPE t0 = SCIPvarGetType(vars[0]);
+        SCIP_VARTYPE t1 = SCIPvarGetType(vars[1]);
+        if (equality) {
+            return LINCLASS_AGGREGATION;
+        }
+        if (t0 == t1 && SCIPisEQ(scip, vals[0], -vals[1])) {
+            return LINCLASS_PRECEDENCE;
+        }
+        if (t0 == SCIP_VARTYPE_BINARY || t1 == SCIP_VARTYPE_BINARY) {
+            return LINCLASS_VARBOUND;
+        }
     }
-    return SCIProwGetLPPos(row);
-}
 
-EMSCRIPTEN_KEEPALIVE
-int scip_row_is_in_lp(int rowId)
-{
-    SCIP_ROW* row = getRowByHandle(rowId);
-    if (row == NULL) {
-        return 0;
+    int nbin = 0;
+    int nint = 0;
+    int ncont = 0;
+    int nunit = 0;
+    int nneg = 0;
+    SCIP_Bool integralcoefs = TRUE;
+    for (int i = 0; i < n; ++i) {
+        SCIP_VARTYPE type = SCIPvarGetType(vars[i]);
+        nbin += type == SCIP_VARTYPE_BINARY;
+        nint += type == SCIP_VARTYPE_INTEGER || type == SCIP_VARTYPE_IMPLINT;
+        ncont += type == SCIP_VARTYPE_CONTINUOUS;
+        nunit += SCIPisEQ(scip, vals[i], 1.0);
+        nneg += vals[i] < 0.0;
+        integralcoefs = integralcoefs && isIntegralValue(scip, vals[i]);
+    }
+
+    // One-sided rows in <= form
+    SCIP_Real side = rhsinf ? -lhs : rhs;
+    int negatives = rhsinf ? n - nneg : nneg;
+
+    if (nbin == n && nunit == n) {
+        SCIP_Real b = equality ? rhs : (rhsinf ? lhs : rhs);
+        if (equality) {
+            return SCIPisEQ(scip, b, 1.0) ? LINCLASS_SETPARTITION : LINCLASS_CARDINALITY;
+        }
+        if (lhsinf || rhsinf) {
+            if (rhsinf) {
+                // sum x >= b complements to an invariant knapsack for b > 1
+                return SCIPisEQ(scip, b, 1.0) ? LINCLASS_SETCOVERING : LINCLASS_INVKNAPSACK;
+            }
+            return SCIPisEQ(scip, b, 1.0) ? LINCLASS_SETPACKING : LINCLASS_INVKNAPSACK;
+        }
     }
-    return SCIProwIsInLP(row) ? 1 : 0;
+    if (nbin == n && integralcoefs) {
+        if (equality) {
+            return LINCLASS_EQKNAPSACK;
+        }
+        if (lhsinf || rhsinf) {
+            if (negatives == 1 && SCIPisEQ(scip, side, 0.0)) {
+                return LINCLASS_BINPACKING;
+            }
+            if (negatives == 0) {
+                return LINCLASS_KNAPSACK;
+            }
+        }
+    }
+    if (ncont == 0 && integralcoefs && negatives == 0 && (lhsinf || rhsinf)) {
+        return LINCLASS_INTKNAPSACK;
+    }
+    if (nint == 0 && nbin > 0 && ncont > 0) {
+        return LINCLASS_MIXEDBINARY;
+    }
+    return LINCLASS_GENERAL;
 }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_row_is_local(int rowId)
+static int featureVarIndex(SCIP_VAR* var)
 {
-    SCIP_ROW* row = getRowByHandle(rowId);
-    if (row == NULL) {
-        return 0;
+    int index = SCIPvarGetProbindex(var);
+    if (index < 0 && SCIPvarGetStatus(var) == SCIP_VARSTATUS_NEGATED) {
+        index = SCIPvarGetProbindex(SCIPvarGetNegationVar(var));
     }
-    return SCIProwIsLocal(row) ? 1 : 0;
+    return index;
 }
 
 EMSCRIPTEN_KEEPALIVE
-const char* scip_row_get_name(int rowId)
+int scip_feature_count(void)
 {
-    SCIP_ROW* row = getRowByHandle(rowId);
-    if (row == NULL) {
-        return "";
-    }
-    return SCIProwGetName(row);
+    return FEATURE_COUNT;
 }
 
+/**
+ * Fixed-length feature vector of the original problem in one pass over its
+ * constraints: sizes, variable-type mix, density, coefficient and objective
+ * ranges, linear row classes and the number of connected components of the
+ * variable-constraint graph. Writes min(max, FEATURE_COUNT) doubles; returns
+ * the count, or 0 without a problem.
+ */
 EMSCRIPTEN_KEEPALIVE
-int scip_ctx_get_n_lp_rows(void)
+int scip_extract_features(double* out, int max)
 {
-    if (scip_instance == NULL) {
+    if (scip_instance == NULL || out == NULL || max <= 0 || SCIPgetStage(scip_instance) < SCIP_STAGE_PROBLEM) {
         return 0;
     }
 
-    if (SCIPgetStage(scip_instance) != SCIP_STAGE_SOLVING) {
+    SCIP* scip = scip_instance;
+    int nvars = SCIPgetNOrigVars(scip);
+    int nconss = SCIPgetNOrigConss(scip);
+    SCIP_VAR** vars = SCIPgetOrigVars(scip);
+    SCIP_CONS** conss = SCIPgetOrigConss(scip);
+    double f[FEATURE_COUNT];
+    memset(f, 0, sizeof(f));
+
+    int* parent = (int*)malloc((size_t)(nvars > 0 ? nvars : 1) * sizeof(int));
+    int* compsize = (int*)malloc((size_t)(nvars > 0 ? nvars : 1) * sizeof(int));
+    int* collen = (int*)calloc((size_t)(nvars > 0 ? nvars : 1), sizeof(int));
+    SCIP_VAR** consvars = NULL;
+    int consvarscap = 0;
+    if (parent == NULL || compsize == NULL || collen == NULL) {
+        free(parent);
+        free(compsize);
+        free(collen);
         return 0;
     }
 
-    if (!SCIPisLPConstructed(scip_instance)) {
-        return 0;
-    }
+    double coefmin = SCIP_INVALID;
+    double objmin = SCIP_INVALID;
+    for (int j = 0; j < nvars; ++j) {
+        SCIP_VAR* var = vars[j];
+        SCIP_VARTYPE type = SCIPvarGetType(var);
+        SCIP_Real obj = fabs(SCIPvarGetObj(var));
+        SCIP_Bool lbinf = SCIPisInfinity(scip, -SCIPvarGetLbOriginal(var));
+        SCIP_Bool ubinf = SCIPisInfinity(scip, SCIPvarGetUbOriginal(var));
+
+        parent[j] = j;
+        compsize[j] = 1;
+        f[1 + type] += 1.0;
+        if (obj > 0.0) {
+            f[16] += 1.0;
+            objmin = obj < objmin ? obj : objmin;
+            f[18] = obj > f[18] ? obj : f[18];
+        }
+        f[21] += lbinf && ubinf;
+        f[22] += type != SCIP_VARTYPE_CONTINUOUS && (lbinf || ubinf);
+    }
+
+    for (int c = 0; c < nconss; ++c) {
+        SCIP_CONS* cons = conss[c];
+        int n = 0;
+
+        if (strcmp(SCIPconshdlrGetName(SCIPconsGetHdlr(cons)), "linear") == 0) {
+            SCIP_VAR** rowvars = SCIPgetVarsLinear(scip, cons);
+            SCIP_Real* rowvals = SCIPgetValsLinear(scip, cons);
+            SCIP_Real lhs = SCIPgetLhsLinear(scip, cons);
+            SCIP_Real rhs = SCIPgetRhsLinear(scip, cons);
+            n = SCIPgetNVarsLinear(scip, cons);
+
+            f[6] += 1.0;
+            f[20] += !SCIPisInfinity(scip, -lhs) && !SCIPisInfinity(scip, rhs) && SCIPisEQ(scip, lhs, rhs);
+            f[FEATURE_CLASS_BASE + classifyLinearRow(scip, rowvars, rowvals, n, lhs, rhs)] += 1.0;
+            if (!SCIPisInfinity(scip, -lhs) && fabs(lhs) > f[19]) {
+                f[19] = fabs(lhs);
+            }
+            if (!SCIPisInfinity(scip, rhs) && fabs(rhs) > f[19]) {
+                f[19] = fabs(rhs);
+            }
 
-    return SCIPgetNLPRows(scip_instance);
-}
+            int first = -1;
+            for (int i = 0; i < n; ++i) {
+                double coef = fabs(rowvals[i]);
+                int index = featureVarIndex(rowvars[i]);
+                if (coef > 0.0) {
+                    coefmin = coef < coefmin ? coef : coefmin;
+                    f[14] = coef > f[14] ? coef : f[14];
+                }
+                if (index < 0 || index >= nvars) {
+                    continue;
+                }
+                collen[index] += 1;
+                if (first < 0) {
+                    first = index;
+                } else {
+                    ufUnion(parent, compsize, first, index);
+                }
+            }
+        } else {
+            SCIP_Bool success = FALSE;
+            f[7] += 1.0;
+            if (SCIPgetConsNVars(scip, cons, &n, &success) != SCIP_OKAY || !success) {
+                continue;
+            }
+            if (n > consvarscap) {
+                SCIP_VAR** grown = (SCIP_VAR**)realloc(consvars, (size_t)n * sizeof(SCIP_VAR*));
+                if (grown == NULL) {
+                    continue;
+                }
+                consvars = grown;
+                consvarscap = n;
+            }
+            if (SCIPgetConsVars(scip, cons, consvars, consvarscap, &success) != SCIP_OKAY || !success) {
+                continue;
+            }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_ctx_get_lp_row_duals_batch(double* out, int n)
-{
-    if (scip_instance == NULL || out == NULL || n <= 0) {
-        return -1;
-    }
+            int first = -1;
+            for (int i = 0; i < n; ++i) {
+                int index = featureVarIndex(consvars[i]);
+                if (index < 0 || index >= nvars) {
+                    continue;
+                }
+                collen[index] += 1;
+                if (first < 0) {
+                    first = index;
+                } else {
+                    ufUnion(parent, compsize, first, index);
+                }
+            }
+        }
 
-    int nrows = scip_ctx_get_n_lp_rows();
-    if (nrows <= 0) {
-        return 0;
+        f[8] += (double)n;
+        f[11] = n > f[11] ? n : f[11];
     }
 
-    SCIP_ROW** rows = SCIPgetLPRows(scip_instance);
-    int count = n < nrows ? n : nrows;
-
-    for (int i = 0; i < count; ++i) {
-        out[i] = SCIProwGetDualsol(rows[i]);
-        registerRowHandle(rows[i]);
+    int isolated = 0;
+    int components = 0;
+    int largest = 0;
+    for (int j = 0; j < nvars; ++j) {
+        f[12] = collen[j] > f[12] ? collen[j] : f[12];
+        if (collen[j] == 0) {
+            isolated += 1;
+        } else if (ufFind(parent, j) == j) {
+            components += 1;
+            largest = compsize[j] > largest ? compsize[j] : largest;
+        }
     }
 
+    f[0] = (double)nvars;
+    f[5] = (double)nconss;
+    f[9] = nvars > 0 && nconss > 0 ? f[8] / ((double)nvars * (double)nconss) : 0.0;
+    f[10] = nconss > 0 ? f[8] / nconss : 0.0;
+    f[13] = coefmin < SCIP_INVALID ? coefmin : 0.0;
+    f[15] = coefmin < SCIP_INVALID && coefmin > 0.0 ? log10(f[14] / coefmin) : 0.0;
+    f[17] = objmin < SCIP_INVALID ? objmin : 0.0;
+    f[20] = f[6] > 0.0 ? f[20] / f[6] : 0.0;
+    f[40] = (double)components;
+    f[41] = (double)largest;
+    f[42] = (double)isolated;
+
+    free(parent);
+    free(compsize);
+    free(collen);
+    free(consvars);
+
+    int count = max < FEATURE_COUNT ? max : FEATURE_COUNT;
+    memcpy(out, f, (size_t)count * sizeof(double));
     return count;
 }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_ctx_get_lp_row_farkas_batch(double* out, int n)
+// ============================================
+// Benders Decomposition
+// ============================================
+
+// A master blob and N subproblem blobs solved with SCIP's default Benders
+// decomposition. Master and subproblems are separate SCIP instances owned here,
+// so scip_instance never carries an activated Benders plugin. Subproblem
+// variables named like a master variable are its copies (linking variables);
+// blobs therefore need names (ModelBuilder names them when any name is set).
+static SCIP* benders_master = NULL;
+static SCIP** benders_subs = NULL;
+static int benders_nsubs = 0;
+static SCIP_VAR** benders_mastervars = NULL;
+static int benders_nmastervars = 0;
+
+static void bendersFree(void)
 {
-    if (scip_instance == NULL || out == NULL || n <= 0) {
-        return -1;
+    // The master first: freeing its transformed problem still touches the subproblems
+    if (benders_master != NULL) {
+        for (int j = 0; j < benders_nmastervars; ++j) {
+            SCIPreleaseVar(benders_master, &benders_mastervars[j]);
+        }
+        SCIPfree(&benders_master);
+        benders_master = NULL;
     }
-
-    int nrows = scip_ctx_get_n_lp_rows();
-    if (nrows <= 0) {
-        return 0;
+    for (int s = 0; s < benders_nsubs; ++s) {
+        if (benders_subs[s] != NULL) {
+            SCIPfree(&benders_subs[s]);
+        }
     }
+    free(benders_subs);
+    free(benders_mastervars);
+    benders_subs = NULL;
+    benders_mastervars = NULL;
+    benders_nsubs = 0;
+    benders_nmastervars = 0;
+}
 
-    SCIP_ROW** rows = SCIPgetLPRows(scip_instance);
-    int count = n < nrows ? n : nrows;
-
-    for (int i = 0; i < count; ++i) {
-        out[i] = SCIProwGetDualfarkas(rows[i]);
-        registerRowHandle(rows[i]);
+static SCIP_RETCODE standaloneCreateInstance(SCIP** scip)
+{
+    int verblevel = 0;
+    SCIP_CALL(SCIPcreate(scip));
+    SCIP_CALL(SCIPincludeDefaultPlugins(*scip));
+    if (scip_instance != NULL) {
+        SCIP_CALL(SCIPgetIntParam(scip_instance, "display/verblevel", &verblevel));
     }
-
-    return count;
+    SCIP_CALL(SCIPsetIntParam(*scip, "display/verblevel", verblevel));
+    return SCIP_OKAY;
 }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_pricer_add_var_to_rows_batch(int varId, int* rowIds, double* vals, int nnz)
+/**
+ * Build the problem of a parsed model blob in a standalone SCIP instance. With
+ * vars non-NULL the created variables are captured into it (nvars entries).
+ * Blobs without names get x<j> / c<i> like scip_load_model.
+ */
+static int standaloneLoadBlob(SCIP* scip, const MODELBLOB* b, SCIP_VAR** vars)
 {
-    if (scip_instance == NULL || rowIds == NULL || vals == NULL || nnz < 0) {
-        pending_pricer_abortround = TRUE;
-        pending_pricer_result = SCIP_DIDNOTRUN;
-        return -1;
+    int flags = b->flags;
+    int nvars = b->nvars;
+    int nrows = b->nrows;
+    const double* lb = b->lb;
+    const double* ub = b->ub;
+    const double* obj = b->obj;
+    const double* lhs = b->lhs;
+    const double* rhs = b->rhs;
+    const double* vals = b->vals;
+    const int* rowstart = b->rowstart;
+    const int* colidx = b->colidx;
+    const unsigned char* vartype = b->vartype;
+    const char* names = b->names;
+    const char* namesend = b->namesend;
+
+    SCIP_Bool hasnames = (flags & MODEL_BLOB_FLAG_NAMES) != 0;
+    const char* problemname = hasnames ? blobNextName(&names, namesend) : "js_problem";
+    if (problemname == NULL || SCIPcreateProbBasic(scip, problemname) != SCIP_OKAY) {
+        return 0;
     }
-
-    SCIP_VAR* var = getVarByHandle(varId);
-    if (var == NULL) {
-        pending_pricer_abortround = TRUE;
-        pending_pricer_result = SCIP_DIDNOTRUN;
-        return -1;
+    if ((flags & MODEL_BLOB_FLAG_MAXIMIZE) && SCIPsetObjsense(scip, SCIP_OBJSENSE_MAXIMIZE) != SCIP_OKAY) {
+        return 0;
     }
 
-    for (int i = 0; i < nnz; ++i) {
-        if (getRowByHandle(rowIds[i]) == NULL) {
-            pending_pricer_abortround = TRUE;
-            pending_pricer_result = SCIP_DIDNOTRUN;
-            return -1;
+    SCIP_VAR** created = (SCIP_VAR**)malloc((size_t)(nvars > 0 ? nvars : 1) * sizeof(SCIP_VAR*));
+    if (created == NULL) {
+        return 0;
+    }
+    int ok = 1;
+    int ncreated = 0;
+    char namebuf[32];
+    for (int j = 0; j < nvars && ok; ++j) {
+        const char* name = namebuf;
+        if (hasnames) {
+            name = blobNextName(&names, namesend);
+        } else {
+            snprintf(namebuf, sizeof(namebuf), "x%d", j);
+        }
+        SCIP_VAR* var = NULL;
+        ok = name != NULL
+            && SCIPcreateVarBasic(scip, &var, name, lb[j], ub[j], obj[j], (SCIP_VARTYPE)vartype[j]) == SCIP_OKAY
+            && SCIPaddVar(scip, var) == SCIP_OKAY;
+        if (var != NULL) {
+            created[ncreated++] = var;
         }
     }
 
-    for (int i = 0; i < nnz; ++i) {
-        SCIP_ROW* row = getRowByHandle(rowIds[i]);
-        SCIP_RETCODE ret = SCIPaddVarToRow(scip_instance, row, var, vals[i]);
-        if (ret != SCIP_OKAY) {
-            pending_pricer_abortround = TRUE;
-            pending_pricer_result = SCIP_DIDNOTRUN;
-            pending_pricer_stopearly = TRUE;
-            SCIPinterruptSolve(scip_instance);
-            return -1;
+    for (int i = 0; i < nrows && ok; ++i) {
+        const char* name = namebuf;
+        if (hasnames) {
+            name = blobNextName(&names, namesend);
+        } else {
+            snprintf(namebuf, sizeof(namebuf), "c%d", i);
+        }
+        SCIP_CONS* cons = NULL;
+        int begin = rowstart[i];
+        int len = rowstart[i + 1] - begin;
+        if (name == NULL) {
+            ok = 0;
+            break;
         }
+        SCIP_VAR** rowvars = (SCIP_VAR**)malloc((size_t)(len > 0 ? len : 1) * sizeof(SCIP_VAR*));
+        if (rowvars == NULL) {
+            ok = 0;
+            break;
+        }
+        for (int k = 0; k < len; ++k) {
+            rowvars[k] = created[colidx[begin + k]];
+        }
+        ok = SCIPcreateConsBasicLinear(scip, &cons, name, len, rowvars, (SCIP_Real*)(vals + begin), lhs[i], rhs[i]) == SCIP_OKAY
+            && SCIPaddCons(scip, cons) == SCIP_OKAY;
+        if (cons != NULL) {
+            SCIPreleaseCons(scip, &cons);
+        }
+        free(rowvars);
     }
 
-    return 1;
+    for (int j = 0; j < ncreated; ++j) {
+        if (vars != NULL && ok) {
+            vars[j] = created[j];
+        } else {
+            SCIPreleaseVar(scip, &created[j]);
+        }
+    }
+    free(created);
+    return ok;
 }
 
+/**
+ * Start a Benders decomposition: load the master blob and make room for
+ * nsubproblems subproblems. Discards any previous one. Returns 1 on success.
+ */
 EMSCRIPTEN_KEEPALIVE
-int scip_pricer_add_var_to_conss_batch(int varId, int* consIds, double* vals, int nnz)
+int scip_benders_begin(const unsigned char* master, int size, int nsubproblems)
 {
-    if (scip_instance == NULL || consIds == NULL || vals == NULL || nnz < 0) {
-        pending_pricer_abortround = TRUE;
-        pending_pricer_result = SCIP_DIDNOTRUN;
-        return -1;
-    }
-
-    SCIP_VAR* var = getVarByHandle(varId);
-    if (var == NULL) {
-        pending_pricer_abortround = TRUE;
-        pending_pricer_result = SCIP_DIDNOTRUN;
-        return -1;
+    bendersFree();
+    MODELBLOB b;
+    if (nsubproblems <= 0 || !modelBlobParse(master, size, &b) || (b.flags & MODEL_BLOB_FLAG_NAMES) == 0) {
+        return 0;
     }
 
-    for (int i = 0; i < nnz; ++i) {
-        if (getConsByHandle(consIds[i]) == NULL) {
-            pending_pricer_abortround = TRUE;
-            pending_pricer_result = SCIP_DIDNOTRUN;
-            return -1;
-        }
+    int nvars = b.nvars;
+    benders_subs = (SCIP**)calloc((size_t)nsubproblems, sizeof(SCIP*));
+    benders_mastervars = (SCIP_VAR**)calloc((size_t)(nvars > 0 ? nvars : 1), sizeof(SCIP_VAR*));
+    if (benders_subs == NULL || benders_mastervars == NULL || standaloneCreateInstance(&benders_master) != SCIP_OKAY) {
+        bendersFree();
+        return 0;
     }
+    benders_nsubs = nsubproblems;
 
-    for (int i = 0; i < nnz; ++i) {
-        SCIP_CONS* cons = getConsByHandle(consIds[i]);
-        SCIP_RETCODE ret = SCIPaddCoefLinear(scip_instance, cons, var, vals[i]);
-        if (ret != SCIP_OKAY) {
-            pending_pricer_abortround = TRUE;
-            pending_pricer_result = SCIP_DIDNOTRUN;
-            pending_pricer_stopearly = TRUE;
-            SCIPinterruptSolve(scip_instance);
-            return -1;
-        }
+    if (!standaloneLoadBlob(benders_master, &b, benders_mastervars)) {
+        bendersFree();
+        return 0;
     }
+    benders_nmastervars = nvars;
+    return 1;
+}
 
+/**
+ * Load subproblem `index` from a blob. Its variables named like master
+ * variables are linked to them. Returns 1 on success.
+ */
+EMSCRIPTEN_KEEPALIVE
+int scip_benders_set_subproblem(int index, const unsigned char* blob, int size)
+{
+    MODELBLOB b;
+    if (benders_master == NULL || index < 0 || index >= benders_nsubs || benders_subs[index] != NULL
+        || !modelBlobParse(blob, size, &b) || (b.flags & MODEL_BLOB_FLAG_NAMES) == 0) {
+        return 0;
+    }
+    if (standaloneCreateInstance(&benders_subs[index]) != SCIP_OKAY) {
+        return 0;
+    }
+    if (!standaloneLoadBlob(benders_subs[index], &b, NULL)) {
+        SCIPfree(&benders_subs[index]);
+        benders_subs[index] = NULL;
+        return 0;
+    }
     return 1;
 }
 
+/**
+ * Solve the master with the default Benders decomposition over all
+ * subproblems. Returns the status code of scip_solve, -1 on error.
+ */
 EMSCRIPTEN_KEEPALIVE
-int scip_pricer_add_priced_var(const char* name, double lb, double ub, double obj, int vartype, int initial, int removable)
+int scip_benders_solve(double timelimit)
 {
-    if (scip_instance == NULL || name == NULL) {
-        pending_pricer_abortround = TRUE;
-        pending_pricer_result = SCIP_DIDNOTRUN;
+    if (benders_master == NULL) {
         return -1;
     }
+    for (int s = 0; s < benders_nsubs; ++s) {
+        if (benders_subs[s] == NULL) {
+            return -1;
+        }
+    }
 
-    SCIP_VAR* var = NULL;
-    SCIP_RETCODE ret = SCIPcreateVarBasic(scip_instance, &var, name, lb, ub, obj, (SCIP_VARTYPE)vartype);
-    if (ret != SCIP_OKAY || var == NULL) {
-        pending_pricer_abortround = TRUE;
-        pending_pricer_result = SCIP_DIDNOTRUN;
+    if (SCIPcreateBendersDefault(benders_master, benders_subs, benders_nsubs) != SCIP_OKAY) {
         return -1;
     }
-
-    SCIP_CALL_ABORT(SCIPvarSetInitial(var, initial ? TRUE : FALSE));
-    SCIP_CALL_ABORT(SCIPvarSetRemovable(var, removable ? TRUE : FALSE));
-
-    ret = SCIPaddPricedVar(scip_instance, var, 1.0);
-    if (ret != SCIP_OKAY) {
-        pending_pricer_abortround = TRUE;
-        pending_pricer_result = SCIP_DIDNOTRUN;
-        SCIP_CALL_ABORT(SCIPreleaseVar(scip_instance, &var));
+    // Benders constraint handlers enforce the subproblems; presolve must not
+    // remove master variables the subproblems still depend on
+    if (SCIPsetBoolParam(benders_master, "constraints/benders/active", TRUE) != SCIP_OKAY
+        || SCIPsetBoolParam(benders_master, "constraints/benderslp/active", TRUE) != SCIP_OKAY
+        || SCIPsetIntParam(benders_master, "constraints/benders/maxprerounds", 1) != SCIP_OKAY
+        || SCIPsetIntParam(benders_master, "presolving/maxrounds", 1) != SCIP_OKAY
+        || SCIPsetRealParam(benders_master, "limits/time", timelimit > 0.0 ? timelimit : 1e20) != SCIP_OKAY) {
         return -1;
     }
 
-    int varId = registerVarHandle(var);
-    priced_vars_added += 1;
-    added_vars_this_call += 1;
-    SCIP_CALL_ABORT(SCIPreleaseVar(scip_instance, &var));
-    return varId;
+    if (SCIPsolve(benders_master) != SCIP_OKAY) {
+        return -1;
+    }
+    return solveStatusCode(benders_master);
 }
 
+/**
+ * Result of the last Benders solve: out[0] objective, [1] dual bound,
+ * [2] solving time, [3] nodes, [4] subproblem solves (Benders calls),
+ * [5] Benders cuts found. Returns 1, or 0 without a solved master.
+ */
 EMSCRIPTEN_KEEPALIVE
-int scip_pricer_get_n_added_vars(void)
+int scip_benders_result(double* out)
 {
-    return priced_vars_added;
-}
+    if (benders_master == NULL || out == NULL || SCIPgetStage(benders_master) < SCIP_STAGE_SOLVING) {
+        return 0;
+    }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_pricer_get_n_added_vars_this_call(void)
-{
-    return added_vars_this_call;
+    SCIP_SOL* sol = SCIPgetBestSol(benders_master);
+    SCIP_BENDERS* benders = SCIPfindBenders(benders_master, "default");
+    out[0] = sol != NULL ? SCIPgetSolOrigObj(benders_master, sol) : SCIPinfinity(benders_master);
+    out[1] = SCIPgetDualbound(benders_master);
+    out[2] = SCIPgetSolvingTime(benders_master);
+    out[3] = (double)SCIPgetNNodes(benders_master);
+    out[4] = benders != NULL ? (double)SCIPbendersGetNCalls(benders) : 0.0;
+    out[5] = benders != NULL ? (double)SCIPbendersGetNCutsFound(benders) : 0.0;
+    return 1;
 }
 
+/**
+ * Master variable values of the best solution, in master blob order.
+ * Returns the number written, 0 without a solution.
+ */
 EMSCRIPTEN_KEEPALIVE
-int scip_pricer_get_last_result(void)
+int scip_benders_values(double* out, int n)
 {
-    return last_pricing_result;
+    if (benders_master == NULL || out == NULL || SCIPgetStage(benders_master) < SCIP_STAGE_SOLVING) {
+        return 0;
+    }
+    SCIP_SOL* sol = SCIPgetBestSol(benders_master);
+    if (sol == NULL) {
+        return 0;
+    }
+    int count = n < benders_nmastervars ? n : benders_nmastervars;
+    for (int j = 0; j < count; ++j) {
+        out[j] = SCIPgetSolVal(benders_master, sol, benders_mastervars[j]);
+    }
+    return count;
 }
 
 EMSCRIPTEN_KEEPALIVE
-int scip_pricer_get_last_mode(void)
+void scip_benders_free(void)
 {
-    return last_pricing_mode;
+    bendersFree();
 }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_pricer_get_redcost_calls(void)
-{
-    return pricer_redcost_calls;
-}
+// ============================================
+// Native Pricing Templates
+// ============================================
 
-EMSCRIPTEN_KEEPALIVE
-int scip_pricer_get_farkas_calls(void)
+// Pricing subproblems built once from model blobs, each in its own standalone
+// SCIP instance. A template's solution y is a master column: its cost is the
+// blob objective at y plus a constant, and its coefficient in master
+// constraint i is sum_j A_ij y_j plus a constant (the column map). Every
+// pricing round sets the template objective to the reduced costs under the
+// duals the pricer sees (stabilized ones included), solves it under an
+// objective limit that only admits improving columns, and adds them to the
+// master directly; JS is not called.
+typedef struct {
+    SCIP* scip;
+    SCIP_VAR** vars;
+    int nvars;
+    double* cost;            // column cost per template variable (blob objective)
+    double* work;            // reduced costs of the round, then column values
+    double constcost;
+    int nentries;            // column map, sorted by master constraint handle
+    int* entrycons;
+    int* entryvar;           // template variable, -1 for a constant coefficient
+    double* entrycoef;
+    double timelimit;
+    int maxcolumns;
+    double solves;
+    double columns;
+    double seconds;
+    double bestredcost;      // best reduced cost of the last round, NaN if none improved
+} PRICINGTEMPLATE;
+
+static PRICINGTEMPLATE* pricing_templates = NULL;
+
+static void pricingTemplateFreeMap(PRICINGTEMPLATE* tpl)
 {
-    return pricer_farkas_calls;
+    free(tpl->entrycons);
+    free(tpl->entryvar);
+    free(tpl->entrycoef);
+    tpl->entrycons = NULL;
+    tpl->entryvar = NULL;
+    tpl->entrycoef = NULL;
+    tpl->nentries = 0;
 }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_pricer_get_round(void)
+static void pricingTemplateFree(PRICINGTEMPLATE* tpl)
 {
-    return pricer_round;
+    if (tpl->scip != NULL) {
+        for (int j = 0; j < tpl->nvars; ++j) {
+            SCIPreleaseVar(tpl->scip, &tpl->vars[j]);
+        }
+        SCIPfree(&tpl->scip);
+    }
+    free(tpl->vars);
+    free(tpl->cost);
+    free(tpl->work);
+    pricingTemplateFreeMap(tpl);
 }
 
-EMSCRIPTEN_KEEPALIVE
-void scip_pricer_abort_round(void)
+static void pricingTemplatesFree(void)
 {
-    pending_pricer_abortround = TRUE;
-    pending_pricer_result = SCIP_DIDNOTRUN;
-    pending_pricer_stopearly = TRUE;
-    if (scip_instance != NULL) {
-        SCIPinterruptSolve(scip_instance);
+    for (int t = 0; t < pricing_ntemplates; ++t) {
+        pricingTemplateFree(&pricing_templates[t]);
     }
+    free(pricing_templates);
+    pricing_templates = NULL;
+    pricing_ntemplates = 0;
 }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_model_write_lp(const char* filename)
+static PRICINGTEMPLATE* getPricingTemplate(int t)
 {
-    if (scip_instance == NULL || filename == NULL) {
-        return 0;
-    }
-    return SCIPwriteLP(scip_instance, filename) == SCIP_OKAY ? 1 : 0;
+    return t >= 0 && t < pricing_ntemplates ? &pricing_templates[t] : NULL;
 }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_model_write_mip(const char* filename, int genericnames, int origobj, int lazyconss)
+// Dual of a master constraint handle for the current pricing mode
+static double pricingDual(SCIP* scip, int consId, SCIP_Bool farkas)
 {
-    if (scip_instance == NULL || filename == NULL) {
-        return 0;
+    SCIP_CONS* cons = transformedLinearCons(scip, getConsByHandle(consId));
+    if (cons == NULL) {
+        return 0.0;
     }
-    return SCIPwriteMIP(scip_instance, filename,
-        genericnames ? TRUE : FALSE,
-        origobj ? TRUE : FALSE,
-        lazyconss ? TRUE : FALSE) == SCIP_OKAY ? 1 : 0;
+    if (farkas) {
+        return SCIPgetDualfarkasLinear(scip, cons);
+    }
+    if (stab_active && consId <= stab_size && !isnan(stab_duals[consId - 1])) {
+        return stab_duals[consId - 1];
+    }
+    return SCIPgetDualsolLinear(scip, cons);
 }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_model_write_lp_snapshot(const char* prefix)
+static SCIP_RETCODE pricingAddColumn(SCIP* scip, int t, PRICINGTEMPLATE* tpl, SCIP_SOL* sol)
 {
-    if (scip_instance == NULL || prefix == NULL) {
-        return 0;
+    double* y = tpl->work;
+    double obj = tpl->constcost;
+    for (int j = 0; j < tpl->nvars; ++j) {
+        double v = SCIPgetSolVal(tpl->scip, sol, tpl->vars[j]);
+        y[j] = SCIPvarGetType(tpl->vars[j]) != SCIP_VARTYPE_CONTINUOUS ? round(v) : v;
+        obj += tpl->cost[j] * y[j];
     }
 
-    char filename[512];
-    snprintf(filename, sizeof(filename), "%s_%d_%d.lp", prefix, current_pricing_mode, pricer_round);
-    return SCIPwriteLP(scip_instance, filename) == SCIP_OKAY ? 1 : 0;
+    char name[64];
+    snprintf(name, sizeof(name), "tpl%d_col%.0f", t, tpl->columns);
+    SCIP_VAR* var = NULL;
+    SCIP_CALL(SCIPcreateVarBasic(scip, &var, name, 0.0, SCIPinfinity(scip), obj, SCIP_VARTYPE_CONTINUOUS));
+    SCIP_CALL(SCIPvarSetInitial(var, TRUE));
+    SCIP_CALL(SCIPvarSetRemovable(var, TRUE));
+    SCIP_CALL(SCIPaddPricedVar(scip, var, 1.0));
+
+    // Entries are sorted by constraint: one coefficient per constraint
+    double redcost = obj;
+    for (int e = 0; e < tpl->nentries;) {
+        int consId = tpl->entrycons[e];
+        double coef = 0.0;
+        for (; e < tpl->nentries && tpl->entrycons[e] == consId; ++e) {
+            coef += tpl->entryvar[e] < 0 ? tpl->entrycoef[e] : tpl->entrycoef[e] * y[tpl->entryvar[e]];
+        }
+        SCIP_CONS* cons = transformedLinearCons(scip, getConsByHandle(consId));
+        if (cons != NULL && coef != 0.0) {
+            SCIP_CALL(SCIPaddCoefLinear(scip, cons, var, coef));
+            redcost -= stabOutDual(consId) * coef;
+        }
+    }
+
+    stabTrackColumn(registerVarHandle(var), redcost);
+    priced_vars_added += 1;
+    added_vars_this_call += 1;
+    tpl->columns += 1.0;
+    SCIP_CALL(SCIPreleaseVar(scip, &var));
+    return SCIP_OKAY;
 }
 
-EMSCRIPTEN_KEEPALIVE
-int scip_pricer_include(const char* name, const char* desc, int priority, int delay)
+static SCIP_RETCODE pricingTemplatesPrice(SCIP* scip, SCIP_Bool farkas)
 {
-    if (scip_instance == NULL || name == NULL || desc == NULL) {
-        return 0;
-    }
+    pricing_templates_complete = TRUE;
+    for (int t = 0; t < pricing_ntemplates; ++t) {
+        PRICINGTEMPLATE* tpl = &pricing_templates[t];
+        if (tpl->nentries == 0) {
+            continue;
+        }
 
-    if (js_pricer != NULL) {
-        return 1;
-    }
+        // Farkas pricing looks for any column that cuts off the dual ray: no costs
+        double constant = farkas ? 0.0 : tpl->constcost;
+        for (int j = 0; j < tpl->nvars; ++j) {
+            tpl->work[j] = farkas ? 0.0 : tpl->cost[j];
+        }
+        for (int e = 0; e < tpl->nentries; ++e) {
+            double dual = pricingDual(scip, tpl->entrycons[e], farkas);
+            if (tpl->entryvar[e] < 0) {
+                constant -= dual * tpl->entrycoef[e];
+            } else {
+                tpl->work[tpl->entryvar[e]] -= dual * tpl->entrycoef[e];
+            }
+        }
 
-    SCIP_RETCODE ret = SCIPincludePricerBasic(
-        scip_instance,
-        &js_pricer,
-        name,
-        desc,
-        priority,
-        delay ? TRUE : FALSE,
-        pricerRedcostJs,
-        pricerFarkasJs,
-        NULL
-    );
+        if (SCIPgetStage(tpl->scip) > SCIP_STAGE_PROBLEM) {
+            SCIP_CALL(SCIPfreeTransform(tpl->scip));
+        }
+        for (int j = 0; j < tpl->nvars; ++j) {
+            SCIP_CALL(SCIPchgVarObj(tpl->scip, tpl->vars[j], tpl->work[j]));
+        }
+        SCIP_CALL(SCIPsetObjlimit(tpl->scip, -constant - 1e-6));
+        SCIP_CALL(SCIPsetRealParam(tpl->scip, "limits/time", tpl->timelimit > 0.0 ? tpl->timelimit : 1e20));
+        SCIP_CALL(SCIPsolve(tpl->scip));
+        tpl->solves += 1.0;
+        tpl->seconds += SCIPgetSolvingTime(tpl->scip);
+        tpl->bestredcost = NAN;
+        // Infeasible under the objective limit proves there is no improving column
+        SCIP_STATUS status = SCIPgetStatus(tpl->scip);
+        if (status != SCIP_STATUS_OPTIMAL && status != SCIP_STATUS_INFEASIBLE) {
+            pricing_templates_complete = FALSE;
+        }
 
-    return ret == SCIP_OKAY ? 1 : 0;
+        // Solutions come best first; all of them beat the objective limit
+        int nsols = SCIPgetNSols(tpl->scip);
+        SCIP_SOL** sols = SCIPgetSols(tpl->scip);
+        for (int s = 0; s < nsols && s < tpl->maxcolumns; ++s) {
+            double value = SCIPgetSolOrigObj(tpl->scip, sols[s]) + constant;
+            if (value >= -1e-6) {
+                break;
+            }
+            if (s == 0) {
+                tpl->bestredcost = value;
+            }
+            SCIP_CALL(pricingAddColumn(scip, t, tpl, sols[s]));
+        }
+    }
+    return SCIP_OKAY;
 }
 
+/**
+ * Add a pricing template from a model blob (its objective is the column cost
+ * per template variable, constcost the cost of every column). The template is
+ * always minimized. Returns its index, -1 on error.
+ */
 EMSCRIPTEN_KEEPALIVE
-int scip_pricer_activate(void)
+int scip_pricing_template_add(const unsigned char* blob, int size, double constcost)
 {
-    if (scip_instance == NULL || js_pricer == NULL) {
-        return 0;
+    MODELBLOB b;
+    if (!modelBlobParse(blob, size, &b)) {
+        return -1;
     }
 
-    return SCIPactivatePricer(scip_instance, js_pricer) == SCIP_OKAY ? 1 : 0;
-}
-
-EMSCRIPTEN_KEEPALIVE
-int scip_pricer_deactivate(void)
-{
-    if (scip_instance == NULL || js_pricer == NULL) {
-        return 0;
+    PRICINGTEMPLATE* grown = (PRICINGTEMPLATE*)realloc(pricing_templates, (size_t)(pricing_ntemplates + 1) * sizeof(PRICINGTEMPLATE));
+    if (grown == NULL) {
+        return -1;
+    }
+    pricing_templates = grown;
+    PRICINGTEMPLATE* tpl = &pricing_templates[pricing_ntemplates];
+    memset(tpl, 0, sizeof(PRICINGTEMPLATE));
+
+    int nvars = b.nvars;
+    size_t n = (size_t)(nvars > 0 ? nvars : 1);
+    tpl->vars = (SCIP_VAR**)calloc(n, sizeof(SCIP_VAR*));
+    tpl->cost = (double*)malloc(n * sizeof(double));
+    tpl->work = (double*)malloc(n * sizeof(double));
+    SCIP_Bool ok = tpl->vars != NULL && tpl->cost != NULL && tpl->work != NULL
+        && standaloneCreateInstance(&tpl->scip) == SCIP_OKAY
+        && SCIPsetIntParam(tpl->scip, "display/verblevel", 0) == SCIP_OKAY
+        && standaloneLoadBlob(tpl->scip, &b, tpl->vars)
+        && SCIPsetObjsense(tpl->scip, SCIP_OBJSENSE_MINIMIZE) == SCIP_OKAY;
+    if (!ok) {
+        if (tpl->scip != NULL) {
+            SCIPfree(&tpl->scip);
+        }
+        free(tpl->vars);
+        free(tpl->cost);
+        free(tpl->work);
+        return -1;
     }
 
-    return SCIPdeactivatePricer(scip_instance, js_pricer) == SCIP_OKAY ? 1 : 0;
+    tpl->nvars = nvars;
+    for (int j = 0; j < nvars; ++j) {
+        tpl->cost[j] = SCIPvarGetObj(tpl->vars[j]);
+    }
+    tpl->constcost = constcost;
+    tpl->timelimit = 0.0;
+    tpl->maxcolumns = 1;
+    tpl->bestredcost = NAN;
+    return pricing_ntemplates++;
 }
 
+/**
+ * Column map of template t: entry k adds coefs[k] * y[vars[k]] (coefs[k] if
+ * vars[k] is -1) to the column's coefficient in master constraint consIds[k].
+ * Replaces the previous map. Returns 1 on success.
+ */
 EMSCRIPTEN_KEEPALIVE
-int scip_pricer_is_active(void)
+int scip_pricing_template_set_column(int t, const int* consIds, const int* vars, const double* coefs, int n)
 {
-    if (js_pricer == NULL) {
+    PRICINGTEMPLATE* tpl = getPricingTemplate(t);
+    if (tpl == NULL || consIds == NULL || vars == NULL || coefs == NULL || n < 0) {
         return 0;
     }
-    return SCIPpricerIsActive(js_pricer) ? 1 : 0;
-}
-
-EMSCRIPTEN_KEEPALIVE
-void scip_pricer_enable_redcost_callback(int enable)
-{
-    js_pricer_redcost_callback = enable ? 1 : 0;
-}
-
-EMSCRIPTEN_KEEPALIVE
-void scip_pricer_enable_farkas_callback(int enable)
-{
-    js_pricer_farkas_callback = enable ? 1 : 0;
-}
+    for (int k = 0; k < n; ++k) {
+        if (getConsByHandle(consIds[k]) == NULL || vars[k] < -1 || vars[k] >= tpl->nvars) {
+            return 0;
+        }
+    }
 
-EMSCRIPTEN_KEEPALIVE
-void scip_pricer_set_result(int resultcode)
-{
-    pending_pricer_result = (SCIP_RESULT)resultcode;
-    last_pricing_result = resultcode;
-}
+    int* order = (int*)malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+    int* entrycons = (int*)malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+    int* entryvar = (int*)malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+    double* entrycoef = (double*)malloc((size_t)(n > 0 ? n : 1) * sizeof(double));
+    if (order == NULL || entrycons == NULL || entryvar == NULL || entrycoef == NULL) {
+        free(order);
+        free(entrycons);
+        free(entryvar);
+        free(entrycoef);
+        return 0;
+    }
 
-EMSCRIPTEN_KEEPALIVE
-void scip_pricer_set_lowerbound(double lowerbound)
-{
-    pending_pricer_lowerbound = lowerbound;
-}
+    // Insertion sort by constraint handle; maps are short and mostly sorted
+    for (int k = 0; k < n; ++k) {
+        int m = k;
+        while (m > 0 && consIds[k] < consIds[order[m - 1]]) {
+            order[m] = order[m - 1];
+            --m;
+        }
+        order[m] = k;
+    }
+    for (int k = 0; k < n; ++k) {
+        entrycons[k] = consIds[order[k]];
+        entryvar[k] = vars[order[k]];
+        entrycoef[k] = coefs[order[k]];
+    }
+    free(order);
 
-EMSCRIPTEN_KEEPALIVE
-void scip_pricer_set_stopearly(int stopearly)
-{
-    pending_pricer_stopearly = stopearly ? TRUE : FALSE;
+    pricingTemplateFreeMap(tpl);
+    tpl->entrycons = entrycons;
+    tpl->entryvar = entryvar;
+    tpl->entrycoef = entrycoef;
+    tpl->nentries = n;
+    return 1;
 }
 
+/**
+ * Limits of template t: seconds per solve (0: none) and improving solutions
+ * added per round. Returns 1 on success.
+ */
 EMSCRIPTEN_KEEPALIVE
-int scip_result_success(void)
+int scip_pricing_template_set_limits(int t, double timelimit, int maxcolumns)
 {
-    return (int)SCIP_SUCCESS;
+    PRICINGTEMPLATE* tpl = getPricingTemplate(t);
+    if (tpl == NULL || maxcolumns < 1 || !(timelimit >= 0.0)) {
+        return 0;
+    }
+    tpl->timelimit = timelimit;
+    tpl->maxcolumns = maxcolumns;
+    return 1;
 }
 
+/**
+ * Counters of template t: out[0] solves, [1] columns added, [2] seconds,
+ * [3] best reduced cost of its last round (NaN if it found no column)
+ */
 EMSCRIPTEN_KEEPALIVE
-int scip_result_didnotrun(void)
+int scip_pricing_template_stats(int t, double* out)
 {
-    return (int)SCIP_DIDNOTRUN;
+    PRICINGTEMPLATE* tpl = getPricingTemplate(t);
+    if (tpl == NULL || out == NULL) {
+        return 0;
+    }
+    out[0] = tpl->solves;
+    out[1] = tpl->columns;
+    out[2] = tpl->seconds;
+    out[3] = tpl->bestredcost;
+    return 1;
 }
 
 EMSCRIPTEN_KEEPALIVE
-int scip_result_didnotfind(void)
+int scip_pricing_template_count(void)
 {
-    return (int)SCIP_DIDNOTFIND;
+    return pricing_ntemplates;
 }
 
 /**
- * Reset for new problem
+ * Drop template t if it is the most recently added one, e.g. when its column
+ * map or limits were rejected. Returns 1 on success.
  */
 EMSCRIPTEN_KEEPALIVE
-void scip_reset(void)
+int scip_pricing_template_pop(int t)
 {
-    clearCurrentProblem();
-    resetPricingState();
-    clearRegistries();
-    js_pricer = NULL;
-    js_pricer_redcost_callback = 0;
-    js_pricer_farkas_callback = 0;
+    if (t < 0 || t != pricing_ntemplates - 1) {
+        return 0;
+    }
+    pricingTemplateFree(&pricing_templates[t]);
+    pricing_ntemplates -= 1;
+    return 1;
 }
 
-/**
- * Enable/disable incumbent callback
- */
 EMSCRIPTEN_KEEPALIVE
-void scip_enable_incumbent_callback(int enable)
+void scip_pricing_templates_clear(void)
 {
-    js_incumbent_callback = enable;
+    pricingTemplatesFree();
 }
 
-/**
- * Enable/disable node callback
- */
-EMSCRIPTEN_KEEPALIVE
-void scip_enable_node_callback(int enable)
-{
-    js_node_callback = enable;
-}
@@ -0,0 +1,62 @@
+/**
+ * SCIP.js plugin ABI
+ *
+ * Native plugins are wasm side modules (emcc -sSIDE_MODULE=1) loaded into the
+ * dynamic-linking build of the API module (scip-api-dynlink.*) with
+ * SCIPApi.loadPlugin(). They link against the SCIP symbols exported by the main
+ * module, so pricers, separators, heuristics etc. are included with the usual
+ * SCIPinclude*() calls and run without crossing into JavaScript.
+ *
+ * A plugin exports one entry point:
+ *
+ *   int scipjs_plugin_init(SCIP* scip, const SCIPJS_PLUGINHOST* host)
+ *   {
+ *       if (host->abi_version != SCIPJS_PLUGIN_ABI_VERSION) {
+ *           return 0;
+ *       }
+ *       SCIP_CALL_ABORT(SCIPincludeSepaBasic(scip, ...));
+ *       return 1;
+ *   }
+ *
+ * Build:
+ *   emcc -O3 -fPIC -sSIDE_MODULE=1 -I<scip include dirs> myplugin.c -o myplugin.wasm
+ *
+ * Plugins are included into the SCIP instance, not into one problem: load them
+ * once after init, before the first solve. Pricers still have to be activated
+ * for each problem (SCIPApi.activatePluginPricer()).
+ */
+
+#ifndef SCIPJS_PLUGIN_H
+#define SCIPJS_PLUGIN_H
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCIPJS_PLUGIN_ABI_VERSION 1
+#define SCIPJS_PLUGIN_INIT_SYMBOL "scipjs_plugin_init"
+
+/**
+ * Bridge services handed to the plugin. Handles are the 1-based ids returned to
+ * JavaScript (addVar, addLinearCons, getLPRowDualsBatch, ...), so a plugin and
+ * JS code can refer to the same variables, constraints and rows.
+ */
+typedef struct SCIPJS_PluginHost {
+    int abi_version;
+    SCIP_VAR* (*get_var)(int varId);
+    SCIP_CONS* (*get_cons)(int consId);
+    SCIP_ROW* (*get_row)(int rowId);
+    int (*register_var)(SCIP_VAR* var);
+    int (*register_cons)(SCIP_CONS* cons);
+    int (*register_row)(SCIP_ROW* row);
+} SCIPJS_PLUGINHOST;
+
+typedef int (*SCIPJS_PLUGIN_INIT)(SCIP* scip, const SCIPJS_PLUGINHOST* host);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
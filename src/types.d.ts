@@ -23,6 +23,17 @@ export const Status: {
 export interface InitOptions {
   /** Path to scip.wasm file (default: CDN) */
   wasmPath?: string;
+  /**
+   * Allocator of the callback API build (SCIPApi only, default 'dlmalloc').
+   * 'mimalloc' loads scip-api-mimalloc.{js,wasm}, which fragments less when
+   * one instance is reused for many models.
+   */
+  allocator?: 'dlmalloc' | 'mimalloc';
+  /**
+   * Load scip-api-dynlink.{js,wasm} (built with SCIPJS_DYNLINK=1), which can
+   * load native wasm plugins with SCIPApi.loadPlugin()
+   */
+  dynamicLinking?: boolean;
 }
 
 /**
@@ -189,6 +200,43 @@ export interface CallbackSolveOptions extends SolveOptions {
   initialSolution?: Record<string, number>;
   /** Cutoff bound - prune nodes with worse objective */
   cutoff?: number;
+  /** Look up every variable value by name after solving (default true) */
+  extractVariables?: boolean;
+  /** Settings profile applied for this solve only */
+  settings?: SettingsProfile;
+}
+
+export declare const Emphasis: {
+  readonly DEFAULT: 0;
+  readonly CPSOLVER: 1;
+  readonly EASYCIP: 2;
+  readonly FEASIBILITY: 3;
+  readonly HARDLP: 4;
+  readonly OPTIMALITY: 5;
+  readonly COUNTER: 6;
+  readonly PHASEFEAS: 7;
+  readonly PHASEIMPROVE: 8;
+  readonly PHASEPROOF: 9;
+  readonly NUMERICS: 10;
+  readonly BENCHMARK: 11;
+};
+
+export declare const ParamSetting: {
+  readonly DEFAULT: 0;
+  readonly AGGRESSIVE: 1;
+  readonly FAST: 2;
+  readonly OFF: 3;
+};
+
+export type MetaSetting = 'default' | 'aggressive' | 'fast' | 'off' | number;
+
+/** Parameter profile, e.g. the output of tune/scip-tune.mjs */
+export interface SettingsProfile {
+  emphasis?: string | number;
+  heuristics?: MetaSetting;
+  presolving?: MetaSetting;
+  separating?: MetaSetting;
+  params?: Record<string, number | boolean | string>;
 }
 
 /**
@@ -250,6 +298,376 @@ export type PricerCallback = () => void;
 
 export type PricingMode = 0 | 1 | 2;
 
+export type TreeNodeStatusName = 'focused' | 'branched' | 'infeasible' | 'pruned' | 'solution';
+
+/**
+ * Decoded branch-and-bound tree trace record
+ */
+export interface TreeTraceRecord {
+  /** Seconds since solve start */
+  time: number;
+  /** Node lower bound (transformed space) */
+  lowerBound: number;
+  /** Bound imposed by the branching that created the node */
+  branchBound: number;
+  node: number;
+  /** Parent node number (0 for the root) */
+  parent: number;
+  depth: number;
+  /** Transformed problem index of the branching variable, -1 if none */
+  branchVar: number;
+  branchVarName: string | null;
+  /** LP iterations spent while the node was focused */
+  lpIterations: number;
+  status: TreeNodeStatusName | 'unknown';
+  direction: 'down' | 'up' | null;
+}
+
+export const TreeNodeStatus: {
+  FOCUSED: 0;
+  BRANCHED: 1;
+  INFEASIBLE: 2;
+  PRUNED: 3;
+  SOLUTION: 4;
+};
+
+/**
+ * Chrome trace-event JSON (object format)
+ */
+export interface ChromeTrace {
+  traceEvents: Array<{
+    name: string;
+    cat: string;
+    ph: 'X';
+    ts: number;
+    dur: number;
+    pid: number;
+    tid: number;
+    args?: Record<string, unknown>;
+  }>;
+  displayTimeUnit: 'ms';
+  otherData: {
+    droppedSpans: number;
+    /** Cumulative time of SCIP's own plugins (not hooked per call) */
+    pluginTimes: Array<{ name: string; kind: string; seconds: number; calls: number }>;
+  };
+}
+
+/**
+ * Memory sample (bytes unless noted)
+ */
+export interface MemorySample {
+  /** performance.now() of the solving thread (ms) */
+  time: number;
+  phase: 'read' | 'transformed' | 'presolved' | 'root' | 'nodes' | 'solved' | 'cleared' | 'manual' | 'unknown';
+  nodes: number;
+  scipMemUsed: number;
+  scipMemTotal: number;
+  heapSize: number;
+  /** mallinfo() bytes in use; -1 in the mimalloc build, which has no mallinfo() */
+  mallocInUse: number;
+  /** mallinfo() free bytes; -1 in the mimalloc build */
+  mallocFree: number;
+  scipMemExtern: number;
+  /** Top of the sbrk heap, i.e. how far the allocator has grown it (any build) */
+  heapBreak: number;
+}
+
+/**
+ * Live progress snapshot (see SCIPApi.attachProgress / readProgress);
+ * bounds are null while SCIP has none
+ */
+export interface ProgressSnapshot {
+  /** Incremented on every publish */
+  version: number;
+  elapsedMs: number;
+  stage: string;
+  primalBound: number | null;
+  dualBound: number | null;
+  gap: number | null;
+  nodes: number;
+  openNodes: number;
+  lpIterations: number;
+  solutions: number;
+  scipMemUsed: number;
+  heapSize: number;
+  updates: number;
+}
+
+export declare const MailboxFlag: {
+  readonly OBJLIMIT: 1;
+  readonly SOLUTION: 2;
+};
+/** Allocate a mailbox for SCIPApi.attachMailbox(); capacity = variables a posted solution may carry */
+export function createMailbox(capacity?: number): SharedArrayBuffer;
+/** Post an objective limit and/or a solution (variable handle order) to a running solve, from any thread */
+export function postToMailbox(buffer: SharedArrayBuffer, message: { objlimit?: number; values?: ArrayLike<number> }): void;
+
+/** Summary of a checkpoint (SCIPApi.saveCheckpoint) */
+export interface CheckpointInfo {
+  version: number;
+  nvars: number;
+  openNodes: number;
+  boundChanges: number;
+  solutions: number;
+  /** Branching bound changes on variables without a handle, dropped on save */
+  droppedBoundChanges: number;
+  /** Hash of the saved model's variables and checked constraints (hex); loadCheckpoint requires a match */
+  regionHash: string;
+  /** Hash of the saved model's objective (hex); loadCheckpoint requires a match */
+  objectiveHash: string;
+  dualBound: number;
+  primalBound: number;
+  solvingTime: number;
+  nodes: number;
+  lpIterations: number;
+}
+export function decodeCheckpoint(checkpoint: Uint8Array | ArrayBuffer): CheckpointInfo;
+
+export const CutRowFlag: {
+  readonly CONFLICT: 1;
+  /** Only valid under the same objective */
+  readonly OBJECTIVE: 2;
+};
+
+/** Rows of a cut pack (SCIPApi.exportCuts) in CSR form over variable indices (handle - 1) */
+export interface CutPack {
+  version: number;
+  nvars: number;
+  nrows: number;
+  nnz: number;
+  cuts: number;
+  conflicts: number;
+  /** Rows not exported: nonlinear or on variables without a handle */
+  dropped: number;
+  /** Hash of variable types, bounds and checked constraints (hex) */
+  regionHash: string;
+  /** Hash of the objective sense and coefficients (hex) */
+  objectiveHash: string;
+  lhs: Float64Array;
+  rhs: Float64Array;
+  rowStart: Int32Array;
+  colIdx: Int32Array;
+  vals: Float64Array;
+  /** CutRowFlag bits per row */
+  flags: Uint8Array;
+  /** Incumbent of the exporting solve, in variable order */
+  incumbent: Float64Array | null;
+}
+export function decodeCutPack(pack: Uint8Array | ArrayBuffer): CutPack;
+
+/**
+ * Postsolve map (SCIPApi.presolveOnly): original variable i (handle i + 1) is
+ * constant[i] + sum scalar[k] * y[index[k]] for k in [start[i], start[i + 1])
+ */
+export interface PostsolveMap {
+  version: number;
+  nvars: number;
+  nnz: number;
+  fixed: number;
+  aggregated: number;
+  multiAggregated: number;
+  /** Original objective = objScale * reduced objective + objOffset */
+  objScale: number;
+  objOffset: number;
+  constant: Float64Array;
+  scalar: Float64Array;
+  start: Int32Array;
+  index: Int32Array;
+}
+export function decodePostsolveMap(map: Uint8Array | ArrayBuffer): PostsolveMap;
+/** Map a reduced-model solution (and objective) back to the original variable handles */
+export function postsolveSolution(
+  map: PostsolveMap | Uint8Array | ArrayBuffer,
+  values: ArrayLike<number>,
+  objective?: number
+): { values: Float64Array; objective: number };
+
+/** Entry names of SCIPApi.extractFeatures() vectors, in order */
+export declare const FEATURE_NAMES: readonly string[];
+/** Name the entries of a feature vector */
+export function featuresToObject(features: Float64Array): Record<string, number>;
+
+/** Allocate a progress block for SCIPApi.attachProgress() */
+export function createProgressBuffer(): SharedArrayBuffer;
+/** Seqlock write of one snapshot (PROGRESS_FIELDS order), as the solver's progress callback does */
+export function writeProgress(buffer: SharedArrayBuffer, fields: ArrayLike<number>): void;
+/** Seqlock read of a progress block from any thread; null before the first publish */
+export function readProgress(buffer: SharedArrayBuffer, options?: { maxRetries?: number }): ProgressSnapshot | null;
+
+/**
+ * Bridge allocation counters (see SCIPApi.enableArena)
+ */
+export interface AllocStats {
+  allocs: number;
+  frees: number;
+  reallocs: number;
+  bytes: number;
+  /** Time spent in bridge allocations (ms), 0 unless timing is enabled */
+  timeMs: number;
+  arenaCapacity: number;
+  arenaUsed: number;
+  arenaHighWater: number;
+  arenaResets: number;
+  /** Allocations served by malloc because the arena was full */
+  arenaFallbacks: number;
+}
+
+/** Decode a binary tree trace (48-byte records) */
+export function decodeTreeTrace(buffer: ArrayBuffer, varNames?: string[] | null): TreeTraceRecord[];
+
+/** Convert a binary tree trace to VBC format */
+export function treeTraceToVbc(buffer: ArrayBuffer, varNames?: string[] | null): string;
+
+/**
+ * Decoded pricing trace record, one per pricer call
+ */
+export interface PricingTraceRecord {
+  /** Seconds since solve start */
+  time: number;
+  /** LP objective priced against (NaN for Farkas rounds) */
+  lpObjective: number;
+  node: number;
+  round: number;
+  mode: 'redcost' | 'farkas' | 'unknown';
+  lpCols: number;
+  lpRows: number;
+  /** Columns added by the call */
+  added: number;
+  /** Problem variables outside the LP (columns that can re-enter) */
+  pooled: number;
+  /** Stabilized pricing repeats within the call */
+  mispricings: number;
+}
+
+/** Decode a binary pricing trace (48-byte records) */
+export function decodePricingTrace(buffer: ArrayBuffer): PricingTraceRecord[];
+
+/**
+ * SCIP variable types
+ */
+export declare const VarType: {
+  readonly BINARY: 0;
+  readonly INTEGER: 1;
+  readonly IMPLINT: 2;
+  readonly CONTINUOUS: 3;
+};
+
+/**
+ * Columnar model builder, compiled into one blob for SCIPApi.loadModel()/solveModel()
+ */
+export class ModelBuilder {
+  constructor(options?: { name?: string; maximize?: boolean; capacity?: number });
+  name: string;
+  maximize: boolean;
+  readonly numVars: number;
+  readonly numRows: number;
+  readonly numCoefs: number;
+  /** Variable names in index order (defaults are x<index>) */
+  readonly varNames: string[];
+  addVar(options?: { name?: string; lb?: number; ub?: number; obj?: number; vartype?: number }): number;
+  addVars(count: number, options?: { lb?: number; ub?: number; obj?: number; vartype?: number }): number;
+  setObjective(varIndex: number, obj: number): void;
+  setBounds(varIndex: number, lb: number, ub: number): void;
+  addRow(options?: { name?: string; lhs?: number; rhs?: number; modifiable?: boolean; removable?: boolean }): number;
+  addCoef(rowIndex: number, varIndex: number, val: number): void;
+  addCoefs(rowIndex: number, varIndices: ArrayLike<number>, vals: ArrayLike<number>): void;
+  /** Transferable model blob */
+  compile(): ArrayBuffer;
+  /** Blob in a SharedArrayBuffer, loadable by many workers without cloning */
+  compile(options: { shared: true }): SharedArrayBuffer;
+  compile(options?: { shared?: boolean }): ArrayBuffer | SharedArrayBuffer;
+}
+
+/** Copy a model blob into a SharedArrayBuffer once (shared blobs are returned as-is) */
+export function shareModel(model: ModelBuilder | ArrayBuffer | SharedArrayBuffer | Uint8Array): SharedArrayBuffer;
+
+export interface BendersSolution {
+  status: string;
+  objective: number;
+  /** Master variable values in master order */
+  values: Float64Array;
+  statistics: { solvingTime: number; nodes: number; gap: number; dualBound: number; primalBound: number };
+  benders: { subproblems: number; calls: number; cuts: number };
+  error?: string;
+}
+
+/** Sections of a compiled blob as typed-array views (no copy) */
+export interface ModelView {
+  maximize: boolean;
+  nvars: number;
+  nrows: number;
+  nnz: number;
+  lb: Float64Array;
+  ub: Float64Array;
+  obj: Float64Array;
+  lhs: Float64Array;
+  rhs: Float64Array;
+  vals: Float64Array;
+  rowStart: Int32Array;
+  colIdx: Int32Array;
+  vartype: Uint8Array;
+  rowflags: Uint8Array;
+  name: string;
+  varNames: string[] | null;
+  rowNames: string[] | null;
+}
+export function readModel(blob: ArrayBuffer | SharedArrayBuffer | Uint8Array): ModelView;
+/**
+ * Compile the rows `rows` over the variables `vars` of a blob; variable k is vars[k] of the original.
+ * Other variables with a value in `fixed` (NaN: not fixed) are moved into the row sides.
+ */
+export function extractSubmodel(
+  blob: ArrayBuffer | SharedArrayBuffer | Uint8Array | ModelView,
+  vars: ArrayLike<number>,
+  rows: ArrayLike<number>,
+  fixed?: Float64Array | null
+): ArrayBuffer;
+
+export interface RollingHorizonOptions {
+  /** Period label of each variable */
+  varPeriods: ArrayLike<number>;
+  /** Period label of each row (default: latest period of its variables) */
+  rowPeriods?: ArrayLike<number> | null;
+  /** Periods per window (default 4) */
+  window?: number;
+  /** Periods committed per window (default: half the window) */
+  step?: number;
+  /** Seconds per window (default 60) */
+  windowTimeLimit?: number;
+  /** Seconds for the whole horizon */
+  timeLimit?: number;
+  settings?: SettingsProfile | null;
+  onWindow?: (window: RollingHorizonWindow) => void;
+}
+
+export interface RollingHorizonWindow {
+  /** First and last period label of the window */
+  periods: [number, number];
+  /** First and last period label fixed after the window */
+  committed: [number, number];
+  vars: number;
+  rows: number;
+  status: string;
+  objective: number;
+  seconds: number;
+}
+
+/** Solve a time-indexed model by overlapping windows, one loaded at a time */
+export function solveRollingHorizon(
+  solver: SCIPApi,
+  model: ModelBuilder | ArrayBuffer | SharedArrayBuffer | Uint8Array,
+  options: RollingHorizonOptions
+): Promise<{
+  status: string;
+  objective: number;
+  values: Float64Array;
+  /** Rows closed between windows that the stitched solution violates */
+  violatedRows: number[];
+  windows: RollingHorizonWindow[];
+  statistics: { solvingTime: number; windows: number; periods: number };
+}>;
+
 /**
  * SCIP API class with callback support
  * 
@@ -352,6 +770,158 @@ export class SCIPApi {
   getPricerRedcostCalls(): number;
   getPricerFarkasCalls(): number;
   getPricerRound(): number;
+  /**
+   * Stabilize the duals seen by the redcost pricer (Wentges smoothing or box-step) with
+   * in-bridge mispricing fallback to the LP duals
+   */
+  setDualStabilization(options?: {
+    mode?: 'smoothing' | 'boxstep' | 'none';
+    alpha?: number;
+    width?: number;
+    adaptive?: boolean;
+  }): boolean;
+  /** Stabilized rounds, mispricings, fallbacks to the LP duals and current alpha / box width */
+  getDualStabilizationStats(): { rounds: number; mispricings: number; fallbacks: number; value: number };
+  /**
+   * MIP pricing subproblem solved natively by the bridge pricer; its improving solutions
+   * become continuous master columns through the column map. Templates ignore branching
+   * decisions, so they price the LP relaxation only. A rejected column map or limits
+   * throws and leaves no template behind. Returns the template index.
+   */
+  addPricingTemplate(
+    model: ModelBuilder | ArrayBuffer | Uint8Array,
+    options: {
+      column: { consIds: ArrayLike<number>; vars: ArrayLike<number>; coefs: ArrayLike<number> };
+      constCost?: number;
+      timeLimit?: number;
+      maxColumns?: number;
+    }
+  ): number;
+  getPricingTemplateStats(index: number): { solves: number; columns: number; seconds: number; bestRedcost: number | null } | null;
+  clearPricingTemplates(): void;
+  /**
+   * Age removable columns out of the LP after ageLimit LP solves at zero; they stay
+   * in the problem as a pool that re-enters on negative reduced cost
+   */
+  setColumnAging(options?: { ageLimit?: number; cleanupRoot?: boolean; cleanupNodes?: boolean }): boolean;
+  /** Removable columns in the LP and pooled outside it, with the ages of those in the LP */
+  getColumnStats(): { inLP: number; pooled: number; meanAge: number; maxAge: number };
+  /**
+   * Record every pricer call of subsequent solves (LP size, columns added, pool size)
+   * @param capacity - Maximum pricer calls kept per solve (default 65536)
+   */
+  enablePricingTrace(capacity?: number): boolean;
+  disablePricingTrace(): void;
+  getPricingTraceDropped(): number;
+  /** Packed 48-byte pricer call records of the last solve */
+  getPricingTrace(): ArrayBuffer;
+  exportPricingTraceJSON(): { dropped: number; rounds: PricingTraceRecord[] };
+
+  /**
+   * Record branch-and-bound nodes of subsequent solves
+   * @param capacity - Maximum node records kept per solve (default 65536)
+   */
+  enableTreeTrace(capacity?: number): boolean;
+  disableTreeTrace(): void;
+  getTreeTraceDropped(): number;
+  /** Packed 48-byte node records of the last solve */
+  getTreeTrace(): ArrayBuffer;
+  exportTreeTraceJSON(): { dropped: number; nodes: TreeTraceRecord[] };
+  exportTreeTraceVbc(): string;
+
+  /**
+   * Record solver phase spans for exportChromeTrace()
+   * @param capacity - Maximum spans kept in the wasm heap (default 65536)
+   */
+  enableProfiling(capacity?: number): boolean;
+  disableProfiling(): void;
+  clearProfile(): void;
+  /**
+   * Recorded spans as Chrome trace-event JSON.
+   * Timestamps share the performance.now() clock of the solving thread.
+   */
+  exportChromeTrace(options?: { pid?: number; tid?: number; absolute?: boolean }): ChromeTrace;
+
+  /**
+   * Sample SCIP and wasm heap memory at phase boundaries and every N nodes
+   */
+  enableMemorySampling(options?: { capacity?: number; everyNodes?: number }): boolean;
+  disableMemorySampling(): void;
+  clearMemorySamples(): void;
+  /** Memory time series, oldest first, `stride` doubles per sample */
+  getMemorySamples(): { fields: string[]; stride: number; data: Float64Array; total: number };
+  getMemoryTimeline(): MemorySample[];
+  sampleMemory(): MemorySample;
+
+  /**
+   * Publish live solver state into a shared block readable with readProgress()
+   * from any thread while a solve runs
+   */
+  attachProgress(buffer?: SharedArrayBuffer, options?: { intervalMs?: number }): SharedArrayBuffer;
+  detachProgress(): void;
+
+  /**
+   * Poll a shared mailbox at every focused node, so other threads can tighten
+   * the objective limit or inject solutions mid-solve (postToMailbox)
+   */
+  attachMailbox(buffer?: SharedArrayBuffer): SharedArrayBuffer;
+  detachMailbox(): void;
+  getMailboxStats(): { polls: number; objlimits: number; solutionsTried: number; solutionsStored: number };
+  resetMailboxStats(): void;
+
+  /** Snapshot an interrupted solve (open nodes, incumbents, bounds, pseudocosts); null if not mid-solve */
+  saveCheckpoint(options?: { maxSolutions?: number }): Uint8Array | null;
+  /** Resume on a freshly loaded copy of the same model; applies at the next solve */
+  loadCheckpoint(checkpoint: Uint8Array | ArrayBuffer): boolean;
+  /**
+   * Globally valid cuts of the cut pool and global conflicts of the current or finished
+   * solve, with the model hashes (see decodeCutPack); null if there is no solve
+   */
+  exportCuts(options?: { maxCuts?: number; maxConflicts?: number }): Uint8Array | null;
+  /**
+   * Add a cut pack to a freshly loaded model with the same feasible region as initial
+   * removable rows; returns the rows added, -1 if the pack does not match
+   */
+  importCuts(pack: Uint8Array | ArrayBuffer): number;
+  /** Apply a profile on top of the current parameters; returns what could not be set */
+  applySettings(profile: SettingsProfile): string[];
+  /** Parameters as SCIP settings file text */
+  saveSettings(options?: { onlyChanged?: boolean }): string | null;
+  loadSettings(text: string): boolean;
+  /** Reset every parameter to SCIP's default */
+  resetSettings(): boolean;
+  /**
+   * Two-stage model via SCIP's default Benders decomposition on separate SCIP
+   * instances; subproblem variables named like master variables link to them
+   */
+  solveBenders(
+    master: ModelBuilder | ArrayBuffer | Uint8Array,
+    subproblems: Array<ModelBuilder | ArrayBuffer | Uint8Array>,
+    options?: { timeLimit?: number }
+  ): Promise<BendersSolution>;
+  /** Connected components of a blob's constraint matrix; -1 labels variables in no row and empty rows */
+  modelComponents(model: ModelBuilder | ArrayBuffer | SharedArrayBuffer | Uint8Array): { count: number; varLabels: Int32Array; rowLabels: Int32Array } | null;
+  /** Shape features of the loaded problem (see FEATURE_NAMES), computed in one pass in C */
+  extractFeatures(): Float64Array;
+  /** Set limits/memory (MB) */
+  setMemoryLimit(megabytes: number): boolean;
+
+  /**
+   * Serve per-problem bridge allocations from a bump arena released on problem clear.
+   * Returns false while a problem still holds arena memory.
+   */
+  enableArena(options?: { bytes?: number; timing?: boolean }): boolean;
+  disableArena(): boolean;
+  getAllocStats(): AllocStats;
+  resetAllocStats(options?: { timing?: boolean }): void;
+
+  /**
+   * Load a native plugin (wasm side module, see scipjs_plugin.h); requires
+   * init({ dynamicLinking: true }). Throws if the plugin cannot be loaded.
+   */
+  loadPlugin(bytes: Uint8Array | ArrayBuffer, name?: string): number;
+  /** Activate a pricer included by a native plugin for the current problem */
+  activatePluginPricer(name: string): boolean;
   getResultCodeSuccess(): number;
   getResultCodeDidNotRun(): number;
   getResultCodeDidNotFind(): number;
@@ -359,6 +929,10 @@ export class SCIPApi {
   setParamReal(name: string, value: number): boolean;
   setParamBool(name: string, value: boolean): boolean;
   setParamString(name: string, value: string): boolean;
+  /** Set a 64-bit integer parameter (e.g. limits/nodes) */
+  setParamLongint(name: string, value: number): boolean;
+  /** Change the bounds of many variables (by handle) at once; NaN keeps a bound. Returns the number changed */
+  setVarBounds(handles: ArrayLike<number>, lb: ArrayLike<number>, ub: ArrayLike<number>): number;
   addPricedVar(options: {
     name: string;
     lb?: number;
@@ -402,6 +976,56 @@ export class SCIPApi {
   addCoefLinear(consId: number, varId: number, val: number): boolean;
   addCoefLinearBatch(consId: number, varIds: number[], vals: number[]): boolean;
   solveCurrentModel(options?: CallbackSolveOptions): Promise<CallbackSolution>;
+  /** Replace the current problem with a compiled model (variable j gets handle j + 1) */
+  loadModel(model: ModelBuilder | ArrayBuffer | SharedArrayBuffer | Uint8Array): boolean;
+  /**
+   * Presolve only: the reduced model as a model blob (always minimizing) and the postsolve
+   * map back to the original handles; the current problem stays presolved
+   */
+  presolveOnly(model?: ModelBuilder | ArrayBuffer | Uint8Array | null): {
+    status: StatusType;
+    error?: string;
+    model?: Uint8Array | null;
+    postsolve?: Uint8Array | null;
+    /** Set when presolve solved the problem (status optimal, empty reduced model) */
+    objective?: number;
+    values?: Float64Array;
+    statistics?: {
+      presolvingTime: number;
+      originalVars: number;
+      vars: number;
+      rows: number;
+      nonzeros: number;
+      fixed: number;
+      aggregated: number;
+      multiAggregated: number;
+    };
+  };
+  /** Best-solution values of the first n variables in handle order */
+  getVarValues(n?: number): Float64Array;
+  /** Offer a start solution in variable handle order (NaN: unknown, completed by SCIP); true if SCIP stored it */
+  addSolutionValues(values: ArrayLike<number>): boolean;
+  /** loadModel() + solve; `values` follows the model's variable order */
+  solveModel(
+    model: ModelBuilder | ArrayBuffer | SharedArrayBuffer | Uint8Array,
+    options?: CallbackSolveOptions & {
+      initialValues?: ArrayLike<number>;
+      /** Continue from a checkpoint of the same model */
+      resumeFrom?: Uint8Array | ArrayBuffer;
+      /** Return result.checkpoint when the solve is interrupted */
+      checkpoint?: boolean;
+      /** Cut pack of a related solve to start from (importCuts) */
+      reuseCuts?: Uint8Array | ArrayBuffer;
+      /** Return this solve's cut pack as result.cuts */
+      exportCuts?: boolean;
+    }
+  ): Promise<CallbackSolution & {
+    values: Float64Array;
+    checkpoint?: Uint8Array | null;
+    resumedNodes?: number;
+    cutsImported?: number;
+    cuts?: Uint8Array | null;
+  }>;
   
   /**
    * Solve an optimization problem
@@ -455,3 +1079,212 @@ declare global {
   var SCIP: SCIPModule;
   var SCIP_BASE_URL: string | undefined;
 }
+
+// ============================================
+// scip.js/server (Node.js)
+// ============================================
+
+/** error.code of jobs rejected by SolverPool */
+export declare const PoolError: {
+  readonly QUEUE_FULL: 'QUEUE_FULL';
+  readonly DEADLINE: 'DEADLINE';
+  readonly BUDGET_EXCEEDED: 'BUDGET_EXCEEDED';
+  readonly CLOSED: 'CLOSED';
+  readonly WORKER: 'WORKER';
+  readonly INVALID_MODEL: 'INVALID_MODEL';
+};
+
+export interface LatencySummary {
+  count: number;
+  p50: number;
+  p90: number;
+  p99: number;
+  max: number;
+}
+
+export interface PoolStats {
+  workers: number;
+  busy: number;
+  queued: number;
+  maxQueue: number;
+  counters: {
+    submitted: number;
+    completed: number;
+    failed: number;
+    rejectedQueueFull: number;
+    rejectedInvalid: number;
+    expiredInQueue: number;
+    budgetExceeded: number;
+    workerRestarts: number;
+    affinityHits: number;
+    affinityMisses: number;
+    spills: number;
+    cutoffsShared: number;
+  };
+  latencyMs: LatencySummary;
+  queueWaitMs: LatencySummary;
+  routing: 'sticky' | 'fifo';
+  /** Share of routed jobs that ran on a worker already warm for their family */
+  hitRatio: number;
+  families: FamilyStats[];
+}
+
+export interface FamilyStats {
+  family: string;
+  jobs: number;
+  hitRatio: number;
+  spills: number;
+  latencyMs: LatencySummary;
+}
+
+export interface SolverPoolOptions {
+  size?: number;
+  maxQueue?: number;
+  defaultBudgetMs?: number;
+  /** Overrun tolerated before a worker is terminated and replaced */
+  graceMs?: number;
+  initOptions?: InitOptions;
+  workerUrl?: URL | string;
+  /** 'sticky' routes model families to the same worker by consistent hashing */
+  routing?: 'sticky' | 'fifo';
+  /** How long a job waits for its busy home worker before spilling (default 50) */
+  spillAfterMs?: number;
+  /** Families each worker keeps warm (default 64) */
+  familyCacheSize?: number;
+  /** Families tracked in stats().families (default 1024) */
+  maxFamilies?: number;
+  /** Blobs of at least this many bytes are posted as one shared copy (default 1 MiB) */
+  shareThreshold?: number;
+  /** Minimum interval of mid-solve progress updates (default 100) */
+  progressIntervalMs?: number;
+  /** Post each job's new incumbents as a cutoff to the other jobs of its group */
+  shareCutoffs?: boolean;
+}
+
+/**
+ * Pool of worker_threads SCIPApi instances behind a bounded queue
+ */
+export class SolverPool {
+  constructor(options?: SolverPoolOptions);
+  readonly size: number;
+  submit(
+    model: ArrayBuffer | SharedArrayBuffer | Uint8Array | string,
+    options?: { format?: string; budgetMs?: number; transfer?: boolean; solveOptions?: CallbackSolveOptions; family?: string; group?: string | null }
+  ): Promise<CallbackSolution & {
+    values?: Float64Array;
+    timing: { queueMs: number; totalMs: number };
+    routing?: { family: string; worker: number; hit: boolean; spilled: boolean };
+  }>;
+  /** Solve the connected components of a blob on separate workers and merge the results */
+  solveComponents(
+    model: ModelBuilder | ArrayBuffer | SharedArrayBuffer | Uint8Array,
+    options?: { budgetMs?: number; solveOptions?: CallbackSolveOptions; maxParts?: number }
+  ): Promise<CallbackSolution & {
+    values: Float64Array;
+    components: {
+      count: number;
+      parts: number;
+      isolatedVars: number;
+      results?: Array<{ vars: number; rows: number; status: string; objective: number; worker: number | null; solveMs: number | null }>;
+    };
+  }>;
+  /** Benders decomposition on one worker; separate decompositions run in parallel */
+  solveBenders(
+    master: ModelBuilder | ArrayBuffer | Uint8Array,
+    subproblems: Array<ModelBuilder | ArrayBuffer | Uint8Array>,
+    options?: { budgetMs?: number; solveOptions?: { timeLimit?: number } }
+  ): Promise<BendersSolution & { timing: { queueMs: number; totalMs: number } }>;
+  familyStats(limit?: number): FamilyStats[];
+  /** Tighten the cutoff of a group's queued and running jobs; returns jobs notified */
+  postCutoff(group: string, message: { objlimit?: number; values?: ArrayLike<number> }): number;
+  /** Live state of each worker's solve, read from shared memory */
+  progress(): Array<{
+    worker: number;
+    busy: boolean;
+    jobId: number | null;
+    family: string | null;
+    runningMs: number;
+    solver: ProgressSnapshot | null;
+  }>;
+  stats(): PoolStats;
+  close(): Promise<void>;
+}
+
+/** Routing key of a model: structure hash for blobs, text hash otherwise */
+export function modelFamilyKey(model: ArrayBuffer | SharedArrayBuffer | Uint8Array | string): string;
+
+export class HashRing {
+  constructor(slots: number, vnodes?: number);
+  /** Distinct worker slots in ring order from the key's position */
+  preference(key: string): number[];
+}
+
+/** Built-in LNS neighbourhoods */
+export const Neighbourhood: {
+  readonly RANDOM: 'random';
+  readonly CONSTRAINT: 'constraint';
+  readonly OBJECTIVE: 'objective';
+  readonly CROSSOVER: 'crossover';
+};
+
+export interface LNSOptions {
+  neighbourhoods?: string[];
+  /** Seconds for the whole search */
+  timeLimit?: number;
+  maxIterations?: number;
+  /** Seconds per sub-MIP */
+  subTimeLimit?: number;
+  /** Nodes per sub-MIP */
+  subNodeLimit?: number;
+  /** Initial share of integer variables fixed */
+  fixRate?: number;
+  /** Sub-MIPs in flight (default: pool size) */
+  parallel?: number;
+  initialValues?: ArrayLike<number>;
+  initialTimeLimit?: number;
+  exploration?: number;
+  seed?: number;
+  onImprove?: (event: { objective: number; values: Float64Array; neighbourhood: string; iteration: number }) => void;
+}
+
+export interface LNSResult {
+  objective: number;
+  values: Float64Array;
+  iterations: number;
+  failures: number;
+  seconds: number;
+  history: Array<{ ms: number; objective: number; neighbourhood: string; iteration: number }>;
+  neighbourhoods: Array<{ name: string; runs: number; improvements: number; meanGain: number; fixRate: number }>;
+}
+
+/** Large-neighbourhood search over a SolverPool (scip.js/lns) */
+export class LNSEngine {
+  constructor(pool: SolverPool, model: ModelBuilder | ArrayBuffer | SharedArrayBuffer | Uint8Array, options?: LNSOptions);
+  best: number | null;
+  bestValues: Float64Array | null;
+  run(): Promise<LNSResult>;
+}
+
+export interface SolveServerOptions {
+  port?: number;
+  host?: string;
+  socketPath?: string | null;
+  workers?: number;
+  maxQueue?: number;
+  defaultBudgetMs?: number;
+  maxBudgetMs?: number;
+  maxBodyBytes?: number;
+  initOptions?: InitOptions;
+  pool?: SolverPool | null;
+}
+
+/**
+ * Start the local HTTP / Unix-socket solve server (POST /solve, GET /metrics)
+ */
+export function createSolveServer(options?: SolveServerOptions): Promise<{
+  server: import('http').Server;
+  pool: SolverPool;
+  address: string;
+  close(): Promise<void>;
+}>;
+
@@ -0,0 +1,387 @@
+#!/usr/bin/env node
+/**
+ * SCIP.js offline parameter tuner
+ *
+ * Races parameter configurations over a model family's sample instances on a
+ * local SolverPool and emits the winner as a settings profile for
+ * SCIPApi.applySettings() / solveModel({ settings }), plus optionally a SCIP
+ * settings file. The search covers emphasis, the heuristics / presolving /
+ * separating meta settings, the branching rule and a few round limits.
+ *
+ * Racing: instances are visited one at a time. Defaults run first with the
+ * full time limit; every surviving candidate then runs with a time cap of
+ * --cap times the default's time, so hopeless configurations stop early.
+ * After --min-instances, candidates whose mean rank trails the leader by more
+ * than the Friedman/Nemenyi critical difference are dropped, as are any that
+ * report a different optimal objective than the defaults.
+ *
+ * Instances: *.lp, *.mps, *.cip, *.zpl problem files or *.bin blobs from
+ * ModelBuilder.compile(), in one directory.
+ *
+ * Usage:
+ *   node tune/scip-tune.mjs --dir samples/ [--candidates 24] [--time 10] [--cap 1.5]
+ *     [--workers 4] [--min-instances 3] [--seed 1] [--out profile.json] [--set profile.set]
+ */
+
+import { readdirSync, readFileSync, writeFileSync } from 'fs';
+import { basename, dirname, extname, resolve } from 'path';
+import { fileURLToPath } from 'url';
+import { SolverPool } from '../dist/scip-pool.js';
+
+const __dirname = dirname(fileURLToPath(import.meta.url));
+const distDir = resolve(__dirname, '..', 'dist');
+
+/**
+ * Search space; the first value of each dimension is SCIP's default
+ */
+export const SEARCH_SPACE = {
+  emphasis: ['default', 'easycip', 'feasibility', 'hardlp', 'optimality'],
+  heuristics: ['default', 'aggressive', 'fast', 'off'],
+  presolving: ['default', 'aggressive', 'fast', 'off'],
+  separating: ['default', 'aggressive', 'fast', 'off'],
+  branching: ['relpscost', 'pscost', 'inference', 'mostinf', 'fullstrong'],
+  'separating/maxroundsroot': [-1, 5, 20],
+  'presolving/maxrestarts': [-1, 0],
+};
+
+const META = ['emphasis', 'heuristics', 'presolving', 'separating'];
+// Above every default branching rule priority (relpscost: 10000)
+const BRANCHING_PRIORITY = 1000000;
+const SHIFT_SECONDS = 1;
+
+// Nemenyi q at alpha = 0.1 for 2..10 candidates
+const NEMENYI_Q = [0, 0, 1.645, 2.052, 2.291, 2.459, 2.589, 2.693, 2.780, 2.855, 2.920];
+
+function mulberry32(seed) {
+  return function () {
+    seed |= 0;
+    seed = (seed + 0x6d2b79f5) | 0;
+    let t = Math.imul(seed ^ (seed >>> 15), 1 | seed);
+    t = (t + Math.imul(t ^ (t >>> 7), 61 | t)) ^ t;
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+/**
+ * Settings profile of a candidate (only what differs from the defaults)
+ */
+export function toProfile(candidate) {
+  const profile = { params: {} };
+  for (const key of META) {
+    if (candidate[key] !== SEARCH_SPACE[key][0]) {
+      profile[key] = candidate[key];
+    }
+  }
+  if (candidate.branching !== SEARCH_SPACE.branching[0]) {
+    profile.params[`branching/${candidate.branching}/priority`] = BRANCHING_PRIORITY;
+  }
+  for (const [key, values] of Object.entries(SEARCH_SPACE)) {
+    if (key.includes('/') && candidate[key] !== values[0]) {
+      profile.params[key] = candidate[key];
+    }
+  }
+  if (Object.keys(profile.params).length === 0) {
+    delete profile.params;
+  }
+  return profile;
+}
+
+function label(candidate) {
+  const parts = Object.entries(candidate)
+    .filter(([key, value]) => value !== SEARCH_SPACE[key][0])
+    .map(([key, value]) => `${key.split('/').pop()}=${value}`);
+  return parts.length > 0 ? parts.join(' ') : 'defaults';
+}
+
+/**
+ * Defaults plus up to count - 1 distinct random configurations
+ */
+export function sampleCandidates(count, rand) {
+  const defaults = Object.fromEntries(Object.entries(SEARCH_SPACE).map(([key, values]) => [key, values[0]]));
+  const seen = new Set([JSON.stringify(defaults)]);
+  const candidates = [defaults];
+  for (let attempt = 0; candidates.length < count && attempt < count * 50; attempt += 1) {
+    const candidate = Object.fromEntries(Object.entries(SEARCH_SPACE).map(([key, values]) => [key, values[Math.floor(rand() * values.length)]]));
+    const key = JSON.stringify(candidate);
+    if (!seen.has(key)) {
+      seen.add(key);
+      candidates.push(candidate);
+    }
+  }
+  return candidates;
+}
+
+/**
+ * Load the sample instances of a family from a directory
+ */
+export function loadInstances(dir) {
+  const formats = { '.lp': 'lp', '.mps': 'mps', '.cip': 'cip', '.zpl': 'zpl' };
+  return readdirSync(dir)
+    .sort()
+    .flatMap((file) => {
+      const ext = extname(file).toLowerCase();
+      const path = resolve(dir, file);
+      if (ext === '.bin') {
+        const bytes = readFileSync(path);
+        return [{ name: basename(file), model: new Uint8Array(bytes.buffer, bytes.byteOffset, bytes.length), format: null }];
+      }
+      if (formats[ext]) {
+        return [{ name: basename(file), model: readFileSync(path, 'utf8'), format: formats[ext] }];
+      }
+      return [];
+    });
+}
+
+// Ranks within one instance, ties averaged (1 = fastest)
+function rankScores(scores) {
+  const order = scores.map((score, i) => [score, i]).sort((a, b) => a[0] - b[0]);
+  const ranks = new Array(scores.length);
+  for (let i = 0; i < order.length;) {
+    let j = i;
+    while (j + 1 < order.length && order[j + 1][0] === order[i][0]) {
+      j += 1;
+    }
+    for (let k = i; k <= j; k += 1) {
+      ranks[order[k][1]] = (i + j) / 2 + 1;
+    }
+    i = j + 1;
+  }
+  return ranks;
+}
+
+function criticalDifference(k, n) {
+  const q = k < NEMENYI_Q.length ? NEMENYI_Q[k] : NEMENYI_Q[NEMENYI_Q.length - 1] + 0.2 * Math.log(k / 10);
+  return q * Math.sqrt((k * (k + 1)) / (6 * n));
+}
+
+function shiftedGeomean(values) {
+  const sum = values.reduce((acc, v) => acc + Math.log(v + SHIFT_SECONDS), 0);
+  return Math.exp(sum / values.length) - SHIFT_SECONDS;
+}
+
+function sameObjective(a, b) {
+  return Math.abs(a - b) <= 1e-6 * Math.max(1, Math.abs(a), Math.abs(b));
+}
+
+/**
+ * Race candidate configurations over the instances
+ * @param {Object} options
+ * @param {Array<{name, model, format}>} options.instances
+ * @param {number} options.candidates - Configurations to race, defaults included
+ * @param {number} options.timeLimit - Seconds per solve
+ * @param {number} options.cap - Candidate time cap as a multiple of the default's time
+ * @param {number} options.minInstances - Instances before elimination starts
+ * @param {number} options.workers - Pool size
+ * @param {number} options.seed
+ * @param {Function} options.log - Progress lines
+ */
+export async function tune({
+  instances,
+  candidates: count = 24,
+  timeLimit = 10,
+  cap = 1.5,
+  minInstances = 3,
+  workers,
+  seed = 1,
+  initOptions = {},
+  log = () => {},
+} = {}) {
+  const rand = mulberry32(seed);
+  const candidates = sampleCandidates(count, rand).map((config, id) => ({
+    id,
+    config,
+    profile: toProfile(config),
+    label: label(config),
+    times: [],
+    alive: true,
+    eliminatedAt: null,
+    reason: null,
+  }));
+  const defaults = candidates[0];
+  const order = instances.slice();
+  for (let i = order.length - 1; i > 0; i -= 1) {
+    const j = Math.floor(rand() * (i + 1));
+    [order[i], order[j]] = [order[j], order[i]];
+  }
+  const pool = new SolverPool({ size: workers, routing: 'fifo', maxQueue: Math.max(64, count * 2), initOptions });
+  let solves = 0;
+  let cappedSolves = 0;
+  let failedSolves = 0;
+
+  // A failed solve (error result or rejected job) counts as unsolved, so it
+  // scores PAR2 on the cap instead of aborting the race
+  const run = async (candidate, instance, limit) => {
+    solves += 1;
+    let result;
+    try {
+      result = await pool.submit(instance.model, {
+        format: instance.format || 'lp',
+        budgetMs: limit * 1000 + 30000,
+        solveOptions: { timeLimit: limit, settings: candidate === defaults ? null : candidate.profile },
+      });
+    } catch (error) {
+      result = { status: 'error', error: error.message };
+    }
+    if (!result.statistics) {
+      failedSolves += 1;
+      log(`${candidate.label} on ${instance.name}: ${result.error || result.status}`);
+      return { solved: false, status: result.status, objective: NaN, time: limit };
+    }
+    const solved = result.status === 'optimal' || result.status === 'infeasible';
+    return { solved, status: result.status, objective: result.objective, time: result.statistics.solvingTime };
+  };
+
+  try {
+    for (let n = 0; n < order.length; n += 1) {
+      const instance = order[n];
+      const base = await run(defaults, instance, timeLimit);
+      const limit = base.solved ? Math.min(timeLimit, Math.max(0.5, base.time * cap)) : timeLimit;
+      // Unsolved within the cap: PAR2 on the cap
+      const score = (outcome, cappedAt) => (outcome.solved ? outcome.time : 2 * cappedAt);
+
+      const alive = candidates.filter((c) => c.alive);
+      const outcomes = await Promise.all(alive.map((c) => (c === defaults ? base : run(c, instance, limit))));
+      alive.forEach((c, i) => {
+        const outcome = outcomes[i];
+        c.times.push(score(outcome, c === defaults ? timeLimit : limit));
+        if (c !== defaults && !outcome.solved) {
+          cappedSolves += 1;
+        }
+        if (c !== defaults && outcome.solved && base.solved && base.status === 'optimal' && outcome.status === 'optimal'
+          && !sameObjective(outcome.objective, base.objective)) {
+          c.alive = false;
+          c.eliminatedAt = n + 1;
+          c.reason = `objective ${outcome.objective} != ${base.objective} on ${instance.name}`;
+        }
+      });
+
+      const racing = candidates.filter((c) => c.alive);
+      // Rank on the instances seen so far among the candidates still racing
+      const blockRanks = racing.map(() => 0);
+      for (let i = 0; i <= n; i += 1) {
+        rankScores(racing.map((c) => c.times[i])).forEach((r, j) => {
+          blockRanks[j] += r;
+        });
+      }
+      racing.forEach((c, j) => {
+        c.meanRank = blockRanks[j] / (n + 1);
+      });
+
+      if (n + 1 >= minInstances && racing.length > 1) {
+        const best = Math.min(...racing.map((c) => c.meanRank));
+        const cd = criticalDifference(racing.length, n + 1);
+        for (const c of racing) {
+          // Defaults keep racing as the baseline
+          if (c !== defaults && c.meanRank - best > cd) {
+            c.alive = false;
+            c.eliminatedAt = n + 1;
+            c.reason = `mean rank ${c.meanRank.toFixed(2)} vs ${best.toFixed(2)} (cd ${cd.toFixed(2)})`;
+          }
+        }
+      }
+      log(`${n + 1}/${order.length} ${instance.name}: defaults ${base.time.toFixed(2)}s, `
+        + `${candidates.filter((c) => c.alive).length} candidates left`);
+    }
+  } finally {
+    await pool.close();
+  }
+
+  const finalists = candidates.filter((c) => c.alive);
+  finalists.sort((a, b) => a.meanRank - b.meanRank || shiftedGeomean(a.times) - shiftedGeomean(b.times));
+  const winner = finalists[0];
+  const speedups = winner.times.map((t, i) => defaults.times[i] / Math.max(t, 1e-3));
+
+  return {
+    winner: { label: winner.label, profile: winner.profile },
+    speedup: {
+      shiftedGeomean: shiftedGeomean(defaults.times) / Math.max(shiftedGeomean(winner.times), 1e-3),
+      total: defaults.times.reduce((a, b) => a + b, 0) / Math.max(winner.times.reduce((a, b) => a + b, 0), 1e-3),
+      perInstance: Object.fromEntries(order.map((inst, i) => [inst.name, speedups[i]])),
+    },
+    instances: order.length,
+    solves,
+    cappedSolves,
+    failedSolves,
+    candidates: candidates.map((c) => ({
+      label: c.label,
+      alive: c.alive,
+      meanRank: c.meanRank,
+      instancesRun: c.times.length,
+      shiftedGeomeanSeconds: shiftedGeomean(c.times),
+      eliminatedAt: c.eliminatedAt,
+      reason: c.reason,
+    })),
+  };
+}
+
+/**
+ * SCIP settings file text for a profile (needs the wasm build)
+ */
+export async function profileToSettingsFile(profile) {
+  const { SCIPApi } = await import('../dist/scip-api-wrapper.js');
+  const solver = new SCIPApi();
+  await solver.init({ wasmPath: resolve(distDir, 'scip-api.wasm') });
+  try {
+    solver.applySettings(profile);
+    return solver.saveSettings();
+  } finally {
+    solver.destroy();
+  }
+}
+
+function parseArgs(argv) {
+  const args = { candidates: 24, time: 10, cap: 1.5, 'min-instances': 3, seed: 1 };
+  for (let i = 0; i < argv.length; i += 1) {
+    if (argv[i].startsWith('--')) {
+      args[argv[i].slice(2)] = argv[i + 1];
+      i += 1;
+    }
+  }
+  return args;
+}
+
+// CLI: node tune/scip-tune.mjs --dir samples/ [--out profile.json] [--set profile.set]
+if (process.argv[1] && fileURLToPath(import.meta.url) === process.argv[1]) {
+  const args = parseArgs(process.argv.slice(2));
+  if (!args.dir) {
+    console.error('usage: node tune/scip-tune.mjs --dir <instances> [--candidates 24] [--time 10] [--out profile.json]');
+    process.exit(1);
+  }
+  const instances = loadInstances(args.dir);
+  if (instances.length === 0) {
+    console.error(`no instances in ${args.dir}`);
+    process.exit(1);
+  }
+
+  const report = await tune({
+    instances,
+    candidates: Number(args.candidates),
+    timeLimit: Number(args.time),
+    cap: Number(args.cap),
+    minInstances: Number(args['min-instances']),
+    workers: args.workers ? Number(args.workers) : undefined,
+    seed: Number(args.seed),
+    initOptions: { wasmPath: resolve(distDir, 'scip-api.wasm') },
+    log: (line) => console.log(line),
+  });
+
+  console.table(report.candidates.map((c) => ({
+    config: c.label,
+    alive: c.alive,
+    meanRank: c.meanRank !== undefined ? +c.meanRank.toFixed(2) : null,
+    instances: c.instancesRun,
+    sgmSeconds: +c.shiftedGeomeanSeconds.toFixed(3),
+  })));
+  console.log(`winner: ${report.winner.label}`);
+  console.log(`speedup over defaults: ${report.speedup.shiftedGeomean.toFixed(2)}x (shifted geomean), `
+    + `${report.speedup.total.toFixed(2)}x (total time); ${report.solves} solves, ${report.cappedSolves} capped, ${report.failedSolves} failed`);
+
+  if (args.out) {
+    writeFileSync(args.out, `${JSON.stringify({ family: basename(resolve(args.dir)), ...report }, null, 2)}\n`);
+    console.log(`profile written to ${args.out}`);
+  }
+  if (args.set) {
+    writeFileSync(args.set, await profileToSettingsFile(report.winner.profile));
+    console.log(`settings file written to ${args.set}`);
+  }
+}